@@ -7,10 +7,11 @@
 #include "include/BuiltIn.CascadedShadowMap.glsl"
 #include "include/BuiltIn.PBR.glsl"
 
-layout(set = 3, binding = 0) uniform sampler2D uGBuffer_Position;
-layout(set = 3, binding = 1) uniform sampler2D uGBuffer_Normal;
-layout(set = 3, binding = 2) uniform sampler2D uGBuffer_Albedo;
-layout(set = 3, binding = 3) uniform sampler2D uGBuffer_AO_Metal_Rough;
+// GBuffer is read at the same pixel, so the deferred pass can be merged with the GBuffer pass into a single render pass
+layout(input_attachment_index = 0, set = 3, binding = 0) uniform subpassInput uGBuffer_Position;
+layout(input_attachment_index = 1, set = 3, binding = 1) uniform subpassInput uGBuffer_Normal;
+layout(input_attachment_index = 2, set = 3, binding = 2) uniform subpassInput uGBuffer_Albedo;
+layout(input_attachment_index = 3, set = 3, binding = 3) uniform subpassInput uGBuffer_AO_Metal_Rough;
 
 layout(location = 0) in vec2 texCoords;
 
@@ -19,13 +20,13 @@ layout(location = 0) out vec4 outColor;
 void main() {
     SurfacePoint point;
 
-    point.n             = texture(uGBuffer_Normal, texCoords).xyz;
-    point.p             = texture(uGBuffer_Position, texCoords).xyz;
+    point.n             = subpassLoad(uGBuffer_Normal).xyz;
+    point.p             = subpassLoad(uGBuffer_Position).xyz;
     point.v             = normalize(uCameraWS - point.p);
 
-    point.surface_color = texture(uGBuffer_Albedo, texCoords).rgb;
+    point.surface_color = subpassLoad(uGBuffer_Albedo).rgb;
 
-    vec3 ao_metal_rough = texture(uGBuffer_AO_Metal_Rough, texCoords).xyz;
+    vec3 ao_metal_rough = subpassLoad(uGBuffer_AO_Metal_Rough).xyz;
     point.metallic      = ao_metal_rough.y;
     point.roughness     = ao_metal_rough.z;
 
@@ -4,12 +4,6 @@
 #include "include/BuiltIn.FrameData.glsl"
 #include "include/BuiltIn.ViewData.glsl"
 
-/* Push constants */
-layout(push_constant) uniform ModelConstant
-{
-    mat4 uModel;
-};
-
 /* Attributes */
 layout(location = 0) in vec3 aPositionMS;
 layout(location = 1) in vec2 aTexCoords;
@@ -19,6 +13,8 @@ layout(location = 4) in vec3 aBitangentMS;
 
 void main()
 {
-    vec4 positionWS = uModel * vec4(aPositionMS, 1.0);
+    mat4 model = uInstanceModels[gl_InstanceIndex];
+
+    vec4 positionWS = model * vec4(aPositionMS, 1.0);
     gl_Position = uProj * uView * positionWS;
 }
\ No newline at end of file
@@ -5,12 +5,6 @@
 #include "include/BuiltIn.ViewData.glsl"
 #include "include/BuiltIn.SceneData.glsl"
 
-/* Push constants */
-layout(push_constant) uniform ModelConstant
-{
-    mat4 uModel;
-};
-
 /* Attributes */
 layout(location = 0) in vec3 aPositionMS;
 layout(location = 1) in vec2 aTexCoords;
@@ -24,10 +18,12 @@ layout(location = 2) out mat3 TBN;
 
 void main()
 {
-    positionWS = (uModel * vec4(aPositionMS, 1.0)).xyz;
+    mat4 model = uInstanceModels[gl_InstanceIndex];
+
+    positionWS = (model * vec4(aPositionMS, 1.0)).xyz;
     texCoords  = aTexCoords;
 
-    mat3 normalMatrix = transpose(inverse(mat3(uModel)));
+    mat3 normalMatrix = transpose(inverse(mat3(model)));
     TBN = normalMatrix * mat3(aTangentMS.xyz, aBitangentMS, aNormalMS.xyz);
 
     gl_Position = uProj * uView * vec4(positionWS, 1.0);
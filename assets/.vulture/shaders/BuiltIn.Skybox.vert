@@ -4,12 +4,6 @@
 #include "include/BuiltIn.FrameData.glsl"
 #include "include/BuiltIn.ViewData.glsl"
 
-/* Push constants */
-layout(push_constant) uniform ModelConstant
-{
-    mat4 uModel;
-};
-
 /* Attributes */
 layout(location = 0) in vec3 aPositionMS;
 
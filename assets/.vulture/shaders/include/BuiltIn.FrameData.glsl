@@ -3,3 +3,9 @@ layout(set = 0, binding = 0) uniform FrameData
 {
     float uTime;
 };
+
+/* Model matrices of instanced draws, indexed by gl_InstanceIndex */
+layout(std430, set = 0, binding = 1) readonly buffer InstancesData
+{
+    mat4 uInstanceModels[];
+};
@@ -42,6 +42,8 @@
 
 using namespace vulture;
 
+static constexpr const char* kPipelineCacheFilename = "assets/.vulture/pipeline_cache.bin";
+
 /************************************************************************************************
  * INIT
  ************************************************************************************************/
@@ -60,6 +62,7 @@ int EditorApp::Init() {
   event_dispatcher_.GetSink<QuitEvent>().Connect<&EditorApp::OnQuit>(*this);
 
   device_.Init(&window_, nullptr, nullptr, false);
+  device_.LoadPipelineCache(kPipelineCacheFilename);
 
   /* Register loaders FIXME: (tralf-strues) move somewhere else */
   AssetRegistry::Instance()->RegisterLoader(CreateShared<OBJLoader>(device_));
@@ -257,6 +260,12 @@ void EditorApp::Run() {
 
   scene_.OnStart(event_dispatcher_);
 
+  /* Build the pipelines now, instead of stalling the first frames */
+  auto main_camera_entity = scene_.GetMainCamera();
+  Camera& main_camera = main_camera_entity.Get<CameraComponent>().camera;
+  main_camera.render_texture = preview_panel_->GetTexture();
+  renderer_->PrebuildShaders(main_camera, asset_registry.GetLoaded<Shader>());
+
   bool first_frame = true;
   current_time_ = timer_.Elapsed();
   while (running_) {
@@ -295,6 +304,7 @@ void EditorApp::Run() {
   }
 
   device_.WaitIdle();
+  device_.SavePipelineCache(kPipelineCacheFilename);
 }
 
 void EditorApp::Render() {
@@ -48,6 +48,8 @@ RendererPanel::~RendererPanel() {
 
 void RendererPanel::OnRender(Renderer& renderer, uint32_t frame_index) {
   if (ImGui::Begin("Renderer")) {
+    RenderViewStatistics(renderer);
+
     for (const auto& feature : renderer.GetFeatures()) {
       if (feature->Name() == "Cascaded Shadow Mapping") {
         RenderCSMFeature(dynamic_cast<CascadedShadowMapRenderFeature&>(*feature), frame_index);
@@ -58,6 +60,24 @@ void RendererPanel::OnRender(Renderer& renderer, uint32_t frame_index) {
   ImGui::End();
 }
 
+void RendererPanel::RenderViewStatistics(const Renderer& renderer) {
+  if (ImGui::TreeNodeEx("Views", kComponentNodeBaseFlags, "Views")) {
+    auto render_statistics = [](const char* name, const ViewStatistics& statistics) {
+      ImGui::Text("%-8s CPU %6.3f ms | GPU %6.3f ms | %u draws, %u instances", name, statistics.cpu_time_ms,
+                  statistics.gpu_time_ms, statistics.draw_statistics.draws, statistics.draw_statistics.instances);
+    };
+
+    render_statistics("Shared", renderer.GetSharedStatistics());
+
+    for (uint32_t view_idx = 0; view_idx < renderer.GetViewsCount(); ++view_idx) {
+      String name = fmt::format("View {}", view_idx);
+      render_statistics(name.c_str(), renderer.GetViewStatistics(view_idx));
+    }
+
+    ImGui::TreePop();
+  }
+}
+
 void RendererPanel::RenderCSMFeature(CascadedShadowMapRenderFeature& feature, uint32_t frame_index) {
   void* code = (void*)typeid(CascadedShadowMapRenderFeature).hash_code();
   if (ImGui::TreeNodeEx(code, kComponentNodeBaseFlags, "Cascaded Shadow Mapping")) {
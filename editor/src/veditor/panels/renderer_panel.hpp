@@ -41,6 +41,7 @@ class RendererPanel {
   void OnRender(Renderer& renderer, uint32_t frame_index);
 
  private:
+  void RenderViewStatistics(const Renderer& renderer);
   void RenderCSMFeature(CascadedShadowMapRenderFeature& feature, uint32_t frame_index);
 
  private:
@@ -0,0 +1,94 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file bench_utils.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <bench_utils.hpp>
+#include <vulture/asset/asset_registry.hpp>
+#include <vulture/asset/loaders/dae_loader.hpp>
+#include <vulture/asset/loaders/fbx_loader.hpp>
+#include <vulture/asset/loaders/glb_loader.hpp>
+#include <vulture/asset/loaders/jpg_loader.hpp>
+#include <vulture/asset/loaders/obj_loader.hpp>
+#include <vulture/asset/loaders/png_loader.hpp>
+#include <vulture/asset/loaders/shader_loader.hpp>
+#include <vulture/asset/loaders/skybox_loader.hpp>
+#include <vulture/asset/loaders/tga_loader.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace vulture;
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations_count{0};
+
+}  // namespace
+
+/************************************************************************************************
+ * Allocation counting
+ ************************************************************************************************/
+void* operator new(std::size_t size) {
+  g_heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+uint64_t bench::GetHeapAllocationsCount() { return g_heap_allocations_count.load(std::memory_order_relaxed); }
+
+/************************************************************************************************
+ * Bench device
+ ************************************************************************************************/
+
+NullRenderDevice& bench::GetBenchDevice() {
+  static NullRenderDevice* device = nullptr;
+
+  if (device == nullptr) {
+    device = new NullRenderDevice();
+    device->Init(nullptr, nullptr, nullptr, false);
+
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<OBJLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<DAELoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<FBXLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<GLBLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<TGALoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<JPGLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<PNGLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<ShaderLoader>(*device));
+    AssetRegistry::Instance()->RegisterLoader(CreateShared<SkyboxLoader>(*device));
+  }
+
+  return *device;
+}
@@ -0,0 +1,55 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file bench_utils.hpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
+
+namespace vulture {
+namespace bench {
+
+/**
+ * @brief Headless device shared by all benchmarks.
+ *
+ * Initialized on the first call, asset loaders are registered with it the same way the editor does, so that
+ * benchmarks loading assets go through the regular AssetRegistry path.
+ *
+ * @note Assets are loaded relative to the working directory, so the benchmarks are supposed to be run from the
+ *       repository root.
+ */
+NullRenderDevice& GetBenchDevice();
+
+/**
+ * @brief Number of global operator new calls since the start of the program, from all threads.
+ *
+ * The benchmark executable replaces the global operator new to count them, which is used to check that steady-state
+ * frames don't allocate.
+ */
+uint64_t GetHeapAllocationsCount();
+
+}  // namespace bench
+}  // namespace vulture
@@ -0,0 +1,101 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file blackboard_bench.cpp
+ * @date 2023-06-26
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <any>
+#include <typeindex>
+#include <unordered_map>
+#include <vulture/renderer/render_graph/blackboard.hpp>
+
+using namespace vulture;
+
+namespace {
+
+template <uint32_t kIdx>
+struct BenchData {
+  uint32_t value{kIdx};
+};
+
+/**
+ * @brief Previous Blackboard storage, kept for comparison.
+ */
+class TypeIndexBlackboard {
+ public:
+  template <typename T, typename... Args>
+  T& Add(Args&&... args) {
+    return storage_[typeid(T)].emplace<T>(T{std::forward<Args>(args)...});
+  }
+
+  template <typename T>
+  T& Get() {
+    return std::any_cast<T&>(storage_.at(typeid(T)));
+  }
+
+ private:
+  std::unordered_map<std::type_index, std::any> storage_;
+};
+
+template <typename BlackboardT, uint32_t... kIndices>
+void AddBenchData(BlackboardT& blackboard, std::integer_sequence<uint32_t, kIndices...>) {
+  (blackboard.template Add<BenchData<kIndices>>(), ...);
+}
+
+template <typename BlackboardT, uint32_t... kIndices>
+uint32_t GetBenchData(BlackboardT& blackboard, std::integer_sequence<uint32_t, kIndices...>) {
+  return (blackboard.template Get<BenchData<kIndices>>().value + ...);
+}
+
+/**
+ * @brief Number of different types in the blackboard, roughly the number of pass data types in the renderer.
+ */
+using BenchIndices = std::make_integer_sequence<uint32_t, 16>;
+
+template <typename BlackboardT>
+void BenchmarkBlackboardGet(benchmark::State& state) {
+  BlackboardT blackboard;
+  AddBenchData(blackboard, BenchIndices{});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GetBenchData(blackboard, BenchIndices{}));
+  }
+
+  state.SetItemsProcessed(state.iterations() * BenchIndices::size());
+}
+
+}  // namespace
+
+/**
+ * @brief Get each of the 16 types, as passes do multiple times per frame.
+ */
+static void BM_BlackboardGet(benchmark::State& state) { BenchmarkBlackboardGet<rg::Blackboard>(state); }
+BENCHMARK(BM_BlackboardGet);
+
+static void BM_BlackboardGetTypeIndexMap(benchmark::State& state) {
+  BenchmarkBlackboardGet<TypeIndexBlackboard>(state);
+}
+BENCHMARK(BM_BlackboardGetTypeIndexMap);
@@ -0,0 +1,157 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file draw_list_bench.cpp
+ * @date 2023-06-18
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vulture/renderer/draw_list.hpp>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kPipelinesCount = 8;
+constexpr uint32_t kMaterialsCount = 64;
+constexpr uint32_t kMeshesCount    = 256;
+
+struct SyntheticDraw {
+  PipelineHandle      pipeline;
+  DescriptorSetHandle material_set;
+  BufferHandle        vertex_buffer;
+  float               depth;
+};
+
+Vector<SyntheticDraw> GenerateDraws(uint32_t count) {
+  std::mt19937                            generator{42};
+  std::uniform_int_distribution<uint32_t> pipeline_distribution{1, kPipelinesCount};
+  std::uniform_int_distribution<uint32_t> material_distribution{1, kMaterialsCount};
+  std::uniform_int_distribution<uint32_t> mesh_distribution{1, kMeshesCount};
+  std::uniform_real_distribution<float>   depth_distribution{0.1f, 1000.0f};
+
+  Vector<SyntheticDraw> draws;
+  draws.reserve(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    draws.push_back(SyntheticDraw{pipeline_distribution(generator), material_distribution(generator),
+                                  mesh_distribution(generator), depth_distribution(generator)});
+  }
+
+  return draws;
+}
+
+}  // namespace
+
+static void BM_DrawListBuildAndSort(benchmark::State& state) {
+  uint32_t              count = static_cast<uint32_t>(state.range(0));
+  DrawOrder             order = static_cast<DrawOrder>(state.range(1));
+  Vector<SyntheticDraw> draws = GenerateDraws(count);
+
+  DrawList draw_list;
+  for (auto _ : state) {
+    draw_list.Clear();
+    for (const auto& draw : draws) {
+      draw_list.Add(DrawList::CalculateSortKey(order, draw.pipeline, draw.material_set, draw.vertex_buffer, draw.depth),
+                    DrawList::Draw{});
+    }
+
+    draw_list.Sort();
+    benchmark::DoNotOptimize(&draw_list[0]);
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_DrawListBuildAndSort)
+    ->ArgsProduct({benchmark::CreateRange(256, 65536, 4),
+                   {static_cast<int64_t>(DrawOrder::kStateChanges), static_cast<int64_t>(DrawOrder::kFrontToBack)}});
+
+/**
+ * @brief Reference comparison sort of the same keys.
+ */
+static void BM_StdSortKeys(benchmark::State& state) {
+  uint32_t              count = static_cast<uint32_t>(state.range(0));
+  Vector<SyntheticDraw> draws = GenerateDraws(count);
+
+  Vector<uint64_t> keys(count);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < count; ++i) {
+      keys[i] = DrawList::CalculateSortKey(DrawOrder::kStateChanges, draws[i].pipeline, draws[i].material_set,
+                                           draws[i].vertex_buffer, draws[i].depth);
+    }
+
+    std::stable_sort(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(keys.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_StdSortKeys)->RangeMultiplier(4)->Range(256, 65536);
+
+/**
+ * @brief Number of state changes left after sorting, reported as counters.
+ */
+static void BM_DrawListStateChanges(benchmark::State& state) {
+  uint32_t              count = static_cast<uint32_t>(state.range(0));
+  DrawOrder             order = static_cast<DrawOrder>(state.range(1));
+  Vector<SyntheticDraw> draws = GenerateDraws(count);
+
+  uint32_t pipeline_changes = 0;
+  uint32_t material_changes = 0;
+  uint32_t buffer_changes   = 0;
+
+  DrawList draw_list;
+  for (auto _ : state) {
+    draw_list.Clear();
+    for (uint32_t draw_idx = 0; draw_idx < count; ++draw_idx) {
+      const SyntheticDraw& draw = draws[draw_idx];
+      draw_list.Add(DrawList::CalculateSortKey(order, draw.pipeline, draw.material_set, draw.vertex_buffer, draw.depth),
+                    DrawList::Draw{nullptr, nullptr, draw_idx, 1});
+    }
+
+    draw_list.Sort();
+
+    pipeline_changes = material_changes = buffer_changes = 0;
+
+    const SyntheticDraw* prev = nullptr;
+    for (uint32_t i = 0; i < draw_list.Size(); ++i) {
+      const SyntheticDraw* cur = &draws[draw_list[i].first_instance];
+
+      pipeline_changes += (prev == nullptr || prev->pipeline != cur->pipeline);
+      material_changes += (prev == nullptr || prev->material_set != cur->material_set);
+      buffer_changes   += (prev == nullptr || prev->vertex_buffer != cur->vertex_buffer);
+
+      prev = cur;
+    }
+  }
+
+  state.counters["pipeline_changes"] = pipeline_changes;
+  state.counters["material_changes"] = material_changes;
+  state.counters["buffer_changes"]   = buffer_changes;
+}
+BENCHMARK(BM_DrawListStateChanges)
+    ->Args({4096, static_cast<int64_t>(DrawOrder::kStateChanges)})
+    ->Args({4096, static_cast<int64_t>(DrawOrder::kFrontToBack)});
@@ -0,0 +1,68 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file event_system_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <vulture/event_system/event_system.hpp>
+
+using namespace vulture;
+
+namespace {
+
+struct BenchEvent {
+  uint32_t value{0};
+};
+
+struct BenchListener {
+  void OnEvent(const BenchEvent& event) { sum += event.value; }
+
+  uint64_t sum{0};
+};
+
+}  // namespace
+
+/**
+ * @brief Trigger an event, which has the given number of listeners connected.
+ */
+static void BM_DispatcherTrigger(benchmark::State& state) {
+  uint32_t listeners_count = static_cast<uint32_t>(state.range(0));
+
+  Dispatcher dispatcher;
+  std::vector<BenchListener> listeners(listeners_count);
+  for (auto& listener : listeners) {
+    dispatcher.GetSink<BenchEvent>().Connect<&BenchListener::OnEvent>(listener);
+  }
+
+  for (auto _ : state) {
+    dispatcher.Trigger<BenchEvent>(1u);
+  }
+
+  benchmark::DoNotOptimize(listeners.data());
+  state.SetItemsProcessed(state.iterations() * listeners_count);
+}
+BENCHMARK(BM_DispatcherTrigger)->RangeMultiplier(4)->Range(1, 1024);
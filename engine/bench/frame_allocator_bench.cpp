@@ -0,0 +1,140 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file frame_allocator_bench.cpp
+ * @date 2023-06-21
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <bench_utils.hpp>
+#include <random>
+#include <vulture/renderer/frame_allocator.hpp>
+#include <vulture/renderer/render_queue.hpp>
+
+using namespace vulture;
+
+namespace {
+
+/* First frames grow the allocators and containers, so they aren't counted */
+constexpr uint32_t kWarmUpFrames = 2 * kFramesInFlight;
+
+Vector<glm::mat4> GenerateModelMatrices(uint32_t count) {
+  std::mt19937                          generator{42};
+  std::uniform_real_distribution<float> position_distribution{-100.0f, 100.0f};
+
+  Vector<glm::mat4> matrices;
+  matrices.reserve(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    glm::vec3 position{position_distribution(generator), position_distribution(generator),
+                       position_distribution(generator)};
+    matrices.push_back(glm::translate(glm::mat4(1.0f), position));
+  }
+
+  return matrices;
+}
+
+}  // namespace
+
+/**
+ * @brief Per-frame part of Scene::Render and Renderer::Render on the CPU: filling the render queue from the frame
+ *        allocator, calculating bounding boxes and culling.
+ *
+ * Heap allocations in steady-state frames are reported as a counter, which is expected to be zero.
+ */
+static void BM_RenderQueueFrame(benchmark::State& state) {
+  uint32_t          count    = static_cast<uint32_t>(state.range(0));
+  Vector<glm::mat4> matrices = GenerateModelMatrices(count);
+
+  Mesh mesh(bench::GetBenchDevice(), Geometry::CreateCube(), nullptr);
+  mesh.CalculateBoundingBox();
+
+  Frustum frustum{glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                  glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f))};
+
+  FrameAllocator  frame_allocator;
+  RenderQueueView view;
+
+  uint64_t frame            = 0;
+  uint64_t heap_allocations = 0;
+  for (auto _ : state) {
+    uint64_t allocations_before = bench::GetHeapAllocationsCount();
+
+    RenderQueue render_queue{frame_allocator.BeginFrame(frame % kFramesInFlight)};
+    for (const auto& matrix : matrices) {
+      render_queue.renderables.push_back(RenderQueue::Renderable{&mesh, matrix});
+    }
+
+    render_queue.CalculateBoundingBoxes();
+    view.Cull(render_queue, frustum);
+
+    benchmark::DoNotOptimize(view.items.data());
+
+    if (frame++ >= kWarmUpFrames) {
+      heap_allocations += bench::GetHeapAllocationsCount() - allocations_before;
+    }
+  }
+
+  state.counters["heap_allocations_per_frame"] =
+      benchmark::Counter(static_cast<double>(heap_allocations), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RenderQueueFrame)->RangeMultiplier(4)->Range(256, 65536);
+
+/**
+ * @brief Raw allocation throughput of the linear allocator compared to the global heap.
+ */
+static void BM_LinearAllocatorAllocate(benchmark::State& state) {
+  constexpr uint32_t kAllocationsCount = 1024;
+
+  LinearAllocator allocator;
+  for (auto _ : state) {
+    allocator.Reset();
+    for (uint32_t i = 0; i < kAllocationsCount; ++i) {
+      benchmark::DoNotOptimize(allocator.Allocate(16 + (i % 8) * 16, 16));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kAllocationsCount);
+}
+BENCHMARK(BM_LinearAllocatorAllocate);
+
+static void BM_HeapAllocate(benchmark::State& state) {
+  constexpr uint32_t kAllocationsCount = 1024;
+
+  Vector<void*> pointers(kAllocationsCount);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < kAllocationsCount; ++i) {
+      pointers[i] = ::operator new(16 + (i % 8) * 16);
+      benchmark::DoNotOptimize(pointers[i]);
+    }
+
+    for (uint32_t i = 0; i < kAllocationsCount; ++i) {
+      ::operator delete(pointers[i]);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kAllocationsCount);
+}
+BENCHMARK(BM_HeapAllocate);
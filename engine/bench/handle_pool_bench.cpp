@@ -0,0 +1,130 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file handle_pool_bench.cpp
+ * @date 2023-06-28
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <vulture/core/handle_pool.hpp>
+#include <vulture/core/types.hpp>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kLiveResourcesCount = 100000;
+constexpr uint32_t kLookupsCount       = 4096;  ///< Roughly the number of handle resolutions per frame
+
+/**
+ * @brief Same size as a VulkanBuffer.
+ */
+struct SyntheticResource {
+  void*    vk_object;
+  void*    allocation;
+  bool     dynamic_memory;
+  void*    map_data;
+};
+
+/**
+ * @brief Handles of the resources to resolve, in random order, as they come from the draw calls.
+ */
+template <typename Handle>
+Vector<Handle> ShuffledLookups(const Vector<Handle>& live_handles) {
+  std::mt19937                            generator{42};
+  std::uniform_int_distribution<uint32_t> distribution{0, static_cast<uint32_t>(live_handles.size()) - 1};
+
+  Vector<Handle> lookups(kLookupsCount);
+  for (auto& handle : lookups) {
+    handle = live_handles[distribution(generator)];
+  }
+
+  return lookups;
+}
+
+}  // namespace
+
+/**
+ * @brief Resolve handles from a pool of 100k live resources, some of which have been recreated.
+ */
+static void BM_HandlePoolGet(benchmark::State& state) {
+  HandlePool<SyntheticResource> pool;
+
+  Vector<HandlePool<SyntheticResource>::Handle> live_handles;
+  for (uint32_t i = 0; i < kLiveResourcesCount; ++i) {
+    live_handles.push_back(pool.Emplace(SyntheticResource{}));
+  }
+
+  /* Recreate every 4th resource, so that slots have different generations */
+  for (uint32_t i = 0; i < kLiveResourcesCount; i += 4) {
+    pool.Remove(live_handles[i]);
+    live_handles[i] = pool.Emplace(SyntheticResource{});
+  }
+
+  auto lookups = ShuffledLookups(live_handles);
+
+  for (auto _ : state) {
+    for (auto handle : lookups) {
+      benchmark::DoNotOptimize(pool.Get(handle).vk_object);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kLookupsCount);
+}
+BENCHMARK(BM_HandlePoolGet);
+
+/**
+ * @brief Previous storage of the Vulkan device, kept for comparison.
+ */
+static void BM_HandleMapFind(benchmark::State& state) {
+  std::map<uint64_t, SyntheticResource> map;
+
+  uint64_t         next_handle = 1;
+  Vector<uint64_t> live_handles;
+  for (uint32_t i = 0; i < kLiveResourcesCount; ++i) {
+    live_handles.push_back(next_handle);
+    map.emplace(next_handle++, SyntheticResource{});
+  }
+
+  for (uint32_t i = 0; i < kLiveResourcesCount; i += 4) {
+    map.erase(live_handles[i]);
+    live_handles[i] = next_handle;
+    map.emplace(next_handle++, SyntheticResource{});
+  }
+
+  auto lookups = ShuffledLookups(live_handles);
+
+  for (auto _ : state) {
+    for (auto handle : lookups) {
+      auto it = map.find(handle);
+      assert(it != map.end());
+      benchmark::DoNotOptimize(it->second.vk_object);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kLookupsCount);
+}
+BENCHMARK(BM_HandleMapFind);
@@ -0,0 +1,90 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file jobs_bench.cpp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <thread>
+#include <vulture/jobs/job_system.hpp>
+
+using namespace vulture;
+using namespace vulture::jobs;
+
+namespace {
+
+constexpr uint32_t kElementsCount = 1U << 20;
+
+int64_t GetMaxThreadsCount() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+}  // namespace
+
+/**
+ * @brief Scaling of a compute-bound parallel-for loop with the number of threads.
+ */
+static void BM_JobsParallelForScaling(benchmark::State& state) {
+  JobSystem job_system(static_cast<uint32_t>(state.range(0)));
+
+  Vector<float> values(kElementsCount, 1.0f);
+  for (auto _ : state) {
+    job_system.ParallelFor(kElementsCount, 1024, [&](uint32_t begin, uint32_t end) {
+      for (uint32_t idx = begin; idx < end; ++idx) {
+        values[idx] = std::sqrt(values[idx] * 1.0001f + 0.5f);
+      }
+    });
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kElementsCount);
+}
+BENCHMARK(BM_JobsParallelForScaling)->DenseRange(1, GetMaxThreadsCount())->UseRealTime();
+
+/**
+ * @brief Overhead of scheduling and waiting for many tiny jobs, including stealing by idle workers.
+ */
+static void BM_JobsScheduleOverhead(benchmark::State& state) {
+  JobSystem job_system(static_cast<uint32_t>(state.range(0)));
+
+  constexpr uint32_t kJobsCount = 4096;
+
+  std::atomic<uint32_t> executed{0};
+  for (auto _ : state) {
+    Counter counter;
+    for (uint32_t job_idx = 0; job_idx < kJobsCount; ++job_idx) {
+      job_system.Schedule(Job{[](void* data, uint32_t, uint32_t) {
+                                static_cast<std::atomic<uint32_t>*>(data)->fetch_add(1, std::memory_order_relaxed);
+                              },
+                              &executed},
+                          counter);
+    }
+
+    job_system.Wait(counter);
+  }
+
+  state.SetItemsProcessed(state.iterations() * kJobsCount);
+}
+BENCHMARK(BM_JobsScheduleOverhead)->DenseRange(1, GetMaxThreadsCount())->UseRealTime();
@@ -0,0 +1,59 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file logger_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vulture/core/logger.hpp>
+
+using namespace vulture;
+
+/**
+ * @note The log file is opened in main, so these measure writing to a file, not to a terminal.
+ */
+static void BM_LoggerInfo(benchmark::State& state) {
+  uint32_t counter = 0;
+  for (auto _ : state) {
+    LOG_INFO("Benchmark message #{} with a float {} and a string \"{}\"", counter++, 3.14f, "argument");
+  }
+
+  Logger::Flush();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoggerInfo);
+
+/**
+ * @brief Errors print the location and flush after every message.
+ */
+static void BM_LoggerErrorFlush(benchmark::State& state) {
+  uint32_t counter = 0;
+  for (auto _ : state) {
+    LOG_ERROR("Benchmark error #{} with a float {} and a string \"{}\"", counter++, 3.14f, "argument");
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoggerErrorFlush);
@@ -0,0 +1,69 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file main.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+#include <vulture/core/logger.hpp>
+
+using namespace vulture;
+
+int main(int argc, char** argv) {
+  /* Logger prints to stdout by default, which would mix with the benchmark report */
+  Logger::OpenLogFile("vulture_bench.log");
+  Logger::SetTraceEnabled(false);
+
+  /* JSON output by default, so that results can be diffed between commits */
+  std::vector<char*> args{argv, argv + argc};
+
+  bool format_specified = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--benchmark_format", std::strlen("--benchmark_format")) == 0) {
+      format_specified = true;
+    }
+  }
+
+  char json_format[] = "--benchmark_format=json";
+  if (!format_specified) {
+    args.push_back(json_format);
+  }
+
+  int args_count = static_cast<int>(args.size());
+
+  benchmark::Initialize(&args_count, args.data());
+  if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  Logger::Close();
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file mesh_loader_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <bench_utils.hpp>
+#include <vulture/asset/detail/mesh_loader.hpp>
+
+using namespace vulture;
+
+/**
+ * @brief Full mesh import (assimp parsing, vertex conversion, buffer uploads) of the bundled assets.
+ *
+ * @note Materials' shaders and textures go through the AssetRegistry, so they are only loaded during the first
+ *       iteration. Shaders also need SPIR-V binaries, i.e. compile_shaders.sh has to be run beforehand.
+ */
+static void BM_LoadMesh(benchmark::State& state, const char* path) {
+  RenderDevice& device = bench::GetBenchDevice();
+
+  for (auto _ : state) {
+    SharedPtr<Mesh> mesh = detail::LoadMesh(device, path);
+    if (mesh == nullptr) {
+      state.SkipWithError("Failed to load mesh");
+      break;
+    }
+
+    benchmark::DoNotOptimize(mesh);
+  }
+}
+BENCHMARK_CAPTURE(BM_LoadMesh, Sphere, "assets/meshes/sphere.fbx")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadMesh, Sponza, "assets/meshes/sponza_pbr_new/sponza_pbr_new.gltf")
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3);
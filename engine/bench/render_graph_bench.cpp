@@ -0,0 +1,302 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file render_graph_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <bench_utils.hpp>
+#include <vulture/renderer/render_graph/render_graph.hpp>
+
+using namespace vulture;
+
+namespace {
+
+String SyntheticTextureName(uint32_t pass_idx) { return fmt::format("synthetic_color_{}", pass_idx); }
+String SyntheticBufferName(uint32_t pass_idx) { return fmt::format("synthetic_buffer_{}", pass_idx); }
+
+/**
+ * @brief Number of passes between a synthetic compute pass and the pass consuming its results.
+ */
+constexpr uint32_t kSyntheticComputeLatency = 4;
+
+/**
+ * @brief Pass of a linear chain, which samples the previous pass' output and renders to its own texture.
+ *
+ * The last pass in the chain renders to the imported backbuffer. Texture sizes depend on the backbuffer, so that
+ * dependent values are updated during compilation as in the real graph.
+ */
+class SyntheticPass final : public rg::IRenderPass {
+ public:
+  SyntheticPass(uint32_t pass_idx, bool last) : pass_idx_(pass_idx), last_(last) {}
+
+  void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/) override {
+    if (pass_idx_ > 0) {
+      builder.AddSampledTexture(builder.LastVersion(SyntheticTextureName(pass_idx_ - 1)));
+    }
+
+    if (pass_idx_ >= kSyntheticComputeLatency) {
+      rg::BufferVersionId buffer = builder.LastBufferVersion(SyntheticBufferName(pass_idx_ - kSyntheticComputeLatency));
+      if (buffer != rg::kInvalidBufferVersionId) {
+        builder.ReadBuffer(buffer);
+      }
+    }
+
+    rg::TextureVersionId backbuffer = builder.LastVersion("backbuffer");
+
+    rg::TextureVersionId target = rg::kInvalidTextureVersionId;
+    if (last_) {
+      target = backbuffer;
+    } else {
+      rg::DynamicTextureSpecification specification{};
+      specification.format = DataFormat::kR8G8B8A8_UNORM;
+      specification.usage  = kTextureUsageBitColorAttachment | kTextureUsageBitSampled;
+      specification.width.SetDependency(backbuffer);
+      specification.height.SetDependency(backbuffer);
+
+      target = builder.CreateTexture(SyntheticTextureName(pass_idx_), specification);
+    }
+
+    builder.AddColorAttachment(target, AttachmentLoad::kClear, AttachmentStore::kStore);
+  }
+
+  void Execute(CommandBuffer& /*command_buffer*/, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/,
+               RenderPassHandle /*handle*/, uint32_t /*subpass_idx*/) override {}
+
+ private:
+  uint32_t pass_idx_{0};
+  bool     last_{false};
+};
+
+/**
+ * @brief Async compute pass, which is executed after a chain pass and samples the texture the chain pass has sampled.
+ *
+ * Writes a buffer, which is only read by the chain pass kSyntheticComputeLatency passes later, so that the chain
+ * passes in between don't depend on it.
+ */
+class SyntheticComputePass final : public rg::IComputePass {
+ public:
+  explicit SyntheticComputePass(uint32_t pass_idx) : pass_idx_(pass_idx) {}
+
+  void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/) override {
+    builder.AddSampledTexture(builder.LastVersion(SyntheticTextureName(pass_idx_ - 1)));
+
+    rg::BufferSpecification specification{};
+    specification.size  = 4096;
+    specification.usage = kBufferUsageBitStorageBuffer;
+
+    rg::BufferVersionId buffer = builder.CreateBuffer(SyntheticBufferName(pass_idx_), specification);
+    builder.WriteBuffer(buffer, kPipelineStageBitComputeShader);
+  }
+
+  void Execute(CommandBuffer& /*command_buffer*/, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/) override {}
+
+  bool UsesAsyncCompute() const override { return true; }
+
+ private:
+  uint32_t pass_idx_{0};
+};
+
+SharedPtr<Texture> CreateBackbuffer(RenderDevice& device) {
+  TextureSpecification specification{};
+  specification.format = DataFormat::kR8G8B8A8_UNORM;
+  specification.usage  = kTextureUsageBitColorAttachment | kTextureUsageBitSampled;
+  specification.width  = 1920;
+  specification.height = 1080;
+
+  return CreateShared<Texture>(device, specification);
+}
+
+struct SyntheticGraph {
+  rg::Blackboard            blackboard;
+  UniquePtr<rg::RenderGraph> graph;
+
+  SyntheticGraph(SharedPtr<Texture> backbuffer, uint32_t passes_count, bool compute_passes = false)
+      : graph(CreateUnique<rg::RenderGraph>(blackboard)) {
+    graph->ImportTexture("backbuffer", backbuffer, TextureLayout::kShaderReadOnly);
+
+    for (uint32_t pass_idx = 0; pass_idx < passes_count; ++pass_idx) {
+      graph->AddPass<SyntheticPass>(fmt::format("synthetic_pass_{}", pass_idx), pass_idx,
+                                    pass_idx + 1 == passes_count);
+
+      if (compute_passes && pass_idx % kSyntheticComputeLatency == 1 &&
+          pass_idx + kSyntheticComputeLatency < passes_count) {
+        graph->AddPass<SyntheticComputePass>(fmt::format("synthetic_compute_pass_{}", pass_idx), pass_idx);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+static void BM_RenderGraphSetup(benchmark::State& state) {
+  RenderDevice& device       = bench::GetBenchDevice();
+  uint32_t      passes_count = static_cast<uint32_t>(state.range(0));
+
+  SharedPtr<Texture> backbuffer = CreateBackbuffer(device);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    SyntheticGraph synthetic{backbuffer, passes_count};
+    state.ResumeTiming();
+
+    synthetic.graph->Setup(device);
+
+    state.PauseTiming();
+    synthetic.graph->Destroy(device);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * passes_count);
+}
+BENCHMARK(BM_RenderGraphSetup)->RangeMultiplier(4)->Range(4, 256);
+
+/**
+ * @brief First compilation, i.e. all transient textures, render passes and framebuffers are created.
+ */
+static void BM_RenderGraphCompile(benchmark::State& state) {
+  RenderDevice& device       = bench::GetBenchDevice();
+  uint32_t      passes_count = static_cast<uint32_t>(state.range(0));
+
+  SharedPtr<Texture> backbuffer = CreateBackbuffer(device);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    SyntheticGraph synthetic{backbuffer, passes_count};
+    synthetic.graph->Setup(device);
+    state.ResumeTiming();
+
+    synthetic.graph->Compile(device);
+
+    state.PauseTiming();
+    synthetic.graph->Destroy(device);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * passes_count);
+}
+BENCHMARK(BM_RenderGraphCompile)->RangeMultiplier(4)->Range(4, 256);
+
+/**
+ * @brief Steady-state recompilation of an already compiled graph, nothing has changed in between.
+ */
+static void BM_RenderGraphRecompile(benchmark::State& state) {
+  RenderDevice& device       = bench::GetBenchDevice();
+  uint32_t      passes_count = static_cast<uint32_t>(state.range(0));
+
+  SharedPtr<Texture> backbuffer = CreateBackbuffer(device);
+
+  SyntheticGraph synthetic{backbuffer, passes_count};
+  synthetic.graph->Setup(device);
+  synthetic.graph->Compile(device);
+
+  for (auto _ : state) {
+    synthetic.graph->Compile(device);
+  }
+
+  synthetic.graph->Destroy(device);
+  state.SetItemsProcessed(state.iterations() * passes_count);
+}
+BENCHMARK(BM_RenderGraphRecompile)->RangeMultiplier(4)->Range(4, 256);
+
+/**
+ * @brief Execution right after the backbuffer has been resized, e.g. while dragging the editor viewport's border.
+ *
+ * Dependent transient textures and framebuffers are recreated, render passes are reused from the graph's cache.
+ */
+static void BM_RenderGraphResize(benchmark::State& state) {
+  RenderDevice& device       = bench::GetBenchDevice();
+  uint32_t      passes_count = static_cast<uint32_t>(state.range(0));
+
+  SharedPtr<Texture> backbuffers[2] = {CreateBackbuffer(device), CreateBackbuffer(device)};
+  TextureSpecification resized_specification = backbuffers[1]->GetSpecification();
+  resized_specification.width /= 2;
+  backbuffers[1] = CreateShared<Texture>(device, resized_specification);
+
+  SyntheticGraph synthetic{backbuffers[0], passes_count};
+  synthetic.graph->Setup(device);
+  synthetic.graph->Compile(device);
+
+  CommandBuffer* command_buffer = device.CreateCommandBuffer(CommandBufferType::kGraphics);
+
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    synthetic.graph->ReimportTexture(synthetic.graph->LastVersion("backbuffer"), backbuffers[++frame % 2]);
+
+    command_buffer->Reset();
+    command_buffer->Begin();
+    synthetic.graph->Execute(device, *command_buffer, frame % kFramesInFlight);
+    command_buffer->End();
+  }
+
+  device.DeleteCommandBuffer(command_buffer);
+  synthetic.graph->Destroy(device);
+  state.SetItemsProcessed(state.iterations() * passes_count);
+}
+BENCHMARK(BM_RenderGraphResize)->RangeMultiplier(4)->Range(4, 256);
+
+/**
+ * @brief Steady-state execution of a graph with a compute pass every kSyntheticComputeLatency passes, the second
+ *        argument toggles executing them on the async compute queue.
+ *
+ * The null device doesn't execute anything, so only the CPU cost of the separate command buffers and submissions is
+ * measured. The GPU overlap has to be compared on a real device by toggling RenderGraph::SetAsyncCompute.
+ */
+static void BM_RenderGraphExecuteAsyncCompute(benchmark::State& state) {
+  RenderDevice& device        = bench::GetBenchDevice();
+  uint32_t      passes_count  = static_cast<uint32_t>(state.range(0));
+  bool          async_compute = (state.range(1) != 0);
+
+  SharedPtr<Texture> backbuffer = CreateBackbuffer(device);
+
+  SyntheticGraph synthetic{backbuffer, passes_count, /*compute_passes=*/true};
+  synthetic.graph->SetAsyncCompute(async_compute);
+  synthetic.graph->Setup(device);
+  synthetic.graph->Compile(device);
+
+  CommandBuffer* command_buffer = device.CreateCommandBuffer(CommandBufferType::kGraphics);
+
+  uint32_t frame_in_flight = 0;
+  for (auto _ : state) {
+    command_buffer->Reset();
+    command_buffer->Begin();
+    synthetic.graph->Execute(device, *command_buffer, frame_in_flight);
+    command_buffer->End();
+
+    frame_in_flight = (frame_in_flight + 1) % kFramesInFlight;
+  }
+
+  device.DeleteCommandBuffer(command_buffer);
+  synthetic.graph->Destroy(device);
+  state.SetItemsProcessed(state.iterations() * passes_count);
+}
+BENCHMARK(BM_RenderGraphExecuteAsyncCompute)
+    ->ArgNames({"passes", "async"})
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({256, 0})
+    ->Args({256, 1});
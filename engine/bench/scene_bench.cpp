@@ -0,0 +1,133 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file scene_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vulture/scene/scene.hpp>
+
+using namespace vulture;
+
+namespace {
+
+/**
+ * @brief Build a chain of entities (each one is a child of the previous one), all of them having a transform.
+ *
+ * @return The deepest entity in the chain.
+ */
+fennecs::EntityHandle CreateHierarchyChain(Scene& scene, uint32_t depth) {
+  fennecs::EntityWorld& world = scene.GetEntityWorld();
+
+  fennecs::EntityHandle entity = scene.CreateEntity("Root");
+  entity = world.Attach<TransformComponent>(entity, Transform(glm::vec3(1.0f, 0.0f, 0.0f)));
+
+  for (uint32_t level = 1; level < depth; ++level) {
+    fennecs::EntityHandle child = scene.CreateChildEntity(entity, "Child");
+    child = world.Attach<TransformComponent>(
+        child, Transform(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.1f, 0.0f), glm::vec3(1.01f)));
+
+    entity = child;
+  }
+
+  return entity;
+}
+
+}  // namespace
+
+/**
+ * @brief World transform of the deepest entity in a hierarchy chain of the given depth.
+ */
+static void BM_ComputeWorldSpaceTransform(benchmark::State& state) {
+  Scene scene;
+  fennecs::EntityHandle leaf = CreateHierarchyChain(scene, static_cast<uint32_t>(state.range(0)));
+
+  for (auto _ : state) {
+    Transform transform = scene.ComputeWorldSpaceTransform(leaf);
+    benchmark::DoNotOptimize(transform);
+  }
+}
+BENCHMARK(BM_ComputeWorldSpaceTransform)->RangeMultiplier(4)->Range(1, 256);
+
+/**
+ * @brief World matrices of every entity in a scene of several chains, the way Scene::Render computes them.
+ */
+static void BM_ComputeWorldSpaceMatrixAllEntities(benchmark::State& state) {
+  uint32_t chains = static_cast<uint32_t>(state.range(0));
+  uint32_t depth  = static_cast<uint32_t>(state.range(1));
+
+  Scene scene;
+  for (uint32_t chain = 0; chain < chains; ++chain) {
+    CreateHierarchyChain(scene, depth);
+  }
+
+  fennecs::EntityWorld& world = scene.GetEntityWorld();
+  for (auto _ : state) {
+    fennecs::EntityStream stream = world.Query<TransformComponent>();
+    for (auto entity = stream.Next(); !entity.IsNull(); entity = stream.Next()) {
+      glm::mat4 matrix = scene.ComputeWorldSpaceMatrix(entity);
+      benchmark::DoNotOptimize(matrix);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * chains * depth);
+}
+BENCHMARK(BM_ComputeWorldSpaceMatrixAllEntities)->Args({1024, 1})->Args({256, 4})->Args({64, 16})->Args({16, 64});
+
+/**
+ * @brief Cached world transforms update, either with nothing changed since the last update or with every root moved
+ *        (so that the whole hierarchy is recomputed).
+ */
+static void BM_UpdateWorldTransforms(benchmark::State& state) {
+  uint32_t chains    = static_cast<uint32_t>(state.range(0));
+  uint32_t depth     = static_cast<uint32_t>(state.range(1));
+  bool     move_root = state.range(2) != 0;
+
+  Scene scene;
+  for (uint32_t chain = 0; chain < chains; ++chain) {
+    CreateHierarchyChain(scene, depth);
+  }
+
+  scene.UpdateWorldTransforms();
+
+  fennecs::EntityWorld& world = scene.GetEntityWorld();
+  for (auto _ : state) {
+    if (move_root) {
+      fennecs::EntityStream stream = world.Query<TransformComponent>();
+      for (auto entity = stream.Next(); !entity.IsNull(); entity = stream.Next()) {
+        if (!entity.Get<HierarchyComponent>().parent.has_value()) {
+          entity.Get<TransformComponent>().transform.position.x += 1.0f;
+        }
+      }
+    }
+
+    scene.UpdateWorldTransforms();
+  }
+
+  state.SetItemsProcessed(state.iterations() * chains * depth);
+}
+BENCHMARK(BM_UpdateWorldTransforms)
+    ->ArgsProduct({{1024, 64, 16}, {1, 16, 64}, {0, 1}})
+    ->ArgNames({"chains", "depth", "move_root"});
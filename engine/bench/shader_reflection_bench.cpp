@@ -0,0 +1,84 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file shader_reflection_bench.cpp
+ * @date 2023-06-15
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <vulture/renderer/material_system/shader_reflection.hpp>
+
+using namespace vulture;
+
+namespace {
+
+bool ReadSpirvFile(const char* filename, Vector<uint32_t>& binary) {
+  std::ifstream file(filename, std::ios::ate | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  size_t file_size = static_cast<size_t>(file.tellg());
+  binary.resize(file_size / sizeof(uint32_t));
+
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(file_size));
+
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @note SPIR-V binaries are not committed, so compile_shaders.sh has to be run beforehand.
+ */
+static void BM_ShaderReflectionAddShaderModule(benchmark::State& state, ShaderModuleType type, const char* filename) {
+  Vector<uint32_t> binary;
+  if (!ReadSpirvFile(filename, binary)) {
+    state.SkipWithError("Failed to read SPIR-V binary, run compile_shaders.sh first");
+    return;
+  }
+
+  for (auto _ : state) {
+    ShaderReflection reflection;
+    reflection.AddShaderModule(type, binary);
+    benchmark::DoNotOptimize(reflection);
+  }
+
+  state.SetBytesProcessed(state.iterations() * binary.size() * sizeof(uint32_t));
+}
+
+#define SHADER_REFLECTION_BENCHMARK(name, type, filename) \
+  BENCHMARK_CAPTURE(BM_ShaderReflectionAddShaderModule, name, type, filename)
+
+SHADER_REFLECTION_BENCHMARK(PBR_vert,       ShaderModuleType::kVertex,   "assets/.vulture/shaders/BuiltIn.PBR.vert.spv");
+SHADER_REFLECTION_BENCHMARK(PBR_frag,       ShaderModuleType::kFragment, "assets/.vulture/shaders/BuiltIn.PBR.frag.spv");
+SHADER_REFLECTION_BENCHMARK(GBuffer_vert,   ShaderModuleType::kVertex,   "assets/.vulture/shaders/BuiltIn.GBuffer.vert.spv");
+SHADER_REFLECTION_BENCHMARK(GBuffer_frag,   ShaderModuleType::kFragment, "assets/.vulture/shaders/BuiltIn.GBuffer.frag.spv");
+SHADER_REFLECTION_BENCHMARK(Deferred_vert,  ShaderModuleType::kVertex,   "assets/.vulture/shaders/BuiltIn.Deferred.vert.spv");
+SHADER_REFLECTION_BENCHMARK(Deferred_frag,  ShaderModuleType::kFragment, "assets/.vulture/shaders/BuiltIn.Deferred.frag.spv");
+SHADER_REFLECTION_BENCHMARK(DirShadow_vert, ShaderModuleType::kVertex,   "assets/.vulture/shaders/BuiltIn.DirShadow.vert.spv");
+SHADER_REFLECTION_BENCHMARK(Skybox_vert,    ShaderModuleType::kVertex,   "assets/.vulture/shaders/BuiltIn.Skybox.vert.spv");
+SHADER_REFLECTION_BENCHMARK(Skybox_frag,    ShaderModuleType::kFragment, "assets/.vulture/shaders/BuiltIn.Skybox.frag.spv");
@@ -0,0 +1,114 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file transform_bench.cpp
+ * @date 2023-06-16
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vulture/renderer/transform_batch.hpp>
+
+using namespace vulture;
+
+namespace {
+
+Vector<Transform> GenerateTransforms(uint32_t count) {
+  std::mt19937                          generator{42};
+  std::uniform_real_distribution<float> distribution{-10.0f, 10.0f};
+
+  Vector<Transform> transforms;
+  transforms.reserve(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    glm::vec3 position{distribution(generator), distribution(generator), distribution(generator)};
+    glm::vec3 euler_angles{distribution(generator), distribution(generator), distribution(generator)};
+    glm::vec3 scale{1.0f + 0.1f * distribution(generator)};
+
+    transforms.emplace_back(position, glm::quat(euler_angles), scale);
+  }
+
+  return transforms;
+}
+
+}  // namespace
+
+/**
+ * @brief Current per-entity path, i.e. T * R * S with separate matrices.
+ */
+static void BM_TransformCalculateMatrix(benchmark::State& state) {
+  uint32_t          count      = static_cast<uint32_t>(state.range(0));
+  Vector<Transform> transforms = GenerateTransforms(count);
+  Vector<glm::mat4> matrices(count);
+
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < count; ++i) {
+      matrices[i] = transforms[i].CalculateMatrix();
+    }
+
+    benchmark::DoNotOptimize(matrices.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformCalculateMatrix)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_ComputeMatricesArray(benchmark::State& state) {
+  uint32_t          count      = static_cast<uint32_t>(state.range(0));
+  Vector<Transform> transforms = GenerateTransforms(count);
+  Vector<glm::mat4> matrices(count);
+
+  for (auto _ : state) {
+    ComputeMatrices(transforms.data(), count, matrices.data());
+
+    benchmark::DoNotOptimize(matrices.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ComputeMatricesArray)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_ComputeMatricesBatch(benchmark::State& state) {
+  uint32_t          count      = static_cast<uint32_t>(state.range(0));
+  Vector<Transform> transforms = GenerateTransforms(count);
+  Vector<glm::mat4> matrices(count);
+
+  TransformBatch batch;
+  batch.Reserve(count);
+  for (const auto& transform : transforms) {
+    batch.Add(transform);
+  }
+
+  for (auto _ : state) {
+    ComputeMatrices(batch, matrices.data());
+
+    benchmark::DoNotOptimize(matrices.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ComputeMatricesBatch)->RangeMultiplier(8)->Range(64, 32768);
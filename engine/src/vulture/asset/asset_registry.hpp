@@ -16,6 +16,12 @@ class AssetRegistry {
   template <typename TAsset>
   SharedPtr<TAsset> Load(const String& path);
 
+  /**
+   * @brief Get all the loaded assets of the type, e.g. to prepare them for rendering during the loading.
+   */
+  template <typename TAsset>
+  Vector<SharedPtr<TAsset>> GetLoaded() const;
+
   void RegisterLoader(SharedPtr<IAssetLoader> loader);
 
  private:
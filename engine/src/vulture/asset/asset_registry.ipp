@@ -20,4 +20,16 @@ SharedPtr<TAsset> AssetRegistry::Load(const String& path) {
   return nullptr;
 }
 
+template <typename TAsset>
+Vector<SharedPtr<TAsset>> AssetRegistry::GetLoaded() const {
+  Vector<SharedPtr<TAsset>> loaded_assets;
+  for (const auto& [path, asset] : assets_) {
+    if (auto typed_asset = std::dynamic_pointer_cast<TAsset>(asset)) {
+      loaded_assets.push_back(std::move(typed_asset));
+    }
+  }
+
+  return loaded_assets;
+}
+
 }  // namespace vulture
\ No newline at end of file
@@ -117,6 +117,8 @@ SharedPtr<Mesh> LoadMesh(RenderDevice& device, const String& path) {
     submesh.SetMaterial(materials[mesh->mMaterialIndex]);
   }
 
+  result_mesh->CalculateBoundingBox();
+
   return result_mesh;
 }
 
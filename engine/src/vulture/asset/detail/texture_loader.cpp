@@ -54,25 +54,9 @@ SharedPtr<Texture> detail::LoadTexture(RenderDevice& device, const String& path)
 
   TextureHandle handle = device.CreateTexture(tex_specification);
 
-  /* Copy pixels to texture */
-  void* map_data = nullptr;
-
+  /* Upload is batched, so the pixels can be freed right away */
   uint32_t buffer_size = tex_width * tex_height * 4;
-  BufferHandle staging_buffer = device.CreateBuffer(buffer_size, kBufferUsageBitTransferSrc, true, &map_data);
-
-  device.InvalidateBufferMemory(staging_buffer, 0, buffer_size);
-  std::memcpy(map_data, pixels, buffer_size);
-  device.FlushBufferMemory(staging_buffer, 0, buffer_size);
-
-  CommandBuffer* command_buffer = device.CreateCommandBuffer(CommandBufferType::kGraphics, true);
-  command_buffer->Begin();
-
-  command_buffer->TransitionLayout(handle, TextureLayout::kUndefined, TextureLayout::kTransferDst);
-  command_buffer->CopyBufferToTexture(staging_buffer, handle, tex_width, tex_height);
-  command_buffer->GenerateMipmaps(handle, TextureLayout::kShaderReadOnly);
-
-  command_buffer->End();
-  command_buffer->Submit();
+  device.LoadTextureData(handle, buffer_size, pixels, /*generate_mipmaps=*/true, TextureLayout::kShaderReadOnly);
 
   stbi_image_free(pixels);
 
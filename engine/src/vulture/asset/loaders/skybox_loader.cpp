@@ -74,6 +74,9 @@ SharedPtr<IAsset> SkyboxLoader::Load(const String& path) {
 
   SharedPtr<Mesh> mesh = CreateShared<Mesh>(device_, Geometry::CreateCube(), material);
 
+  // Skybox follows the camera in the vertex shader, so it must never be frustum culled
+  mesh->SetNeverCulled(true);
+
   YAML::Node root = YAML::LoadFile(path.data());
 
   Array<String, 6> filenames;
@@ -123,27 +126,15 @@ SharedPtr<IAsset> SkyboxLoader::Load(const String& path) {
   tex_specification.height     = static_cast<uint32_t>(height);
   TextureHandle handle = device_.CreateTexture(tex_specification);
 
-  void* map_data = nullptr;
-
-  uint32_t layer_size  = width * height * 4;
-  uint32_t buffer_size = layer_size * 6;
-  BufferHandle staging_buffer = device_.CreateBuffer(buffer_size, kBufferUsageBitTransferSrc, true, &map_data);
-
-  device_.InvalidateBufferMemory(staging_buffer, 0, buffer_size);
+  /* Cube map layers are uploaded one after another */
+  uint32_t layer_size = width * height * 4;
+  Vector<stbi_uc> pixels(layer_size * 6);
   for (uint32_t i = 0; i < 6; ++i) {
-    std::memcpy(static_cast<stbi_uc*>(map_data) + i * layer_size, side_pixels[i], layer_size);
+    std::memcpy(pixels.data() + i * layer_size, side_pixels[i], layer_size);
   }
-  device_.FlushBufferMemory(staging_buffer, 0, buffer_size);
-
-  CommandBuffer* command_buffer = device_.CreateCommandBuffer(CommandBufferType::kGraphics, true);
-  command_buffer->Begin();
-
-  command_buffer->TransitionLayout(handle, TextureLayout::kUndefined, TextureLayout::kTransferDst);
-  command_buffer->CopyBufferToTexture(staging_buffer, handle, width, height, 0, 6);
-  command_buffer->GenerateMipmaps(handle, TextureLayout::kShaderReadOnly);
 
-  command_buffer->End();
-  command_buffer->Submit();
+  device_.LoadTextureData(handle, pixels.size(), pixels.data(), /*generate_mipmaps=*/true,
+                          TextureLayout::kShaderReadOnly);
 
   for (uint32_t i = 0; i < 6; ++i) {
     stbi_image_free(side_pixels[i]);
@@ -0,0 +1,108 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file handle_pool.hpp
+ * @date 2023-06-28
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace vulture {
+
+/**
+ * @brief Slot map, which gives out generational handles to the stored values.
+ *
+ * A handle packs the slot index (lower 32 bits) and the slot's generation (upper 32 bits), which is incremented each
+ * time the slot's value is removed. Lookup is a single indexing, while stale handles (to removed values) are told apart
+ * by the generation, which @ref{Get} checks only with assertions.
+ *
+ * Slots live in a deque, so references to values stay valid until they are removed. Generations start from 1, so 0 is
+ * never a valid handle.
+ *
+ * @note Not thread-safe.
+ */
+template <typename T>
+class HandlePool {
+ public:
+  using Handle = uint64_t;
+  static constexpr Handle kInvalidHandle = 0;
+
+ public:
+  HandlePool() = default;
+
+  HandlePool(const HandlePool& other) = delete;
+  HandlePool& operator=(const HandlePool& other) = delete;
+
+  template <typename... Args>
+  Handle Emplace(Args&&... args);
+
+  /**
+   * @brief Remove the value, the handle and all its copies become stale.
+   */
+  void Remove(Handle handle);
+
+  T& Get(Handle handle);
+  const T& Get(Handle handle) const;
+
+  /**
+   * @return The value or nullptr if the handle is invalid or stale.
+   */
+  T* TryGet(Handle handle);
+
+  bool Contains(Handle handle) const;
+
+  uint32_t Size() const;
+  bool Empty() const;
+
+  /**
+   * @brief Call func(Handle, T&) for each stored value.
+   */
+  template <typename Func>
+  void ForEach(Func&& func);
+
+ private:
+  struct Slot {
+    std::optional<T> value;
+    uint32_t         generation{1};
+  };
+
+  static Handle MakeHandle(uint32_t idx, uint32_t generation);
+  static uint32_t GetIdx(Handle handle);
+  static uint32_t GetGeneration(Handle handle);
+
+ private:
+  std::deque<Slot>      slots_;
+  std::vector<uint32_t> free_slots_;
+  uint32_t              size_{0};
+};
+
+#include <vulture/core/handle_pool.ipp>
+
+}  // namespace vulture
@@ -0,0 +1,126 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file handle_pool.ipp
+ * @date 2023-06-28
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+template <typename T>
+template <typename... Args>
+typename HandlePool<T>::Handle HandlePool<T>::Emplace(Args&&... args) {
+  uint32_t idx = 0;
+  if (!free_slots_.empty()) {
+    idx = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    idx = static_cast<uint32_t>(slots_.size());
+    slots_.emplace_back();
+  }
+
+  Slot& slot = slots_[idx];
+  assert(!slot.value.has_value());
+  slot.value.emplace(std::forward<Args>(args)...);
+
+  ++size_;
+  return MakeHandle(idx, slot.generation);
+}
+
+template <typename T>
+void HandlePool<T>::Remove(Handle handle) {
+  assert(Contains(handle));
+
+  Slot& slot = slots_[GetIdx(handle)];
+  slot.value.reset();
+
+  /* Skip 0 on overflow, so that handles never become kInvalidHandle */
+  if (++slot.generation == 0) {
+    slot.generation = 1;
+  }
+
+  free_slots_.push_back(GetIdx(handle));
+  --size_;
+}
+
+template <typename T>
+T& HandlePool<T>::Get(Handle handle) {
+  assert(Contains(handle));
+  return *slots_[GetIdx(handle)].value;
+}
+
+template <typename T>
+const T& HandlePool<T>::Get(Handle handle) const {
+  assert(Contains(handle));
+  return *slots_[GetIdx(handle)].value;
+}
+
+template <typename T>
+T* HandlePool<T>::TryGet(Handle handle) {
+  return Contains(handle) ? &*slots_[GetIdx(handle)].value : nullptr;
+}
+
+template <typename T>
+bool HandlePool<T>::Contains(Handle handle) const {
+  uint32_t idx = GetIdx(handle);
+  if (handle == kInvalidHandle || idx >= slots_.size()) {
+    return false;
+  }
+
+  const Slot& slot = slots_[idx];
+  return slot.value.has_value() && slot.generation == GetGeneration(handle);
+}
+
+template <typename T>
+uint32_t HandlePool<T>::Size() const {
+  return size_;
+}
+
+template <typename T>
+bool HandlePool<T>::Empty() const {
+  return size_ == 0;
+}
+
+template <typename T>
+template <typename Func>
+void HandlePool<T>::ForEach(Func&& func) {
+  for (uint32_t idx = 0; idx < slots_.size(); ++idx) {
+    Slot& slot = slots_[idx];
+    if (slot.value.has_value()) {
+      func(MakeHandle(idx, slot.generation), *slot.value);
+    }
+  }
+}
+
+template <typename T>
+typename HandlePool<T>::Handle HandlePool<T>::MakeHandle(uint32_t idx, uint32_t generation) {
+  return (static_cast<Handle>(generation) << 32) | static_cast<Handle>(idx);
+}
+
+template <typename T>
+uint32_t HandlePool<T>::GetIdx(Handle handle) {
+  return static_cast<uint32_t>(handle);
+}
+
+template <typename T>
+uint32_t HandlePool<T>::GetGeneration(Handle handle) {
+  return static_cast<uint32_t>(handle >> 32);
+}
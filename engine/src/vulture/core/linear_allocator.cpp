@@ -0,0 +1,112 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file linear_allocator.cpp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/core/linear_allocator.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace vulture;
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+}  // namespace
+
+LinearAllocator::LinearAllocator(size_t block_size) : block_size_(block_size) { assert(block_size_ > 0); }
+
+LinearAllocator::~LinearAllocator() {
+  for (auto& block : blocks_) {
+    ::operator delete(block.data);
+  }
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment) {
+  assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  assert(alignment <= alignof(std::max_align_t));
+
+  size = std::max<size_t>(size, 1);
+
+  while (block_idx_ < blocks_.size()) {
+    Block& block   = blocks_[block_idx_];
+    size_t aligned = AlignUp(offset_, alignment);
+
+    if (aligned + size <= block.size) {
+      offset_ = aligned + size;
+      return block.data + aligned;
+    }
+
+    ++block_idx_;
+    offset_ = 0;
+  }
+
+  Block block;
+  block.size = std::max(size, block_size_);
+  block.data = static_cast<std::byte*>(::operator new(block.size));  // Aligned to at least alignof(max_align_t)
+  blocks_.push_back(block);
+
+  block_idx_ = static_cast<uint32_t>(blocks_.size()) - 1;
+  offset_    = size;
+
+  return block.data;
+}
+
+LinearAllocator::Marker LinearAllocator::GetMarker() const { return Marker{block_idx_, offset_}; }
+
+void LinearAllocator::Rewind(const Marker& marker) {
+  assert(marker.block_idx < block_idx_ || (marker.block_idx == block_idx_ && marker.offset <= offset_));
+
+  block_idx_ = marker.block_idx;
+  offset_    = marker.offset;
+}
+
+void LinearAllocator::Reset() {
+  block_idx_ = 0;
+  offset_    = 0;
+}
+
+size_t LinearAllocator::GetBlockSize() const { return block_size_; }
+
+size_t LinearAllocator::GetCapacity() const {
+  size_t capacity = 0;
+  for (const auto& block : blocks_) {
+    capacity += block.size;
+  }
+
+  return capacity;
+}
+
+size_t LinearAllocator::GetUsedSize() const {
+  size_t used = offset_;
+  for (uint32_t block_idx = 0; block_idx < block_idx_ && block_idx < blocks_.size(); ++block_idx) {
+    used += blocks_[block_idx].size;
+  }
+
+  return used;
+}
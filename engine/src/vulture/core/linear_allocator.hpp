@@ -0,0 +1,158 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file linear_allocator.hpp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/core/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace vulture {
+
+/**
+ * @brief Bump allocator over a list of fixed-size blocks.
+ *
+ * Individual allocations are never freed, instead the whole allocator is either reset or rewound to a marker. Blocks
+ * are kept after reset, so once the allocator has grown to its working set size it doesn't allocate anymore.
+ *
+ * @note Not thread-safe.
+ */
+class LinearAllocator {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  /**
+   * @brief Position in the allocator, allocations made after it are released by @ref{Rewind}.
+   */
+  struct Marker {
+    uint32_t block_idx{0};
+    size_t   offset{0};
+  };
+
+  explicit LinearAllocator(size_t block_size = kDefaultBlockSize);
+  ~LinearAllocator();
+
+  LinearAllocator(const LinearAllocator& other) = delete;
+  LinearAllocator& operator=(const LinearAllocator& other) = delete;
+
+  /**
+   * @brief Allocate size bytes aligned to alignment (must be a power of two).
+   *
+   * Allocations larger than the block size get a dedicated block.
+   */
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  T* Allocate(size_t count = 1) {
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  Marker GetMarker() const;
+  void Rewind(const Marker& marker);
+  void Reset();
+
+  size_t GetBlockSize() const;
+
+  /**
+   * @brief Total size of the allocated blocks.
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * @brief Number of bytes allocated since the last reset, including alignment padding.
+   */
+  size_t GetUsedSize() const;
+
+ private:
+  struct Block {
+    std::byte* data{nullptr};
+    size_t     size{0};
+  };
+
+ private:
+  size_t        block_size_{0};
+  Vector<Block> blocks_;
+  uint32_t      block_idx_{0};
+  size_t        offset_{0};
+};
+
+/**
+ * @brief Rewinds the allocator to the position it had at construction when going out of scope.
+ */
+class LinearAllocatorScope {
+ public:
+  explicit LinearAllocatorScope(LinearAllocator& allocator) : allocator_(allocator), marker_(allocator.GetMarker()) {}
+  ~LinearAllocatorScope() { allocator_.Rewind(marker_); }
+
+  LinearAllocatorScope(const LinearAllocatorScope& other) = delete;
+  LinearAllocatorScope& operator=(const LinearAllocatorScope& other) = delete;
+
+ private:
+  LinearAllocator&        allocator_;
+  LinearAllocator::Marker marker_;
+};
+
+/**
+ * @brief STL-compatible allocator adapter, deallocation is a no-op.
+ *
+ * Containers using it must not outlive the next reset of the allocator (and must not be used after it).
+ */
+template <typename T>
+class LinearStlAllocator {
+ public:
+  using value_type = T;
+
+  explicit LinearStlAllocator(LinearAllocator& allocator) : allocator_(&allocator) {}
+
+  template <typename U>
+  LinearStlAllocator(const LinearStlAllocator<U>& other) : allocator_(other.GetAllocator()) {}
+
+  T* allocate(size_t count) { return allocator_->Allocate<T>(count); }
+  void deallocate(T* /*ptr*/, size_t /*count*/) {}
+
+  LinearAllocator* GetAllocator() const { return allocator_; }
+
+  template <typename U>
+  bool operator==(const LinearStlAllocator<U>& other) const { return allocator_ == other.GetAllocator(); }
+
+  template <typename U>
+  bool operator!=(const LinearStlAllocator<U>& other) const { return allocator_ != other.GetAllocator(); }
+
+ private:
+  LinearAllocator* allocator_{nullptr};
+};
+
+template <typename T>
+using LinearVector = std::vector<T, LinearStlAllocator<T>>;
+
+template <typename K, typename V>
+using LinearHashMap =
+    std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, LinearStlAllocator<std::pair<const K, V>>>;
+
+}  // namespace vulture
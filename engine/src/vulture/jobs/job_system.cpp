@@ -0,0 +1,237 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file job_system.cpp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/jobs/job_system.hpp>
+
+#include <cassert>
+
+using namespace vulture;
+using namespace vulture::jobs;
+
+namespace {
+
+constexpr uint32_t kInitialQueueCapacity = 256;
+
+thread_local const JobSystem* g_worker_owner{nullptr};
+thread_local uint32_t         g_worker_idx{0};
+
+}  // namespace
+
+/************************************************************************************************
+ * Job Queue
+ ************************************************************************************************/
+void JobSystem::JobQueue::PushBack(const QueuedJob& job) {
+  if (tail - head == jobs.size()) {
+    Vector<QueuedJob> new_jobs(std::max<size_t>(kInitialQueueCapacity, 2 * jobs.size()));
+    for (uint64_t idx = head; idx < tail; ++idx) {
+      new_jobs[idx % new_jobs.size()] = jobs[idx % jobs.size()];
+    }
+
+    jobs.swap(new_jobs);
+  }
+
+  jobs[tail++ % jobs.size()] = job;
+}
+
+bool JobSystem::JobQueue::PopBack(QueuedJob& job) {
+  if (head == tail) {
+    return false;
+  }
+
+  job = jobs[--tail % jobs.size()];
+  return true;
+}
+
+bool JobSystem::JobQueue::PopFront(QueuedJob& job) {
+  if (head == tail) {
+    return false;
+  }
+
+  job = jobs[head++ % jobs.size()];
+  return true;
+}
+
+/************************************************************************************************
+ * Job System
+ ************************************************************************************************/
+JobSystem::JobSystem(uint32_t threads_count) {
+  if (threads_count == 0) {
+    threads_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  queues_count_ = threads_count;
+  queues_       = CreateUnique<JobQueue[]>(queues_count_);
+
+  workers_.reserve(threads_count - 1);
+  for (uint32_t thread_idx = 1; thread_idx < threads_count; ++thread_idx) {
+    workers_.emplace_back(&JobSystem::WorkerLoop, this, thread_idx);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+
+  wake_condition_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+
+  assert(queued_jobs_.load() == 0);
+}
+
+JobSystem& JobSystem::Instance() {
+  static JobSystem instance;
+  return instance;
+}
+
+uint32_t JobSystem::GetThreadsCount() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+uint32_t JobSystem::GetCurrentThreadIdx() const { return (g_worker_owner == this) ? g_worker_idx : 0; }
+
+LinearAllocator& JobSystem::GetScratchAllocator() {
+  thread_local LinearAllocator allocator;
+  return allocator;
+}
+
+void JobSystem::Schedule(const Job& job, Counter& counter) {
+  assert(job.function != nullptr);
+
+  counter.pending_.fetch_add(1, std::memory_order_relaxed);
+
+  JobQueue& queue = queues_[GetCurrentThreadIdx()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.PushBack(QueuedJob{job, &counter});
+  }
+
+  WakeWorkers(1);
+}
+
+void JobSystem::Wait(Counter& counter) {
+  uint32_t thread_idx = GetCurrentThreadIdx();
+
+  QueuedJob job;
+  while (!counter.IsDone()) {
+    if (TryGetJob(thread_idx, job)) {
+      ExecuteJob(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::ScheduleBatches(const Job& job, uint32_t batch_size, Counter& counter) {
+  assert(job.function != nullptr);
+  assert(batch_size > 0);
+
+  uint32_t batches_count = (job.end - job.begin + batch_size - 1) / batch_size;
+  counter.pending_.fetch_add(batches_count, std::memory_order_relaxed);
+
+  JobQueue& queue = queues_[GetCurrentThreadIdx()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    /* Pushed in reverse, so that the owner pops batches from the beginning of the range */
+    for (uint32_t batch_idx = batches_count; batch_idx > 0; --batch_idx) {
+      Job batch   = job;
+      batch.begin = job.begin + (batch_idx - 1) * batch_size;
+      batch.end   = std::min(batch.begin + batch_size, job.end);
+
+      queue.PushBack(QueuedJob{batch, &counter});
+    }
+  }
+
+  WakeWorkers(batches_count);
+}
+
+void JobSystem::WakeWorkers(uint32_t jobs_count) {
+  queued_jobs_.fetch_add(static_cast<int32_t>(jobs_count), std::memory_order_release);
+
+  if (workers_.empty()) {
+    return;
+  }
+
+  /* Taking the mutex guarantees a worker can't miss the wake up between checking the predicate and going to sleep */
+  { std::lock_guard<std::mutex> lock(wake_mutex_); }
+
+  if (jobs_count == 1) {
+    wake_condition_.notify_one();
+  } else {
+    wake_condition_.notify_all();
+  }
+}
+
+bool JobSystem::TryGetJob(uint32_t thread_idx, QueuedJob& job) {
+  bool found = false;
+
+  {
+    JobQueue& queue = queues_[thread_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    found = queue.PopBack(job);
+  }
+
+  for (uint32_t offset = 1; !found && offset < queues_count_; ++offset) {
+    JobQueue& queue = queues_[(thread_idx + offset) % queues_count_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    found = queue.PopFront(job);
+  }
+
+  if (found) {
+    queued_jobs_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  return found;
+}
+
+void JobSystem::ExecuteJob(const QueuedJob& job) {
+  job.job.function(job.job.data, job.job.begin, job.job.end);
+  job.counter->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(uint32_t thread_idx) {
+  g_worker_owner = this;
+  g_worker_idx   = thread_idx;
+
+  QueuedJob job;
+  while (true) {
+    if (TryGetJob(thread_idx, job)) {
+      ExecuteJob(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_condition_.wait(lock, [this]() { return stop_ || queued_jobs_.load(std::memory_order_acquire) > 0; });
+
+    if (stop_) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,180 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file job_system.hpp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/core/linear_allocator.hpp>
+#include <vulture/core/types.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace vulture {
+namespace jobs {
+
+/**
+ * @brief Job entry point, [begin, end) is the range of the job (e.g. a batch of a parallel-for loop).
+ */
+using JobFunction = void (*)(void* data, uint32_t begin, uint32_t end);
+
+struct Job {
+  JobFunction function{nullptr};
+  void*       data    {nullptr};
+  uint32_t    begin   {0};
+  uint32_t    end     {0};
+};
+
+/**
+ * @brief Number of scheduled jobs, which haven't finished yet.
+ *
+ * Jobs are waited for by @ref{JobSystem::Wait}. The counter must outlive all jobs it has been passed to.
+ */
+class Counter {
+ public:
+  Counter() = default;
+
+  Counter(const Counter& other) = delete;
+  Counter& operator=(const Counter& other) = delete;
+
+  bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+ private:
+  std::atomic<uint32_t> pending_{0};
+
+  friend class JobSystem;
+};
+
+/**
+ * @brief Work-stealing job system.
+ *
+ * Every worker thread owns a job queue, jobs scheduled from a worker are pushed to its own queue and popped from it in
+ * LIFO order, while idle workers steal the oldest jobs from other queues. Threads, which are not workers of the system
+ * (e.g. the main thread), share an additional queue with index 0.
+ *
+ * Waiting doesn't block the thread, instead it executes pending jobs until the counter is done. So a job can schedule
+ * child jobs and wait for them without stalling a worker, which is also why nested @ref{ParallelFor} calls are fine.
+ *
+ * Every thread has its own scratch allocator for temporary data of the jobs it executes.
+ */
+class JobSystem {
+ public:
+  /**
+   * @param threads_count Total number of threads including the calling one, 0 means hardware concurrency.
+   */
+  explicit JobSystem(uint32_t threads_count = 0);
+  ~JobSystem();
+
+  JobSystem(const JobSystem& other) = delete;
+  JobSystem& operator=(const JobSystem& other) = delete;
+
+  /**
+   * @brief Engine-wide job system with hardware concurrency threads, created on first use.
+   */
+  static JobSystem& Instance();
+
+  uint32_t GetThreadsCount() const;
+
+  /**
+   * @brief Index of the current thread in [0, GetThreadsCount()), threads other than workers have index 0.
+   */
+  uint32_t GetCurrentThreadIdx() const;
+
+  /**
+   * @brief Per-thread allocator for temporary data, shared by all job systems.
+   *
+   * Jobs should release what they allocate, e.g. using @ref{LinearAllocatorScope}.
+   */
+  static LinearAllocator& GetScratchAllocator();
+
+  void Schedule(const Job& job, Counter& counter);
+
+  /**
+   * @brief Schedule func() as a job, the callable is moved to the heap and deleted after execution.
+   */
+  template <typename Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Job>>>
+  void Schedule(Func&& func, Counter& counter);
+
+  /**
+   * @brief Execute pending jobs on the calling thread until the counter is done.
+   */
+  void Wait(Counter& counter);
+
+  /**
+   * @brief Call func(begin, end) for batches covering [0, count) and wait for all of them to finish.
+   *
+   * The range is split into batches of at least min_batch_size elements, a few batches per thread to balance the
+   * load. If the range fits into a single batch, func is called on the calling thread directly.
+   */
+  template <typename Func>
+  void ParallelFor(uint32_t count, uint32_t min_batch_size, Func&& func);
+
+ private:
+  struct QueuedJob {
+    Job      job;
+    Counter* counter{nullptr};
+  };
+
+  /**
+   * @brief Mutex-protected ring buffer of jobs, aligned to avoid false sharing between queues.
+   */
+  struct alignas(64) JobQueue {
+    std::mutex        mutex;
+    Vector<QueuedJob> jobs;
+    uint64_t          head{0};
+    uint64_t          tail{0};
+
+    void PushBack(const QueuedJob& job);
+    bool PopBack(QueuedJob& job);
+    bool PopFront(QueuedJob& job);
+  };
+
+  void ScheduleBatches(const Job& job, uint32_t batch_size, Counter& counter);
+  void WakeWorkers(uint32_t jobs_count);
+
+  bool TryGetJob(uint32_t thread_idx, QueuedJob& job);
+  void ExecuteJob(const QueuedJob& job);
+  void WorkerLoop(uint32_t thread_idx);
+
+ private:
+  Vector<std::thread>     workers_;
+  UniquePtr<JobQueue[]>   queues_;
+  uint32_t                queues_count_{0};
+
+  std::atomic<int32_t>    queued_jobs_{0};
+  std::mutex              wake_mutex_;
+  std::condition_variable wake_condition_;
+  bool                    stop_{false};
+};
+
+}  // namespace jobs
+}  // namespace vulture
+
+#include <vulture/jobs/job_system.ipp>
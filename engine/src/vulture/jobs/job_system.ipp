@@ -0,0 +1,76 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file job_system.ipp
+ * @date 2023-06-20
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+namespace vulture {
+namespace jobs {
+
+template <typename Func, typename>
+void JobSystem::Schedule(Func&& func, Counter& counter) {
+  using Callable = std::decay_t<Func>;
+
+  Job job;
+  job.data     = new Callable(std::forward<Func>(func));
+  job.function = [](void* data, uint32_t /*begin*/, uint32_t /*end*/) {
+    Callable* callable = static_cast<Callable*>(data);
+    (*callable)();
+    delete callable;
+  };
+
+  Schedule(job, counter);
+}
+
+template <typename Func>
+void JobSystem::ParallelFor(uint32_t count, uint32_t min_batch_size, Func&& func) {
+  if (count == 0) {
+    return;
+  }
+
+  constexpr uint32_t kBatchesPerThread = 4;
+
+  uint32_t batches_count = std::max(1U, GetThreadsCount() * kBatchesPerThread);
+  uint32_t batch_size    = std::max({1U, min_batch_size, (count + batches_count - 1) / batches_count});
+
+  if (batch_size >= count || GetThreadsCount() == 1) {
+    func(0U, count);
+    return;
+  }
+
+  using Callable = std::remove_reference_t<Func>;
+
+  Job job;
+  job.data     = const_cast<void*>(static_cast<const void*>(std::addressof(func)));
+  job.function = [](void* data, uint32_t begin, uint32_t end) { (*static_cast<Callable*>(data))(begin, end); };
+  job.begin    = 0;
+  job.end      = count;
+
+  Counter counter;
+  ScheduleBatches(job, batch_size, counter);
+  Wait(counter);
+}
+
+}  // namespace jobs
+}  // namespace vulture
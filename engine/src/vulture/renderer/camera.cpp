@@ -97,6 +97,10 @@ void Camera::CalculateFrustumCorners(glm::vec3* out_corners) const {
   }
 }
 
+Frustum Camera::CalculateFrustum() const {
+  return Frustum{ProjMatrix() * ViewMatrix()};
+}
+
 void Camera::OnUpdateAspect(float aspect) {
   perspective_specification.aspect  = aspect;
   orthographic_specification.aspect = aspect;
@@ -29,6 +29,7 @@
 
 #include <glm/glm.hpp>
 #include <vulture/core/core.hpp>
+#include <vulture/renderer/frustum.hpp>
 #include <vulture/renderer/texture.hpp>
 #include <vulture/renderer/transform.hpp>
 
@@ -83,6 +84,7 @@ struct Camera {
   float            FarPlane()        const;
 
   void CalculateFrustumCorners(glm::vec3* out_corners) const;
+  Frustum CalculateFrustum() const;
 
   void OnUpdateAspect(float aspect);
   void OnUpdateTransform(const Transform& transform);
@@ -0,0 +1,157 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file draw_list.cpp
+ * @date 2023-06-18
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/renderer/draw_list.hpp>
+
+#include <cstring>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kRadixBits    = 8;
+constexpr uint32_t kRadixBuckets = 1U << kRadixBits;
+constexpr uint32_t kRadixPasses  = sizeof(uint64_t) * 8 / kRadixBits;
+
+uint64_t KeyBits16(uint64_t value) { return value & 0xFFFFULL; }
+
+/**
+ * @brief Quantize non-negative depth to 16 bits, preserving order.
+ *
+ * The bit pattern of a non-negative IEEE-754 float increases monotonically with its value, so taking the upper 16 bits
+ * (exponent and upper mantissa bits) gives a logarithmic quantization, which is more precise near the viewer.
+ */
+uint64_t QuantizeDepth(float depth) {
+  if (!(depth > 0.0f)) {
+    return 0;
+  }
+
+  uint32_t bits = 0;
+  std::memcpy(&bits, &depth, sizeof(bits));
+
+  return bits >> 16;
+}
+
+}  // namespace
+
+/************************************************************************************************
+ * Draw Statistics
+ ************************************************************************************************/
+DrawStatistics& DrawStatistics::operator+=(const DrawStatistics& other) {
+  draws                += other.draws;
+  instances            += other.instances;
+  pipeline_binds       += other.pipeline_binds;
+  descriptor_set_binds += other.descriptor_set_binds;
+  vertex_buffer_binds  += other.vertex_buffer_binds;
+  index_buffer_binds   += other.index_buffer_binds;
+
+  return *this;
+}
+
+/************************************************************************************************
+ * Draw List
+ ************************************************************************************************/
+uint64_t DrawList::CalculateSortKey(DrawOrder order, PipelineHandle pipeline, DescriptorSetHandle material_set,
+                                    BufferHandle vertex_buffer, float depth) {
+  uint64_t pipeline_bits = KeyBits16(pipeline);
+  uint64_t material_bits = KeyBits16(material_set);
+  uint64_t buffer_bits   = KeyBits16(vertex_buffer);
+  uint64_t depth_bits    = QuantizeDepth(depth);
+
+  switch (order) {
+    case DrawOrder::kStateChanges: {
+      return (pipeline_bits << 48) | (material_bits << 32) | (buffer_bits << 16) | depth_bits;
+    }
+
+    case DrawOrder::kFrontToBack: {
+      return (pipeline_bits << 48) | (depth_bits << 32) | (material_bits << 16) | buffer_bits;
+    }
+
+    default: { assert(!"Invalid draw order"); return 0; }
+  }
+}
+
+void DrawList::Clear() {
+  draws_.clear();
+  keys_.clear();
+  order_.clear();
+}
+
+void DrawList::Add(uint64_t sort_key, const Draw& draw) {
+  order_.push_back(static_cast<uint32_t>(draws_.size()));
+  keys_.push_back(sort_key);
+  draws_.push_back(draw);
+}
+
+void DrawList::Sort() {
+  uint32_t count = Size();
+  if (count <= 1) {
+    return;
+  }
+
+  keys_tmp_.resize(count);
+  order_tmp_.resize(count);
+
+  uint32_t histogram[kRadixBuckets];
+  for (uint32_t pass = 0; pass < kRadixPasses; ++pass) {
+    uint32_t shift = pass * kRadixBits;
+
+    std::memset(histogram, 0, sizeof(histogram));
+    for (uint64_t key : keys_) {
+      ++histogram[(key >> shift) & (kRadixBuckets - 1)];
+    }
+
+    /* All keys have the same digit, the pass wouldn't change anything */
+    if (histogram[(keys_[0] >> shift) & (kRadixBuckets - 1)] == count) {
+      continue;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t bucket = 0; bucket < kRadixBuckets; ++bucket) {
+      uint32_t bucket_size = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucket_size;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t dst = histogram[(keys_[i] >> shift) & (kRadixBuckets - 1)]++;
+
+      keys_tmp_[dst]  = keys_[i];
+      order_tmp_[dst] = order_[i];
+    }
+
+    keys_.swap(keys_tmp_);
+    order_.swap(order_tmp_);
+  }
+}
+
+uint32_t DrawList::Size() const { return static_cast<uint32_t>(draws_.size()); }
+
+const DrawList::Draw& DrawList::operator[](uint32_t idx) const {
+  assert(idx < Size());
+  return draws_[order_[idx]];
+}
@@ -0,0 +1,111 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file draw_list.hpp
+ * @date 2023-06-18
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/renderer/geometry/mesh.hpp>
+#include <vulture/renderer/material_system/material_pass.hpp>
+
+namespace vulture {
+
+/**
+ * @brief Order in which draws are submitted after sorting.
+ *
+ * Both orders group by pipeline first, since pipeline changes are the most expensive. After that
+ * - kStateChanges groups by material and geometry, sorting by depth only draws with equal state;
+ * - kFrontToBack sorts by depth (front to back), which maximizes early depth test rejection for opaque geometry.
+ */
+enum class DrawOrder : uint32_t {
+  kStateChanges,
+  kFrontToBack
+};
+
+/**
+ * @brief Counters of the commands actually recorded by render queue passes, i.e. excluding skipped redundant binds.
+ */
+struct DrawStatistics {
+  uint32_t draws                {0};
+  uint32_t instances            {0};
+  uint32_t pipeline_binds       {0};
+  uint32_t descriptor_set_binds {0};
+  uint32_t vertex_buffer_binds  {0};
+  uint32_t index_buffer_binds   {0};
+
+  DrawStatistics& operator+=(const DrawStatistics& other);
+};
+
+/**
+ * @brief Flattened list of draws of a single pass, sorted by 64-bit sort keys.
+ *
+ * Sort key layout (from the most significant bits):
+ * - DrawOrder::kStateChanges: pipeline (16) | material set (16) | vertex buffer (16) | depth (16)
+ * - DrawOrder::kFrontToBack:  pipeline (16) | depth (16) | material set (16) | vertex buffer (16)
+ *
+ * Handles are truncated to their lowest 16 bits, so different resources can occasionally share the same key bits.
+ * This only affects the quality of grouping, as redundant binds are detected by comparing actual handles.
+ */
+class DrawList {
+ public:
+  /**
+   * @brief Instanced draw of a submesh, instance data is in RendererBlackboardData::instances.
+   */
+  struct Draw {
+    Submesh*       submesh        {nullptr};
+    MaterialPass*  material_pass  {nullptr};
+    uint32_t       first_instance {0};
+    uint32_t       instances_count{0};
+    PipelineHandle pipeline       {kInvalidRenderResourceHandle};  ///< Built for the render pass recording the draw
+  };
+
+  static uint64_t CalculateSortKey(DrawOrder order, PipelineHandle pipeline, DescriptorSetHandle material_set,
+                                   BufferHandle vertex_buffer, float depth);
+
+  void Clear();
+  void Add(uint64_t sort_key, const Draw& draw);
+
+  /**
+   * @brief Stable LSD radix sort of the draws by their keys, skipping bytes equal for all keys.
+   */
+  void Sort();
+
+  uint32_t Size() const;
+
+  /**
+   * @brief Get draw in the sorted order.
+   */
+  const Draw& operator[](uint32_t idx) const;
+
+ private:
+  Vector<Draw>     draws_;
+  Vector<uint64_t> keys_;
+  Vector<uint32_t> order_;
+
+  Vector<uint64_t> keys_tmp_;
+  Vector<uint32_t> order_tmp_;
+};
+
+}  // namespace vulture
@@ -41,26 +41,30 @@ void DeferredPass::Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackb
   data.input_color = builder.LastVersion("backbuffer");
 
   data.output_color = builder.AddColorAttachment(data.input_color, AttachmentLoad::kLoad, AttachmentStore::kStore);
-  builder.AddSampledTexture(gbuffer.output_position);
-  builder.AddSampledTexture(gbuffer.output_normal);
-  builder.AddSampledTexture(gbuffer.output_albedo);
-  builder.AddSampledTexture(gbuffer.output_ao_metal_rough);
+
+  /* Read at the same pixel, which allows merging with the GBuffer Pass into a single render pass */
+  builder.AddInputAttachment(gbuffer.output_position);
+  builder.AddInputAttachment(gbuffer.output_normal);
+  builder.AddInputAttachment(gbuffer.output_albedo);
+  builder.AddInputAttachment(gbuffer.output_ao_metal_rough);
+
+  builder.AddSampledTexture(blackboard.Get<CascadedShadowMapPass::ViewData>().shadow_map);
 }
 
 void DeferredPass::Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-                           RenderPassHandle handle) {
+                           RenderPassHandle handle, uint32_t subpass_idx) {
   const auto& data        = blackboard.Get<Data>();
-  const auto& shadow_data = blackboard.Get<CascadedShadowMapPass::Data>();
+  const auto& shadow_data = blackboard.Get<CascadedShadowMapPass::ViewData>();
 
   auto& renderer_data = blackboard.Get<RendererBlackboardData>();
 
   auto& shader = data.material_pass->GetShader();
 
-  if (!shader.IsBuilt()) {
-    shader.Build(handle);
+  if (!shader.IsBuilt(handle, subpass_idx)) {
+    shader.Build(handle, subpass_idx);
   }
 
-  auto pipeline = shader.GetPipeline();
+  auto pipeline = shader.GetPipeline(handle, subpass_idx);
 
   command_buffer.CmdBindGraphicsPipeline(pipeline);
   shader.BindDescriptorSetIfUsed(command_buffer, Shader::kFrameSetBit, renderer_data.descriptor_set_frame);
@@ -92,28 +96,55 @@ void DeferredRenderFeature::Execute(RenderContext& context) {
   /* GBuffer Pass */
   GBufferPass::Data& gbuffer_pass_data = context.GetBlackboard().Get<GBufferPass::Data>();
 
-  gbuffer_pass_data.render_queue = &context.GetRenderQueue();
-  gbuffer_pass_data.view_set     = renderer_data.descriptor_set_main_view;
+  gbuffer_pass_data.render_queue_view = &context.GetView();
+  gbuffer_pass_data.view_set          = renderer_data.descriptor_set_view;
 
   context.GetRenderGraph().ReimportTexture(gbuffer_pass_data.input_color, context.GetCamera().render_texture);
 
   /* Deferred Pass */
-  if (!material_pass_) {
+  if (context.GetViewIdx() >= views_.size()) {
+    views_.resize(context.GetViewIdx() + 1);
+  }
+
+  ViewState& view = views_[context.GetViewIdx()];
+
+  if (!view.material_pass) {
     AssetRegistry* asset_registry = AssetRegistry::Instance();
     SharedPtr<Shader> deferred_shader = asset_registry->Load<Shader>(".vulture/shaders/BuiltIn.Deferred.shader");
 
-    material_pass_ = CreateUnique<MaterialPass>(context.GetRenderDevice(), deferred_shader);
+    view.material_pass = CreateUnique<MaterialPass>(context.GetRenderDevice(), deferred_shader);
+  }
+
+  /* Only rewrite the descriptor set if GBuffer textures have been recreated */
+  const rg::TextureVersionId gbuffer_versions[kGBufferTexturesCount] = {
+      gbuffer_pass_data.output_position, gbuffer_pass_data.output_normal, gbuffer_pass_data.output_albedo,
+      gbuffer_pass_data.output_ao_metal_rough};
+
+  bool gbuffer_changed = false;
+  for (uint32_t i = 0; i < kGBufferTexturesCount; ++i) {
+    const Texture& texture = *context.GetRenderGraph().GetTexture(gbuffer_versions[i]);
+    if (view.gbuffer_textures[i] != &texture || view.gbuffer_handles[i] != texture.GetHandle()) {
+      view.gbuffer_textures[i] = &texture;
+      view.gbuffer_handles[i]  = texture.GetHandle();
+      gbuffer_changed          = true;
+    }
   }
 
-  material_pass_->SetTextureSampler("uGBuffer_Position", context.GetRenderGraph().GetTexture(gbuffer_pass_data.output_position));
-  material_pass_->SetTextureSampler("uGBuffer_Normal", context.GetRenderGraph().GetTexture(gbuffer_pass_data.output_normal));
-  material_pass_->SetTextureSampler("uGBuffer_Albedo", context.GetRenderGraph().GetTexture(gbuffer_pass_data.output_albedo));
-  material_pass_->SetTextureSampler("uGBuffer_AO_Metal_Rough", context.GetRenderGraph().GetTexture(gbuffer_pass_data.output_ao_metal_rough));
-  material_pass_->WriteDescriptorSet();
+  if (gbuffer_changed) {
+    const StringView gbuffer_names[kGBufferTexturesCount] = {"uGBuffer_Position", "uGBuffer_Normal", "uGBuffer_Albedo",
+                                                             "uGBuffer_AO_Metal_Rough"};
+
+    for (uint32_t i = 0; i < kGBufferTexturesCount; ++i) {
+      view.material_pass->SetInputAttachment(gbuffer_names[i],
+                                             context.GetRenderGraph().GetTexture(gbuffer_versions[i]));
+    }
+
+    view.material_pass->WriteDescriptorSet();
+  }
 
   DeferredPass::Data& deferred_pass_data = context.GetBlackboard().Get<DeferredPass::Data>();
-  deferred_pass_data.material_pass = material_pass_.get();
-  deferred_pass_data.view_set = renderer_data.descriptor_set_main_view;
+  deferred_pass_data.material_pass = view.material_pass.get();
+  deferred_pass_data.view_set = renderer_data.descriptor_set_view;
 
   context.GetRenderGraph().ReimportTexture(deferred_pass_data.input_color, context.GetCamera().render_texture);
 }
\ No newline at end of file
@@ -52,7 +52,7 @@ class DeferredPass final : public rg::IRenderPass {
   void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackboard, RenderPassId pass_id) override;
 
   void Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-               RenderPassHandle handle) override;
+               RenderPassHandle handle, uint32_t subpass_idx) override;
 };
 
 /************************************************************************************************
@@ -67,7 +67,19 @@ class DeferredRenderFeature : public IRenderFeature {
   void Execute(RenderContext& context) override;
 
  private:
-  UniquePtr<MaterialPass> material_pass_{nullptr};
+  static constexpr uint32_t kGBufferTexturesCount = 4;
+
+  /**
+   * @brief Each view has its own GBuffer textures, so it needs its own material pass to bind them.
+   */
+  struct ViewState {
+    UniquePtr<MaterialPass> material_pass{nullptr};
+
+    const Texture*          gbuffer_textures[kGBufferTexturesCount]{};  ///< Bound to material_pass
+    TextureHandle           gbuffer_handles[kGBufferTexturesCount]{};
+  };
+
+  Vector<ViewState> views_;
 };
 
 }  // namespace vulture
\ No newline at end of file
@@ -32,6 +32,11 @@ using namespace vulture;
 /************************************************************************************************
  * GBuffer Pass
  ************************************************************************************************/
+GBufferPass::GBufferPass() {
+  /* GBuffer is opaque only, so front-to-back order lets the depth test reject occluded fragments early */
+  SetDrawOrder(DrawOrder::kFrontToBack);
+}
+
 void GBufferPass::Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackboard, RenderPassId pass_id) {
   Data& data = blackboard.Get<Data>();
 
@@ -48,42 +53,44 @@ void GBufferPass::Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackbo
 
   rg::DynamicTextureSpecification position_specification{};
   position_specification.format = DataFormat::kR16G16B16_SFLOAT;
-  position_specification.usage = kTextureUsageBitColorAttachment;
+  position_specification.usage = kTextureUsageBitColorAttachment | kTextureUsageBitInputAttachment;
   position_specification.width.SetDependency(backbuffer_id);
   position_specification.height.SetDependency(backbuffer_id);
   auto gbuffer_position = builder.CreateTexture("gbuffer_position", position_specification);
 
   rg::DynamicTextureSpecification normal_specification{};
   normal_specification.format = DataFormat::kR16G16B16_SFLOAT;
-  normal_specification.usage = kTextureUsageBitColorAttachment;
+  normal_specification.usage = kTextureUsageBitColorAttachment | kTextureUsageBitInputAttachment;
   normal_specification.width.SetDependency(backbuffer_id);
   normal_specification.height.SetDependency(backbuffer_id);
   auto gbuffer_normal = builder.CreateTexture("gbuffer_normal", normal_specification);
 
   rg::DynamicTextureSpecification albedo_specification{};
   albedo_specification.format = DataFormat::kR8G8B8A8_UNORM;
-  albedo_specification.usage = kTextureUsageBitColorAttachment;
+  albedo_specification.usage = kTextureUsageBitColorAttachment | kTextureUsageBitInputAttachment;
   albedo_specification.width.SetDependency(backbuffer_id);
   albedo_specification.height.SetDependency(backbuffer_id);
   auto gbuffer_albedo = builder.CreateTexture("gbuffer_albedo", albedo_specification);
 
   rg::DynamicTextureSpecification ao_metal_rough_specification{};
   ao_metal_rough_specification.format = DataFormat::kR8G8B8_UNORM;
-  ao_metal_rough_specification.usage = kTextureUsageBitColorAttachment;
+  ao_metal_rough_specification.usage = kTextureUsageBitColorAttachment | kTextureUsageBitInputAttachment;
   ao_metal_rough_specification.width.SetDependency(backbuffer_id);
   ao_metal_rough_specification.height.SetDependency(backbuffer_id);
   auto gbuffer_ao_metal_rough = builder.CreateTexture("gbuffer_ao_metal_rough", ao_metal_rough_specification);
 
+  /* Cleared rather than loaded, so that the GBuffer never leaves the tile memory if merged with the Deferred Pass */
   data.output_depth          = builder.SetDepthStencil(gbuffer_depth, AttachmentLoad::kClear, AttachmentStore::kStore);
-  data.output_position       = builder.AddColorAttachment(gbuffer_position);
-  data.output_normal         = builder.AddColorAttachment(gbuffer_normal);
-  data.output_albedo         = builder.AddColorAttachment(gbuffer_albedo);
-  data.output_ao_metal_rough = builder.AddColorAttachment(gbuffer_ao_metal_rough);
+  data.output_position       = builder.AddColorAttachment(gbuffer_position, AttachmentLoad::kClear);
+  data.output_normal         = builder.AddColorAttachment(gbuffer_normal, AttachmentLoad::kClear);
+  data.output_albedo         = builder.AddColorAttachment(gbuffer_albedo, AttachmentLoad::kClear);
+  data.output_ao_metal_rough = builder.AddColorAttachment(gbuffer_ao_metal_rough, AttachmentLoad::kClear);
 }
 
 void GBufferPass::Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-                          RenderPassHandle handle) {
+                          RenderPassHandle handle, uint32_t subpass_idx) {
   const auto& data = blackboard.Get<Data>();
 
-  Render(command_buffer, blackboard, *data.render_queue, data.view_set, kInvalidRenderResourceHandle, pass_id, handle);
+  Render(command_buffer, blackboard, *data.render_queue_view, data.view_set, kInvalidRenderResourceHandle, pass_id,
+         handle, subpass_idx);
 }
\ No newline at end of file
@@ -39,24 +39,26 @@ namespace vulture {
 class GBufferPass final : public IRenderQueuePass {
  public:
   struct Data {
-    rg::TextureVersionId input_color           {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   input_color           {rg::kInvalidTextureVersionId};
 
-    rg::TextureVersionId output_depth          {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_position       {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_normal         {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_albedo         {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_ao_metal_rough {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_depth          {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_position       {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_normal         {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_albedo         {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_ao_metal_rough {rg::kInvalidTextureVersionId};
 
-    const RenderQueue*   render_queue          {nullptr};
-    DescriptorSetHandle  view_set              {kInvalidRenderResourceHandle};
+    const RenderQueueView* render_queue_view     {nullptr};
+    DescriptorSetHandle    view_set              {kInvalidRenderResourceHandle};
   };
 
   static const StringView GetName() { return "GBuffer Pass"; }
 
+  GBufferPass();
+
   void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackboard, RenderPassId pass_id) override;
 
   void Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-               RenderPassHandle handle) override;
+               RenderPassHandle handle, uint32_t subpass_idx) override;
 };
 
 }  // namespace vulture
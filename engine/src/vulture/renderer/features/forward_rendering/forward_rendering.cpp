@@ -54,19 +54,18 @@ void ForwardPass::Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackbo
   rg::TextureVersionId color = builder.CreateTexture("forward_color", color_specification);
 
   builder.AddColorAttachment(color, AttachmentLoad::kClear, AttachmentStore::kDontCare);
-  for (uint32_t i = 0; i < kCascadedShadowMapCascadesCount; ++i) {
-    builder.AddSampledTexture(blackboard.Get<CascadedShadowMapPass::Data>().output_depth[i]);
-  }
+  builder.AddSampledTexture(blackboard.Get<CascadedShadowMapPass::ViewData>().shadow_map);
   data.output_color = builder.AddResolveAttachment(data.input_color, AttachmentLoad::kClear, AttachmentStore::kStore);
   data.output_depth = builder.SetDepthStencil(data.input_depth, AttachmentLoad::kClear, AttachmentStore::kStore);
 }
 
 void ForwardPass::Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-                          RenderPassHandle handle) {
+                          RenderPassHandle handle, uint32_t subpass_idx) {
   const auto& data        = blackboard.Get<Data>();
-  const auto& shadow_data = blackboard.Get<CascadedShadowMapPass::Data>();
+  const auto& shadow_data = blackboard.Get<CascadedShadowMapPass::ViewData>();
 
-  Render(command_buffer, blackboard, *data.render_queue, data.view_set, shadow_data.shadow_map_set, pass_id, handle);
+  Render(command_buffer, blackboard, *data.render_queue_view, data.view_set, shadow_data.shadow_map_set, pass_id, handle,
+         subpass_idx);
 }
 
 /************************************************************************************************
@@ -80,8 +79,8 @@ void ForwardRenderFeature::Execute(RenderContext& context) {
   RendererBlackboardData& renderer_data     = context.GetBlackboard().Get<RendererBlackboardData>();
   ForwardPass::Data&      forward_pass_data = context.GetBlackboard().Get<ForwardPass::Data>();
 
-  forward_pass_data.render_queue = &context.GetRenderQueue();
-  forward_pass_data.view_set     = renderer_data.descriptor_set_main_view;
+  forward_pass_data.render_queue_view = &context.GetView();
+  forward_pass_data.view_set          = renderer_data.descriptor_set_view;
 
   context.GetRenderGraph().ReimportTexture(forward_pass_data.input_color, context.GetCamera().render_texture);
 }
\ No newline at end of file
@@ -39,14 +39,14 @@ namespace vulture {
 class ForwardPass final : public IRenderQueuePass {
  public:
   struct Data {
-    rg::TextureVersionId input_color  {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId input_depth  {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   input_color       {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   input_depth       {rg::kInvalidTextureVersionId};
 
-    rg::TextureVersionId output_color {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_depth {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_color      {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_depth      {rg::kInvalidTextureVersionId};
 
-    const RenderQueue*   render_queue {nullptr};
-    DescriptorSetHandle  view_set     {kInvalidRenderResourceHandle};
+    const RenderQueueView* render_queue_view {nullptr};
+    DescriptorSetHandle    view_set          {kInvalidRenderResourceHandle};
   };
 
  public:
@@ -55,7 +55,7 @@ class ForwardPass final : public IRenderQueuePass {
   void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackboard, RenderPassId pass_id) override;
 
   void Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-               RenderPassHandle handle) override;
+               RenderPassHandle handle, uint32_t subpass_idx) override;
 };
 
 /************************************************************************************************
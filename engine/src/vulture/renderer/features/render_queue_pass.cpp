@@ -25,59 +25,243 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <vulture/jobs/job_system.hpp>
 #include <vulture/renderer/features/render_queue_pass.hpp>
 
 using namespace vulture;
 
-void IRenderQueuePass::Render(CommandBuffer& command_buffer, rg::Blackboard& blackboard, const RenderQueue& queue,
+IRenderQueuePass::~IRenderQueuePass() {
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    for (CommandBuffer* command_buffer : secondary_command_buffers_[frame]) {
+      device_->DeleteCommandBuffer(command_buffer);
+    }
+  }
+}
+
+void IRenderQueuePass::Render(CommandBuffer& command_buffer, rg::Blackboard& blackboard, const RenderQueueView& view,
                               DescriptorSetHandle view_set, DescriptorSetHandle custom_set, RenderPassId id,
-                              RenderPassHandle handle) {
+                              RenderPassHandle handle, uint32_t subpass_idx) {
   RendererBlackboardData& renderer_data = blackboard.Get<RendererBlackboardData>();
-  
-  PipelineHandle pipeline      = kInvalidRenderResourceHandle;
-  Material*      prev_material = nullptr;
-
-  for (auto& render_object : queue.renderables) {
-    Mesh& mesh = *render_object.mesh.get(); 
-    const glm::mat4& model_matrix = render_object.model_matrix;
-
-    for (auto& submesh : mesh.GetSubmeshes()) {
-      Material& material = submesh.GetMaterial();
-      if (!material.Has(id)) {
-        continue;
-      }
 
-      MaterialPass& material_pass = material.GetMaterialPass(id);
-      Shader&       shader        = material_pass.GetShader();
+  statistics_ = DrawStatistics{};
+  BuildDrawList(view, renderer_data, id, handle, subpass_idx);
 
-      if (!shader.IsBuilt()) {
-        shader.Build(handle);
-      }
+  if (inheritance_info_ != nullptr) {
+    RecordDrawsParallel(command_buffer, renderer_data, view_set, custom_set);
+  } else {
+    RecordDraws(command_buffer, renderer_data, view_set, custom_set, 0, draw_list_.Size(), statistics_);
+  }
 
-      if (!ValidRenderHandle(pipeline) || pipeline != shader.GetPipeline()) {
-        pipeline = shader.GetPipeline();
-      }
+  renderer_data.draw_statistics += statistics_;
+}
+
+bool IRenderQueuePass::UsesSecondaryCommandBuffers() const {
+  // Based on the previous frame, as the draw list is only built during recording
+  return parallel_recording_ && jobs::JobSystem::Instance().GetThreadsCount() > 1 &&
+         draw_list_.Size() >= 2 * kMinDrawsPerCommandBuffer;
+}
+
+void IRenderQueuePass::ExecuteSecondary(CommandBuffer& primary_command_buffer,
+                                        const CommandBuffer::InheritanceInfo& inheritance_info,
+                                        rg::Blackboard& blackboard, RenderPassId pass_id) {
+  inheritance_info_ = &inheritance_info;
+  Execute(primary_command_buffer, blackboard, pass_id, inheritance_info.render_pass, inheritance_info.subpass);
+  inheritance_info_ = nullptr;
+}
+
+void IRenderQueuePass::SetParallelRecording(bool parallel_recording) { parallel_recording_ = parallel_recording; }
+bool IRenderQueuePass::GetParallelRecording() const { return parallel_recording_; }
+
+void IRenderQueuePass::SetDrawOrder(DrawOrder draw_order) { draw_order_ = draw_order; }
+DrawOrder IRenderQueuePass::GetDrawOrder() const { return draw_order_; }
+
+const DrawStatistics& IRenderQueuePass::GetStatistics() const { return statistics_; }
+
+void IRenderQueuePass::BuildDrawList(const RenderQueueView& view, RendererBlackboardData& renderer_data,
+                                     RenderPassId id, RenderPassHandle handle, uint32_t subpass_idx) {
+  draw_list_.Clear();
+  groups_.clear();
+  item_groups_.clear();
+
+  if (view.queue == nullptr) {
+    return;
+  }
+
+  Vector<glm::mat4>& instances = renderer_data.instances;
+
+  /* Group items by submesh (submesh's material and pass id uniquely determine the material pass) */
+  LinearHashMap<const Submesh*, uint32_t> group_indices(
+      LinearStlAllocator<std::pair<const Submesh* const, uint32_t>>(*renderer_data.frame_allocator));
+  group_indices.reserve(view.items.size());
+
+  for (const auto& item : view.items) {
+    const RenderQueue::Renderable& render_object = view.queue->renderables[item.renderable_idx];
+
+    Submesh&  submesh  = render_object.mesh->GetSubmeshes()[item.submesh_idx];
+    Material& material = submesh.GetMaterial();
+    if (!material.Has(id)) {
+      item_groups_.push_back(kInvalidGroup);
+      continue;
+    }
+
+    auto [it, inserted] = group_indices.emplace(&submesh, static_cast<uint32_t>(groups_.size()));
+    if (inserted) {
+      groups_.push_back(InstanceGroup{&submesh, &material.GetMaterialPass(id), item.depth});
+    }
+
+    InstanceGroup& group = groups_[it->second];
+    group.depth = std::min(group.depth, item.depth);
+    ++group.instances_count;
+
+    item_groups_.push_back(it->second);
+  }
+
+  /* Allocate contiguous ranges of instances */
+  uint32_t first_instance = static_cast<uint32_t>(instances.size());
+  for (auto& group : groups_) {
+    group.first_instance   = first_instance;
+    first_instance        += group.instances_count;
+    group.instances_count  = 0;
+  }
+
+  renderer_data.renderer->ReserveInstances(first_instance);
+
+  instances.resize(first_instance);
+  for (uint32_t item_idx = 0; item_idx < view.items.size(); ++item_idx) {
+    if (item_groups_[item_idx] == kInvalidGroup) {
+      continue;
+    }
+
+    InstanceGroup& group = groups_[item_groups_[item_idx]];
+    instances[group.first_instance + group.instances_count++] =
+        view.queue->renderables[view.items[item_idx].renderable_idx].model_matrix;
+  }
+
+  /* Sort instanced draws */
+  for (const auto& group : groups_) {
+    MaterialPass& material_pass = *group.material_pass;
+    Shader&       shader        = material_pass.GetShader();
+
+    if (!shader.IsBuilt(handle, subpass_idx)) {
+      shader.Build(handle, subpass_idx);
+    }
+
+    PipelineHandle      pipeline     = shader.GetPipeline(handle, subpass_idx);
+    DescriptorSetHandle material_set = material_pass.IsMaterialUsed() ? material_pass.GetDescriptorSet()
+                                                                      : kInvalidRenderResourceHandle;
+
+    uint64_t sort_key = DrawList::CalculateSortKey(draw_order_, pipeline, material_set,
+                                                   group.submesh->GetVertexBuffer(), group.depth);
+
+    draw_list_.Add(sort_key, DrawList::Draw{group.submesh, &material_pass, group.first_instance,
+                                            group.instances_count, pipeline});
+  }
+
+  draw_list_.Sort();
+}
+
+void IRenderQueuePass::RecordDrawsParallel(CommandBuffer& primary_command_buffer,
+                                           const RendererBlackboardData& renderer_data, DescriptorSetHandle view_set,
+                                           DescriptorSetHandle custom_set) {
+  uint32_t draws_count = draw_list_.Size();
+  if (draws_count == 0) {
+    return;
+  }
+
+  jobs::JobSystem& job_system = jobs::JobSystem::Instance();
+
+  uint32_t command_buffers_count = (draws_count + kMinDrawsPerCommandBuffer - 1) / kMinDrawsPerCommandBuffer;
+  command_buffers_count          = std::min(command_buffers_count, job_system.GetThreadsCount());
+  uint32_t draws_per_buffer      = (draws_count + command_buffers_count - 1) / command_buffers_count;
+
+  device_ = &primary_command_buffer.GetDevice();
+
+  Vector<CommandBuffer*>& command_buffers = secondary_command_buffers_[renderer_data.frame_in_flight];
+  while (command_buffers.size() < command_buffers_count) {
+    command_buffers.push_back(device_->CreateCommandBuffer(CommandBufferType::kGraphicsSecondary));
+  }
+
+  secondary_statistics_.assign(command_buffers_count, DrawStatistics{});
+
+  job_system.ParallelFor(command_buffers_count, 1, [&](uint32_t first_buffer, uint32_t last_buffer) {
+    for (uint32_t buffer_idx = first_buffer; buffer_idx < last_buffer; ++buffer_idx) {
+      uint32_t first_draw = buffer_idx * draws_per_buffer;
+      uint32_t last_draw  = std::min(first_draw + draws_per_buffer, draws_count);
+
+      CommandBuffer& command_buffer = *command_buffers[buffer_idx];
+      command_buffer.Reset();
+      command_buffer.BeginSecondary(*inheritance_info_);
+      RecordDraws(command_buffer, renderer_data, view_set, custom_set, first_draw, last_draw,
+                  secondary_statistics_[buffer_idx]);
+      command_buffer.End();
+    }
+  });
+
+  primary_command_buffer.CmdExecuteCommands(command_buffers_count, command_buffers.data());
+
+  for (const auto& statistics : secondary_statistics_) {
+    statistics_ += statistics;
+  }
+}
+
+void IRenderQueuePass::RecordDraws(CommandBuffer& command_buffer, const RendererBlackboardData& renderer_data,
+                                   DescriptorSetHandle view_set, DescriptorSetHandle custom_set, uint32_t first_draw,
+                                   uint32_t last_draw, DrawStatistics& statistics) const {
+  PipelineHandle      pipeline      = kInvalidRenderResourceHandle;
+  DescriptorSetHandle material_set  = kInvalidRenderResourceHandle;
+  BufferHandle        vertex_buffer = kInvalidRenderResourceHandle;
+  BufferHandle        index_buffer  = kInvalidRenderResourceHandle;
+
+  auto bind_set_if_used = [&](Shader& shader, Shader::DescriptorSetBit set_bit, DescriptorSetHandle set) {
+    if (shader.DescriptorSetUsed(set_bit)) {
+      shader.BindDescriptorSetIfUsed(command_buffer, set_bit, set);
+      ++statistics.descriptor_set_binds;
+    }
+  };
+
+  for (uint32_t draw_idx = first_draw; draw_idx < last_draw; ++draw_idx) {
+    const DrawList::Draw& draw          = draw_list_[draw_idx];
+    Submesh&              submesh       = *draw.submesh;
+    MaterialPass&         material_pass = *draw.material_pass;
+    Shader&               shader        = material_pass.GetShader();
+
+    /* Frame, view, scene and custom sets are the same for all draws, so only need rebinding with a new pipeline */
+    if (pipeline != draw.pipeline) {
+      pipeline     = draw.pipeline;
+      material_set = kInvalidRenderResourceHandle;
 
-      // TODO: (tralf-strues) not bind per submesh!
       command_buffer.CmdBindGraphicsPipeline(pipeline);
-      shader.BindDescriptorSetIfUsed(command_buffer, Shader::kFrameSetBit, renderer_data.descriptor_set_frame);
-      shader.BindDescriptorSetIfUsed(command_buffer, Shader::kViewSetBit,  view_set);
-      shader.BindDescriptorSetIfUsed(command_buffer, Shader::kSceneSetBit, renderer_data.descriptor_set_scene);
+      ++statistics.pipeline_binds;
 
-      if ((prev_material == nullptr || prev_material != &material) && material_pass.IsMaterialUsed()) {
-        shader.BindDescriptorSetIfUsed(command_buffer, Shader::kMaterialSetBit, material_pass.GetDescriptorSet());
-        prev_material = &material;
+      bind_set_if_used(shader, Shader::kFrameSetBit, renderer_data.descriptor_set_frame);
+      bind_set_if_used(shader, Shader::kViewSetBit,  view_set);
+      bind_set_if_used(shader, Shader::kSceneSetBit, renderer_data.descriptor_set_scene);
 
-        if (ValidRenderHandle(custom_set)) {
-          shader.BindDescriptorSetIfUsed(command_buffer, Shader::kCustomSetBit, custom_set);
-        }
+      if (ValidRenderHandle(custom_set)) {
+        bind_set_if_used(shader, Shader::kCustomSetBit, custom_set);
       }
+    }
 
-      command_buffer.CmdPushConstants(pipeline, &model_matrix, 0, sizeof(model_matrix), kShaderStageBitVertex);
+    if (material_pass.IsMaterialUsed() && material_set != material_pass.GetDescriptorSet()) {
+      material_set = material_pass.GetDescriptorSet();
+      bind_set_if_used(shader, Shader::kMaterialSetBit, material_set);
+    }
+
+    if (vertex_buffer != submesh.GetVertexBuffer()) {
+      vertex_buffer = submesh.GetVertexBuffer();
+      command_buffer.CmdBindVertexBuffer(0, vertex_buffer);
+      ++statistics.vertex_buffer_binds;
+    }
 
-      command_buffer.CmdBindVertexBuffer(0, submesh.GetVertexBuffer());
-      command_buffer.CmdBindIndexBuffer(submesh.GetIndexBuffer());
-      command_buffer.CmdDrawIndexed(submesh.GetGeometry().GetIndices().size());
+    if (index_buffer != submesh.GetIndexBuffer()) {
+      index_buffer = submesh.GetIndexBuffer();
+      command_buffer.CmdBindIndexBuffer(index_buffer);
+      ++statistics.index_buffer_binds;
     }
+
+    command_buffer.CmdDrawIndexed(submesh.GetGeometry().GetIndices().size(), 0, 0, draw.instances_count,
+                                  draw.first_instance);
+    ++statistics.draws;
+    statistics.instances += draw.instances_count;
   }
-}
\ No newline at end of file
+}
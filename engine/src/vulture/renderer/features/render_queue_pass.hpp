@@ -27,14 +27,95 @@
 
 #pragma once
 
+#include <limits>
 #include <vulture/renderer/renderer.hpp>
 
 namespace vulture {
 
 class IRenderQueuePass : public rg::IRenderPass {
  public:
-  void Render(CommandBuffer& command_buffer, rg::Blackboard& blackboard, const RenderQueue& queue,
-              DescriptorSetHandle view_set, DescriptorSetHandle custom_set, RenderPassId id, RenderPassHandle handle);
+  /**
+   * Minimal number of draws recorded into each secondary command buffer, so that passes with few draws don't pay
+   * for splitting them across threads.
+   */
+  static constexpr uint32_t kMinDrawsPerCommandBuffer = 64;
+
+ public:
+  ~IRenderQueuePass() override;
+
+  /**
+   * @brief Group the view's submeshes into instanced draws, sort them and record, skipping redundant binds.
+   *
+   * Model matrices of each group's instances are appended to @ref{RendererBlackboardData::instances} and indexed in
+   * shaders by gl_InstanceIndex.
+   *
+   * Recorded command counts are stored in the pass's statistics and added to the frame statistics in
+   * @ref{RendererBlackboardData}.
+   *
+   * If called from @ref{ExecuteSecondary}, the draw list is split into chunks recorded into secondary command buffers
+   * in parallel using @ref{jobs::JobSystem::Instance}.
+   */
+  void Render(CommandBuffer& command_buffer, rg::Blackboard& blackboard, const RenderQueueView& view,
+              DescriptorSetHandle view_set, DescriptorSetHandle custom_set, RenderPassId id, RenderPassHandle handle,
+              uint32_t subpass_idx);
+
+  /**
+   * @brief Use secondary command buffers if there are multiple threads and enough draws (in the previous frame).
+   */
+  bool UsesSecondaryCommandBuffers() const override;
+
+  /**
+   * @brief Calls Execute, in which Render records into secondary command buffers.
+   */
+  void ExecuteSecondary(CommandBuffer& primary_command_buffer, const CommandBuffer::InheritanceInfo& inheritance_info,
+                        rg::Blackboard& blackboard, RenderPassId pass_id) override;
+
+  void SetParallelRecording(bool parallel_recording);
+  bool GetParallelRecording() const;
+
+  void SetDrawOrder(DrawOrder draw_order);
+  DrawOrder GetDrawOrder() const;
+
+  /**
+   * @brief Statistics of the last Render call.
+   */
+  const DrawStatistics& GetStatistics() const;
+
+ private:
+  static constexpr uint32_t kInvalidGroup = std::numeric_limits<uint32_t>::max();
+
+  struct InstanceGroup {
+    Submesh*      submesh        {nullptr};
+    MaterialPass* material_pass  {nullptr};
+    float         depth          {0.0f};  ///< Minimal depth of the instances
+    uint32_t      first_instance {0};
+    uint32_t      instances_count{0};
+  };
+
+  void BuildDrawList(const RenderQueueView& view, RendererBlackboardData& renderer_data, RenderPassId id,
+                     RenderPassHandle handle, uint32_t subpass_idx);
+
+  void RecordDrawsParallel(CommandBuffer& primary_command_buffer, const RendererBlackboardData& renderer_data,
+                           DescriptorSetHandle view_set, DescriptorSetHandle custom_set);
+
+  void RecordDraws(CommandBuffer& command_buffer, const RendererBlackboardData& renderer_data,
+                   DescriptorSetHandle view_set, DescriptorSetHandle custom_set, uint32_t first_draw,
+                   uint32_t last_draw, DrawStatistics& statistics) const;
+
+ private:
+  DrawOrder                         draw_order_{DrawOrder::kStateChanges};
+  DrawList                          draw_list_;
+  DrawStatistics                    statistics_;
+
+  Vector<InstanceGroup>             groups_;
+  Vector<uint32_t>                  item_groups_;  ///< Group index of each view item, kInvalidGroup if not drawn
+
+  /* Parallel recording */
+  bool                                  parallel_recording_{true};
+  const CommandBuffer::InheritanceInfo* inheritance_info_{nullptr};  ///< Only set during ExecuteSecondary
+  RenderDevice*                         device_{nullptr};
+  PerFrameData<Vector<CommandBuffer*>>  secondary_command_buffers_;
+  Vector<DrawStatistics>                secondary_statistics_;
 };
 
 }  // namespace vulture
\ No newline at end of file
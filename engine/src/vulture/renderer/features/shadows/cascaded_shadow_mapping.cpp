@@ -44,13 +44,19 @@ void CascadedShadowMapPass::Setup(rg::RenderGraphBuilder& builder, rg::Blackboar
                                                             AttachmentStore::kStore,
                                                             ClearValue{1.0f, 0},
                                                             cascade_num_);
+
+  builder.ReadBuffer(data.view_buffer[cascade_num_], kPipelineStageBitVertexShade, kMemoryAccessBitUniformRead);
+}
+
+bool CascadedShadowMapPass::IsEnabled(const rg::Blackboard& blackboard, RenderPassId pass_id) const {
+  return blackboard.Get<Data>().enabled;
 }
 
 void CascadedShadowMapPass::Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-                                    RenderPassHandle handle) {
+                                    RenderPassHandle handle, uint32_t subpass_idx) {
   Data& data = blackboard.Get<Data>();
-  Render(command_buffer, blackboard, *data.render_queue, data.view_set[cascade_num_], kInvalidRenderResourceHandle,
-         pass_id, handle);
+  Render(command_buffer, blackboard, *data.render_queue_view[cascade_num_], data.view_set[cascade_num_],
+         kInvalidRenderResourceHandle, pass_id, handle, subpass_idx);
 }
 
 /************************************************************************************************
@@ -74,25 +80,17 @@ CascadedShadowMapRenderFeature::CascadedShadowMapRenderFeature(RenderDevice& dev
   const ShaderStageFlags stage_flags = kShaderStageBitVertex | kShaderStageBitFragment;
 
   for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
-    ub_csm_[frame] = device_.CreateDynamicUniformBuffer<UBCSMData>(1);
-
     shadow_map_set_[frame].AddBinding(DescriptorType::kTextureSampler, stage_flags)
                           .AddBinding(DescriptorType::kUniformBuffer, stage_flags)
                           .Build(device_);
 
     device_.WriteDescriptorSampler(shadow_map_set_[frame].GetHandle(), 0, shadow_map_->GetHandle(),
                                    shadow_map_sampler_->GetHandle());
-    device_.WriteDescriptorUniformBuffer(shadow_map_set_[frame].GetHandle(), 1, ub_csm_[frame], 0, sizeof(UBCSMData));
   }
 
   for (uint32_t cascade_num = 0; cascade_num < kCascadedShadowMapCascadesCount; ++cascade_num) {
     for (uint32_t frame = 0; frame < view_set_per_cascade_[cascade_num].size(); ++frame) {
-      ub_view_per_cascade_[cascade_num][frame] = device_.CreateDynamicUniformBuffer<UBViewData>(1);
-
       view_set_per_cascade_[cascade_num][frame].AddBinding(DescriptorType::kUniformBuffer, stage_flags).Build(device_);
-
-      device_.WriteDescriptorUniformBuffer(view_set_per_cascade_[cascade_num][frame].GetHandle(), 0,
-                                           ub_view_per_cascade_[cascade_num][frame], 0, sizeof(UBViewData));
     }
   }
 }
@@ -101,36 +99,67 @@ CascadedShadowMapRenderFeature::~CascadedShadowMapRenderFeature() {
   // TODO:
 }
 
-void CascadedShadowMapRenderFeature::SetupRenderPasses(rg::RenderGraph& render_graph) {
-  render_graph.GetBlackboard().Add<CascadedShadowMapPass::Data>();
+void CascadedShadowMapRenderFeature::SetupSharedRenderPasses(rg::RenderGraph& render_graph) {
+  CascadedShadowMapPass::Data& pass_data = render_graph.GetBlackboard().Add<CascadedShadowMapPass::Data>();
 
   render_graph.ImportTexture("cascaded_shadow_map", shadow_map_, TextureLayout::kDepthStencilReadOnly);
 
+  ub_csm_ = render_graph.CreateBuffer("csm_data", {sizeof(UBCSMData), kBufferUsageBitUniformBuffer});
+
+  for (uint32_t cascade_num = 0; cascade_num < kCascadedShadowMapCascadesCount; ++cascade_num) {
+    ub_view_per_cascade_[cascade_num] = render_graph.CreateBuffer(fmt::format("csm_view_{0}", cascade_num),
+                                                                  {sizeof(UBViewData), kBufferUsageBitUniformBuffer});
+    pass_data.view_buffer[cascade_num] = ub_view_per_cascade_[cascade_num];
+  }
+
   for (uint32_t cascade_num = 0; cascade_num < kCascadedShadowMapCascadesCount; ++cascade_num) {
     render_graph.AddPass<CascadedShadowMapPass>(CascadedShadowMapPass::GetName(), cascade_num);
   }
 }
 
+void CascadedShadowMapRenderFeature::SetupRenderPasses(rg::RenderGraph& render_graph) {
+  CascadedShadowMapPass::ViewData& view_data = render_graph.GetBlackboard().Add<CascadedShadowMapPass::ViewData>();
+
+  view_data.shadow_map = render_graph.ImportTexture("cascaded_shadow_map", shadow_map_,
+                                                    TextureLayout::kDepthStencilReadOnly);
+}
+
 void CascadedShadowMapRenderFeature::Execute(RenderContext& context) {
+  CascadedShadowMapPass::ViewData& view_data = context.GetBlackboard().Get<CascadedShadowMapPass::ViewData>();
+
+  /* Only updates the graph if the shadow map has been recreated */
+  context.GetRenderGraph().ReimportTexture(view_data.shadow_map, shadow_map_);
+
+  view_data.shadow_map_set = shadow_map_set_[context.GetFrameIdx()].GetHandle();
+}
+
+void CascadedShadowMapRenderFeature::ExecuteShared(RenderContext& context) {
   if (shadow_map_size_ != shadow_map_->GetSpecification().width) {
     OnResize(context.GetRenderGraph());
   }
 
-  RendererBlackboardData&      renderer_data = context.GetBlackboard().Get<RendererBlackboardData>();
-  CascadedShadowMapPass::Data& pass_data     = context.GetBlackboard().Get<CascadedShadowMapPass::Data>();
+  if (!buffer_descriptors_written_) {
+    WriteBufferDescriptors(context.GetRenderGraph());
+  }
+
+  CascadedShadowMapPass::Data& pass_data = context.GetBlackboard().Get<CascadedShadowMapPass::Data>();
+
+  /* Shadow map is only cleared if there are no directional lights */
+  pass_data.enabled = !context.GetLights().directional_lights.empty();
+  if (!pass_data.enabled) {
+    return;
+  }
 
-  // FIXME: disable passes when there are no directional lights
   const DirectionalLight& light = context.GetLights().directional_lights[0];
   
   UBCSMData ub_csm_data{};
   UBViewData view_data_per_cascade[kCascadedShadowMapCascadesCount];
 
+  /* Split ratios of the first view's clip range, each view applies them to its own one */
   const Camera& camera = context.GetCamera();
   float camera_near          = camera.NearPlane();
   float camera_far           = camera.FarPlane();
   float camera_clip_range    = camera_far - camera_near;
-  auto  camera_proj_view     = camera.ProjMatrix() * camera.ViewMatrix();
-  auto  camera_inv_proj_view = glm::inverse(camera_proj_view);
 
   /* Step 1. Calculate cascade splits */
   VULTURE_ASSERT(log_split_contribution_ >= 0.0f && log_split_contribution_ <= 1.0f,
@@ -152,14 +181,15 @@ void CascadedShadowMapRenderFeature::Execute(RenderContext& context) {
   ub_csm_data.cascade_splits[0]                               = 0.0f;
   ub_csm_data.cascade_splits[kCascadedShadowMapCascadesCount] = 1.0f;
 
-  /* Step 2. Calculate transforms per cascade */
-  for (uint32_t cascade = 0; cascade < kCascadedShadowMapCascadesCount; ++cascade) {
-    glm::vec3 frustum_corners[8] = {
+  /* Step 2. Calculate transforms per cascade, fitted to the cascade's slices of all views' frusta, so that every view
+     samples the shadow map within its cascades */
+  auto get_slice_corners = [&ub_csm_data](const Camera& view_camera, uint32_t cascade, glm::vec3 frustum_corners[8]) {
+    const glm::vec3 ndc_corners[8] = {
       glm::vec3(-1.0f,  1.0f, 0.0f),
       glm::vec3( 1.0f,  1.0f, 0.0f),
       glm::vec3( 1.0f, -1.0f, 0.0f),
       glm::vec3(-1.0f, -1.0f, 0.0f),
-      
+
       glm::vec3(-1.0f,  1.0f, 1.0f),
       glm::vec3( 1.0f,  1.0f, 1.0f),
       glm::vec3( 1.0f, -1.0f, 1.0f),
@@ -167,8 +197,9 @@ void CascadedShadowMapRenderFeature::Execute(RenderContext& context) {
     };
 
     // Frustum corners from NDC to world space
+    glm::mat4 inv_proj_view = glm::inverse(view_camera.ProjMatrix() * view_camera.ViewMatrix());
     for (uint32_t i = 0; i < 8; ++i) {
-      glm::vec4 corner = camera_inv_proj_view * glm::vec4(frustum_corners[i], 1.0f);
+      glm::vec4 corner = inv_proj_view * glm::vec4(ndc_corners[i], 1.0f);
       frustum_corners[i] = corner / corner.w;
     }
 
@@ -178,19 +209,29 @@ void CascadedShadowMapRenderFeature::Execute(RenderContext& context) {
       frustum_corners[i]     = frustum_corners[i] + (dist * ub_csm_data.cascade_splits[cascade].value);
       frustum_corners[i + 4] = frustum_corners[i] + (dist * ub_csm_data.cascade_splits[cascade + 1].value);
     }
+  };
+
+  for (uint32_t cascade = 0; cascade < kCascadedShadowMapCascadesCount; ++cascade) {
+    glm::vec3 frustum_corners[8];
 
     // Frustum center
     glm::vec3 frustum_center{0.0f};
-    for (uint32_t i = 0; i < 8; ++i) {
-      frustum_center += frustum_corners[i];
+    for (uint32_t view_idx = 0; view_idx < context.GetViewsCount(); ++view_idx) {
+      get_slice_corners(context.GetViewCamera(view_idx), cascade, frustum_corners);
+      for (uint32_t i = 0; i < 8; ++i) {
+        frustum_center += frustum_corners[i];
+      }
     }
-    frustum_center /= 8.0f;
+    frustum_center /= 8.0f * static_cast<float>(context.GetViewsCount());
 
     // Frustum radius
     float radius = 0.0f;
-    for (uint32_t i = 0; i < 8; ++i) {
-      float distance = glm::length(frustum_corners[i] - frustum_center);
-      radius = glm::max(radius, distance);
+    for (uint32_t view_idx = 0; view_idx < context.GetViewsCount(); ++view_idx) {
+      get_slice_corners(context.GetViewCamera(view_idx), cascade, frustum_corners);
+      for (uint32_t i = 0; i < 8; ++i) {
+        float distance = glm::length(frustum_corners[i] - frustum_center);
+        radius = glm::max(radius, distance);
+      }
     }
     radius = std::ceil(radius * 16.0f) / 16.0f;
 
@@ -226,22 +267,21 @@ void CascadedShadowMapRenderFeature::Execute(RenderContext& context) {
   }
 
   for (uint32_t cascade = 0; cascade < kCascadedShadowMapCascadesCount; ++cascade) {
-    device_.LoadBufferData<UBViewData>(ub_view_per_cascade_[cascade][context.GetFrameIdx()], 0, 1,
-                                        &view_data_per_cascade[cascade]);
+    context.GetRenderGraph().LoadBufferData<UBViewData>(device_, ub_view_per_cascade_[cascade], context.GetFrameIdx(),
+                                                        1, &view_data_per_cascade[cascade]);
 
     pass_data.view_set[cascade] = view_set_per_cascade_[cascade][context.GetFrameIdx()].GetHandle();
     ub_csm_data.cascade_matrices[cascade] = view_data_per_cascade[cascade].proj * view_data_per_cascade[cascade].view;
+
+    view_per_cascade_[cascade].Cull(context.GetRenderQueue(), Frustum{ub_csm_data.cascade_matrices[cascade]});
+    pass_data.render_queue_view[cascade] = &view_per_cascade_[cascade];
   }
 
   ub_csm_data.shadow_color = shadow_color_;
   ub_csm_data.soft_shadows = soft_shadows_;
   ub_csm_data.bias         = bias_;
 
-  device_.LoadBufferData<UBCSMData>(ub_csm_[context.GetFrameIdx()], 0, 1, &ub_csm_data);
-
-  pass_data.shadow_map     = shadow_map_;
-  pass_data.shadow_map_set = shadow_map_set_[context.GetFrameIdx()].GetHandle();
-  pass_data.render_queue   = &context.GetRenderQueue();
+  context.GetRenderGraph().LoadBufferData<UBCSMData>(device_, ub_csm_, context.GetFrameIdx(), 1, &ub_csm_data);
 }
 
 void CascadedShadowMapRenderFeature::CreateShadowMap() {
@@ -265,4 +305,20 @@ void CascadedShadowMapRenderFeature::OnResize(rg::RenderGraph& render_graph) {
   }
 
   render_graph.ReimportTexture(render_graph.FirstVersion("cascaded_shadow_map"), shadow_map_);
+}
+
+void CascadedShadowMapRenderFeature::WriteBufferDescriptors(const rg::RenderGraph& render_graph) {
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    rg::BufferSlice csm_data = render_graph.GetBuffer(ub_csm_, frame);
+    device_.WriteDescriptorUniformBuffer(shadow_map_set_[frame].GetHandle(), 1, csm_data.buffer, csm_data.offset,
+                                         csm_data.size);
+
+    for (uint32_t cascade_num = 0; cascade_num < kCascadedShadowMapCascadesCount; ++cascade_num) {
+      rg::BufferSlice view_data = render_graph.GetBuffer(ub_view_per_cascade_[cascade_num], frame);
+      device_.WriteDescriptorUniformBuffer(view_set_per_cascade_[cascade_num][frame].GetHandle(), 0, view_data.buffer,
+                                           view_data.offset, view_data.size);
+    }
+  }
+
+  buffer_descriptors_written_ = true;
 }
\ No newline at end of file
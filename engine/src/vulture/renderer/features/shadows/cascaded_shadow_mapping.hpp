@@ -58,13 +58,21 @@ struct UBCSMData {
 class CascadedShadowMapPass final : public IRenderQueuePass {
  public:
   struct Data {
-    rg::TextureVersionId input_depth [kCascadedShadowMapCascadesCount] {rg::kInvalidTextureVersionId};
-    rg::TextureVersionId output_depth[kCascadedShadowMapCascadesCount] {rg::kInvalidTextureVersionId};
-    DescriptorSetHandle  view_set    [kCascadedShadowMapCascadesCount] {kInvalidRenderResourceHandle};
+    rg::TextureVersionId   input_depth      [kCascadedShadowMapCascadesCount] {rg::kInvalidTextureVersionId};
+    rg::TextureVersionId   output_depth     [kCascadedShadowMapCascadesCount] {rg::kInvalidTextureVersionId};
+    rg::BufferVersionId    view_buffer      [kCascadedShadowMapCascadesCount] {rg::kInvalidBufferVersionId};
+    DescriptorSetHandle    view_set         [kCascadedShadowMapCascadesCount] {kInvalidRenderResourceHandle};
+    const RenderQueueView* render_queue_view[kCascadedShadowMapCascadesCount] {nullptr};
 
-    SharedPtr<Texture>   shadow_map                                    {nullptr};
-    DescriptorSetHandle  shadow_map_set                                {kInvalidRenderResourceHandle};
-    const RenderQueue*   render_queue                                  {nullptr};
+    bool                   enabled                                            {true};
+  };
+
+  /**
+   * @brief Shadow map imported into a view's render graph, which samples it after the shared graph has rendered it.
+   */
+  struct ViewData {
+    rg::TextureVersionId shadow_map     {rg::kInvalidTextureVersionId};
+    DescriptorSetHandle  shadow_map_set {kInvalidRenderResourceHandle};
   };
 
  public:
@@ -74,8 +82,10 @@ class CascadedShadowMapPass final : public IRenderQueuePass {
 
   void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& blackboard, RenderPassId pass_id) override;
 
+  bool IsEnabled(const rg::Blackboard& blackboard, RenderPassId pass_id) const override;
+
   void Execute(CommandBuffer& command_buffer, rg::Blackboard& blackboard, RenderPassId pass_id,
-               RenderPassHandle handle) override;
+               RenderPassHandle handle, uint32_t subpass_idx) override;
 
  private:
   uint32_t cascade_num_{0};
@@ -101,12 +111,20 @@ class CascadedShadowMapRenderFeature : public IRenderFeature {
   float& GetBias() { return bias_; }
   uint32_t& GetResolution() { return shadow_map_size_; }
 
+  /**
+   * @brief Cascades are rendered once per frame and fitted to the union of all views' camera frusta, split by the ratios
+   *        of the first view's clip range.
+   */
+  void SetupSharedRenderPasses(rg::RenderGraph& render_graph) override;
+  void ExecuteShared(RenderContext& context) override;
+
   void SetupRenderPasses(rg::RenderGraph& render_graph) override;
   void Execute(RenderContext& context) override;
 
  private:
   void CreateShadowMap();
   void OnResize(rg::RenderGraph& render_graph);
+  void WriteBufferDescriptors(const rg::RenderGraph& render_graph);
 
  private:
   RenderDevice&               device_;
@@ -123,10 +141,14 @@ class CascadedShadowMapRenderFeature : public IRenderFeature {
   SharedPtr<Texture>          shadow_map_             {nullptr};
 
   PerFrameData<DescriptorSet> shadow_map_set_;
-  PerFrameData<BufferHandle>  ub_csm_;
+  rg::BufferVersionId         ub_csm_                 {rg::kInvalidBufferVersionId};
 
   PerFrameData<DescriptorSet> view_set_per_cascade_ [kCascadedShadowMapCascadesCount];
-  PerFrameData<BufferHandle>  ub_view_per_cascade_  [kCascadedShadowMapCascadesCount];
+  rg::BufferVersionId         ub_view_per_cascade_  [kCascadedShadowMapCascadesCount] {rg::kInvalidBufferVersionId};
+
+  bool                        buffer_descriptors_written_{false};  ///< Graph buffers are only allocated by its setup
+
+  RenderQueueView             view_per_cascade_     [kCascadedShadowMapCascadesCount];
 };
 
 }  // namespace vulture
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file frame_allocator.hpp
+ * @date 2023-06-21
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/core/linear_allocator.hpp>
+#include <vulture/renderer/graphics_api/render_device.hpp>
+
+namespace vulture {
+
+/**
+ * @brief Linear allocator per frame in flight for transient per-frame data (render queue, temporary containers etc).
+ *
+ * A frame's allocator is reset when the frame begins, so data allocated during a frame stays valid until the same
+ * frame in flight begins again, i.e. it can still be read during the next frame.
+ */
+class FrameAllocator {
+ public:
+  /**
+   * @brief Reset the frame's allocator and make it the current one.
+   */
+  LinearAllocator& BeginFrame(uint32_t frame_in_flight);
+
+  /**
+   * @brief Allocator of the frame begun last.
+   */
+  LinearAllocator& Get();
+
+  template <typename T>
+  LinearStlAllocator<T> GetStlAllocator() {
+    return LinearStlAllocator<T>(Get());
+  }
+
+  uint32_t GetFrameInFlight() const;
+
+ private:
+  PerFrameData<LinearAllocator> allocators_;
+  uint32_t                      frame_in_flight_{0};
+};
+
+}  // namespace vulture
@@ -0,0 +1,67 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file frustum.cpp
+ * @date 2023-06-17
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/renderer/frustum.hpp>
+
+using namespace vulture;
+
+Frustum::Frustum(const glm::mat4& proj_view) {
+  glm::vec4 row0{proj_view[0][0], proj_view[1][0], proj_view[2][0], proj_view[3][0]};
+  glm::vec4 row1{proj_view[0][1], proj_view[1][1], proj_view[2][1], proj_view[3][1]};
+  glm::vec4 row2{proj_view[0][2], proj_view[1][2], proj_view[2][2], proj_view[3][2]};
+  glm::vec4 row3{proj_view[0][3], proj_view[1][3], proj_view[2][3], proj_view[3][3]};
+
+  planes[kLeft]   = row3 + row0;
+  planes[kRight]  = row3 - row0;
+  planes[kBottom] = row3 + row1;
+  planes[kTop]    = row3 - row1;
+  planes[kNear]   = row3 + row2;
+  planes[kFar]    = row3 - row2;
+
+  for (auto& plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+}
+
+bool Frustum::Intersects(const AABB& box) const {
+  glm::vec3 center  = box.Center();
+  glm::vec3 extents = box.Extents();
+
+  for (const auto& plane : planes) {
+    glm::vec3 normal = glm::vec3(plane);
+
+    // Projection radius of the box onto the plane's normal
+    float radius   = glm::dot(extents, glm::abs(normal));
+    float distance = glm::dot(normal, center) + plane.w;
+
+    if (distance < -radius) {
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,70 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file frustum.hpp
+ * @date 2023-06-17
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/renderer/geometry/geometry.hpp>
+
+namespace vulture {
+
+/**
+ * @brief View frustum represented by six planes, used for culling.
+ */
+struct Frustum {
+  enum Plane : uint32_t {
+    kLeft,
+    kRight,
+    kBottom,
+    kTop,
+    kNear,
+    kFar,
+
+    kPlanesCount
+  };
+
+  glm::vec4 planes[kPlanesCount]{};  ///< (normal, distance), normals point inside and are normalized
+
+  Frustum() = default;
+
+  /**
+   * @brief Extract planes from a combined projection-view matrix (works for both perspective and orthographic).
+   *
+   * Based on "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix" by Gil Gribb and
+   * Klaus Hartmann. Assumes OpenGL clip-space depth range [-1, 1], which for [0, 1] projections results in a slightly
+   * more conservative near plane.
+   *
+   * @param proj_view
+   */
+  explicit Frustum(const glm::mat4& proj_view);
+
+  /**
+   * @brief Conservative test, i.e. may return true for boxes near frustum corners which are not actually inside.
+   */
+  bool Intersects(const AABB& box) const;
+};
+
+}  // namespace vulture
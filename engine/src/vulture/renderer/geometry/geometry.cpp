@@ -31,6 +31,29 @@ using namespace vulture;
 
 AABB::AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
 
+glm::vec3 AABB::Center() const { return 0.5f * (min + max); }
+glm::vec3 AABB::Extents() const { return 0.5f * (max - min); }
+
+void AABB::Extend(const AABB& other) {
+  min = glm::min(min, other.min);
+  max = glm::max(max, other.max);
+}
+
+AABB AABB::Transformed(const glm::mat4& matrix) const {
+  // Based on "Transforming Axis-Aligned Bounding Boxes" by Jim Arvo, Graphics Gems, 1990
+  glm::vec3 center  = Center();
+  glm::vec3 extents = Extents();
+
+  glm::vec3 new_center  = glm::vec3(matrix[3]);
+  glm::vec3 new_extents = glm::vec3(0.0f);
+  for (uint32_t column = 0; column < 3; ++column) {
+    new_center  += glm::vec3(matrix[column]) * center[column];
+    new_extents += glm::abs(glm::vec3(matrix[column])) * extents[column];
+  }
+
+  return AABB(new_center - new_extents, new_center + new_extents);
+}
+
 Geometry::Geometry(uint32_t vertex_count, uint32_t index_count) {
   vertices_.resize(vertex_count);
   indices_.resize(index_count);
@@ -43,6 +66,12 @@ Vector<uint32_t>& Geometry::GetIndices() { return indices_; }
 const Vector<uint32_t>& Geometry::GetIndices() const { return indices_; }
 
 void Geometry::CalculateBoundingBox() {
+  if (GetVertices().empty()) {
+    bounding_box_ = AABB{};
+    return;
+  }
+
+  bounding_box_ = AABB{GetVertices()[0].position, GetVertices()[0].position};
   for (const auto& vertex : GetVertices()) {
     bounding_box_.min.x = std::min(bounding_box_.min.x, vertex.position.x);
     bounding_box_.min.y = std::min(bounding_box_.min.y, vertex.position.y);
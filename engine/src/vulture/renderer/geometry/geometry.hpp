@@ -38,6 +38,16 @@ struct AABB {
 
   AABB() = default;
   AABB(const glm::vec3& min, const glm::vec3& max);
+
+  glm::vec3 Center() const;
+  glm::vec3 Extents() const;  ///< Half-size
+
+  void Extend(const AABB& other);
+
+  /**
+   * @brief Calculate the AABB enclosing this one transformed by the matrix (e.g. model to world space).
+   */
+  AABB Transformed(const glm::mat4& matrix) const;
 };
 
 class Geometry {
@@ -131,21 +131,40 @@ Material& Submesh::GetMaterial() const {
 Mesh::Mesh(RenderDevice& device, const Geometry& geometry, SharedPtr<Material> material, bool dynamic) {
   Submesh& submesh = submeshes_.emplace_back(geometry, material, dynamic);
   submesh.UpdateDeviceBuffers(device);
+
+  CalculateBoundingBox();
 }
 
 Vector<Submesh>& Mesh::GetSubmeshes() { return submeshes_; }
 const Vector<Submesh>& Mesh::GetSubmeshes() const { return submeshes_; }
 
 void Mesh::CalculateBoundingBox() {
-  /* TODO: (tralf-strues) */
-  VULTURE_ASSERT(false, "Not implemented");
+  bounding_box_ = AABB{};
+
+  for (uint32_t submesh_idx = 0; submesh_idx < submeshes_.size(); ++submesh_idx) {
+    Geometry& geometry = submeshes_[submesh_idx].GetGeometry();
+    geometry.CalculateBoundingBox();
+
+    if (submesh_idx == 0) {
+      bounding_box_ = geometry.GetBoundingBox();
+    } else {
+      bounding_box_.Extend(geometry.GetBoundingBox());
+    }
+  }
 }
 
 const AABB& Mesh::GetBoundingBox() const {
-  VULTURE_ASSERT(false, "Not implemented");
   return bounding_box_;
 }
 
+void Mesh::SetNeverCulled(bool never_culled) {
+  never_culled_ = never_culled;
+}
+
+bool Mesh::IsNeverCulled() const {
+  return never_culled_;
+}
+
 void Mesh::UpdateDeviceBuffers(RenderDevice& device) {
   for (auto& submesh : submeshes_) {
     submesh.UpdateDeviceBuffers(device);
@@ -85,15 +85,26 @@ public:
   Vector<Submesh>& GetSubmeshes();
   const Vector<Submesh>& GetSubmeshes() const;
 
+  /**
+   * @brief Calculate bounding boxes of all submeshes' geometry and the whole mesh (in model space).
+   */
   void CalculateBoundingBox();
   const AABB& GetBoundingBox() const;
 
+  /**
+   * @brief Exclude the mesh from frustum culling, e.g. if its vertices are moved in the shader so that the bounding
+   * box says nothing about where it is drawn.
+   */
+  void SetNeverCulled(bool never_culled);
+  bool IsNeverCulled() const;
+
   void UpdateDeviceBuffers(RenderDevice& device);
 
 private:
   Vector<Submesh> submeshes_;
 
   AABB bounding_box_{};
+  bool never_culled_{false};
 };
 
 }  // namespace vulture
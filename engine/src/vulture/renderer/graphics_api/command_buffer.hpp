@@ -35,6 +35,14 @@ namespace vulture {
 
 class RenderDevice;
 
+enum class CommandBufferType {
+  kInvalid,
+  kGraphics,
+  kGraphicsSecondary,  ///< Can't be submitted, only executed by a kGraphics command buffer inside a render pass
+  kCompute,            ///< Only compute commands, see @ref{RenderDevice::SupportsAsyncCompute}
+  // kTransfer,
+};
+
 /* Viewport */
 struct Viewport {
   float x         {0.0f};  ///< In pixels
@@ -53,30 +61,94 @@ struct RenderArea {
   uint32_t height {0};  ///< In pixels
 };
 
-enum class CommandBufferType {
-  kInvalid,
-  kGraphics,
-  // kTransfer,
-  // kCompute  // TODO: (tralf-strues) Compute pipeline is not supported at the moment
+/* Texture Barrier */
+/**
+ * @brief Layout transition and/or memory dependency for all mip levels and layers of a texture.
+ */
+struct TextureBarrier {
+  TextureHandle               texture         {kInvalidRenderResourceHandle};
+  TextureLayout               old_layout      {TextureLayout::kUndefined};  ///< kUndefined discards the contents
+  TextureLayout               new_layout      {TextureLayout::kUndefined};
+  MemoryAccessDependencyFlags src_access_mask {kMemoryAccessBitNone};
+  MemoryAccessDependencyFlags dst_access_mask {kMemoryAccessBitNone};
+
+  /**
+   * @brief Queue ownership transfer, if both are set and the queues are different.
+   *
+   * The same barrier must be recorded twice: as a release into a command buffer of src_queue (dst_access_mask is
+   * ignored) and as an acquire into a command buffer of dst_queue (src_access_mask is ignored), which must wait for the
+   * release with a semaphore.
+   */
+  CommandBufferType           src_queue       {CommandBufferType::kInvalid};
+  CommandBufferType           dst_queue       {CommandBufferType::kInvalid};
 };
 
+/* Buffer Barrier */
+/**
+ * @brief Memory dependency for a range of a buffer.
+ */
+struct BufferBarrier {
+  BufferHandle                buffer          {kInvalidRenderResourceHandle};
+  uint32_t                    offset          {0};
+  uint32_t                    size            {0};
+  MemoryAccessDependencyFlags src_access_mask {kMemoryAccessBitNone};
+  MemoryAccessDependencyFlags dst_access_mask {kMemoryAccessBitNone};
+};
+
+
 class CommandBuffer {
  public:
   virtual ~CommandBuffer() = default;
 
   virtual RenderDevice& GetDevice() = 0;
 
+  CommandBufferType GetType() const { return type_; }
+
+  /**
+   * @brief State a secondary command buffer continues from, i.e. the primary command buffer's current render pass.
+   */
+  struct InheritanceInfo {
+    RenderPassHandle  render_pass{kInvalidRenderResourceHandle};
+    uint32_t          subpass    {0};
+    FramebufferHandle framebuffer{kInvalidRenderResourceHandle};  ///< Optional, but may improve performance
+    RenderArea        render_area{};  ///< Scissor is set to the render area on begin, same as in RenderPassBegin
+    Viewport          viewport   {};  ///< Set on begin, as dynamic state isn't inherited from the primary
+  };
+
   virtual void Begin() = 0;
+
+  /**
+   * @brief Begin recording a secondary command buffer, which is entirely inside the inherited render pass' subpass.
+   * @warning Can only be called on CommandBufferType::kGraphicsSecondary command buffers.
+   */
+  virtual void BeginSecondary(const InheritanceInfo& inheritance_info) = 0;
+
   virtual void End() = 0;
+
+  /**
+   * @param wait_stages Stages of this command buffer, which wait for the wait_semaphore.
+   */
   virtual void Submit(FenceHandle signal_fence = kInvalidRenderResourceHandle,
                       SemaphoreHandle signal_semaphore = kInvalidRenderResourceHandle,
-                      SemaphoreHandle wait_semaphore = kInvalidRenderResourceHandle) = 0;
+                      SemaphoreHandle wait_semaphore = kInvalidRenderResourceHandle,
+                      PipelineStageFlags wait_stages = kPipelineStageBitColorAttachmentOutput) = 0;
 
   virtual void Reset() = 0;
 
   virtual void GenerateMipmaps(TextureHandle texture, TextureLayout final_layout = TextureLayout::kShaderReadOnly) = 0;
   virtual void TransitionLayout(TextureHandle texture, TextureLayout old_layout, TextureLayout new_layout) = 0;
 
+  /**
+   * @brief Record a batch of texture and buffer barriers as a single pipeline barrier.
+   *
+   * @param src_stage_mask Stages, which must finish before the dst_stage_mask stages of the subsequent commands start.
+   *                       If none, the barrier only performs the layout transitions.
+   */
+  virtual void CmdPipelineBarrier(PipelineStageFlags src_stage_mask, PipelineStageFlags dst_stage_mask,
+                                  uint32_t texture_barriers_count, const TextureBarrier* texture_barriers,
+                                  uint32_t buffer_barriers_count = 0,
+                                  const BufferBarrier* buffer_barriers = nullptr) = 0;
+
   virtual void CopyBuffer(BufferHandle src_buffer, BufferHandle dst_buffer, uint32_t size, uint32_t src_offset = 0,
                           uint32_t dst_offset = 0) = 0;
 
@@ -139,12 +211,27 @@ class CommandBuffer {
      *       then clear value i is ignored.
      */
     const ClearValue* clear_values{nullptr};
+
+    /**
+     * @brief Whether the first subpass is recorded in secondary command buffers. In this case the only command, which
+     *        can be recorded into this command buffer before the next subpass or the end of the render pass, is
+     *        CmdExecuteCommands.
+     */
+    bool secondary_command_buffers{false};
   };
 
   virtual void RenderPassBegin(const RenderPassBeginInfo& begin_info) = 0;
   virtual void RenderPassEnd() = 0;
 
-  virtual void CmdNextSubpass() = 0;
+  /**
+   * @param secondary_command_buffers Same as in RenderPassBeginInfo, but for the next subpass.
+   */
+  virtual void CmdNextSubpass(bool secondary_command_buffers = false) = 0;
+
+  /**
+   * @brief Execute secondary command buffers, which must have already been ended.
+   */
+  virtual void CmdExecuteCommands(uint32_t count, CommandBuffer* const* command_buffers) = 0;
 
   virtual void CmdBindDescriptorSets(PipelineHandle pipeline, uint32_t first_set_idx, uint32_t count,
                                      const DescriptorSetHandle* descriptor_sets) = 0;
@@ -183,6 +270,34 @@ class CommandBuffer {
                               uint32_t instances_count = 1,
                               uint32_t first_instance  = 0) = 0;
 
+  /************************************************************************************************
+   * Compute Commands
+   ************************************************************************************************/
+  /**
+   * @warning Must not be called inside a render pass.
+   */
+  virtual void CmdBindComputePipeline(PipelineHandle pipeline) = 0;
+
+  /**
+   * @brief Dispatch work groups of the currently bound compute pipeline.
+   */
+  virtual void CmdDispatch(uint32_t group_count_x, uint32_t group_count_y = 1, uint32_t group_count_z = 1) = 0;
+
+  /************************************************************************************************
+   * Query Commands
+   ************************************************************************************************/
+  /**
+   * @brief Reset the queries [first_query, first_query + count), which must be done before writing them again.
+   *
+   * @warning Must not be called inside a render pass.
+   */
+  virtual void CmdResetQueryPool(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count) = 0;
+
+  /**
+   * @brief Write the timestamp to the query, once all previously recorded commands have completed the stage.
+   */
+  virtual void CmdWriteTimestamp(QueryPoolHandle query_pool, uint32_t query, PipelineStageFlags stage) = 0;
+
  protected:
   CommandBuffer(CommandBufferType type) : type_(type) {}
 
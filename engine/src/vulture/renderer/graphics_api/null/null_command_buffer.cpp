@@ -0,0 +1,353 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file null_command_buffer.cpp
+ * @date 2023-06-14
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/renderer/graphics_api/null/null_command_buffer.hpp>
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
+
+#include <cstring>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kCommandAlignment = 8;
+
+constexpr uint32_t AlignCommandSize(uint32_t size) {
+  return (size + kCommandAlignment - 1) & ~(kCommandAlignment - 1);
+}
+
+}  // namespace
+
+NullCommandBuffer::NullCommandBuffer(CommandBufferType type, NullRenderDevice& device, bool temporary)
+    : CommandBuffer(type), device_(device), temporary_(temporary) {}
+
+RenderDevice& NullCommandBuffer::GetDevice() {
+  return device_;
+}
+
+/************************************************************************************************
+ * Recorded data
+ ************************************************************************************************/
+const NullCommandBufferStats& NullCommandBuffer::GetStats() const {
+  return stats_;
+}
+
+const uint8_t* NullCommandBuffer::GetCommandStreamData() const {
+  return stream_.data();
+}
+
+uint32_t NullCommandBuffer::GetCommandStreamSize() const {
+  return static_cast<uint32_t>(stream_.size());
+}
+
+void NullCommandBuffer::RecordRaw(NullCommandType type, const void* payload, uint32_t payload_size,
+                                  const void* extra_data, uint32_t extra_size) {
+  assert(recording_);
+
+  uint32_t command_size = sizeof(NullCommandHeader) + payload_size + extra_size;
+  uint32_t aligned_size = AlignCommandSize(command_size);
+
+  size_t offset = stream_.size();
+  stream_.resize(offset + aligned_size);
+
+  NullCommandHeader header{};
+  header.type = type;
+  header.size = aligned_size;
+
+  uint8_t* dst = stream_.data() + offset;
+  std::memcpy(dst, &header, sizeof(header));
+  dst += sizeof(header);
+
+  if (payload_size > 0) {
+    std::memcpy(dst, payload, payload_size);
+    dst += payload_size;
+  }
+
+  if (extra_size > 0) {
+    assert(extra_data != nullptr);
+    std::memcpy(dst, extra_data, extra_size);
+  }
+
+  ++stats_.commands;
+}
+
+/************************************************************************************************
+ * CommandBuffer
+ ************************************************************************************************/
+void NullCommandBuffer::Begin() {
+  assert(!recording_);
+  assert(type_ != CommandBufferType::kGraphicsSecondary);
+
+  // Like vkBeginCommandBuffer, beginning implicitly resets the command buffer
+  stream_.clear();
+  stats_ = NullCommandBufferStats{};
+
+  recording_ = true;
+}
+
+void NullCommandBuffer::BeginSecondary(const InheritanceInfo& inheritance_info) {
+  assert(!recording_);
+  assert(type_ == CommandBufferType::kGraphicsSecondary);
+  assert(ValidRenderHandle(inheritance_info.render_pass));
+
+  stream_.clear();
+  stats_ = NullCommandBufferStats{};
+
+  recording_ = true;
+
+  CmdSetViewports(1, &inheritance_info.viewport);
+}
+
+void NullCommandBuffer::End() {
+  assert(recording_);
+  recording_ = false;
+}
+
+void NullCommandBuffer::Submit(FenceHandle signal_fence, SemaphoreHandle signal_semaphore,
+                               SemaphoreHandle wait_semaphore, PipelineStageFlags wait_stages) {
+  assert(!recording_);
+  assert(type_ != CommandBufferType::kGraphicsSecondary);
+
+  if (ValidRenderHandle(wait_semaphore)) {
+    assert(wait_stages != kPipelineStageBitNone);
+    device_.semaphores_.at(wait_semaphore) = false;
+  }
+
+  if (ValidRenderHandle(signal_semaphore)) {
+    device_.semaphores_.at(signal_semaphore) = true;
+  }
+
+  if (ValidRenderHandle(signal_fence)) {
+    device_.fences_.at(signal_fence) = true;
+  }
+
+  ++stats_.submits;
+}
+
+void NullCommandBuffer::Reset() {
+  stream_.clear();
+  stats_     = NullCommandBufferStats{};
+  recording_ = false;
+}
+
+void NullCommandBuffer::GenerateMipmaps(TextureHandle texture, TextureLayout final_layout) {
+  Record(NullCommandType::kGenerateMipmaps, NullCmdGenerateMipmaps{texture, final_layout});
+}
+
+void NullCommandBuffer::TransitionLayout(TextureHandle texture, TextureLayout old_layout, TextureLayout new_layout) {
+  Record(NullCommandType::kTransitionLayout, NullCmdTransitionLayout{texture, old_layout, new_layout});
+  ++stats_.layout_transitions;
+}
+
+void NullCommandBuffer::CmdPipelineBarrier(PipelineStageFlags src_stage_mask, PipelineStageFlags dst_stage_mask,
+                                           uint32_t texture_barriers_count, const TextureBarrier* texture_barriers,
+                                           uint32_t buffer_barriers_count, const BufferBarrier* /*buffer_barriers*/) {
+  Record(NullCommandType::kPipelineBarrier,
+         NullCmdPipelineBarrier{src_stage_mask, dst_stage_mask, texture_barriers_count, buffer_barriers_count},
+         texture_barriers, texture_barriers_count * sizeof(TextureBarrier));
+
+  ++stats_.pipeline_barriers;
+  for (uint32_t i = 0; i < texture_barriers_count; ++i) {
+    if (texture_barriers[i].old_layout != texture_barriers[i].new_layout) {
+      ++stats_.layout_transitions;
+    }
+  }
+}
+
+void NullCommandBuffer::CopyBuffer(BufferHandle src_buffer, BufferHandle dst_buffer, uint32_t size,
+                                   uint32_t src_offset, uint32_t dst_offset) {
+  Record(NullCommandType::kCopyBuffer, NullCmdCopyBuffer{src_buffer, dst_buffer, size, src_offset, dst_offset});
+  ++stats_.copies;
+}
+
+void NullCommandBuffer::CopyBufferToTexture(BufferHandle buffer, TextureHandle texture, uint32_t width,
+                                            uint32_t height, uint32_t layer, uint32_t layers_count) {
+  Record(NullCommandType::kCopyBufferToTexture,
+         NullCmdCopyBufferTexture{buffer, texture, width, height, layer, layers_count});
+  ++stats_.copies;
+}
+
+void NullCommandBuffer::CopyTextureToBuffer(TextureHandle texture, BufferHandle buffer, uint32_t width,
+                                            uint32_t height, uint32_t layer, uint32_t layers_count) {
+  Record(NullCommandType::kCopyTextureToBuffer,
+         NullCmdCopyBufferTexture{buffer, texture, width, height, layer, layers_count});
+  ++stats_.copies;
+}
+
+void NullCommandBuffer::CopyTexture(TextureHandle src_texture, TextureHandle dst_texture, uint32_t width,
+                                    uint32_t height) {
+  Record(NullCommandType::kCopyTexture, NullCmdCopyTexture{src_texture, dst_texture, width, height});
+  ++stats_.copies;
+}
+
+/************************************************************************************************
+ * Graphics/Compute Commands (depending on the usage)
+ ************************************************************************************************/
+void NullCommandBuffer::RenderPassBegin(const RenderPassBeginInfo& begin_info) {
+  assert(type_ != CommandBufferType::kCompute);
+
+  NullCmdRenderPassBegin command{begin_info.render_pass, begin_info.framebuffer, begin_info.render_area,
+                                 begin_info.clear_values_count};
+
+  Record(NullCommandType::kRenderPassBegin, command, begin_info.clear_values,
+         begin_info.clear_values_count * sizeof(ClearValue));
+
+  ++stats_.render_passes;
+  ++stats_.subpasses;
+}
+
+void NullCommandBuffer::RenderPassEnd() {
+  RecordRaw(NullCommandType::kRenderPassEnd, nullptr, 0);
+}
+
+void NullCommandBuffer::CmdNextSubpass(bool /*secondary_command_buffers*/) {
+  RecordRaw(NullCommandType::kNextSubpass, nullptr, 0);
+  ++stats_.subpasses;
+}
+
+void NullCommandBuffer::CmdExecuteCommands(uint32_t count, CommandBuffer* const* command_buffers) {
+  Record(NullCommandType::kExecuteCommands, NullCmdExecuteCommands{count}, command_buffers,
+         count * sizeof(CommandBuffer*));
+
+  for (uint32_t i = 0; i < count; ++i) {
+    assert(command_buffers[i]->GetType() == CommandBufferType::kGraphicsSecondary);
+
+    const auto*                   secondary = static_cast<const NullCommandBuffer*>(command_buffers[i]);
+    const NullCommandBufferStats& stats     = secondary->GetStats();
+    assert(!secondary->recording_);
+
+    stats_.commands                  += stats.commands;
+    stats_.draws                     += stats.draws;
+    stats_.indexed_draws             += stats.indexed_draws;
+    stats_.instances                 += stats.instances;
+    stats_.primitives                += stats.primitives;
+    stats_.dispatches                += stats.dispatches;
+    stats_.pipeline_binds            += stats.pipeline_binds;
+    stats_.descriptor_set_bind_calls += stats.descriptor_set_bind_calls;
+    stats_.descriptor_sets_bound     += stats.descriptor_sets_bound;
+    stats_.push_constants            += stats.push_constants;
+    stats_.vertex_buffer_binds       += stats.vertex_buffer_binds;
+    stats_.index_buffer_binds        += stats.index_buffer_binds;
+  }
+
+  stats_.executed_command_buffers += count;
+}
+
+void NullCommandBuffer::CmdBindDescriptorSets(PipelineHandle pipeline, uint32_t first_set_idx, uint32_t count,
+                                              const DescriptorSetHandle* descriptor_sets) {
+  Record(NullCommandType::kBindDescriptorSets, NullCmdBindDescriptorSets{pipeline, first_set_idx, count},
+         descriptor_sets, count * sizeof(DescriptorSetHandle));
+
+  ++stats_.descriptor_set_bind_calls;
+  stats_.descriptor_sets_bound += count;
+}
+
+void NullCommandBuffer::CmdPushConstants(PipelineHandle pipeline, const void* data, uint32_t offset, uint32_t size,
+                                         ShaderStageFlags shader_stages) {
+  Record(NullCommandType::kPushConstants, NullCmdPushConstants{pipeline, offset, size, shader_stages}, data, size);
+  ++stats_.push_constants;
+}
+
+/************************************************************************************************
+ * Graphics Commands
+ ************************************************************************************************/
+void NullCommandBuffer::CmdBindGraphicsPipeline(PipelineHandle pipeline) {
+  Record(NullCommandType::kBindGraphicsPipeline, NullCmdBindGraphicsPipeline{pipeline});
+  ++stats_.pipeline_binds;
+}
+
+void NullCommandBuffer::CmdSetViewports(uint32_t viewports_count, const Viewport* viewports) {
+  Record(NullCommandType::kSetViewports, NullCmdSetViewports{viewports_count}, viewports,
+         viewports_count * sizeof(Viewport));
+}
+
+void NullCommandBuffer::CmdBindVertexBuffers(uint32_t first_binding, uint32_t count,
+                                             const BufferHandle* vertex_buffers, const uint64_t* offsets) {
+  // Buffers and offsets are stored one after another, so they are gathered into one contiguous block first
+  constexpr uint32_t kMaxInlineBindings = 16;
+  assert(count <= kMaxInlineBindings);
+
+  uint64_t extra[2 * kMaxInlineBindings]{};
+  std::memcpy(extra, vertex_buffers, count * sizeof(BufferHandle));
+  if (offsets != nullptr) {
+    std::memcpy(extra + count, offsets, count * sizeof(uint64_t));
+  }
+
+  Record(NullCommandType::kBindVertexBuffers, NullCmdBindVertexBuffers{first_binding, count}, extra,
+         count * (sizeof(BufferHandle) + sizeof(uint64_t)));
+
+  stats_.vertex_buffer_binds += count;
+}
+
+void NullCommandBuffer::CmdBindIndexBuffer(BufferHandle index_buffer, uint64_t offset) {
+  Record(NullCommandType::kBindIndexBuffer, NullCmdBindIndexBuffer{index_buffer, offset});
+  ++stats_.index_buffer_binds;
+}
+
+void NullCommandBuffer::CmdDraw(uint32_t vertices_count, uint32_t first_vertex, uint32_t instances_count,
+                                uint32_t first_instance) {
+  Record(NullCommandType::kDraw, NullCmdDraw{vertices_count, first_vertex, instances_count, first_instance});
+
+  ++stats_.draws;
+  stats_.instances  += instances_count;
+  stats_.primitives += static_cast<uint64_t>(vertices_count / 3) * instances_count;
+}
+
+void NullCommandBuffer::CmdDrawIndexed(uint32_t indices_count, uint32_t first_index, int32_t vertex_offset,
+                                       uint32_t instances_count, uint32_t first_instance) {
+  Record(NullCommandType::kDrawIndexed,
+         NullCmdDrawIndexed{indices_count, first_index, vertex_offset, instances_count, first_instance});
+
+  ++stats_.draws;
+  ++stats_.indexed_draws;
+  stats_.instances  += instances_count;
+  stats_.primitives += static_cast<uint64_t>(indices_count / 3) * instances_count;
+}
+
+/************************************************************************************************
+ * Compute Commands
+ ************************************************************************************************/
+void NullCommandBuffer::CmdBindComputePipeline(PipelineHandle pipeline) {
+  Record(NullCommandType::kBindComputePipeline, NullCmdBindComputePipeline{pipeline});
+  ++stats_.pipeline_binds;
+}
+
+void NullCommandBuffer::CmdDispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) {
+  Record(NullCommandType::kDispatch, NullCmdDispatch{group_count_x, group_count_y, group_count_z});
+  ++stats_.dispatches;
+}
+
+/************************************************************************************************
+ * Query Commands
+ ************************************************************************************************/
+void NullCommandBuffer::CmdResetQueryPool(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count) {
+  Record(NullCommandType::kResetQueryPool, NullCmdResetQueryPool{query_pool, first_query, count});
+}
+
+void NullCommandBuffer::CmdWriteTimestamp(QueryPoolHandle query_pool, uint32_t query, PipelineStageFlags stage) {
+  Record(NullCommandType::kWriteTimestamp, NullCmdWriteTimestamp{query_pool, query, stage});
+}
@@ -0,0 +1,379 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file null_command_buffer.hpp
+ * @date 2023-06-14
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/core/core.hpp>
+#include <vulture/renderer/graphics_api/command_buffer.hpp>
+
+namespace vulture {
+
+class NullRenderDevice;
+
+enum class NullCommandType : uint16_t {
+  kInvalid,
+  kGenerateMipmaps,
+  kTransitionLayout,
+  kPipelineBarrier,
+  kCopyBuffer,
+  kCopyBufferToTexture,
+  kCopyTextureToBuffer,
+  kCopyTexture,
+  kRenderPassBegin,
+  kRenderPassEnd,
+  kNextSubpass,
+  kExecuteCommands,
+  kBindDescriptorSets,
+  kPushConstants,
+  kBindGraphicsPipeline,
+  kSetViewports,
+  kBindVertexBuffers,
+  kBindIndexBuffer,
+  kDraw,
+  kDrawIndexed,
+  kBindComputePipeline,
+  kDispatch,
+  kResetQueryPool,
+  kWriteTimestamp,
+
+  kTotalCommandTypes
+};
+
+/**
+ * @brief Header preceding every command in the stream.
+ *
+ * Command payload (if any) follows the header immediately, @ref{size} includes the header itself, so the next command
+ * starts at (header + size). Headers are always aligned to 8 bytes.
+ */
+struct NullCommandHeader {
+  NullCommandType type{NullCommandType::kInvalid};
+  uint16_t        reserved{0};
+  uint32_t        size{0};
+};
+
+/************************************************************************************************
+ * Command payloads
+ ************************************************************************************************/
+struct NullCmdGenerateMipmaps {
+  TextureHandle texture;
+  TextureLayout final_layout;
+};
+
+struct NullCmdTransitionLayout {
+  TextureHandle texture;
+  TextureLayout old_layout;
+  TextureLayout new_layout;
+};
+
+/** @note Followed by texture_barriers_count TextureBarrier structures, buffer barriers are only counted */
+struct NullCmdPipelineBarrier {
+  PipelineStageFlags src_stage_mask;
+  PipelineStageFlags dst_stage_mask;
+  uint32_t           texture_barriers_count;
+  uint32_t           buffer_barriers_count;
+};
+
+struct NullCmdCopyBuffer {
+  BufferHandle src_buffer;
+  BufferHandle dst_buffer;
+  uint32_t     size;
+  uint32_t     src_offset;
+  uint32_t     dst_offset;
+};
+
+/** @note Used for both kCopyBufferToTexture and kCopyTextureToBuffer */
+struct NullCmdCopyBufferTexture {
+  BufferHandle  buffer;
+  TextureHandle texture;
+  uint32_t      width;
+  uint32_t      height;
+  uint32_t      start_layer;
+  uint32_t      layers_count;
+};
+
+struct NullCmdCopyTexture {
+  TextureHandle src_texture;
+  TextureHandle dst_texture;
+  uint32_t      width;
+  uint32_t      height;
+};
+
+/** @note Followed by clear_values_count ClearValue structures */
+struct NullCmdRenderPassBegin {
+  RenderPassHandle  render_pass;
+  FramebufferHandle framebuffer;
+  RenderArea        render_area;
+  uint32_t          clear_values_count;
+};
+
+/** @note Followed by count NullCommandBuffer pointers */
+struct NullCmdExecuteCommands {
+  uint32_t count;
+};
+
+/** @note Followed by count DescriptorSetHandle values */
+struct NullCmdBindDescriptorSets {
+  PipelineHandle pipeline;
+  uint32_t       first_set_idx;
+  uint32_t       count;
+};
+
+/** @note Followed by size bytes of data */
+struct NullCmdPushConstants {
+  PipelineHandle   pipeline;
+  uint32_t         offset;
+  uint32_t         size;
+  ShaderStageFlags shader_stages;
+};
+
+struct NullCmdBindGraphicsPipeline {
+  PipelineHandle pipeline;
+};
+
+/** @note Followed by viewports_count Viewport structures */
+struct NullCmdSetViewports {
+  uint32_t viewports_count;
+};
+
+/** @note Followed by count BufferHandle values and then count uint64_t offsets */
+struct NullCmdBindVertexBuffers {
+  uint32_t first_binding;
+  uint32_t count;
+};
+
+struct NullCmdBindIndexBuffer {
+  BufferHandle index_buffer;
+  uint64_t     offset;
+};
+
+struct NullCmdDraw {
+  uint32_t vertices_count;
+  uint32_t first_vertex;
+  uint32_t instances_count;
+  uint32_t first_instance;
+};
+
+struct NullCmdDrawIndexed {
+  uint32_t indices_count;
+  uint32_t first_index;
+  int32_t  vertex_offset;
+  uint32_t instances_count;
+  uint32_t first_instance;
+};
+
+struct NullCmdBindComputePipeline {
+  PipelineHandle pipeline;
+};
+
+struct NullCmdDispatch {
+  uint32_t group_count_x;
+  uint32_t group_count_y;
+  uint32_t group_count_z;
+};
+
+struct NullCmdResetQueryPool {
+  QueryPoolHandle query_pool;
+  uint32_t        first_query;
+  uint32_t        count;
+};
+
+struct NullCmdWriteTimestamp {
+  QueryPoolHandle    query_pool;
+  uint32_t           query;
+  PipelineStageFlags stage;
+};
+
+/**
+ * @brief Per command buffer counters, gathered while recording.
+ */
+struct NullCommandBufferStats {
+  uint32_t commands{0};
+  uint32_t draws{0};  ///< CmdDraw + CmdDrawIndexed
+  uint32_t indexed_draws{0};
+  uint64_t instances{0};
+  uint64_t primitives{0};  ///< Assuming triangle lists
+  uint32_t dispatches{0};
+  uint32_t pipeline_binds{0};  ///< Both graphics and compute
+  uint32_t descriptor_set_bind_calls{0};
+  uint32_t descriptor_sets_bound{0};
+  uint32_t push_constants{0};
+  uint32_t vertex_buffer_binds{0};
+  uint32_t index_buffer_binds{0};
+  uint32_t executed_command_buffers{0};  ///< Secondary command buffers, whose counters are added to these ones
+  uint32_t render_passes{0};
+  uint32_t subpasses{0};
+  uint32_t layout_transitions{0};
+  uint32_t pipeline_barriers{0};
+  uint32_t copies{0};
+  uint32_t submits{0};
+};
+
+/**
+ * @brief Command buffer, which doesn't execute anything, but records every command into a compact linear stream.
+ *
+ * Used for profiling the CPU side of the renderer without a GPU and for checking draw/bind counts.
+ */
+class NullCommandBuffer final : public CommandBuffer {
+ public:
+  NullCommandBuffer(CommandBufferType type, NullRenderDevice& device, bool temporary = false);
+  ~NullCommandBuffer() override = default;
+
+  RenderDevice& GetDevice() override;
+
+  /************************************************************************************************
+   * Recorded data
+   ************************************************************************************************/
+  const NullCommandBufferStats& GetStats() const;
+
+  const uint8_t* GetCommandStreamData() const;
+  uint32_t GetCommandStreamSize() const;
+
+  /**
+   * @brief Iterate over the recorded commands.
+   *
+   * @param func Callable with signature void(const NullCommandHeader& header, const void* payload).
+   */
+  template <typename Func>
+  void ForEachCommand(Func&& func) const;
+
+  /************************************************************************************************
+   * CommandBuffer
+   ************************************************************************************************/
+  void Begin() override;
+  void BeginSecondary(const InheritanceInfo& inheritance_info) override;
+  void End() override;
+  void Submit(FenceHandle signal_fence, SemaphoreHandle signal_semaphore, SemaphoreHandle wait_semaphore,
+              PipelineStageFlags wait_stages) override;
+
+  void Reset() override;
+
+  void GenerateMipmaps(TextureHandle texture, TextureLayout final_layout) override;
+  void TransitionLayout(TextureHandle texture, TextureLayout old_layout, TextureLayout new_layout) override;
+
+  void CmdPipelineBarrier(PipelineStageFlags src_stage_mask, PipelineStageFlags dst_stage_mask,
+                          uint32_t texture_barriers_count, const TextureBarrier* texture_barriers,
+                          uint32_t buffer_barriers_count, const BufferBarrier* buffer_barriers) override;
+
+  void CopyBuffer(BufferHandle src_buffer, BufferHandle dst_buffer, uint32_t size, uint32_t src_offset,
+                  uint32_t dst_offset) override;
+
+  void CopyBufferToTexture(BufferHandle buffer, TextureHandle texture, uint32_t width, uint32_t height,
+                           uint32_t layer, uint32_t layers_count) override;
+  void CopyTextureToBuffer(TextureHandle texture, BufferHandle buffer, uint32_t width, uint32_t height,
+                           uint32_t layer, uint32_t layers_count) override;
+  void CopyTexture(TextureHandle src_texture, TextureHandle dst_texture, uint32_t width, uint32_t height) override;
+
+  /************************************************************************************************
+   * Graphics/Compute Commands (depending on the usage)
+   ************************************************************************************************/
+  void RenderPassBegin(const RenderPassBeginInfo& begin_info) override;
+  void RenderPassEnd() override;
+
+  void CmdNextSubpass(bool secondary_command_buffers) override;
+
+  void CmdExecuteCommands(uint32_t count, CommandBuffer* const* command_buffers) override;
+
+  void CmdBindDescriptorSets(PipelineHandle pipeline, uint32_t first_set_idx, uint32_t count,
+                             const DescriptorSetHandle* descriptor_sets) override;
+
+  void CmdPushConstants(PipelineHandle pipeline, const void* data, uint32_t offset, uint32_t size,
+                        ShaderStageFlags shader_stages) override;
+
+  /************************************************************************************************
+   * Graphics Commands
+   ************************************************************************************************/
+  void CmdBindGraphicsPipeline(PipelineHandle pipeline) override;
+
+  void CmdSetViewports(uint32_t viewports_count, const Viewport* viewports) override;
+
+  void CmdBindVertexBuffers(uint32_t first_binding, uint32_t count, const BufferHandle* vertex_buffers,
+                            const uint64_t* offsets) override;
+
+  void CmdBindIndexBuffer(BufferHandle index_buffer, uint64_t offset) override;
+
+  void CmdDraw(uint32_t vertices_count,
+               uint32_t first_vertex,
+               uint32_t instances_count,
+               uint32_t first_instance) override;
+
+  void CmdDrawIndexed(uint32_t indices_count,
+                      uint32_t first_index,
+                      int32_t  vertex_offset,
+                      uint32_t instances_count,
+                      uint32_t first_instance) override;
+
+  /************************************************************************************************
+   * Compute Commands
+   ************************************************************************************************/
+  void CmdBindComputePipeline(PipelineHandle pipeline) override;
+
+  void CmdDispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override;
+
+  /************************************************************************************************
+   * Query Commands
+   ************************************************************************************************/
+  void CmdResetQueryPool(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count) override;
+  void CmdWriteTimestamp(QueryPoolHandle query_pool, uint32_t query, PipelineStageFlags stage) override;
+
+ private:
+  /**
+   * @brief Append a command to the stream.
+   *
+   * @param payload       Fixed-size part of the command.
+   * @param extra_data    Variable-size part of the command (handles, push constant data, etc.), can be nullptr.
+   * @param extra_size    Size of the variable-size part in bytes.
+   */
+  void RecordRaw(NullCommandType type, const void* payload, uint32_t payload_size, const void* extra_data = nullptr,
+                 uint32_t extra_size = 0);
+
+  template <typename T>
+  void Record(NullCommandType type, const T& payload, const void* extra_data = nullptr, uint32_t extra_size = 0) {
+    RecordRaw(type, &payload, sizeof(T), extra_data, extra_size);
+  }
+
+ private:
+  NullRenderDevice&      device_;
+  bool                   temporary_{false};
+  bool                   recording_{false};
+
+  Vector<uint8_t>        stream_;
+  NullCommandBufferStats stats_;
+};
+
+template <typename Func>
+void NullCommandBuffer::ForEachCommand(Func&& func) const {
+  uint32_t offset = 0;
+  while (offset < stream_.size()) {
+    const auto* header = reinterpret_cast<const NullCommandHeader*>(stream_.data() + offset);
+    assert(header->size >= sizeof(NullCommandHeader));
+
+    func(*header, reinterpret_cast<const void*>(header + 1));
+    offset += header->size;
+  }
+}
+
+}  // namespace vulture
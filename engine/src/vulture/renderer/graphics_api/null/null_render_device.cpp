@@ -0,0 +1,647 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file null_render_device.cpp
+ * @date 2023-06-14
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/platform/window.hpp>
+#include <vulture/renderer/graphics_api/null/null_command_buffer.hpp>
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vulture;
+
+uint32_t NullRenderDevice::GenNextHandle() {
+  return next_handle_++;
+}
+
+NullRenderDevice::NullRenderDevice() : RenderDevice(DeviceFamily::kNull) {}
+
+NullRenderDevice::~NullRenderDevice() = default;
+
+void NullRenderDevice::SetSwapchainExtent(uint32_t width, uint32_t height) {
+  assert(width > 0 && height > 0);
+  swapchain_width_  = width;
+  swapchain_height_ = height;
+}
+
+void NullRenderDevice::WaitIdle() {}
+
+uint32_t NullRenderDevice::CurrentFrame() const {
+  return current_frame_;
+}
+
+bool NullRenderDevice::SupportsAsyncCompute() const { return true; }
+bool NullRenderDevice::SupportsLazilyAllocatedMemory() const { return true; }
+
+void NullRenderDevice::FrameBegin() {
+  assert(!frame_began_);
+  frame_began_ = true;
+}
+
+void NullRenderDevice::FrameEnd() {
+  assert(frame_began_);
+
+  frame_began_ = false;
+  current_frame_ = (current_frame_ + 1) % kFramesInFlight;
+}
+
+/************************************************************************************************
+ * INIT
+ ************************************************************************************************/
+void NullRenderDevice::Init(Window* window, const DeviceFeatures* /*required_features*/,
+                            const DeviceProperties* /*required_properties*/, bool /*enable_validation*/) {
+  window_ = window;
+}
+
+DeviceFeatures NullRenderDevice::GetDeviceFeatures() {
+  DeviceFeatures features{};
+  features.sampler_anisotropy = true;
+
+  return features;
+}
+
+DeviceProperties NullRenderDevice::GetDeviceProperties() {
+  DeviceProperties properties{};
+  properties.max_msaa_samples       = 8;
+  properties.max_sampler_anisotropy = 16.0f;
+  properties.name                   = "Null Device";
+
+  return properties;
+}
+
+/************************************************************************************************
+ * SYNCHRONIZATION
+ ************************************************************************************************/
+FenceHandle NullRenderDevice::CreateFence() {
+  FenceHandle handle = GenNextHandle();
+  fences_.emplace(handle, /*signaled=*/true);
+  return handle;
+}
+
+void NullRenderDevice::DeleteFence(FenceHandle handle) {
+  auto it = fences_.find(handle);
+  assert(it != fences_.end());
+  fences_.erase(it);
+}
+
+void NullRenderDevice::WaitForFences(uint32_t count, const FenceHandle* handles) {
+  for (uint32_t i = 0; i < count; ++i) {
+    assert(fences_.find(handles[i]) != fences_.end());
+  }
+}
+
+void NullRenderDevice::ResetFence(FenceHandle handle) {
+  auto it = fences_.find(handle);
+  assert(it != fences_.end());
+  it->second = false;
+}
+
+SemaphoreHandle NullRenderDevice::CreateSemaphore() {
+  SemaphoreHandle handle = GenNextHandle();
+  semaphores_.emplace(handle, false);
+  return handle;
+}
+
+void NullRenderDevice::DeleteSemaphore(SemaphoreHandle handle) {
+  auto it = semaphores_.find(handle);
+  assert(it != semaphores_.end());
+  semaphores_.erase(it);
+}
+
+/************************************************************************************************
+ * SWAPCHAIN
+ ************************************************************************************************/
+void NullRenderDevice::CreateSwapchainTextures(NullSwapchain& swapchain) {
+  uint32_t width  = swapchain_width_;
+  uint32_t height = swapchain_height_;
+  if (window_ != nullptr) {
+    width  = window_->GetFramebufferWidth();
+    height = window_->GetFramebufferHeight();
+  }
+
+  swapchain.textures.resize(kSwapchainTexturesCount);
+  for (uint32_t i = 0; i < kSwapchainTexturesCount; ++i) {
+    NullTexture texture{};
+    texture.specification.format     = DataFormat::kB8G8R8A8_SRGB;
+    texture.specification.usage      = swapchain.usage;
+    texture.specification.width      = width;
+    texture.specification.height     = height;
+    texture.specification.mip_levels = 1;
+    texture.specification.samples    = 1;
+    texture.swapchain_owned          = true;
+
+    TextureHandle texture_handle = GenNextHandle();
+    textures_.emplace(texture_handle, std::move(texture));
+
+    swapchain.textures[i] = texture_handle;
+  }
+}
+
+SwapchainHandle NullRenderDevice::CreateSwapchain(TextureUsageFlags usage) {
+  NullSwapchain swapchain{};
+  swapchain.usage = usage;
+  CreateSwapchainTextures(swapchain);
+
+  SwapchainHandle handle = GenNextHandle();
+  swapchains_.emplace(handle, std::move(swapchain));
+
+  return handle;
+}
+
+void NullRenderDevice::DeleteSwapchain(SwapchainHandle handle) {
+  auto it = swapchains_.find(handle);
+  assert(it != swapchains_.end());
+
+  for (TextureHandle texture_handle : it->second.textures) {
+    auto texture_it = textures_.find(texture_handle);
+    assert(texture_it != textures_.end());
+    textures_.erase(texture_it);
+  }
+
+  swapchains_.erase(it);
+}
+
+void NullRenderDevice::GetSwapchainTextures(SwapchainHandle swapchain_handle, uint32_t* textures_count,
+                                            TextureHandle* texture_handles) {
+  NullSwapchain& swapchain = GetNullSwapchain(swapchain_handle);
+
+  if (textures_count != nullptr) {
+    *textures_count = static_cast<uint32_t>(swapchain.textures.size());
+  }
+
+  if (texture_handles != nullptr) {
+    std::memcpy(texture_handles, swapchain.textures.data(), swapchain.textures.size() * sizeof(*texture_handles));
+  }
+}
+
+bool NullRenderDevice::AcquireNextTexture(SwapchainHandle swapchain_handle, uint32_t* texture_idx,
+                                          SemaphoreHandle signal_semaphore, FenceHandle signal_fence) {
+  NullSwapchain& swapchain = GetNullSwapchain(swapchain_handle);
+
+  swapchain.current_texture_idx = (swapchain.current_texture_idx + 1) % swapchain.textures.size();
+  if (texture_idx != nullptr) {
+    *texture_idx = swapchain.current_texture_idx;
+  }
+
+  if (ValidRenderHandle(signal_semaphore)) {
+    semaphores_.at(signal_semaphore) = true;
+  }
+
+  if (ValidRenderHandle(signal_fence)) {
+    fences_.at(signal_fence) = true;
+  }
+
+  return true;
+}
+
+bool NullRenderDevice::Present(SwapchainHandle swapchain_handle, SemaphoreHandle wait_semaphore) {
+  assert(swapchains_.find(swapchain_handle) != swapchains_.end());
+
+  if (ValidRenderHandle(wait_semaphore)) {
+    semaphores_.at(wait_semaphore) = false;
+  }
+
+  return true;
+}
+
+SwapchainHandle NullRenderDevice::RecreateSwapchain(SwapchainHandle swapchain_handle) {
+  TextureUsageFlags usage = GetNullSwapchain(swapchain_handle).usage;
+  DeleteSwapchain(swapchain_handle);
+
+  return CreateSwapchain(usage);
+}
+
+/************************************************************************************************
+ * TEXTURE AND SAMPLER
+ ************************************************************************************************/
+TextureHandle NullRenderDevice::CreateTexture(const TextureSpecification& specification) {
+  assert(specification.width > 0 && specification.height > 0);
+  assert(specification.array_layers <= kTextureMaxLayers);
+
+  TextureHandle handle = GenNextHandle();
+  textures_.emplace(handle, NullTexture{specification});
+  return handle;
+}
+
+void NullRenderDevice::DeleteTexture(TextureHandle handle) {
+  auto it = textures_.find(handle);
+  assert(it != textures_.end());
+  assert(!it->second.swapchain_owned);
+
+  textures_.erase(it);
+}
+
+const TextureSpecification& NullRenderDevice::GetTextureSpecification(TextureHandle handle) {
+  return GetNullTexture(handle).specification;
+}
+
+SamplerHandle NullRenderDevice::CreateSampler(const SamplerSpecification& specification) {
+  SamplerHandle handle = GenNextHandle();
+  samplers_.emplace(handle, NullSampler{specification});
+  return handle;
+}
+
+void NullRenderDevice::DeleteSampler(SamplerHandle handle) {
+  auto it = samplers_.find(handle);
+  assert(it != samplers_.end());
+  samplers_.erase(it);
+}
+
+const SamplerSpecification& NullRenderDevice::GetSamplerSpecification(SamplerHandle handle) {
+  return GetNullSampler(handle).specification;
+}
+
+/************************************************************************************************
+ * DEVICE MEMORY
+ ************************************************************************************************/
+MemoryRequirements NullRenderDevice::GetTextureMemoryRequirements(const TextureSpecification& specification) {
+  constexpr uint64_t kAlignment = 64 * 1024;
+
+  uint64_t layers     = (specification.type == TextureType::kTextureCube) ? 6 : specification.array_layers;
+  uint64_t level_size = static_cast<uint64_t>(specification.width) * specification.height *
+                        GetDataFormatSize(specification.format) * specification.samples * layers;
+
+  /* Each mip level is a quarter of the previous one */
+  uint64_t size = 0;
+  for (uint32_t level = 0; level < specification.mip_levels && level_size > 0; ++level) {
+    size       += level_size;
+    level_size /= 4;
+  }
+
+  MemoryRequirements requirements{};
+  requirements.size             = (size + kAlignment - 1) / kAlignment * kAlignment;
+  requirements.alignment        = kAlignment;
+  requirements.memory_type_bits = 1;
+
+  return requirements;
+}
+
+DeviceMemoryHandle NullRenderDevice::AllocateDeviceMemory(const MemoryRequirements& requirements) {
+  assert(requirements.size > 0);
+  assert(requirements.memory_type_bits & 1);
+
+  DeviceMemoryHandle handle = GenNextHandle();
+  device_memories_.emplace(handle, NullDeviceMemory{requirements});
+  return handle;
+}
+
+void NullRenderDevice::FreeDeviceMemory(DeviceMemoryHandle handle) {
+  auto it = device_memories_.find(handle);
+  assert(it != device_memories_.end());
+
+  device_memories_.erase(it);
+}
+
+TextureHandle NullRenderDevice::CreateTexture(const TextureSpecification& specification, DeviceMemoryHandle memory,
+                                              uint64_t offset) {
+  assert(!specification.cpu_readable);
+
+  auto memory_it = device_memories_.find(memory);
+  assert(memory_it != device_memories_.end());
+
+  MemoryRequirements requirements = GetTextureMemoryRequirements(specification);
+  assert(offset % requirements.alignment == 0);
+  assert(offset + requirements.size <= memory_it->second.requirements.size);
+
+  TextureHandle handle  = CreateTexture(specification);
+  NullTexture&  texture = GetNullTexture(handle);
+  texture.memory        = memory;
+  texture.memory_offset = offset;
+
+  return handle;
+}
+
+bool NullRenderDevice::GetTexturePlacement(TextureHandle handle, DeviceMemoryHandle* memory, uint64_t* offset) {
+  const NullTexture& texture = GetNullTexture(handle);
+  if (!ValidRenderHandle(texture.memory)) {
+    return false;
+  }
+
+  *memory = texture.memory;
+  *offset = texture.memory_offset;
+  return true;
+}
+
+/************************************************************************************************
+ * BUFFER
+ ************************************************************************************************/
+BufferHandle NullRenderDevice::CreateBuffer(uint32_t size, BufferUsageFlags usage, bool dynamic_memory,
+                                            void** map_data) {
+  assert(size > 0);
+
+  NullBuffer buffer{};
+  buffer.usage          = usage;
+  buffer.dynamic_memory = dynamic_memory;
+  buffer.memory.resize(size);
+
+  BufferHandle handle = GenNextHandle();
+  auto [it, inserted] = buffers_.emplace(handle, std::move(buffer));
+  assert(inserted);
+
+  if (dynamic_memory && map_data != nullptr) {
+    *map_data = it->second.memory.data();
+  }
+
+  return handle;
+}
+
+void NullRenderDevice::DeleteBuffer(BufferHandle handle) {
+  auto it = buffers_.find(handle);
+  assert(it != buffers_.end());
+  buffers_.erase(it);
+}
+
+UploadToken NullRenderDevice::LoadBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) {
+  NullBuffer& buffer = GetNullBuffer(handle);
+  assert(offset + size <= buffer.memory.size());
+  assert(data != nullptr);
+
+  std::memcpy(buffer.memory.data() + offset, data, size);
+
+  return kInvalidUploadToken;
+}
+
+void NullRenderDevice::InvalidateBufferMemory(BufferHandle handle, uint32_t offset, uint32_t size) {
+  NullBuffer& buffer = GetNullBuffer(handle);
+  assert(buffer.dynamic_memory);
+  assert(offset + size <= buffer.memory.size());
+}
+
+void NullRenderDevice::FlushBufferMemory(BufferHandle handle, uint32_t offset, uint32_t size) {
+  NullBuffer& buffer = GetNullBuffer(handle);
+  assert(buffer.dynamic_memory);
+  assert(offset + size <= buffer.memory.size());
+}
+
+/************************************************************************************************
+ * DESCRIPTOR SET
+ ************************************************************************************************/
+DescriptorSetLayoutHandle NullRenderDevice::CreateDescriptorSetLayout(const DescriptorSetLayoutInfo& layout_info) {
+  DescriptorSetLayoutHandle handle = GenNextHandle();
+  descriptor_set_layouts_.emplace(handle, NullDescriptorSetLayout{layout_info});
+  return handle;
+}
+
+void NullRenderDevice::DeleteDescriptorSetLayout(DescriptorSetLayoutHandle handle) {
+  auto it = descriptor_set_layouts_.find(handle);
+  assert(it != descriptor_set_layouts_.end());
+  descriptor_set_layouts_.erase(it);
+}
+
+DescriptorSetHandle NullRenderDevice::CreateDescriptorSet(DescriptorSetLayoutHandle layout_handle) {
+  assert(descriptor_set_layouts_.find(layout_handle) != descriptor_set_layouts_.end());
+
+  NullDescriptorSet descriptor_set{};
+  descriptor_set.layout_handle = layout_handle;
+
+  DescriptorSetHandle handle = GenNextHandle();
+  descriptor_sets_.emplace(handle, descriptor_set);
+  return handle;
+}
+
+void NullRenderDevice::DeleteDescriptorSet(DescriptorSetHandle handle) {
+  auto it = descriptor_sets_.find(handle);
+  assert(it != descriptor_sets_.end());
+  descriptor_sets_.erase(it);
+}
+
+void NullRenderDevice::WriteDescriptorUniformBuffer(DescriptorSetHandle descriptor_set, uint32_t /*binding*/,
+                                                    BufferHandle uniform_buffer, uint32_t offset, uint32_t size) {
+  GetNullDescriptorSet(descriptor_set);
+  assert(offset + size <= GetNullBuffer(uniform_buffer).memory.size());
+}
+
+void NullRenderDevice::WriteDescriptorStorageBuffer(DescriptorSetHandle descriptor_set, uint32_t /*binding*/,
+                                                    BufferHandle storage_buffer, uint32_t offset, uint32_t size) {
+  GetNullDescriptorSet(descriptor_set);
+  assert(offset + size <= GetNullBuffer(storage_buffer).memory.size());
+}
+
+void NullRenderDevice::WriteDescriptorInputAttachment(DescriptorSetHandle descriptor_set, uint32_t /*binding_idx*/,
+                                                      TextureHandle texture) {
+  GetNullDescriptorSet(descriptor_set);
+  GetNullTexture(texture);
+}
+
+void NullRenderDevice::WriteDescriptorSampler(DescriptorSetHandle descriptor_set, uint32_t /*binding_idx*/,
+                                              TextureHandle texture, SamplerHandle sampler) {
+  GetNullDescriptorSet(descriptor_set);
+  GetNullTexture(texture);
+  GetNullSampler(sampler);
+}
+
+/************************************************************************************************
+ * RENDER PASS
+ ************************************************************************************************/
+RenderPassHandle NullRenderDevice::CreateRenderPass(const RenderPassDescription& render_pass_description) {
+  RenderPassHandle handle = GenNextHandle();
+  auto [it, inserted] = render_passes_.emplace(handle, NullRenderPass{render_pass_description});
+  it->second.compatibility_hash = CalculateCompatibilityHash(render_pass_description);
+  return handle;
+}
+
+void NullRenderDevice::DeleteRenderPass(RenderPassHandle handle) {
+  auto it = render_passes_.find(handle);
+  assert(it != render_passes_.end());
+  render_passes_.erase(it);
+}
+
+uint64_t NullRenderDevice::GetRenderPassCompatibilityHash(RenderPassHandle handle) {
+  auto it = render_passes_.find(handle);
+  assert(it != render_passes_.end());
+  return it->second.compatibility_hash;
+}
+
+FramebufferHandle NullRenderDevice::CreateFramebuffer(const std::vector<FramebufferAttachment>& attachments,
+                                                      RenderPassHandle compatible_render_pass) {
+  assert(render_passes_.find(compatible_render_pass) != render_passes_.end());
+  assert(attachments.size() == render_passes_.at(compatible_render_pass).description.attachments.size());
+
+  NullFramebuffer framebuffer{};
+  framebuffer.attachments            = attachments;
+  framebuffer.compatible_render_pass = compatible_render_pass;
+
+  FramebufferHandle handle = GenNextHandle();
+  framebuffers_.emplace(handle, std::move(framebuffer));
+  return handle;
+}
+
+void NullRenderDevice::DeleteFramebuffer(FramebufferHandle handle) {
+  auto it = framebuffers_.find(handle);
+  assert(it != framebuffers_.end());
+  framebuffers_.erase(it);
+}
+
+/************************************************************************************************
+ * PIPELINE
+ ************************************************************************************************/
+ShaderModuleHandle NullRenderDevice::CreateShaderModule(ShaderModuleType type, uint32_t binary_size,
+                                                        const uint32_t* binary) {
+  assert(type != ShaderModuleType::kInvalid);
+  assert(binary_size > 0 && binary != nullptr);
+
+  NullShaderModule shader_module{};
+  shader_module.type = type;
+
+  ShaderModuleHandle handle = GenNextHandle();
+  shader_modules_.emplace(handle, shader_module);
+  return handle;
+}
+
+void NullRenderDevice::DeleteShaderModule(ShaderModuleHandle handle) {
+  auto it = shader_modules_.find(handle);
+  assert(it != shader_modules_.end());
+  shader_modules_.erase(it);
+}
+
+PipelineHandle NullRenderDevice::CreatePipeline(const PipelineDescription& description,
+                                                RenderPassHandle compatible_render_pass, uint32_t subpass_idx) {
+  assert(render_passes_.find(compatible_render_pass) != render_passes_.end());
+  assert(subpass_idx < render_passes_.at(compatible_render_pass).description.subpasses.size());
+
+  NullPipeline pipeline{description};
+  pipeline.compatible_render_pass = compatible_render_pass;
+  pipeline.subpass_idx            = subpass_idx;
+
+  PipelineHandle handle = GenNextHandle();
+  pipelines_.emplace(handle, std::move(pipeline));
+  return handle;
+}
+
+PipelineHandle NullRenderDevice::CreateComputePipeline(const ComputePipelineDescription& description) {
+  assert(shader_modules_.find(description.shader_module) != shader_modules_.end());
+  assert(shader_modules_.at(description.shader_module).type == ShaderModuleType::kCompute);
+
+  NullPipeline pipeline{};
+  pipeline.compute = true;
+
+  PipelineHandle handle = GenNextHandle();
+  pipelines_.emplace(handle, std::move(pipeline));
+  return handle;
+}
+
+void NullRenderDevice::DeletePipeline(PipelineHandle handle) {
+  auto it = pipelines_.find(handle);
+  assert(it != pipelines_.end());
+  pipelines_.erase(it);
+}
+
+bool NullRenderDevice::LoadPipelineCache(const std::string_view filename) {
+  return false;
+}
+
+void NullRenderDevice::SavePipelineCache(const std::string_view filename) {}
+
+/************************************************************************************************
+ * UPLOAD
+ ************************************************************************************************/
+UploadToken NullRenderDevice::LoadTextureData(TextureHandle texture, uint32_t size, const void* data,
+                                              bool generate_mipmaps, TextureLayout final_layout) {
+  GetNullTexture(texture);
+  assert(size > 0);
+  assert(data != nullptr);
+
+  return kInvalidUploadToken;
+}
+
+void NullRenderDevice::FlushUploads() {}
+
+bool NullRenderDevice::IsUploadComplete(UploadToken token) {
+  return true;
+}
+
+void NullRenderDevice::WaitForUpload(UploadToken token) {}
+
+/************************************************************************************************
+ * QUERY
+ ************************************************************************************************/
+QueryPoolHandle NullRenderDevice::CreateTimestampQueryPool(uint32_t queries_count) {
+  assert(queries_count > 0);
+
+  QueryPoolHandle handle = GenNextHandle();
+  query_pools_.emplace(handle, NullQueryPool{queries_count});
+  return handle;
+}
+
+void NullRenderDevice::DeleteQueryPool(QueryPoolHandle query_pool) {
+  auto it = query_pools_.find(query_pool);
+  assert(it != query_pools_.end());
+  query_pools_.erase(it);
+}
+
+bool NullRenderDevice::GetTimestamps(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count,
+                                     uint64_t* timestamps) {
+  auto it = query_pools_.find(query_pool);
+  assert(it != query_pools_.end());
+  assert(first_query + count <= it->second.queries_count);
+
+  std::fill(timestamps, timestamps + count, 0);
+  return true;
+}
+
+/************************************************************************************************
+ * COMMAND BUFFER
+ ************************************************************************************************/
+CommandBuffer* NullRenderDevice::CreateCommandBuffer(CommandBufferType type, bool temporary) {
+  assert(type != CommandBufferType::kInvalid);
+  return new NullCommandBuffer(type, *this, temporary);
+}
+
+void NullRenderDevice::DeleteCommandBuffer(CommandBuffer* command_buffer) {
+  assert(command_buffer);
+  delete command_buffer;
+}
+
+NullTexture& NullRenderDevice::GetNullTexture(TextureHandle handle) {
+  auto it = textures_.find(handle);
+  assert(it != textures_.end());
+  return it->second;
+}
+
+NullSampler& NullRenderDevice::GetNullSampler(SamplerHandle handle) {
+  auto it = samplers_.find(handle);
+  assert(it != samplers_.end());
+  return it->second;
+}
+
+NullBuffer& NullRenderDevice::GetNullBuffer(BufferHandle handle) {
+  auto it = buffers_.find(handle);
+  assert(it != buffers_.end());
+  return it->second;
+}
+
+NullDescriptorSet& NullRenderDevice::GetNullDescriptorSet(DescriptorSetHandle handle) {
+  auto it = descriptor_sets_.find(handle);
+  assert(it != descriptor_sets_.end());
+  return it->second;
+}
+
+NullSwapchain& NullRenderDevice::GetNullSwapchain(SwapchainHandle handle) {
+  auto it = swapchains_.find(handle);
+  assert(it != swapchains_.end());
+  return it->second;
+}
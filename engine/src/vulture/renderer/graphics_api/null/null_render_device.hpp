@@ -0,0 +1,342 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file null_render_device.hpp
+ * @date 2023-06-14
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <map>
+
+#include <vulture/renderer/graphics_api/render_device.hpp>
+
+namespace vulture {
+
+struct NullTexture {
+  NullTexture() = default;
+  NullTexture(const TextureSpecification& specification) : specification(specification) {}
+
+  TextureSpecification specification{};
+  bool                 swapchain_owned{false};
+  DeviceMemoryHandle   memory{kInvalidRenderResourceHandle};  ///< Memory the texture is placed in, if any
+  uint64_t             memory_offset{0};
+};
+
+struct NullDeviceMemory {
+  MemoryRequirements requirements{};
+};
+
+struct NullSampler {
+  NullSampler() = default;
+  NullSampler(const SamplerSpecification& specification) : specification(specification) {}
+
+  SamplerSpecification specification{};
+};
+
+struct NullBuffer {
+  BufferUsageFlags usage{0};
+  bool             dynamic_memory{false};
+  Vector<uint8_t>  memory;  ///< Host copy of the buffer's contents
+};
+
+struct NullDescriptorSetLayout {
+  NullDescriptorSetLayout() = default;
+  NullDescriptorSetLayout(const DescriptorSetLayoutInfo& layout_info) : layout_info(layout_info) {}
+
+  DescriptorSetLayoutInfo layout_info{};
+};
+
+struct NullDescriptorSet {
+  DescriptorSetLayoutHandle layout_handle{kInvalidRenderResourceHandle};  // Not owned by the set
+};
+
+struct NullRenderPass {
+  NullRenderPass() = default;
+  NullRenderPass(const RenderPassDescription& description) : description(description) {}
+
+  RenderPassDescription description{};
+  uint64_t              compatibility_hash{0};
+};
+
+struct NullFramebuffer {
+  Vector<FramebufferAttachment> attachments;
+  RenderPassHandle              compatible_render_pass{kInvalidRenderResourceHandle};
+};
+
+struct NullShaderModule {
+  ShaderModuleType type{ShaderModuleType::kInvalid};
+};
+
+struct NullPipeline {
+  NullPipeline() = default;
+  NullPipeline(const PipelineDescription& description) : description(description) {}
+
+  PipelineDescription description{};
+  RenderPassHandle    compatible_render_pass{kInvalidRenderResourceHandle};
+  uint32_t            subpass_idx{0};
+  bool                compute{false};
+};
+
+struct NullQueryPool {
+  uint32_t queries_count{0};
+};
+
+struct NullSwapchain {
+  TextureUsageFlags     usage{0};
+  uint32_t              current_texture_idx{0};
+  Vector<TextureHandle> textures;
+};
+
+/**
+ * @brief Headless render device, which doesn't talk to any graphics API.
+ *
+ * Keeps track of all created resources (so that handles and specifications behave exactly like with a real device),
+ * but never executes anything. Command buffers created by the device are @ref{NullCommandBuffer}s, which record all
+ * commands into a command stream.
+ *
+ * @note The window passed to @ref{Init} can be nullptr, in which case swapchain textures are of the size set by
+ *       @ref{SetSwapchainExtent}.
+ */
+class NullRenderDevice final : public RenderDevice {
+ public:
+  static constexpr uint32_t kSwapchainTexturesCount = 3;
+  static constexpr uint32_t kDefaultSwapchainWidth  = 1920;
+  static constexpr uint32_t kDefaultSwapchainHeight = 1080;
+
+ public:
+  NullRenderDevice();
+  ~NullRenderDevice() override;
+
+  void SetSwapchainExtent(uint32_t width, uint32_t height);
+
+  void WaitIdle() override;
+
+  uint32_t CurrentFrame() const override;
+
+  void FrameBegin() override;
+  void FrameEnd() override;
+
+  /**
+   * @brief Always true, so that the graphics and compute queue submissions can be inspected separately.
+   */
+  bool SupportsAsyncCompute() const override;
+
+  /**
+   * @brief Always true, so that transient attachments are created the same way as on tile-based GPUs.
+   */
+  bool SupportsLazilyAllocatedMemory() const override;
+
+  /************************************************************************************************
+   * INIT
+   ************************************************************************************************/
+  void Init(Window* window, const DeviceFeatures* required_features, const DeviceProperties* required_properties,
+            bool enable_validation) override;
+
+  DeviceFeatures GetDeviceFeatures() override;
+  DeviceProperties GetDeviceProperties() override;
+
+  /************************************************************************************************
+   * SYNCHRONIZATION
+   ************************************************************************************************/
+  FenceHandle CreateFence() override;
+  void DeleteFence(FenceHandle fence) override;
+
+  void WaitForFences(uint32_t count, const FenceHandle* fences) override;
+  void ResetFence(FenceHandle fence) override;
+
+  SemaphoreHandle CreateSemaphore() override;
+  void DeleteSemaphore(SemaphoreHandle semaphore) override;
+
+  /************************************************************************************************
+   * SWAPCHAIN
+   ************************************************************************************************/
+  SwapchainHandle CreateSwapchain(TextureUsageFlags usage) override;
+  void DeleteSwapchain(SwapchainHandle swapchain) override;
+
+  void GetSwapchainTextures(SwapchainHandle swapchain, uint32_t* textures_count, TextureHandle* textures) override;
+
+  bool AcquireNextTexture(SwapchainHandle swapchain, uint32_t* texture_idx, SemaphoreHandle signal_semaphore,
+                          FenceHandle signal_fence) override;
+
+  bool Present(SwapchainHandle swapchain, SemaphoreHandle wait_semaphore) override;
+
+  SwapchainHandle RecreateSwapchain(SwapchainHandle swapchain) override;
+
+  /************************************************************************************************
+   * TEXTURE AND SAMPLER
+   ************************************************************************************************/
+  TextureHandle CreateTexture(const TextureSpecification& specification) override;
+  void DeleteTexture(TextureHandle texture) override;
+
+  const TextureSpecification& GetTextureSpecification(TextureHandle texture) override;
+
+  SamplerHandle CreateSampler(const SamplerSpecification& specification) override;
+  void DeleteSampler(SamplerHandle sampler) override;
+
+  const SamplerSpecification& GetSamplerSpecification(SamplerHandle sampler) override;
+
+  /************************************************************************************************
+   * DEVICE MEMORY
+   ************************************************************************************************/
+  MemoryRequirements GetTextureMemoryRequirements(const TextureSpecification& specification) override;
+
+  DeviceMemoryHandle AllocateDeviceMemory(const MemoryRequirements& requirements) override;
+  void FreeDeviceMemory(DeviceMemoryHandle memory) override;
+
+  TextureHandle CreateTexture(const TextureSpecification& specification, DeviceMemoryHandle memory,
+                              uint64_t offset) override;
+
+  /**
+   * @brief Get the memory the texture has been placed in, e.g. to check which textures alias.
+   * @return false If the texture has been created without an explicit memory.
+   */
+  bool GetTexturePlacement(TextureHandle texture, DeviceMemoryHandle* memory, uint64_t* offset);
+
+  /************************************************************************************************
+   * BUFFER
+   ************************************************************************************************/
+  BufferHandle CreateBuffer(uint32_t size, BufferUsageFlags usage, bool dynamic_memory, void** map_data) override;
+  void DeleteBuffer(BufferHandle buffer) override;
+
+  /**
+   * @note Data is always written right away, so returns kInvalidUploadToken.
+   */
+  UploadToken LoadBufferData(BufferHandle buffer, uint32_t offset, uint32_t size, const void* data) override;
+
+  void InvalidateBufferMemory(BufferHandle buffer, uint32_t offset, uint32_t size) override;
+  void FlushBufferMemory(BufferHandle buffer, uint32_t offset, uint32_t size) override;
+
+  /************************************************************************************************
+   * DESCRIPTOR SET
+   ************************************************************************************************/
+  DescriptorSetLayoutHandle CreateDescriptorSetLayout(const DescriptorSetLayoutInfo& layout_info) override;
+  void DeleteDescriptorSetLayout(DescriptorSetLayoutHandle layout) override;
+
+  DescriptorSetHandle CreateDescriptorSet(DescriptorSetLayoutHandle layout) override;
+  void DeleteDescriptorSet(DescriptorSetHandle descriptor_set) override;
+
+  void WriteDescriptorUniformBuffer(DescriptorSetHandle descriptor_set, uint32_t binding, BufferHandle uniform_buffer,
+                                    uint32_t offset, uint32_t size) override;
+  void WriteDescriptorStorageBuffer(DescriptorSetHandle descriptor_set, uint32_t binding, BufferHandle storage_buffer,
+                                    uint32_t offset, uint32_t size) override;
+
+  void WriteDescriptorInputAttachment(DescriptorSetHandle descriptor_set, uint32_t binding_idx,
+                                      TextureHandle texture) override;
+  void WriteDescriptorSampler(DescriptorSetHandle descriptor_set, uint32_t binding_idx, TextureHandle texture,
+                              SamplerHandle sampler) override;
+
+  /************************************************************************************************
+   * RENDER PASS
+   ************************************************************************************************/
+  RenderPassHandle CreateRenderPass(const RenderPassDescription& render_pass_description) override;
+  void DeleteRenderPass(RenderPassHandle render_pass) override;
+  uint64_t GetRenderPassCompatibilityHash(RenderPassHandle render_pass) override;
+
+  FramebufferHandle CreateFramebuffer(const std::vector<FramebufferAttachment>& attachments,
+                                      RenderPassHandle compatible_render_pass) override;
+  void DeleteFramebuffer(FramebufferHandle framebuffer) override;
+
+  /************************************************************************************************
+   * PIPELINE
+   ************************************************************************************************/
+  ShaderModuleHandle CreateShaderModule(ShaderModuleType type, uint32_t binary_size, const uint32_t* binary) override;
+  void DeleteShaderModule(ShaderModuleHandle shader_module) override;
+
+  PipelineHandle CreatePipeline(const PipelineDescription& description, RenderPassHandle compatible_render_pass,
+                                uint32_t subpass_idx) override;
+  PipelineHandle CreateComputePipeline(const ComputePipelineDescription& description) override;
+  void DeletePipeline(PipelineHandle pipeline) override;
+
+  bool LoadPipelineCache(const std::string_view filename) override;
+  void SavePipelineCache(const std::string_view filename) override;
+
+  /************************************************************************************************
+   * UPLOAD
+   ************************************************************************************************/
+  /**
+   * @note Texture memory isn't stored, so nothing is uploaded and kInvalidUploadToken is returned.
+   */
+  UploadToken LoadTextureData(TextureHandle texture, uint32_t size, const void* data, bool generate_mipmaps,
+                              TextureLayout final_layout) override;
+
+  void FlushUploads() override;
+  bool IsUploadComplete(UploadToken token) override;
+  void WaitForUpload(UploadToken token) override;
+
+  /************************************************************************************************
+   * QUERY
+   ************************************************************************************************/
+  QueryPoolHandle CreateTimestampQueryPool(uint32_t queries_count) override;
+  void DeleteQueryPool(QueryPoolHandle query_pool) override;
+
+  /**
+   * @note Nothing is executed, so all timestamps are always available and equal to zero.
+   */
+  bool GetTimestamps(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count, uint64_t* timestamps) override;
+
+  /************************************************************************************************
+   * COMMAND BUFFER
+   ************************************************************************************************/
+  CommandBuffer* CreateCommandBuffer(CommandBufferType type, bool temporary) override;
+  void DeleteCommandBuffer(CommandBuffer* command_buffer) override;
+
+ private:
+  uint32_t GenNextHandle();
+
+  NullTexture&             GetNullTexture(TextureHandle);
+  NullSampler&             GetNullSampler(SamplerHandle);
+  NullBuffer&              GetNullBuffer(BufferHandle);
+  NullDescriptorSet&       GetNullDescriptorSet(DescriptorSetHandle);
+  NullSwapchain&           GetNullSwapchain(SwapchainHandle);
+
+  void CreateSwapchainTextures(NullSwapchain& swapchain);
+
+ private:
+  Window*  window_{nullptr};
+  uint32_t swapchain_width_{kDefaultSwapchainWidth};
+  uint32_t swapchain_height_{kDefaultSwapchainHeight};
+
+  bool     frame_began_{false};
+  uint32_t current_frame_{0};
+
+  uint32_t next_handle_{1};
+  std::map<FenceHandle, bool>                                  fences_;  ///< Whether the fence is signaled
+  std::map<SemaphoreHandle, bool>                              semaphores_;
+  std::map<SwapchainHandle, NullSwapchain>                     swapchains_;
+  std::map<TextureHandle, NullTexture>                         textures_;
+  std::map<SamplerHandle, NullSampler>                         samplers_;
+  std::map<DeviceMemoryHandle, NullDeviceMemory>               device_memories_;
+  std::map<BufferHandle, NullBuffer>                           buffers_;
+  std::map<DescriptorSetLayoutHandle, NullDescriptorSetLayout> descriptor_set_layouts_;
+  std::map<DescriptorSetHandle, NullDescriptorSet>             descriptor_sets_;
+  std::map<RenderPassHandle, NullRenderPass>                   render_passes_;
+  std::map<FramebufferHandle, NullFramebuffer>                 framebuffers_;
+  std::map<ShaderModuleHandle, NullShaderModule>               shader_modules_;
+  std::map<PipelineHandle, NullPipeline>                       pipelines_;
+  std::map<QueryPoolHandle, NullQueryPool>                     query_pools_;
+
+  friend class NullCommandBuffer;
+};
+
+}  // namespace vulture
@@ -0,0 +1,83 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file pipeline.cpp
+ * @date 2023-06-30
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/core/hash.hpp>
+#include <vulture/renderer/graphics_api/pipeline.hpp>
+
+namespace vulture {
+
+uint64_t CalculateStateHash(const PipelineDescription& description) {
+  uint64_t hash = 0;
+
+  HashCombine(hash, description.input_vertex_data_info != nullptr);
+  if (description.input_vertex_data_info != nullptr) {
+    const auto& bindings = description.input_vertex_data_info->bindings;
+
+    HashCombine(hash, bindings.size());
+    for (const auto& binding : bindings) {
+      HashCombine(hash, binding.binding_slot);
+      HashCombine(hash, binding.stride);
+
+      HashCombine(hash, binding.attributes_info.size());
+      for (const auto& attribute : binding.attributes_info) {
+        HashCombine(hash, attribute.location);
+        HashCombine(hash, static_cast<uint64_t>(attribute.format));
+        HashCombine(hash, attribute.offset);
+      }
+    }
+  }
+
+  HashCombine(hash, static_cast<uint64_t>(description.input_assembly_info.topology));
+
+  HashCombine(hash, description.push_constant_ranges_count);
+  for (uint32_t i = 0; i < description.push_constant_ranges_count; ++i) {
+    HashCombine(hash, description.push_constant_ranges[i].offset);
+    HashCombine(hash, description.push_constant_ranges[i].size);
+    HashCombine(hash, description.push_constant_ranges[i].shader_stages);
+  }
+
+  HashCombine(hash, static_cast<uint64_t>(description.rasterization_info.cull_mode));
+  HashCombine(hash, static_cast<uint64_t>(description.rasterization_info.front_face));
+  HashCombine(hash, static_cast<uint64_t>(description.rasterization_info.polygon_mode));
+
+  HashCombine(hash, description.depth_test_description.test_enable);
+  HashCombine(hash, description.depth_test_description.write_enable);
+  HashCombine(hash, static_cast<uint64_t>(description.depth_test_description.compare_op));
+
+  const auto& blend = description.blend_description;
+  HashCombine(hash, blend.enable);
+  HashCombine(hash, static_cast<uint64_t>(blend.src_color_blend_factor));
+  HashCombine(hash, static_cast<uint64_t>(blend.dst_color_blend_factor));
+  HashCombine(hash, static_cast<uint64_t>(blend.color_blend_op));
+  HashCombine(hash, static_cast<uint64_t>(blend.src_alpha_blend_factor));
+  HashCombine(hash, static_cast<uint64_t>(blend.dst_alpha_blend_factor));
+  HashCombine(hash, static_cast<uint64_t>(blend.alpha_blend_op));
+
+  return hash;
+}
+
+}  // namespace vulture
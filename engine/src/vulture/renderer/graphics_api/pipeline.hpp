@@ -78,8 +78,14 @@ enum PipelineStageBit : uint32_t {
    */
   kPipelineStageBitColorAttachmentOutput = 0x0000'0400,
 
+  /** @brief Compute shader stage */
+  kPipelineStageBitComputeShader = 0x0000'0800,
+
   /** @brief Specifies all copy commands */
-  kPipelineStageBitTransfer = 0x0000'1000
+  kPipelineStageBitTransfer = 0x0000'1000,
+
+  /** @brief All commands supported on the queue */
+  kPipelineStageBitAllCommands = 0x0001'0000
 };
 
 using PipelineStageFlags = uint32_t;
@@ -282,4 +288,23 @@ struct PipelineDescription {
   ColorAttachmentsBlendDescription blend_description{};
 };
 
+/**
+ * @brief Hash of the fixed-function state and the push constant ranges. Shader modules and descriptor set layouts are
+ *        left out, as only the device knows their contents, which identical pipelines share, unlike the handles.
+ */
+uint64_t CalculateStateHash(const PipelineDescription& description);
+
+/**
+ * @brief Compute pipeline, which unlike the graphics one is not bound to any render pass.
+ */
+struct ComputePipelineDescription {
+  uint32_t                  descriptor_sets_count{0};
+  DescriptorSetLayoutHandle descriptor_set_layouts[kMaxPipelineDescriptorSets]{kInvalidRenderResourceHandle};
+
+  uint32_t                  push_constant_ranges_count{0};
+  PushConstantRange         push_constant_ranges[kMaxPipelinePushConstantRanges];
+
+  ShaderModuleHandle        shader_module{kInvalidRenderResourceHandle};
+};
+
 }  // namespace vulture
@@ -25,6 +25,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
 #include <vulture/renderer/graphics_api/render_device.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_render_device.hpp>
 
@@ -33,6 +34,7 @@ using namespace vulture;
 RenderDevice* RenderDevice::Create(DeviceFamily family) {
   switch (family) {
     case DeviceFamily::kVulkan: { return new VulkanRenderDevice{}; }
+    case DeviceFamily::kNull:   { return new NullRenderDevice{}; }
   }
 
   return nullptr;
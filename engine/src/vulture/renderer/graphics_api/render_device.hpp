@@ -36,6 +36,8 @@
 #include <vulture/renderer/graphics_api/shader_module.hpp>
 #include <vulture/renderer/graphics_api/texture.hpp>
 
+#include <string_view>
+
 namespace vulture {
 
 constexpr uint32_t kFramesInFlight = 2;
@@ -57,6 +59,22 @@ struct PerFrameData {
   size_t size() const { return kFramesInFlight; }
 };
 
+/**
+ * @brief Requirements for the device memory of a resource.
+ */
+struct MemoryRequirements {
+  uint64_t size             {0};
+  uint64_t alignment        {1};
+  uint32_t memory_type_bits {0};  ///< Memory types (device specific) the resource can be placed in
+};
+
+/**
+ * @brief Identifies a batch of uploads (see @ref{RenderDevice::LoadBufferData}), tokens only ever increase, so waiting
+ *        for a token also waits for all the uploads issued before it.
+ */
+using UploadToken = uint64_t;
+constexpr UploadToken kInvalidUploadToken = 0;  ///< Already completed upload
+
 class Window;
 
 /**
@@ -71,7 +89,7 @@ class Window;
  */
 class RenderDevice {
  public:
-  enum class DeviceFamily {kVulkan, /*kOpenGL*/ /*kMetal*/};
+  enum class DeviceFamily {kVulkan, kNull, /*kOpenGL*/ /*kMetal*/};
 
   virtual void WaitIdle() = 0;
 
@@ -79,6 +97,20 @@ class RenderDevice {
 
   virtual void FrameBegin() = 0;
   virtual void FrameEnd() = 0;
+
+  /**
+   * @brief Whether the device has a dedicated compute queue (from a queue family without graphics support), so that
+   *        CommandBufferType::kCompute command buffers run asynchronously to the graphics ones.
+   *
+   * Otherwise kCompute command buffers are submitted to the graphics queue.
+   */
+  virtual bool SupportsAsyncCompute() const = 0;
+
+  /**
+   * @brief Whether the device has lazily allocated memory (usually tile-based GPUs), which backs textures with the
+   *        kTextureUsageBitTransientAttachment usage, so that they may never take any actual memory.
+   */
+  virtual bool SupportsLazilyAllocatedMemory() const = 0;
   
   /************************************************************************************************
    * INIT
@@ -164,6 +196,35 @@ class RenderDevice {
 
   virtual const SamplerSpecification& GetSamplerSpecification(SamplerHandle sampler) = 0;
 
+  /************************************************************************************************
+   * DEVICE MEMORY
+   ************************************************************************************************/
+  /**
+   * @brief Requirements for the memory of a texture with the specification.
+   */
+  virtual MemoryRequirements GetTextureMemoryRequirements(const TextureSpecification& specification) = 0;
+
+  /**
+   * @brief Allocate device-local memory satisfying the requirements, in which textures can be placed.
+   */
+  virtual DeviceMemoryHandle AllocateDeviceMemory(const MemoryRequirements& requirements) = 0;
+
+  /**
+   * @warning All textures placed in the memory must not be used after freeing it.
+   */
+  virtual void FreeDeviceMemory(DeviceMemoryHandle memory) = 0;
+
+  /**
+   * @brief Create a texture placed in the memory at the offset, the texture doesn't own the memory.
+   *
+   * Textures, which are never used at the same time, can be placed in overlapping memory ranges (i.e. aliased).
+   * Contents of such a texture are undefined at the beginning of its use.
+   *
+   * @param offset Must satisfy the alignment returned by @ref{GetTextureMemoryRequirements}.
+   */
+  virtual TextureHandle CreateTexture(const TextureSpecification& specification, DeviceMemoryHandle memory,
+                                      uint64_t offset) = 0;
+
   /************************************************************************************************
    * BUFFER
    ************************************************************************************************/
@@ -247,17 +308,23 @@ class RenderDevice {
 
   /**
    * @brief Update region of the buffer's memory.
+   *
+   * Dynamic buffers are written right away. For static ones the data is copied to a staging memory and the transfer
+   * is recorded into the current upload batch, so the function returns immediately (see the UPLOAD section). The
+   * transfer is guaranteed to happen before any command buffer submitted afterwards.
    * 
    * @param buffer 
    * @param offset 
    * @param size 
    * @param data 
+   *
+   * @return Token of the upload batch, or kInvalidUploadToken if the data has already been written.
    */
-  virtual void LoadBufferData(BufferHandle buffer, uint32_t offset, uint32_t size, const void* data) = 0;
+  virtual UploadToken LoadBufferData(BufferHandle buffer, uint32_t offset, uint32_t size, const void* data) = 0;
 
   template <typename T>
-  void LoadBufferData(BufferHandle buffer, uint32_t offset_idx, uint32_t count, const T* data) {
-    LoadBufferData(buffer, offset_idx * sizeof(T), count * sizeof(T), reinterpret_cast<const void*>(data));
+  UploadToken LoadBufferData(BufferHandle buffer, uint32_t offset_idx, uint32_t count, const T* data) {
+    return LoadBufferData(buffer, offset_idx * sizeof(T), count * sizeof(T), reinterpret_cast<const void*>(data));
   }
 
   /**
@@ -321,6 +388,11 @@ class RenderDevice {
   virtual RenderPassHandle CreateRenderPass(const RenderPassDescription& render_pass_description) = 0;
   virtual void DeleteRenderPass(RenderPassHandle render_pass) = 0;
 
+  /**
+   * @brief Pipelines created for a render pass can be used with any other one that has the same compatibility hash.
+   */
+  virtual uint64_t GetRenderPassCompatibilityHash(RenderPassHandle render_pass) = 0;
+
   virtual FramebufferHandle CreateFramebuffer(const std::vector<FramebufferAttachment>& attachments,
                                               RenderPassHandle compatible_render_pass) = 0;
   virtual void DeleteFramebuffer(FramebufferHandle framebuffer) = 0;
@@ -335,8 +407,76 @@ class RenderDevice {
   virtual PipelineHandle CreatePipeline(const PipelineDescription& description,
                                         RenderPassHandle compatible_render_pass,
                                         uint32_t subpass_idx) = 0;
+  virtual PipelineHandle CreateComputePipeline(const ComputePipelineDescription& description) = 0;
   virtual void DeletePipeline(PipelineHandle pipeline) = 0;
 
+  /**
+   * @brief Load the pipeline cache saved by @ref{SavePipelineCache}, so that the pipelines created during the previous
+   *        runs don't need their shaders to be compiled again.
+   *
+   * The cache is discarded if it has been saved on a different device or driver version.
+   *
+   * @return Whether the cache has been loaded.
+   */
+  virtual bool LoadPipelineCache(const std::string_view filename) = 0;
+  virtual void SavePipelineCache(const std::string_view filename) = 0;
+
+  /************************************************************************************************
+   * UPLOAD
+   ************************************************************************************************/
+  /**
+   * @brief Upload the texture's base mip level, then transition it to the final_layout.
+   *
+   * Same as @ref{LoadBufferData}, the function returns immediately and the upload is batched.
+   *
+   * @param texture          Texture in the kUndefined layout.
+   * @param size             Size of the data in bytes.
+   * @param data             Tightly packed texels of all the layers, one layer after another.
+   * @param generate_mipmaps Whether to generate the rest of the mip levels from the base one.
+   * @param final_layout
+   *
+   * @return Token of the upload batch.
+   */
+  virtual UploadToken LoadTextureData(TextureHandle texture, uint32_t size, const void* data,
+                                      bool generate_mipmaps = true,
+                                      TextureLayout final_layout = TextureLayout::kShaderReadOnly) = 0;
+
+  /**
+   * @brief Submit the current upload batch, doesn't wait for it.
+   *
+   * @note Called implicitly before any command buffer submission and when the staging memory runs out.
+   */
+  virtual void FlushUploads() = 0;
+
+  /**
+   * @brief Whether all the uploads up to and including the token's batch have been completed by the GPU.
+   */
+  virtual bool IsUploadComplete(UploadToken token) = 0;
+
+  /**
+   * @brief Wait until all the uploads up to and including the token's batch are completed, submitting it if needed.
+   */
+  virtual void WaitForUpload(UploadToken token) = 0;
+
+  /************************************************************************************************
+   * QUERY
+   ************************************************************************************************/
+  /**
+   * @brief Create a pool of timestamp queries, which are written by @ref{CommandBuffer::CmdWriteTimestamp}.
+   *
+   * @note Queries must be reset by @ref{CommandBuffer::CmdResetQueryPool} before the first write.
+   */
+  virtual QueryPoolHandle CreateTimestampQueryPool(uint32_t queries_count) = 0;
+  virtual void DeleteQueryPool(QueryPoolHandle query_pool) = 0;
+
+  /**
+   * @brief Get timestamps in nanoseconds of the queries [first_query, first_query + count), doesn't wait for them.
+   *
+   * @return Whether all the queries are available, in which case timestamps are written.
+   */
+  virtual bool GetTimestamps(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count,
+                             uint64_t* timestamps) = 0;
+
   /************************************************************************************************
    * COMMAND BUFFER
    ************************************************************************************************/
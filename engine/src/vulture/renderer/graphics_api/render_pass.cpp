@@ -0,0 +1,157 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file render_pass.cpp
+ * @date 2023-06-25
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/core/hash.hpp>
+#include <vulture/renderer/graphics_api/render_pass.hpp>
+
+using namespace vulture;
+
+namespace {
+
+void HashAttachmentReference(uint64_t& hash, const AttachmentReference& reference, bool with_layout = true) {
+  HashCombine(hash, reference.attachment_idx);
+
+  if (with_layout) {
+    HashCombine(hash, static_cast<uint64_t>(reference.layout));
+  }
+}
+
+void HashSubpasses(uint64_t& hash, const std::vector<SubpassDescription>& subpasses, bool with_layouts) {
+  HashCombine(hash, subpasses.size());
+  for (const auto& subpass : subpasses) {
+    HashCombine(hash, static_cast<uint64_t>(subpass.bind_point));
+
+    HashCombine(hash, subpass.color_attachments.size());
+    for (const auto& reference : subpass.color_attachments) {
+      HashAttachmentReference(hash, reference, with_layouts);
+    }
+
+    HashCombine(hash, subpass.resolve_attachments.size());
+    for (const auto& reference : subpass.resolve_attachments) {
+      HashAttachmentReference(hash, reference, with_layouts);
+    }
+
+    HashCombine(hash, subpass.depth_stencil_attachment.has_value());
+    if (subpass.depth_stencil_attachment.has_value()) {
+      HashAttachmentReference(hash, *subpass.depth_stencil_attachment, with_layouts);
+    }
+
+    HashCombine(hash, subpass.input_attachments.size());
+    for (const auto& reference : subpass.input_attachments) {
+      HashAttachmentReference(hash, reference, with_layouts);
+    }
+
+    HashCombine(hash, subpass.preserve_attachments.size());
+    for (uint32_t attachment_idx : subpass.preserve_attachments) {
+      HashCombine(hash, attachment_idx);
+    }
+  }
+}
+
+void HashSubpassDependencies(uint64_t& hash, const std::vector<SubpassDependency>& dependencies) {
+  HashCombine(hash, dependencies.size());
+  for (const auto& dependency : dependencies) {
+    HashCombine(hash, dependency.dependency_subpass_idx);
+    HashCombine(hash, dependency.dependent_subpass_idx);
+    HashCombine(hash, dependency.dependency_stage_mask);
+    HashCombine(hash, dependency.dependent_stage_mask);
+    HashCombine(hash, dependency.dependency_access_mask);
+    HashCombine(hash, dependency.dependent_access_mask);
+    HashCombine(hash, dependency.by_region);
+  }
+}
+
+}  // namespace
+
+namespace vulture {
+
+bool operator==(const AttachmentDescription& lhs, const AttachmentDescription& rhs) {
+  return lhs.format == rhs.format && lhs.samples == rhs.samples && lhs.load_op == rhs.load_op &&
+         lhs.store_op == rhs.store_op && lhs.initial_layout == rhs.initial_layout &&
+         lhs.final_layout == rhs.final_layout;
+}
+
+bool operator==(const AttachmentReference& lhs, const AttachmentReference& rhs) {
+  return lhs.attachment_idx == rhs.attachment_idx && lhs.layout == rhs.layout;
+}
+
+bool operator==(const SubpassDescription& lhs, const SubpassDescription& rhs) {
+  return lhs.bind_point == rhs.bind_point && lhs.color_attachments == rhs.color_attachments &&
+         lhs.resolve_attachments == rhs.resolve_attachments &&
+         lhs.depth_stencil_attachment == rhs.depth_stencil_attachment &&
+         lhs.input_attachments == rhs.input_attachments && lhs.preserve_attachments == rhs.preserve_attachments;
+}
+
+bool operator==(const SubpassDependency& lhs, const SubpassDependency& rhs) {
+  return lhs.dependency_subpass_idx == rhs.dependency_subpass_idx &&
+         lhs.dependent_subpass_idx == rhs.dependent_subpass_idx &&
+         lhs.dependency_stage_mask == rhs.dependency_stage_mask &&
+         lhs.dependent_stage_mask == rhs.dependent_stage_mask &&
+         lhs.dependency_access_mask == rhs.dependency_access_mask &&
+         lhs.dependent_access_mask == rhs.dependent_access_mask && lhs.by_region == rhs.by_region;
+}
+
+bool operator==(const RenderPassDescription& lhs, const RenderPassDescription& rhs) {
+  return lhs.attachments == rhs.attachments && lhs.subpasses == rhs.subpasses &&
+         lhs.subpass_dependencies == rhs.subpass_dependencies;
+}
+
+uint64_t CalculateHash(const RenderPassDescription& description) {
+  uint64_t hash = 0;
+
+  HashCombine(hash, description.attachments.size());
+  for (const auto& attachment : description.attachments) {
+    HashCombine(hash, static_cast<uint64_t>(attachment.format));
+    HashCombine(hash, attachment.samples);
+    HashCombine(hash, static_cast<uint64_t>(attachment.load_op));
+    HashCombine(hash, static_cast<uint64_t>(attachment.store_op));
+    HashCombine(hash, static_cast<uint64_t>(attachment.initial_layout));
+    HashCombine(hash, static_cast<uint64_t>(attachment.final_layout));
+  }
+
+  HashSubpasses(hash, description.subpasses, /*with_layouts=*/true);
+  HashSubpassDependencies(hash, description.subpass_dependencies);
+
+  return hash;
+}
+
+uint64_t CalculateCompatibilityHash(const RenderPassDescription& description) {
+  uint64_t hash = 0;
+
+  HashCombine(hash, description.attachments.size());
+  for (const auto& attachment : description.attachments) {
+    HashCombine(hash, static_cast<uint64_t>(attachment.format));
+    HashCombine(hash, attachment.samples);
+  }
+
+  HashSubpasses(hash, description.subpasses, /*with_layouts=*/false);
+  HashSubpassDependencies(hash, description.subpass_dependencies);
+
+  return hash;
+}
+
+}  // namespace vulture
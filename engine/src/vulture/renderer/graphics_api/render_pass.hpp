@@ -83,6 +83,11 @@ struct SubpassDescription {
   std::vector<uint32_t> preserve_attachments;
 };
 
+/**
+ * @brief Subpass index referring to the commands before (or after) the render pass in a SubpassDependency.
+ */
+constexpr uint32_t kSubpassExternal = ~0U;
+
 struct SubpassDependency {
   uint32_t                    dependency_subpass_idx {0};
   uint32_t                    dependent_subpass_idx  {0};
@@ -92,6 +97,9 @@ struct SubpassDependency {
 
   MemoryAccessDependencyFlags dependency_access_mask {kMemoryAccessBitNone};
   MemoryAccessDependencyFlags dependent_access_mask  {kMemoryAccessBitNone};
+
+  /** @brief Framebuffer-local dependency, i.e. only on the same pixel, which tile-based GPUs keep on chip. */
+  bool                        by_region              {false};
 };
 
 /* Clear Value */
@@ -128,6 +136,24 @@ struct RenderPassDescription {
   std::vector<SubpassDependency>     subpass_dependencies;
 };
 
+bool operator==(const AttachmentDescription& lhs, const AttachmentDescription& rhs);
+bool operator==(const AttachmentReference& lhs, const AttachmentReference& rhs);
+bool operator==(const SubpassDescription& lhs, const SubpassDescription& rhs);
+bool operator==(const SubpassDependency& lhs, const SubpassDependency& rhs);
+bool operator==(const RenderPassDescription& lhs, const RenderPassDescription& rhs);
+
+/**
+ * @brief Hash of the whole description, which is everything a render pass is created from. Extents and attached
+ *        textures are only specified by framebuffers, so render passes can be reused when these change.
+ */
+uint64_t CalculateHash(const RenderPassDescription& description);
+
+/**
+ * @brief Hash of what makes render passes compatible, i.e. everything except the load and store operations and the
+ *        layouts. A pipeline created for a render pass can be used with any compatible one.
+ */
+uint64_t CalculateCompatibilityHash(const RenderPassDescription& description);
+
 /* Framebuffer */
 struct FramebufferAttachment {
   TextureHandle texture{kInvalidRenderResourceHandle};
@@ -40,6 +40,7 @@ using SemaphoreHandle           = RenderResourceHandle;
 using FenceHandle               = RenderResourceHandle;
 using SwapchainHandle           = RenderResourceHandle;
 using TextureHandle             = RenderResourceHandle;
+using DeviceMemoryHandle        = RenderResourceHandle;
 using SamplerHandle             = RenderResourceHandle;
 using BufferHandle              = RenderResourceHandle;
 using DescriptorSetLayoutHandle = RenderResourceHandle;
@@ -48,5 +49,6 @@ using RenderPassHandle          = RenderResourceHandle;
 using FramebufferHandle         = RenderResourceHandle;
 using ShaderModuleHandle        = RenderResourceHandle;
 using PipelineHandle            = RenderResourceHandle;
+using QueryPoolHandle           = RenderResourceHandle;
 
 }  // namespace vulture
\ No newline at end of file
@@ -36,6 +36,7 @@ enum class ShaderModuleType : uint32_t {
   kInvalid,
   kVertex,
   kFragment,
+  kCompute,
 };
 
 enum ShaderStageBit : uint32_t {
@@ -45,6 +46,7 @@ enum ShaderStageBit : uint32_t {
   /* TODO: other stages */
   kShaderStageBitFragment    = 0x0000'0010,
   kShaderStageBitAllGraphics = 0x0000'001F,
+  kShaderStageBitCompute     = 0x0000'0020,
 };
 
 using ShaderStageFlags = uint32_t;
@@ -61,6 +63,7 @@ inline ShaderStageBit GetShaderStageBitFromShaderModuleType(ShaderModuleType typ
   switch (type) {
     case ShaderModuleType::kVertex:   { return kShaderStageBitVertex; }
     case ShaderModuleType::kFragment: { return kShaderStageBitFragment; }
+    case ShaderModuleType::kCompute:  { return kShaderStageBitCompute; }
 
     default: { assert(!"Invalid ShaderModuleType"); }
   }
@@ -57,7 +57,13 @@ enum TextureUsageBit : uint32_t {
   kTextureUsageBitSampled         = 0x0000'0004,
   kTextureUsageBitColorAttachment = 0x0000'0010,
   kTextureUsageBitDepthAttachment = 0x0000'0020,
-  kTextureUsageBitInputAttachment = 0x0000'0080,
+
+  /**
+   * Contents only live during a render pass, so the texture can be backed by lazily allocated memory, see
+   * @ref{RenderDevice::SupportsLazilyAllocatedMemory}. Can only be combined with the attachment usages.
+   */
+  kTextureUsageBitTransientAttachment = 0x0000'0040,
+  kTextureUsageBitInputAttachment     = 0x0000'0080,
 };
 
 using TextureUsageFlags = uint32_t;
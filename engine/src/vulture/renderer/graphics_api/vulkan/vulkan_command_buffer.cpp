@@ -27,27 +27,44 @@
 
 #include <vulture/renderer/graphics_api/vulkan/vulkan_command_buffer.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_render_device.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_upload_context.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_utils.hpp>
 
 using namespace vulture;
 
 VulkanCommandBuffer::VulkanCommandBuffer(CommandBufferType type, VulkanRenderDevice& device, bool temporary)
     : CommandBuffer(type), device_(device), temporary_(temporary) {
-  if (temporary) {
-    vk_command_buffer_ = device_.CreateCommandBuffer(device_.transient_command_pool_);
+  if (type == CommandBufferType::kGraphicsSecondary) {
+    assert(!temporary);
+    secondary_command_pool_ = device_.CreateCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                        device_.queue_family_indices_.graphics_family.value());
+    vk_command_buffer_      = device_.CreateCommandBuffer(secondary_command_pool_, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
   } else {
-    vk_command_buffer_ = device_.CreateCommandBuffer(device_.main_command_pool_);
+    vk_command_buffer_ = device_.CreateCommandBuffer(GetCommandPool());
   }
 }
 
 VulkanCommandBuffer::~VulkanCommandBuffer() {
-  if (temporary_) {
-    vkFreeCommandBuffers(device_.device_, device_.transient_command_pool_, 1, &vk_command_buffer_);
-  } else {
-    vkFreeCommandBuffers(device_.device_, device_.main_command_pool_, 1, &vk_command_buffer_);
+  vkFreeCommandBuffers(device_.device_, GetCommandPool(), 1, &vk_command_buffer_);
+  vk_command_buffer_ = VK_NULL_HANDLE;
+
+  if (secondary_command_pool_ != VK_NULL_HANDLE) {
+    vkDestroyCommandPool(device_.device_, secondary_command_pool_, /*allocator=*/nullptr);
+    secondary_command_pool_ = VK_NULL_HANDLE;
   }
+}
 
-  vk_command_buffer_ = VK_NULL_HANDLE;
+VkCommandPool VulkanCommandBuffer::GetCommandPool() const {
+  if (secondary_command_pool_ != VK_NULL_HANDLE) {
+    return secondary_command_pool_;
+  }
+
+  if (type_ == CommandBufferType::kCompute) {
+    assert(!temporary_);
+    return device_.compute_command_pool_;
+  }
+
+  return temporary_ ? device_.transient_command_pool_ : device_.main_command_pool_;
 }
 
 RenderDevice& VulkanCommandBuffer::GetDevice() {
@@ -55,6 +72,8 @@ RenderDevice& VulkanCommandBuffer::GetDevice() {
 }
 
 void VulkanCommandBuffer::Begin() {
+  assert(type_ != CommandBufferType::kGraphicsSecondary);
+
   VkCommandBufferBeginInfo vk_command_buffer_begin_info{};
   vk_command_buffer_begin_info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   vk_command_buffer_begin_info.flags             = 0;
@@ -63,12 +82,48 @@ void VulkanCommandBuffer::Begin() {
   VULKAN_CALL(vkBeginCommandBuffer(vk_command_buffer_, &vk_command_buffer_begin_info));
 }
 
+void VulkanCommandBuffer::BeginSecondary(const InheritanceInfo& inheritance_info) {
+  assert(type_ == CommandBufferType::kGraphicsSecondary);
+
+  VkCommandBufferInheritanceInfo vk_inheritance_info{};
+  vk_inheritance_info.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  vk_inheritance_info.renderPass  = device_.GetVulkanRenderPass(inheritance_info.render_pass).vk_render_pass;
+  vk_inheritance_info.subpass     = inheritance_info.subpass;
+  vk_inheritance_info.framebuffer = ValidRenderHandle(inheritance_info.framebuffer)
+                                        ? device_.GetVulkanFramebuffer(inheritance_info.framebuffer).vk_framebuffer
+                                        : VK_NULL_HANDLE;
+
+  VkCommandBufferBeginInfo vk_command_buffer_begin_info{};
+  vk_command_buffer_begin_info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  vk_command_buffer_begin_info.flags            = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                                                  VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vk_command_buffer_begin_info.pInheritanceInfo = &vk_inheritance_info;
+
+  VULKAN_CALL(vkBeginCommandBuffer(vk_command_buffer_, &vk_command_buffer_begin_info));
+
+  VkRect2D vk_scissor{};
+  vk_scissor.offset = {static_cast<int32_t>(inheritance_info.render_area.x),
+                       static_cast<int32_t>(inheritance_info.render_area.y)};
+  vk_scissor.extent = {inheritance_info.render_area.width, inheritance_info.render_area.height};
+  vkCmdSetScissor(vk_command_buffer_, 0, 1, &vk_scissor);
+
+  CmdSetViewports(1, &inheritance_info.viewport);
+}
+
 void VulkanCommandBuffer::End() {
   VULKAN_CALL(vkEndCommandBuffer(vk_command_buffer_));
 }
 
 void VulkanCommandBuffer::Submit(FenceHandle signal_fence, SemaphoreHandle signal_semaphore,
-                                 SemaphoreHandle wait_semaphore) {
+                                 SemaphoreHandle wait_semaphore, PipelineStageFlags wait_stages) {
+  /* Uploads are submitted to the graphics queue, so they must precede the command buffer */
+  device_.upload_context_->Flush();
+
+  /* A dedicated compute queue isn't ordered with the graphics one, so pending uploads are waited for on the CPU */
+  if (type_ == CommandBufferType::kCompute && device_.SupportsAsyncCompute()) {
+    device_.upload_context_->Wait(device_.upload_context_->GetLastSubmittedToken());
+  }
+
   VkFence vk_fence = ValidRenderHandle(signal_fence) ? device_.GetVulkanFence(signal_fence).vk_fence : VK_NULL_HANDLE;
   VkSemaphore vk_signal_semaphore =
       ValidRenderHandle(signal_semaphore) ? device_.GetVulkanSemaphore(signal_semaphore).vk_semaphore : VK_NULL_HANDLE;
@@ -88,19 +143,20 @@ void VulkanCommandBuffer::Submit(FenceHandle signal_fence, SemaphoreHandle signa
     submit_info.pSignalSemaphores    = nullptr;
   }
 
-  VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};  // FIXME: (tralf-strues)
+  VkPipelineStageFlags vk_wait_stages = static_cast<VkPipelineStageFlags>(wait_stages);
   if (ValidRenderHandle(wait_semaphore)) {
     submit_info.waitSemaphoreCount = 1;
     submit_info.pWaitSemaphores    = &vk_wait_semaphore;
-    submit_info.pWaitDstStageMask  = wait_stages;
+    submit_info.pWaitDstStageMask  = &vk_wait_stages;
   } else {
     submit_info.waitSemaphoreCount = 0;
     submit_info.pWaitSemaphores    = nullptr;
   }
 
   VkQueue vk_queue{VK_NULL_HANDLE};
-  switch (type_) {
+  switch (type_) {  // Note: secondary command buffers can't be submitted
     case CommandBufferType::kGraphics: { vk_queue = device_.graphics_queue_;   break; }
+    case CommandBufferType::kCompute:  { vk_queue = device_.compute_queue_;    break; }
     default:                           { assert(!"Invalid CommandBufferType"); break; }
   }
 
@@ -113,106 +169,7 @@ void VulkanCommandBuffer::Reset() {
 }
 
 void VulkanCommandBuffer::GenerateMipmaps(TextureHandle handle, TextureLayout final_layout) {
-  VulkanTexture& texture        = device_.GetVulkanTexture(handle);
-  VkImageLayout  vk_final_layout = GetVKImageLayout(final_layout);
-
-  /* Check if format supports linear blitting */
-  VkFormatProperties format_properties{};
-  vkGetPhysicalDeviceFormatProperties(device_.physical_device_, GetVKFormat(texture.specification.format),
-                                      &format_properties);
-  if (!(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
-    assert(!"Texture image format does not support linear blitting!");
-  }
-
-  VkImageMemoryBarrier barrier{};
-  barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  barrier.image                           = texture.vk_image;
-  barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-  barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-  barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-  barrier.subresourceRange.baseArrayLayer = 0;
-  barrier.subresourceRange.layerCount     = GetLayerCountFromTextureType(texture.specification);
-  barrier.subresourceRange.levelCount     = 1;
-
-  uint32_t mip_width  = texture.specification.width;
-  uint32_t mip_height = texture.specification.height;
-  for (uint32_t i = 1; i < texture.specification.mip_levels; ++i) {
-    /* Transition level (i - 1) to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
-    barrier.subresourceRange.baseMipLevel = i - 1;
-    // barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.oldLayout                     = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
-
-    vkCmdPipelineBarrier(vk_command_buffer_,
-                         /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         /*dstStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         /*dependencyFlags=*/0,
-                         /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
-                         /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
-                         /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
-
-    /* Blit from level (i - 1) to level i */
-    int32_t src_offset_x = static_cast<int32_t>(mip_width);
-    int32_t src_offset_y = static_cast<int32_t>(mip_height);
-    int32_t dst_offset_x = static_cast<int32_t>((mip_width  > 1) ? (mip_width  / 2) : 1);
-    int32_t dst_offset_y = static_cast<int32_t>((mip_height > 1) ? (mip_height / 2) : 1);
-
-    VkImageBlit blit{};
-    blit.srcOffsets[0]                 = {0, 0, 0};
-    blit.srcOffsets[1]                 = {src_offset_x, src_offset_y, 1};
-    blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    blit.srcSubresource.mipLevel       = i - 1;
-    blit.srcSubresource.baseArrayLayer = 0;
-    blit.srcSubresource.layerCount     = GetLayerCountFromTextureType(texture.specification);
-
-    blit.dstOffsets[0]                 = {0, 0, 0};
-    blit.dstOffsets[1]                 = {dst_offset_x, dst_offset_y, 1};
-    blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    blit.dstSubresource.mipLevel       = i;
-    blit.dstSubresource.baseArrayLayer = 0;
-    blit.dstSubresource.layerCount     = GetLayerCountFromTextureType(texture.specification);
-
-    // Should be submitted to a queue with graphics capabilities!
-    vkCmdBlitImage(vk_command_buffer_, /*srcImage=*/texture.vk_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                   /*dstImage=*/texture.vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, /*regionCount=*/1,
-                   /*pRegions=*/&blit, VK_FILTER_LINEAR);
-
-    /* Transition level (i - 1) to vk_final_layout */
-    barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    barrier.newLayout     = vk_final_layout;
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    vkCmdPipelineBarrier(vk_command_buffer_,
-                         /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         /*dstStageMask=*/VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                         /*dependencyFlags=*/0,
-                         /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
-                         /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
-                         /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
-
-    /* Next mip size */
-    if (mip_width  > 1) { mip_width  /= 2; }
-    if (mip_height > 1) { mip_height /= 2; }
-  }
-
-  /* Transition last level (not handled in the loop) */
-  barrier.subresourceRange.baseMipLevel = texture.specification.mip_levels - 1;
-  barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  barrier.newLayout                     = vk_final_layout;
-  barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
-  barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
-
-  vkCmdPipelineBarrier(vk_command_buffer_,
-                       /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
-                       /*dstStageMask=*/VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                       /*dependencyFlags=*/0,
-                       /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
-                       /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
-                       /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
-
+  device_.GenerateMipmaps(vk_command_buffer_, device_.GetVulkanTexture(handle), GetVKImageLayout(final_layout));
 }
 
 void VulkanCommandBuffer::TransitionLayout(TextureHandle handle, TextureLayout old_layout, TextureLayout new_layout) {
@@ -271,6 +228,87 @@ void VulkanCommandBuffer::TransitionLayout(TextureHandle handle, TextureLayout o
                        /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
 }
 
+void VulkanCommandBuffer::CmdPipelineBarrier(PipelineStageFlags src_stage_mask, PipelineStageFlags dst_stage_mask,
+                                             uint32_t texture_barriers_count, const TextureBarrier* texture_barriers,
+                                             uint32_t buffer_barriers_count, const BufferBarrier* buffer_barriers) {
+  image_barriers_.resize(texture_barriers_count);
+
+  for (uint32_t i = 0; i < texture_barriers_count; ++i) {
+    const TextureBarrier& texture_barrier = texture_barriers[i];
+    const VulkanTexture&  texture         = device_.GetVulkanTexture(texture_barrier.texture);
+
+    VkImageAspectFlags vk_aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT;
+    if (IsDepthStencilDataFormat(texture.specification.format)) {
+      vk_aspect_flags = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    } else if (IsDepthContainingDataFormat(texture.specification.format)) {
+      vk_aspect_flags = VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+
+    VkImageMemoryBarrier& barrier = image_barriers_[i];
+    barrier = VkImageMemoryBarrier{};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout                       = GetVKImageLayout(texture_barrier.old_layout);
+    barrier.newLayout                       = GetVKImageLayout(texture_barrier.new_layout);
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = texture.vk_image;
+
+    if (texture_barrier.src_queue != CommandBufferType::kInvalid &&
+        texture_barrier.dst_queue != CommandBufferType::kInvalid) {
+      uint32_t src_family = device_.GetQueueFamily(texture_barrier.src_queue);
+      uint32_t dst_family = device_.GetQueueFamily(texture_barrier.dst_queue);
+
+      if (src_family != dst_family) {
+        barrier.srcQueueFamilyIndex = src_family;
+        barrier.dstQueueFamilyIndex = dst_family;
+      }
+    }
+    barrier.subresourceRange.aspectMask     = vk_aspect_flags;
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = texture.specification.mip_levels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = GetLayerCountFromTextureType(texture.specification);
+    barrier.srcAccessMask                   = static_cast<VkAccessFlags>(texture_barrier.src_access_mask);
+    barrier.dstAccessMask                   = static_cast<VkAccessFlags>(texture_barrier.dst_access_mask);
+  }
+
+  buffer_barriers_.resize(buffer_barriers_count);
+
+  for (uint32_t i = 0; i < buffer_barriers_count; ++i) {
+    const BufferBarrier& buffer_barrier = buffer_barriers[i];
+
+    VkBufferMemoryBarrier& barrier = buffer_barriers_[i];
+    barrier = VkBufferMemoryBarrier{};
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask       = static_cast<VkAccessFlags>(buffer_barrier.src_access_mask);
+    barrier.dstAccessMask       = static_cast<VkAccessFlags>(buffer_barrier.dst_access_mask);
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer              = device_.GetVulkanBuffer(buffer_barrier.buffer).vk_buffer;
+    barrier.offset              = buffer_barrier.offset;
+    barrier.size                = buffer_barrier.size;
+  }
+
+  // Stage masks must not be empty
+  VkPipelineStageFlags vk_src_stage_mask = static_cast<VkPipelineStageFlags>(src_stage_mask);
+  VkPipelineStageFlags vk_dst_stage_mask = static_cast<VkPipelineStageFlags>(dst_stage_mask);
+  if (vk_src_stage_mask == 0) {
+    vk_src_stage_mask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+  }
+  if (vk_dst_stage_mask == 0) {
+    vk_dst_stage_mask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+  }
+
+  vkCmdPipelineBarrier(vk_command_buffer_,
+                       /*srcStageMask=*/vk_src_stage_mask, /*dstStageMask=*/vk_dst_stage_mask,
+                       /*dependencyFlags=*/0,
+                       /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                       /*bufferMemoryBarrierCount=*/buffer_barriers_count,
+                       /*pBufferMemoryBarriers=*/buffer_barriers_.data(),
+                       /*imageMemoryBarrierCount=*/texture_barriers_count,
+                       /*pImageMemoryBarriers=*/image_barriers_.data());
+}
+
 void VulkanCommandBuffer::CopyBuffer(BufferHandle src_buffer_handle, BufferHandle dst_buffer_handle, uint32_t size,
                                      uint32_t src_offset, uint32_t dst_offset) {
   VulkanBuffer& src_buffer = device_.GetVulkanBuffer(src_buffer_handle);
@@ -370,7 +408,13 @@ void VulkanCommandBuffer::RenderPassBegin(const RenderPassBeginInfo& begin_info)
   vk_render_pass_begin_info.clearValueCount   = begin_info.clear_values_count;
   vk_render_pass_begin_info.pClearValues      = reinterpret_cast<const VkClearValue*>(begin_info.clear_values);
   
-  // No secondary command buffers
+  if (begin_info.secondary_command_buffers) {
+    // Secondary command buffers set the scissor themselves, see BeginSecondary
+    vkCmdBeginRenderPass(vk_command_buffer_, &vk_render_pass_begin_info,
+                         VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    return;
+  }
+
   vkCmdBeginRenderPass(vk_command_buffer_, &vk_render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
 
   VkRect2D vk_scissor{};
@@ -382,30 +426,42 @@ void VulkanCommandBuffer::RenderPassEnd() {
   vkCmdEndRenderPass(vk_command_buffer_);
 }
 
-void VulkanCommandBuffer::CmdNextSubpass() { vkCmdNextSubpass(vk_command_buffer_, VK_SUBPASS_CONTENTS_INLINE); }
+void VulkanCommandBuffer::CmdNextSubpass(bool secondary_command_buffers) {
+  vkCmdNextSubpass(vk_command_buffer_, secondary_command_buffers ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                                                 : VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void VulkanCommandBuffer::CmdExecuteCommands(uint32_t count, CommandBuffer* const* command_buffers) {
+  thread_local std::vector<VkCommandBuffer> vk_command_buffers;
+  vk_command_buffers.resize(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    assert(command_buffers[i]->GetType() == CommandBufferType::kGraphicsSecondary);
+    vk_command_buffers[i] = static_cast<VulkanCommandBuffer*>(command_buffers[i])->vk_command_buffer_;
+  }
+
+  vkCmdExecuteCommands(vk_command_buffer_, count, vk_command_buffers.data());
+}
 
 void VulkanCommandBuffer::CmdBindDescriptorSets(PipelineHandle pipeline_handle, uint32_t first_set_idx, uint32_t count,
                                                 const DescriptorSetHandle* descriptor_sets) {
-  assert(device_.pipelines_.find(pipeline_handle) != device_.pipelines_.end());
-  VulkanPipeline& pipeline = device_.pipelines_.at(pipeline_handle);
+  VulkanPipeline& pipeline = device_.GetVulkanPipeline(pipeline_handle);
   
-  static std::vector<VkDescriptorSet> vk_descriptor_sets;
+  thread_local std::vector<VkDescriptorSet> vk_descriptor_sets;
   vk_descriptor_sets.resize(count);
 
   for (uint32_t i = 0; i < count; ++i) {
-    assert(device_.descriptor_sets_.find(descriptor_sets[i]) != device_.descriptor_sets_.end());
-    vk_descriptor_sets[i] = device_.descriptor_sets_.at(descriptor_sets[i]).vk_set;
+    vk_descriptor_sets[i] = device_.GetVulkanDescriptorSet(descriptor_sets[i]).vk_set;
   }
 
-  vkCmdBindDescriptorSets(vk_command_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.vk_pipeline_layout,
+  vkCmdBindDescriptorSets(vk_command_buffer_, pipeline.vk_bind_point, pipeline.vk_pipeline_layout,
                           first_set_idx, count, vk_descriptor_sets.data(), /*dynamicOffsetCount=*/0,
                           /*pDynamicOffsets=*/nullptr);
 }
 
 void VulkanCommandBuffer::CmdPushConstants(PipelineHandle pipeline_handle, const void* data, uint32_t offset,
                                            uint32_t size, ShaderStageFlags shader_stages) {
-  assert(device_.pipelines_.find(pipeline_handle) != device_.pipelines_.end());
-  vkCmdPushConstants(vk_command_buffer_, device_.pipelines_.at(pipeline_handle).vk_pipeline_layout,
+  vkCmdPushConstants(vk_command_buffer_, device_.GetVulkanPipeline(pipeline_handle).vk_pipeline_layout,
                      *reinterpret_cast<VkShaderStageFlags*>(&shader_stages), offset, size, data);
 }
 
@@ -413,8 +469,8 @@ void VulkanCommandBuffer::CmdPushConstants(PipelineHandle pipeline_handle, const
  * Graphics Commands
  ************************************************************************************************/
 void VulkanCommandBuffer::CmdBindGraphicsPipeline(PipelineHandle pipeline_handle) {
-  assert(device_.pipelines_.find(pipeline_handle) != device_.pipelines_.end());
-  VulkanPipeline& pipeline = device_.pipelines_.at(pipeline_handle);
+  VulkanPipeline& pipeline = device_.GetVulkanPipeline(pipeline_handle);
+  assert(pipeline.vk_bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS);
 
   vkCmdBindPipeline(vk_command_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.vk_pipeline);
 }
@@ -425,14 +481,13 @@ void VulkanCommandBuffer::CmdSetViewports(uint32_t viewports_count, const Viewpo
 
 void VulkanCommandBuffer::CmdBindVertexBuffers(uint32_t first_binding, uint32_t count,
                                                const BufferHandle* handles, const uint64_t* offsets) {
-  static std::vector<VkBuffer> vk_buffers;
-  static std::vector<VkDeviceSize> vk_zero_offsets; 
+  thread_local std::vector<VkBuffer> vk_buffers;
+  thread_local std::vector<VkDeviceSize> vk_zero_offsets;
   vk_buffers.resize(count);
   vk_zero_offsets.resize(count);
 
   for (uint32_t i = 0; i < count; ++i) {
-    assert(device_.buffers_.find(handles[i]) != device_.buffers_.end());
-    vk_buffers[i] = device_.buffers_.at(handles[i]).vk_buffer;
+    vk_buffers[i] = device_.GetVulkanBuffer(handles[i]).vk_buffer;
   }
 
   if (offsets != nullptr) {
@@ -447,8 +502,7 @@ void VulkanCommandBuffer::CmdBindVertexBuffers(uint32_t first_binding, uint32_t
 }
 
 void VulkanCommandBuffer::CmdBindIndexBuffer(BufferHandle handle, uint64_t offset) {
-  assert(device_.buffers_.find(handle) != device_.buffers_.end());
-  vkCmdBindIndexBuffer(vk_command_buffer_, device_.buffers_.at(handle).vk_buffer, offset, VK_INDEX_TYPE_UINT32);
+  vkCmdBindIndexBuffer(vk_command_buffer_, device_.GetVulkanBuffer(handle).vk_buffer, offset, VK_INDEX_TYPE_UINT32);
 }
 
 void VulkanCommandBuffer::CmdDraw(uint32_t vertices_count, uint32_t first_vertex, uint32_t instances_count,
@@ -459,4 +513,30 @@ void VulkanCommandBuffer::CmdDraw(uint32_t vertices_count, uint32_t first_vertex
 void VulkanCommandBuffer::CmdDrawIndexed(uint32_t indices_count, uint32_t first_index, int32_t vertex_offset,
                                          uint32_t instances_count, uint32_t first_instance) {
   vkCmdDrawIndexed(vk_command_buffer_, indices_count, instances_count, first_index, vertex_offset, first_instance);
-}
\ No newline at end of file
+}
+
+/************************************************************************************************
+ * Compute Commands
+ ************************************************************************************************/
+void VulkanCommandBuffer::CmdBindComputePipeline(PipelineHandle pipeline_handle) {
+  VulkanPipeline& pipeline = device_.GetVulkanPipeline(pipeline_handle);
+  assert(pipeline.vk_bind_point == VK_PIPELINE_BIND_POINT_COMPUTE);
+
+  vkCmdBindPipeline(vk_command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.vk_pipeline);
+}
+
+void VulkanCommandBuffer::CmdDispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) {
+  vkCmdDispatch(vk_command_buffer_, group_count_x, group_count_y, group_count_z);
+}
+
+/************************************************************************************************
+ * Query Commands
+ ************************************************************************************************/
+void VulkanCommandBuffer::CmdResetQueryPool(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count) {
+  vkCmdResetQueryPool(vk_command_buffer_, device_.GetVulkanQueryPool(query_pool).vk_query_pool, first_query, count);
+}
+
+void VulkanCommandBuffer::CmdWriteTimestamp(QueryPoolHandle query_pool, uint32_t query, PipelineStageFlags stage) {
+  vkCmdWriteTimestamp(vk_command_buffer_, static_cast<VkPipelineStageFlagBits>(stage),
+                      device_.GetVulkanQueryPool(query_pool).vk_query_pool, query);
+}
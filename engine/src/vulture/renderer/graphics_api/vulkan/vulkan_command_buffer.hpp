@@ -48,14 +48,20 @@ class VulkanCommandBuffer final : public CommandBuffer {
   RenderDevice& GetDevice() override;
 
   void Begin() override;
+  void BeginSecondary(const InheritanceInfo& inheritance_info) override;
   void End() override;
-  void Submit(FenceHandle signal_fence, SemaphoreHandle signal_semaphore, SemaphoreHandle wait_semaphore) override;
+  void Submit(FenceHandle signal_fence, SemaphoreHandle signal_semaphore, SemaphoreHandle wait_semaphore,
+              PipelineStageFlags wait_stages) override;
 
   void Reset() override;
 
   void GenerateMipmaps(TextureHandle texture, TextureLayout final_layout) override;
   void TransitionLayout(TextureHandle texture, TextureLayout old_layout, TextureLayout new_layout) override;
 
+  void CmdPipelineBarrier(PipelineStageFlags src_stage_mask, PipelineStageFlags dst_stage_mask,
+                          uint32_t texture_barriers_count, const TextureBarrier* texture_barriers,
+                          uint32_t buffer_barriers_count, const BufferBarrier* buffer_barriers) override;
+
   void CopyBuffer(BufferHandle src_buffer, BufferHandle dst_buffer, uint32_t size, uint32_t src_offset,
                   uint32_t dst_offset) override;
 
@@ -71,7 +77,9 @@ class VulkanCommandBuffer final : public CommandBuffer {
   void RenderPassBegin(const RenderPassBeginInfo& begin_info) override;
   void RenderPassEnd() override;
 
-  void CmdNextSubpass() override;
+  void CmdNextSubpass(bool secondary_command_buffers) override;
+
+  void CmdExecuteCommands(uint32_t count, CommandBuffer* const* command_buffers) override;
 
   void CmdBindDescriptorSets(PipelineHandle pipeline, uint32_t first_set_idx, uint32_t count,
                                      const DescriptorSetHandle* descriptor_sets) override;
@@ -102,11 +110,36 @@ class VulkanCommandBuffer final : public CommandBuffer {
                               uint32_t instances_count,
                               uint32_t first_instance) override;
 
+  /************************************************************************************************
+   * Compute Commands
+   ************************************************************************************************/
+  void CmdBindComputePipeline(PipelineHandle pipeline) override;
+
+  void CmdDispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override;
+
+  /************************************************************************************************
+   * Query Commands
+   ************************************************************************************************/
+  void CmdResetQueryPool(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count) override;
+  void CmdWriteTimestamp(QueryPoolHandle query_pool, uint32_t query, PipelineStageFlags stage) override;
+
+ private:
+  VkCommandPool GetCommandPool() const;
+
  private:
   VulkanRenderDevice& device_;
   VkCommandBuffer     vk_command_buffer_{VK_NULL_HANDLE};
   bool                temporary_{false};
 
+  /**
+   * Secondary command buffers are recorded from multiple threads, while command pools must be externally synchronized,
+   * so each of them is allocated from its own pool.
+   */
+  VkCommandPool       secondary_command_pool_{VK_NULL_HANDLE};
+
+  std::vector<VkImageMemoryBarrier>  image_barriers_;   ///< Reused by CmdPipelineBarrier to avoid allocations
+  std::vector<VkBufferMemoryBarrier> buffer_barriers_;  ///< Reused by CmdPipelineBarrier to avoid allocations
+
   friend class VulkanImGuiImplementation;
 };
 
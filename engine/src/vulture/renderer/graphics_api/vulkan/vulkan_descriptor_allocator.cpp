@@ -0,0 +1,214 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file vulkan_descriptor_allocator.cpp
+ * @date 2023-06-29
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/core/hash.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_descriptor_allocator.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_utils.hpp>
+
+#include <algorithm>
+
+using namespace vulture;
+
+size_t VulkanDescriptorAllocator::SignatureHash::operator()(const Signature& signature) const {
+  uint64_t hash = 0;
+  for (uint32_t count : signature) {
+    HashCombine(hash, count);
+  }
+
+  return static_cast<size_t>(hash);
+}
+
+VulkanDescriptorAllocator::VulkanDescriptorAllocator(VulkanRenderDevice& device) : device_(device) {}
+
+VulkanDescriptorAllocator::~VulkanDescriptorAllocator() {
+  /* Frees all the descriptor sets as well */
+  for (auto& [signature, signature_pools] : pools_) {
+    for (VkDescriptorPool vk_pool : signature_pools.vk_pools) {
+      vkDestroyDescriptorPool(device_.device_, vk_pool, /*allocator=*/nullptr);
+    }
+  }
+}
+
+VulkanDescriptorSet VulkanDescriptorAllocator::Allocate(DescriptorSetLayoutHandle layout_handle) {
+  VulkanDescriptorSet descriptor_set{};
+  descriptor_set.layout_handle = layout_handle;
+
+  /* Reuse a free set */
+  LayoutSets& layout_sets = layout_sets_[layout_handle];
+  assert(!layout_sets.released);
+
+  if (!layout_sets.free_sets.empty() && IsSafeToReuse(layout_sets.free_sets.front())) {
+    descriptor_set.vk_pool = layout_sets.free_sets.front().vk_pool;
+    descriptor_set.vk_set  = layout_sets.free_sets.front().vk_set;
+
+    layout_sets.free_sets.pop_front();
+    return descriptor_set;
+  }
+
+  /* Allocate a new set */
+  VulkanDescriptorSetLayout& layout = device_.GetVulkanDescriptorSetLayout(layout_handle);
+
+  Signature       signature       = ComputeSignature(layout.layout_info);
+  SignaturePools& signature_pools = pools_[signature];
+
+  VkDescriptorSetAllocateInfo alloc_info{};
+  alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  alloc_info.descriptorSetCount = 1;
+  alloc_info.pSetLayouts        = &layout.vk_layout;
+
+  if (!signature_pools.vk_pools.empty()) {
+    alloc_info.descriptorPool = signature_pools.vk_pools.back();
+    if (vkAllocateDescriptorSets(device_.device_, &alloc_info, &descriptor_set.vk_set) == VK_SUCCESS) {
+      descriptor_set.vk_pool = alloc_info.descriptorPool;
+      return descriptor_set;
+    }
+  }
+
+  /* The last pool is exhausted */
+  signature_pools.sets_per_pool = std::clamp(signature_pools.sets_per_pool * 2, kMinSetsPerPool, kMaxSetsPerPool);
+  signature_pools.vk_pools.push_back(CreatePool(signature, signature_pools.sets_per_pool));
+
+  alloc_info.descriptorPool = signature_pools.vk_pools.back();
+  VULKAN_CALL(vkAllocateDescriptorSets(device_.device_, &alloc_info, &descriptor_set.vk_set));
+
+  descriptor_set.vk_pool = alloc_info.descriptorPool;
+  return descriptor_set;
+}
+
+void VulkanDescriptorAllocator::Free(const VulkanDescriptorSet& descriptor_set) {
+  FreeSet free_set{};
+  free_set.vk_pool    = descriptor_set.vk_pool;
+  free_set.vk_set     = descriptor_set.vk_set;
+  free_set.free_frame = frame_number_;
+
+  LayoutSets& layout_sets = layout_sets_[descriptor_set.layout_handle];
+  layout_sets.free_sets.push_back(free_set);
+
+  /* The layout has been deleted while the set was still alive */
+  if (!layout_sets.released && !device_.descriptor_set_layouts_.Contains(descriptor_set.layout_handle)) {
+    layout_sets.released = true;
+    released_layouts_.push_back(descriptor_set.layout_handle);
+  }
+}
+
+void VulkanDescriptorAllocator::ReleaseLayout(DescriptorSetLayoutHandle layout_handle) {
+  auto it = layout_sets_.find(layout_handle);
+  if (it == layout_sets_.end()) {
+    return;
+  }
+
+  it->second.released = true;
+
+  if (FreeReleasedSets(it->second)) {
+    layout_sets_.erase(it);
+  } else {
+    released_layouts_.push_back(layout_handle);
+  }
+}
+
+void VulkanDescriptorAllocator::NextFrame() {
+  ++frame_number_;
+
+  auto released_end = std::remove_if(released_layouts_.begin(), released_layouts_.end(),
+                                     [this](DescriptorSetLayoutHandle layout_handle) {
+                                       auto it = layout_sets_.find(layout_handle);
+                                       if (!FreeReleasedSets(it->second)) {
+                                         return false;
+                                       }
+
+                                       layout_sets_.erase(it);
+                                       return true;
+                                     });
+
+  released_layouts_.erase(released_end, released_layouts_.end());
+}
+
+uint32_t VulkanDescriptorAllocator::GetPoolsCount() const {
+  uint32_t pools_count = 0;
+  for (const auto& [signature, signature_pools] : pools_) {
+    pools_count += static_cast<uint32_t>(signature_pools.vk_pools.size());
+  }
+
+  return pools_count;
+}
+
+VulkanDescriptorAllocator::Signature VulkanDescriptorAllocator::ComputeSignature(
+    const DescriptorSetLayoutInfo& layout_info) {
+  Signature signature{};
+  for (const auto& binding : layout_info.bindings_layout_info) {
+    ++signature[static_cast<size_t>(binding.descriptor_type)];
+  }
+
+  return signature;
+}
+
+bool VulkanDescriptorAllocator::IsSafeToReuse(const FreeSet& free_set) const {
+  /* The set might have been used by any of the frames in flight at the moment it was freed, and the current frame's
+   * fence might have not been waited for yet */
+  return free_set.free_frame + kFramesInFlight < frame_number_;
+}
+
+VkDescriptorPool VulkanDescriptorAllocator::CreatePool(const Signature& signature, uint32_t max_sets) {
+  std::vector<VkDescriptorPoolSize> vk_pool_sizes{};
+  for (uint32_t i = 0; i < signature.size(); ++i) {
+    DescriptorType type = static_cast<DescriptorType>(i);
+
+    if (type == DescriptorType::kInvalid || signature[i] == 0) { continue; }
+
+    VkDescriptorPoolSize vk_pool_size{};
+    vk_pool_size.descriptorCount = signature[i] * max_sets;
+    vk_pool_size.type            = GetVKDescriptorType(type);
+
+    vk_pool_sizes.emplace_back(vk_pool_size);
+  }
+
+  VkDescriptorPool vk_pool{VK_NULL_HANDLE};
+
+  VkDescriptorPoolCreateInfo pool_create_info{};
+  pool_create_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  pool_create_info.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  pool_create_info.poolSizeCount = static_cast<uint32_t>(vk_pool_sizes.size());
+  pool_create_info.pPoolSizes    = vk_pool_sizes.data();
+  pool_create_info.maxSets       = max_sets;
+
+  VULKAN_CALL(vkCreateDescriptorPool(device_.device_, &pool_create_info, /*allocator=*/nullptr, &vk_pool));
+
+  return vk_pool;
+}
+
+bool VulkanDescriptorAllocator::FreeReleasedSets(LayoutSets& layout_sets) {
+  assert(layout_sets.released);
+
+  while (!layout_sets.free_sets.empty() && IsSafeToReuse(layout_sets.free_sets.front())) {
+    const FreeSet& free_set = layout_sets.free_sets.front();
+    VULKAN_CALL(vkFreeDescriptorSets(device_.device_, free_set.vk_pool, 1, &free_set.vk_set));
+
+    layout_sets.free_sets.pop_front();
+  }
+
+  return layout_sets.free_sets.empty();
+}
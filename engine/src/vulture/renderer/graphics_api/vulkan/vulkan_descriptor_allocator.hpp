@@ -0,0 +1,124 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file vulkan_descriptor_allocator.hpp
+ * @date 2023-06-29
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <vulture/renderer/graphics_api/vulkan/vulkan_render_device.hpp>
+
+namespace vulture {
+
+/**
+ * @brief Allocates descriptor sets from shared descriptor pools instead of creating a pool per set.
+ *
+ * Pools are grouped by layout signature, i.e. by the number of descriptors of each type in the layout, so different
+ * layouts with the same signature share pools. When the pools of a signature are exhausted, a new one twice as large
+ * as the previous is created (up to kMaxSetsPerPool sets).
+ *
+ * Freed sets are kept in per-layout free lists and handed out again once the frames that could still be using them
+ * have finished, without updating the pools at all.
+ */
+class VulkanDescriptorAllocator {
+ public:
+  static constexpr uint32_t kMinSetsPerPool = 16;
+  static constexpr uint32_t kMaxSetsPerPool = 256;
+
+ public:
+  explicit VulkanDescriptorAllocator(VulkanRenderDevice& device);
+  ~VulkanDescriptorAllocator();
+
+  VulkanDescriptorAllocator(const VulkanDescriptorAllocator& other) = delete;
+  VulkanDescriptorAllocator& operator=(const VulkanDescriptorAllocator& other) = delete;
+
+  VulkanDescriptorSet Allocate(DescriptorSetLayoutHandle layout_handle);
+
+  /**
+   * @brief Put the set to its layout's free list.
+   */
+  void Free(const VulkanDescriptorSet& descriptor_set);
+
+  /**
+   * @brief Return the free sets of the layout to their pools, as they cannot be reused after it is deleted.
+   */
+  void ReleaseLayout(DescriptorSetLayoutHandle layout_handle);
+
+  /**
+   * @brief Must be called once per frame, tells which freed sets are no longer used by the GPU.
+   */
+  void NextFrame();
+
+  uint32_t GetPoolsCount() const;
+
+ private:
+  using Signature = std::array<uint32_t, static_cast<size_t>(DescriptorType::kTotalTypes)>;
+
+  struct SignatureHash {
+    size_t operator()(const Signature& signature) const;
+  };
+
+  struct SignaturePools {
+    std::vector<VkDescriptorPool> vk_pools;
+    uint32_t                      sets_per_pool{0};  ///< Of the last pool
+  };
+
+  struct FreeSet {
+    VkDescriptorPool vk_pool{VK_NULL_HANDLE};
+    VkDescriptorSet  vk_set{VK_NULL_HANDLE};
+    uint64_t         free_frame{0};
+  };
+
+  struct LayoutSets {
+    std::deque<FreeSet> free_sets;  ///< Ordered by free_frame
+    bool                released{false};
+  };
+
+  static Signature ComputeSignature(const DescriptorSetLayoutInfo& layout_info);
+
+  bool IsSafeToReuse(const FreeSet& free_set) const;
+  VkDescriptorPool CreatePool(const Signature& signature, uint32_t max_sets);
+
+  /**
+   * @brief Free the sets of a released layout, which are not used anymore.
+   * @return Whether all the sets have been freed.
+   */
+  bool FreeReleasedSets(LayoutSets& layout_sets);
+
+ private:
+  VulkanRenderDevice&                                                  device_;
+
+  std::unordered_map<Signature, SignaturePools, SignatureHash>         pools_;
+  std::unordered_map<DescriptorSetLayoutHandle, LayoutSets>            layout_sets_;
+  std::vector<DescriptorSetLayoutHandle>                               released_layouts_;
+
+  uint64_t                                                             frame_number_{0};
+};
+
+}  // namespace vulture
@@ -25,8 +25,11 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <vulture/core/hash.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_command_buffer.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_descriptor_allocator.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_render_device.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_upload_context.hpp>
 #include <vulture/renderer/graphics_api/vulkan/vulkan_utils.hpp>
 
 #define VMA_IMPLEMENTATION
@@ -39,6 +42,8 @@
 #include <vk_mem_alloc.h>
 
 #include <array>
+#include <cstring>
+#include <fstream>
 #include <set>
 
 using namespace vulture;
@@ -48,8 +53,45 @@ static constexpr const char* kValidationLayers[] = {"VK_LAYER_KHRONOS_validation
 static const std::vector<const char*> kRequiredDeviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                                                                    VK_KHR_MAINTENANCE1_EXTENSION_NAME};
 
-uint32_t VulkanRenderDevice::GenNextHandle() {
-  return next_handle_++;
+static constexpr uint32_t kPipelineCacheFileMagic = 0x5650'4346;  // "VPCF"
+
+/**
+ * @brief Precedes the pipeline cache data in the file. The data has a header of its own, but it doesn't include the
+ *        driver version, and not all drivers reject stale data gracefully.
+ */
+struct PipelineCacheFileHeader {
+  uint32_t magic                             {kPipelineCacheFileMagic};
+  uint32_t vendor_id                         {0};
+  uint32_t device_id                         {0};
+  uint32_t driver_version                    {0};
+  uint8_t  pipeline_cache_uuid[VK_UUID_SIZE] {};
+  uint64_t data_size                         {0};
+};
+
+static uint64_t CalculateLayoutInfoHash(const DescriptorSetLayoutInfo& layout_info) {
+  uint64_t hash = 0;
+
+  HashCombine(hash, layout_info.bindings_layout_info.size());
+  for (const auto& binding : layout_info.bindings_layout_info) {
+    HashCombine(hash, binding.binding_idx);
+    HashCombine(hash, static_cast<uint64_t>(binding.descriptor_type));
+    HashCombine(hash, binding.shader_stages);
+  }
+
+  return hash;
+}
+
+static PipelineCacheFileHeader GetPipelineCacheFileHeader(VkPhysicalDevice physical_device) {
+  VkPhysicalDeviceProperties device_properties{};
+  vkGetPhysicalDeviceProperties(physical_device, &device_properties);
+
+  PipelineCacheFileHeader header{};
+  header.vendor_id      = device_properties.vendorID;
+  header.device_id      = device_properties.deviceID;
+  header.driver_version = device_properties.driverVersion;
+  std::memcpy(header.pipeline_cache_uuid, device_properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+  return header;
 }
 
 VulkanBuffer VulkanRenderDevice::CreateStagingBuffer(VkDeviceSize size) {
@@ -70,6 +112,89 @@ VulkanBuffer VulkanRenderDevice::CreateStagingBuffer(VkDeviceSize size) {
   return staging_buffer;
 }
 
+bool VulkanPipelineKey::operator==(const VulkanPipelineKey& other) const {
+  return hash == other.hash && vk_bind_point == other.vk_bind_point && state_hash == other.state_hash &&
+         render_pass_compatibility_hash == other.render_pass_compatibility_hash && subpass_idx == other.subpass_idx &&
+         shader_module_hashes == other.shader_module_hashes &&
+         descriptor_set_layout_hashes == other.descriptor_set_layout_hashes;
+}
+
+void VulkanRenderDevice::FinishPipelineKey(VulkanPipelineKey& key, uint32_t shader_modules_count,
+                                           const ShaderModuleHandle* shader_modules,
+                                           uint32_t descriptor_sets_count,
+                                           const DescriptorSetLayoutHandle* descriptor_set_layouts) {
+  key.shader_module_hashes.resize(shader_modules_count);
+  for (uint32_t i = 0; i < shader_modules_count; ++i) {
+    const VulkanShaderModule& shader_module = GetVulkanShaderModule(shader_modules[i]);
+
+    uint64_t module_hash = static_cast<uint64_t>(shader_module.type);
+    HashCombine(module_hash, shader_module.binary_hash);
+    key.shader_module_hashes[i] = module_hash;
+  }
+
+  key.descriptor_set_layout_hashes.resize(descriptor_sets_count);
+  for (uint32_t i = 0; i < descriptor_sets_count; ++i) {
+    key.descriptor_set_layout_hashes[i] = GetVulkanDescriptorSetLayout(descriptor_set_layouts[i]).hash;
+  }
+
+  key.hash = 0;
+  HashCombine(key.hash, static_cast<uint64_t>(key.vk_bind_point));
+  HashCombine(key.hash, key.state_hash);
+  HashCombine(key.hash, key.render_pass_compatibility_hash);
+  HashCombine(key.hash, key.subpass_idx);
+
+  HashCombine(key.hash, key.shader_module_hashes.size());
+  for (uint64_t module_hash : key.shader_module_hashes) {
+    HashCombine(key.hash, module_hash);
+  }
+
+  HashCombine(key.hash, key.descriptor_set_layout_hashes.size());
+  for (uint64_t layout_hash : key.descriptor_set_layout_hashes) {
+    HashCombine(key.hash, layout_hash);
+  }
+}
+
+PipelineHandle VulkanRenderDevice::AcquireCachedPipeline(const VulkanPipelineKey& key) {
+  auto it = pipelines_by_key_.find(key);
+  if (it == pipelines_by_key_.end()) {
+    return kInvalidRenderResourceHandle;
+  }
+
+  ++GetVulkanPipeline(it->second).ref_count;
+  return it->second;
+}
+
+VkPipelineLayout VulkanRenderDevice::CreatePipelineLayout(uint32_t descriptor_sets_count,
+                                                          const DescriptorSetLayoutHandle* descriptor_set_layouts,
+                                                          uint32_t push_constant_ranges_count,
+                                                          const PushConstantRange* push_constant_ranges) {
+  VkPipelineLayout vk_pipeline_layout{VK_NULL_HANDLE};
+
+  std::vector<VkDescriptorSetLayout> vk_descriptor_set_layouts{descriptor_sets_count};
+  for (uint32_t i = 0; i < descriptor_sets_count; ++i) {
+    vk_descriptor_set_layouts[i] = GetVulkanDescriptorSetLayout(descriptor_set_layouts[i]).vk_layout;
+  }
+
+  std::vector<VkPushConstantRange> vk_push_constant_ranges{push_constant_ranges_count};
+  for (uint32_t i = 0; i < push_constant_ranges_count; ++i) {
+    vk_push_constant_ranges[i].offset     = push_constant_ranges[i].offset;
+    vk_push_constant_ranges[i].size       = push_constant_ranges[i].size;
+    vk_push_constant_ranges[i].stageFlags =
+        static_cast<VkShaderStageFlagBits>(push_constant_ranges[i].shader_stages);
+  }
+
+  VkPipelineLayoutCreateInfo vk_pipeline_layout_info{};
+  vk_pipeline_layout_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  vk_pipeline_layout_info.setLayoutCount         = static_cast<uint32_t>(vk_descriptor_set_layouts.size());
+  vk_pipeline_layout_info.pSetLayouts            = vk_descriptor_set_layouts.data();
+  vk_pipeline_layout_info.pushConstantRangeCount = static_cast<uint32_t>(vk_push_constant_ranges.size());
+  vk_pipeline_layout_info.pPushConstantRanges    = vk_push_constant_ranges.data();
+
+  VULKAN_CALL(vkCreatePipelineLayout(device_, &vk_pipeline_layout_info, /*allocator=*/nullptr, &vk_pipeline_layout));
+
+  return vk_pipeline_layout;
+}
+
 uint32_t VulkanRenderDevice::FindMemoryType(uint32_t type_filter, VkMemoryPropertyFlags properties) {
   VkPhysicalDeviceMemoryProperties mem_properties{};
   vkGetPhysicalDeviceMemoryProperties(physical_device_, &mem_properties);
@@ -94,11 +219,111 @@ void VulkanRenderDevice::CopyBuffer(VkCommandBuffer command_buffer, VkBuffer src
   vkCmdCopyBuffer(command_buffer, src_buffer, dst_buffer, /*regionCount=*/1, &copy_region);
 }
 
-VkCommandPool VulkanRenderDevice::CreateCommandPool(VkCommandPoolCreateFlags flags) {
+void VulkanRenderDevice::GenerateMipmaps(VkCommandBuffer command_buffer, VulkanTexture& texture,
+                                         VkImageLayout vk_final_layout) {
+  /* Check if format supports linear blitting */
+  VkFormatProperties format_properties{};
+  vkGetPhysicalDeviceFormatProperties(physical_device_, GetVKFormat(texture.specification.format),
+                                      &format_properties);
+  if (!(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
+    assert(!"Texture image format does not support linear blitting!");
+  }
+
+  VkImageMemoryBarrier barrier{};
+  barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.image                           = texture.vk_image;
+  barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount     = GetLayerCountFromTextureType(texture.specification);
+  barrier.subresourceRange.levelCount     = 1;
+
+  uint32_t mip_width  = texture.specification.width;
+  uint32_t mip_height = texture.specification.height;
+  for (uint32_t i = 1; i < texture.specification.mip_levels; ++i) {
+    /* Transition level (i - 1) to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
+    barrier.subresourceRange.baseMipLevel = i - 1;
+    // barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.oldLayout                     = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
+
+    vkCmdPipelineBarrier(command_buffer,
+                         /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         /*dstStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         /*dependencyFlags=*/0,
+                         /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                         /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                         /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
+
+    /* Blit from level (i - 1) to level i */
+    int32_t src_offset_x = static_cast<int32_t>(mip_width);
+    int32_t src_offset_y = static_cast<int32_t>(mip_height);
+    int32_t dst_offset_x = static_cast<int32_t>((mip_width  > 1) ? (mip_width  / 2) : 1);
+    int32_t dst_offset_y = static_cast<int32_t>((mip_height > 1) ? (mip_height / 2) : 1);
+
+    VkImageBlit blit{};
+    blit.srcOffsets[0]                 = {0, 0, 0};
+    blit.srcOffsets[1]                 = {src_offset_x, src_offset_y, 1};
+    blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    blit.srcSubresource.mipLevel       = i - 1;
+    blit.srcSubresource.baseArrayLayer = 0;
+    blit.srcSubresource.layerCount     = GetLayerCountFromTextureType(texture.specification);
+
+    blit.dstOffsets[0]                 = {0, 0, 0};
+    blit.dstOffsets[1]                 = {dst_offset_x, dst_offset_y, 1};
+    blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    blit.dstSubresource.mipLevel       = i;
+    blit.dstSubresource.baseArrayLayer = 0;
+    blit.dstSubresource.layerCount     = GetLayerCountFromTextureType(texture.specification);
+
+    // Should be submitted to a queue with graphics capabilities!
+    vkCmdBlitImage(command_buffer, /*srcImage=*/texture.vk_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   /*dstImage=*/texture.vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, /*regionCount=*/1,
+                   /*pRegions=*/&blit, VK_FILTER_LINEAR);
+
+    /* Transition level (i - 1) to vk_final_layout */
+    barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout     = vk_final_layout;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(command_buffer,
+                         /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         /*dstStageMask=*/VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         /*dependencyFlags=*/0,
+                         /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                         /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                         /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
+
+    /* Next mip size */
+    if (mip_width  > 1) { mip_width  /= 2; }
+    if (mip_height > 1) { mip_height /= 2; }
+  }
+
+  /* Transition last level (not handled in the loop) */
+  barrier.subresourceRange.baseMipLevel = texture.specification.mip_levels - 1;
+  barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.newLayout                     = vk_final_layout;
+  barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
+  barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+
+  vkCmdPipelineBarrier(command_buffer,
+                       /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       /*dstStageMask=*/VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       /*dependencyFlags=*/0,
+                       /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                       /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                       /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
+}
+
+VkCommandPool VulkanRenderDevice::CreateCommandPool(VkCommandPoolCreateFlags flags, uint32_t queue_family) {
   VkCommandPoolCreateInfo pool_create_info{};
   pool_create_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
   pool_create_info.flags             = flags;
-  pool_create_info.queueFamilyIndex = queue_family_indices_.graphics_family.value();
+  pool_create_info.queueFamilyIndex = queue_family;
 
   VkCommandPool command_pool{VK_NULL_HANDLE};
   VULKAN_CALL(vkCreateCommandPool(device_, &pool_create_info, /*allocator=*/nullptr, &command_pool));
@@ -106,15 +331,22 @@ VkCommandPool VulkanRenderDevice::CreateCommandPool(VkCommandPoolCreateFlags fla
   return command_pool;
 }
 
-VkCommandBuffer VulkanRenderDevice::CreateCommandBuffer(VkCommandPool command_pool) {
+uint32_t VulkanRenderDevice::GetQueueFamily(CommandBufferType queue) const {
+  if (queue == CommandBufferType::kCompute && SupportsAsyncCompute()) {
+    return queue_family_indices_.compute_family.value();
+  }
+
+  return queue_family_indices_.graphics_family.value();
+}
+
+VkCommandBuffer VulkanRenderDevice::CreateCommandBuffer(VkCommandPool command_pool, VkCommandBufferLevel level) {
   VkCommandBuffer command_buffer{VK_NULL_HANDLE};
 
   VkCommandBufferAllocateInfo command_buffer_alloc_info{};
   command_buffer_alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   command_buffer_alloc_info.commandPool        = command_pool;
   command_buffer_alloc_info.commandBufferCount = 1;
-  // Can be submitted to a queue for execution, can't be called from other command buffers
-  command_buffer_alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  command_buffer_alloc_info.level              = level;
   VULKAN_CALL(vkAllocateCommandBuffers(device_, &command_buffer_alloc_info, &command_buffer));
 
   return command_buffer;
@@ -143,6 +375,9 @@ VkCommandBuffer VulkanRenderDevice::BeginSingleTimeCommands() {
 void VulkanRenderDevice::EndSingleTimeCommands(VkCommandBuffer command_buffer) {
   VULKAN_CALL(vkEndCommandBuffer(command_buffer));
 
+  // The commands may read resources whose uploads are still being recorded, so submit those first
+  upload_context_->Flush();
+
   VkSubmitInfo submit_info{};
   submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   submit_info.commandBufferCount = 1;
@@ -158,11 +393,20 @@ void VulkanRenderDevice::EndSingleTimeCommands(VkCommandBuffer command_buffer) {
 VulkanRenderDevice::VulkanRenderDevice() : RenderDevice(DeviceFamily::kVulkan) {}
 
 VulkanRenderDevice::~VulkanRenderDevice() {
+  upload_context_.reset();
+  descriptor_allocator_.reset();
+
+  vkDestroyPipelineCache(device_, pipeline_cache_, /*allocator=*/nullptr);
+
   vkDestroyFence(device_, fence_swapchain_image_available_, /*allocator=*/nullptr);
 
   vkDestroyCommandPool(device_, transient_command_pool_, /*allocator=*/nullptr);
   vkDestroyCommandPool(device_, main_command_pool_, /*allocator=*/nullptr);
 
+  if (compute_command_pool_ != main_command_pool_) {
+    vkDestroyCommandPool(device_, compute_command_pool_, /*allocator=*/nullptr);
+  }
+
   vmaDestroyAllocator(allocator_);
 
   vkDestroyDevice(device_, /*allocator=*/nullptr);
@@ -179,6 +423,23 @@ uint32_t VulkanRenderDevice::CurrentFrame() const {
   return current_frame_;
 }
 
+bool VulkanRenderDevice::SupportsAsyncCompute() const {
+  return queue_family_indices_.compute_family.has_value();
+}
+
+bool VulkanRenderDevice::SupportsLazilyAllocatedMemory() const {
+  VkPhysicalDeviceMemoryProperties mem_properties{};
+  vkGetPhysicalDeviceMemoryProperties(physical_device_, &mem_properties);
+
+  for (uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i) {
+    if (mem_properties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void VulkanRenderDevice::FrameBegin() {
   assert(!frame_began_);
   
@@ -194,6 +455,8 @@ void VulkanRenderDevice::FrameEnd() {
   // vkQueueWaitIdle(graphics_queue_);
   frame_began_ = false;
   current_frame_ = (current_frame_ + 1) % kFramesInFlight;
+
+  descriptor_allocator_->NextFrame();
 }
 
 /************************************************************************************************
@@ -214,8 +477,20 @@ void VulkanRenderDevice::Init(Window* window, const DeviceFeatures* required_fea
   allocator_info.instance       = instance_;
   VULKAN_CALL(vmaCreateAllocator(&allocator_info, &allocator_));
 
-  transient_command_pool_ = CreateCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
-  main_command_pool_      = CreateCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+  uint32_t graphics_family = queue_family_indices_.graphics_family.value();
+  transient_command_pool_  = CreateCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, graphics_family);
+  main_command_pool_       = CreateCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, graphics_family);
+  compute_command_pool_    = SupportsAsyncCompute()
+                                 ? CreateCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                     queue_family_indices_.compute_family.value())
+                                 : main_command_pool_;
+
+  upload_context_       = CreateUnique<VulkanUploadContext>(*this);
+  descriptor_allocator_ = CreateUnique<VulkanDescriptorAllocator>(*this);
+
+  VkPipelineCacheCreateInfo pipeline_cache_info{};
+  pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  VULKAN_CALL(vkCreatePipelineCache(device_, &pipeline_cache_info, /*allocator=*/nullptr, &pipeline_cache_));
   
   VkFenceCreateInfo fence_info = {};
   fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
@@ -439,17 +714,24 @@ VulkanRenderDevice::QueueFamilyIndices VulkanRenderDevice::FindQueueFamilies(VkP
 
   int i = 0;
   for (const auto& queue_family : queue_families) {
-    if (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+    if ((queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphics_family.has_value()) {
       indices.graphics_family = i;
     }
+
+    /* Async compute only makes sense on a queue, which doesn't share the hardware with the graphics one */
+    if ((queue_family.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+        !indices.compute_family.has_value()) {
+      indices.compute_family = i;
+    }
     
     VkBool32 present_support = false;
     VULKAN_CALL(vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, i, window_surface_, &present_support));
-    if (present_support) {
+    if (present_support && !indices.present_family.has_value()) {
       indices.present_family = i;
     }
 
-    if (indices.graphics_family.has_value() && indices.present_family.has_value()) {
+    if (indices.graphics_family.has_value() && indices.present_family.has_value() &&
+        indices.compute_family.has_value()) {
       break;
     }
 
@@ -497,6 +779,9 @@ void VulkanRenderDevice::CreateLogicalDevice() {
   std::set<uint32_t> unique_queue_families; // Set is used in case some queue families support several operations
   unique_queue_families.insert(indices.graphics_family.value());
   unique_queue_families.insert(indices.present_family.value());
+  if (indices.compute_family.has_value()) {
+    unique_queue_families.insert(indices.compute_family.value());
+  }
 
   // Even though we are creating only one device queue, we still need to specify the priority
   float queue_priority = 1.0f;
@@ -537,6 +822,11 @@ void VulkanRenderDevice::CreateLogicalDevice() {
   queue_family_indices_ = indices;
   vkGetDeviceQueue(device_, indices.graphics_family.value(), /*queueIndex=*/0, &graphics_queue_);
   vkGetDeviceQueue(device_, indices.present_family.value(), /*queueIndex=*/0, &present_queue_);
+
+  compute_queue_ = graphics_queue_;
+  if (indices.compute_family.has_value()) {
+    vkGetDeviceQueue(device_, indices.compute_family.value(), /*queueIndex=*/0, &compute_queue_);
+  }
 }
 
 /************************************************************************************************
@@ -553,19 +843,15 @@ FenceHandle VulkanRenderDevice::CreateFence() {
   VulkanFence fence{};
   fence.vk_fence = vk_fence;
 
-  FenceHandle handle = GenNextHandle();
-  fences_.emplace(handle, std::move(fence));
+  FenceHandle handle = fences_.Emplace(std::move(fence));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteFence(FenceHandle handle) {
-  auto it = fences_.find(handle);
-  assert(it != fences_.end());
-
-  VulkanFence& fence = it->second;
+  VulkanFence& fence = GetVulkanFence(handle);
 
   vkDestroyFence(device_, fence.vk_fence, /*allocator=*/nullptr);
-  fences_.erase(it);
+  fences_.Remove(handle);
 }
 
 void VulkanRenderDevice::WaitForFences(uint32_t count, const FenceHandle* handles) {
@@ -594,19 +880,15 @@ SemaphoreHandle VulkanRenderDevice::CreateSemaphore() {
   VulkanSemaphore semaphore{};
   semaphore.vk_semaphore = vk_semaphore;
 
-  SemaphoreHandle handle = GenNextHandle();
-  semaphores_.emplace(handle, std::move(semaphore));
+  SemaphoreHandle handle = semaphores_.Emplace(std::move(semaphore));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteSemaphore(SemaphoreHandle handle) {
-  auto it = semaphores_.find(handle);
-  assert(it != semaphores_.end());
-
-  VulkanSemaphore& semaphore = it->second;
+  VulkanSemaphore& semaphore = GetVulkanSemaphore(handle);
 
   vkDestroySemaphore(device_, semaphore.vk_semaphore, /*allocator=*/nullptr);
-  semaphores_.erase(it);
+  semaphores_.Remove(handle);
 }
 
 /************************************************************************************************
@@ -706,40 +988,32 @@ SwapchainHandle VulkanRenderDevice::CreateSwapchain(TextureUsageFlags usage) {
     vulkan_texture.vk_image_view  = vk_image_views[i];
     vulkan_texture.vma_allocation = VK_NULL_HANDLE;  // Not accessible!
 
-    TextureHandle texture_handle = GenNextHandle();
-    textures_.emplace(texture_handle, std::move(vulkan_texture));
+    TextureHandle texture_handle = textures_.Emplace(std::move(vulkan_texture));
 
     swapchain.textures[i] = texture_handle;
   }
 
   /* Adding VulkanSwapchain */
-  SwapchainHandle handle = GenNextHandle();
-  swapchains_.emplace(handle, std::move(swapchain));
+  SwapchainHandle handle = swapchains_.Emplace(std::move(swapchain));
   
   return handle;
 }
 
 void VulkanRenderDevice::DeleteSwapchain(SwapchainHandle handle) {
-  auto it = swapchains_.find(handle);
-  assert(it != swapchains_.end());
-
-  VulkanSwapchain& swapchain = it->second;
+  VulkanSwapchain& swapchain = GetVulkanSwapchain(handle);
 
   /* Deleting textures */
   for (TextureHandle texture_handle : swapchain.textures) {
-    auto texture_it = textures_.find(texture_handle);
-    assert(texture_it != textures_.end());
-
     // NOTE: only need to delete the image view, because the image is owned by the vulkan swapchain itself
-    VulkanTexture& texture = texture_it->second;
+    VulkanTexture& texture = GetVulkanTexture(texture_handle);
     vkDestroyImageView(device_, texture.vk_image_view, /*allocator=*/nullptr);
 
-    textures_.erase(texture_it);
+    textures_.Remove(texture_handle);
   }
 
   /* Deleting swapchain */
   vkDestroySwapchainKHR(device_, swapchain.vk_swapchain, /*allocator=*/nullptr);
-  swapchains_.erase(it);
+  swapchains_.Remove(handle);
 }
 
 void VulkanRenderDevice::GetSwapchainTextures(SwapchainHandle swapchain_handle, uint32_t* textures_count,
@@ -849,23 +1123,20 @@ VkPresentModeKHR VulkanRenderDevice::ChooseSwapPresentMode(const VulkanSwapChain
 /************************************************************************************************
  * TEXTURE AND SAMPLER
  ************************************************************************************************/
-TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& specification) {
-  uint32_t width  = specification.width;
-  uint32_t height = specification.height;
-
+VkImageCreateInfo VulkanRenderDevice::GetImageCreateInfo(const TextureSpecification& specification) {
   uint32_t layers = GetLayerCountFromTextureType(specification);
   VULTURE_ASSERT(layers < kTextureMaxLayers,
                  "Texture cannot contain more than kTextureMaxLayers={0}, trying to create a texture with {1} layers",
                  kTextureMaxLayers, layers);
 
-  /* Create image */
-  VkImage           vk_image        = VK_NULL_HANDLE;
-  VmaAllocation     vma_allocation  = VK_NULL_HANDLE;
-  VkFormat          vk_format       = GetVKFormat(specification.format);
-  VkImageTiling     vk_tiling       = specification.cpu_readable ? VK_IMAGE_TILING_LINEAR : VK_IMAGE_TILING_OPTIMAL;
-  
+  VkImageTiling vk_tiling = specification.cpu_readable ? VK_IMAGE_TILING_LINEAR : VK_IMAGE_TILING_OPTIMAL;
+
   // We use VK_IMAGE_USAGE_TRANSFER_SRC_BIT for vkCmdBlitImage which generates mip levels for the image
   VkImageUsageFlags vk_usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+  if (specification.usage & kTextureUsageBitTransientAttachment) {
+    // Transient attachments can only be used as attachments, their contents never leave the render pass
+    vk_usage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+  }
   if (specification.usage & kTextureUsageBitSampled) {
     vk_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
   }
@@ -875,22 +1146,24 @@ TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& spec
   if (specification.usage & kTextureUsageBitDepthAttachment) {
     vk_usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
   }
+  if (specification.usage & kTextureUsageBitInputAttachment) {
+    vk_usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+  }
 
   VkImageCreateFlags vk_image_flags = 0;
   if (specification.type == TextureType::kTextureCube) {
     vk_image_flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
   }
 
-  /* Create image */
   VkImageCreateInfo image_info{};
   image_info.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
   image_info.imageType     = VK_IMAGE_TYPE_2D;
-  image_info.extent.width  = width;
-  image_info.extent.height = height;
+  image_info.extent.width  = specification.width;
+  image_info.extent.height = specification.height;
   image_info.extent.depth  = 1;
   image_info.mipLevels     = specification.mip_levels;
   image_info.arrayLayers   = layers;
-  image_info.format        = vk_format;
+  image_info.format        = GetVKFormat(specification.format);
   // If want to directly access texels in memory, then should use VK_IMAGE_TILING_LINEAR
   // VK_IMAGE_TILING_OPTIMAL - Implementation-based tiling (not necessarily row-major)
   image_info.tiling        = vk_tiling;
@@ -900,12 +1173,64 @@ TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& spec
   image_info.samples       = static_cast<VkSampleCountFlagBits>(specification.samples);
   image_info.flags         = vk_image_flags;
 
+  return image_info;
+}
+
+TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& specification) {
+  VkImageCreateInfo image_info = GetImageCreateInfo(specification);
+
   VmaAllocationCreateInfo vma_alloc_info = {};
   vma_alloc_info.usage  = (specification.cpu_readable ? VMA_MEMORY_USAGE_AUTO : VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE);
   vma_alloc_info.flags |= (specification.cpu_readable ? VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT : 0);
-  
+
+  if (specification.usage & kTextureUsageBitTransientAttachment) {
+    VULTURE_ASSERT(SupportsLazilyAllocatedMemory(), "Transient attachments require lazily allocated memory");
+    vma_alloc_info.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+  }
+
+  VkImage       vk_image       = VK_NULL_HANDLE;
+  VmaAllocation vma_allocation = VK_NULL_HANDLE;
   VULKAN_CALL(vmaCreateImage(allocator_, &image_info, &vma_alloc_info, &vk_image, &vma_allocation, nullptr));
 
+  VulkanTexture texture{specification};
+  texture.vk_image       = vk_image;
+  texture.vma_allocation = vma_allocation;
+
+  return AddTexture(std::move(texture));
+}
+
+TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& specification, DeviceMemoryHandle memory,
+                                                uint64_t offset) {
+  VULTURE_ASSERT(!specification.cpu_readable, "CPU readable textures cannot be placed in device memory");
+
+  VULTURE_ASSERT(device_memories_.Contains(memory), "Invalid device memory handle");
+  VulkanDeviceMemory& device_memory = device_memories_.Get(memory);
+
+  VkImageCreateInfo image_info = GetImageCreateInfo(specification);
+
+  VkImage vk_image = VK_NULL_HANDLE;
+  VULKAN_CALL(vkCreateImage(device_, &image_info, /*allocator=*/nullptr, &vk_image));
+
+  VkMemoryRequirements vk_requirements{};
+  vkGetImageMemoryRequirements(device_, vk_image, &vk_requirements);
+  VULTURE_ASSERT(offset % vk_requirements.alignment == 0 &&
+                     offset + vk_requirements.size <= device_memory.requirements.size,
+                 "Texture doesn't fit into the device memory at offset {0}", offset);
+
+  VULKAN_CALL(vmaBindImageMemory2(allocator_, device_memory.vma_allocation, offset, vk_image, nullptr));
+
+  VulkanTexture texture{specification};
+  texture.vk_image = vk_image;
+  texture.placed   = true;
+
+  return AddTexture(std::move(texture));
+}
+
+TextureHandle VulkanRenderDevice::AddTexture(VulkanTexture texture) {
+  const TextureSpecification& specification = texture.specification;
+
+  uint32_t layers = GetLayerCountFromTextureType(specification);
+
   /* Create image view */
   VkImageAspectFlags vk_aspect_flags = VK_IMAGE_ASPECT_NONE;
   if (IsDepthStencilDataFormat(specification.format)) {
@@ -918,9 +1243,9 @@ TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& spec
 
   VkImageViewCreateInfo view_info{};
   view_info.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-  view_info.image                           = vk_image;
+  view_info.image                           = texture.vk_image;
   view_info.viewType                        = GetVKImageViewType(specification.type);
-  view_info.format                          = vk_format;
+  view_info.format                          = GetVKFormat(specification.format);
   view_info.subresourceRange.aspectMask     = vk_aspect_flags;
   view_info.subresourceRange.baseMipLevel   = 0;
   view_info.subresourceRange.levelCount     = specification.mip_levels;
@@ -931,14 +1256,7 @@ TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& spec
   view_info.components.b                    = VK_COMPONENT_SWIZZLE_IDENTITY;
   view_info.components.a                    = VK_COMPONENT_SWIZZLE_IDENTITY;
 
-  VkImageView vk_image_view{VK_NULL_HANDLE};
-  VULKAN_CALL(vkCreateImageView(device_, &view_info, /*allocator=*/nullptr, &vk_image_view));
-
-  /* Create texture object */
-  VulkanTexture texture{specification};
-  texture.vk_image       = vk_image;
-  texture.vk_image_view  = vk_image_view;
-  texture.vma_allocation = vma_allocation;
+  VULKAN_CALL(vkCreateImageView(device_, &view_info, /*allocator=*/nullptr, &texture.vk_image_view));
 
   /* Individual layer views */
   if (specification.individual_layers_accessible && layers > 0) {
@@ -951,28 +1269,28 @@ TextureHandle VulkanRenderDevice::CreateTexture(const TextureSpecification& spec
     }
   }
 
-  TextureHandle handle = GenNextHandle();
-  textures_.emplace(handle, std::move(texture));
+  TextureHandle handle = textures_.Emplace(std::move(texture));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteTexture(TextureHandle handle) {
-  auto it = textures_.find(handle);
-  if (it != textures_.end()) {
-    if (it->second.specification.individual_layers_accessible) {
-      for (uint32_t i = 0; i < it->second.specification.array_layers; ++i) {
-        vkDestroyImageView(device_, it->second.vk_image_view_per_layer[i], /*allocator=*/nullptr);
+  if (VulkanTexture* texture = textures_.TryGet(handle)) {
+    if (texture->specification.individual_layers_accessible) {
+      for (uint32_t i = 0; i < texture->specification.array_layers; ++i) {
+        vkDestroyImageView(device_, texture->vk_image_view_per_layer[i], /*allocator=*/nullptr);
       }
     }
 
-    vkDestroyImageView(device_, it->second.vk_image_view, /*allocator=*/nullptr);
+    vkDestroyImageView(device_, texture->vk_image_view, /*allocator=*/nullptr);
 
     // If not swapchain image
-    if (it->second.vma_allocation != nullptr) {
-      vmaDestroyImage(allocator_, it->second.vk_image, it->second.vma_allocation);
+    if (texture->vma_allocation != nullptr) {
+      vmaDestroyImage(allocator_, texture->vk_image, texture->vma_allocation);
+    } else if (texture->placed) {
+      vkDestroyImage(device_, texture->vk_image, /*allocator=*/nullptr);
     }
 
-    textures_.erase(it);
+    textures_.Remove(handle);
   }
 }
 
@@ -1009,17 +1327,15 @@ SamplerHandle VulkanRenderDevice::CreateSampler(const SamplerSpecification& spec
   VulkanSampler sampler{specification};
   sampler.vk_sampler = vk_sampler;
 
-  SamplerHandle handle = GenNextHandle();
-  samplers_.emplace(handle, std::move(sampler));
+  SamplerHandle handle = samplers_.Emplace(std::move(sampler));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteSampler(SamplerHandle handle) {
-  auto it = samplers_.find(handle);
-  if (it != samplers_.end()) {
-    vkDestroySampler(device_, it->second.vk_sampler, /*allocator=*/nullptr);
+  if (VulkanSampler* sampler = samplers_.TryGet(handle)) {
+    vkDestroySampler(device_, sampler->vk_sampler, /*allocator=*/nullptr);
 
-    samplers_.erase(it);
+    samplers_.Remove(handle);
   }
 }
 
@@ -1028,6 +1344,52 @@ const SamplerSpecification& VulkanRenderDevice::GetSamplerSpecification(SamplerH
   return sampler.specification;
 }
 
+/************************************************************************************************
+ * DEVICE MEMORY
+ ************************************************************************************************/
+MemoryRequirements VulkanRenderDevice::GetTextureMemoryRequirements(const TextureSpecification& specification) {
+  VkImageCreateInfo image_info = GetImageCreateInfo(specification);
+
+  VkImage vk_image = VK_NULL_HANDLE;
+  VULKAN_CALL(vkCreateImage(device_, &image_info, /*allocator=*/nullptr, &vk_image));
+
+  VkMemoryRequirements vk_requirements{};
+  vkGetImageMemoryRequirements(device_, vk_image, &vk_requirements);
+
+  vkDestroyImage(device_, vk_image, /*allocator=*/nullptr);
+
+  MemoryRequirements requirements{};
+  requirements.size             = vk_requirements.size;
+  requirements.alignment        = vk_requirements.alignment;
+  requirements.memory_type_bits = vk_requirements.memoryTypeBits;
+
+  return requirements;
+}
+
+DeviceMemoryHandle VulkanRenderDevice::AllocateDeviceMemory(const MemoryRequirements& requirements) {
+  VkMemoryRequirements vk_requirements{};
+  vk_requirements.size           = requirements.size;
+  vk_requirements.alignment      = requirements.alignment;
+  vk_requirements.memoryTypeBits = requirements.memory_type_bits;
+
+  VmaAllocationCreateInfo vma_alloc_info{};
+  vma_alloc_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+  vma_alloc_info.flags         = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+  VulkanDeviceMemory memory{requirements};
+  VULKAN_CALL(vmaAllocateMemory(allocator_, &vk_requirements, &vma_alloc_info, &memory.vma_allocation, nullptr));
+
+  DeviceMemoryHandle handle = device_memories_.Emplace(memory);
+  return handle;
+}
+
+void VulkanRenderDevice::FreeDeviceMemory(DeviceMemoryHandle handle) {
+  if (VulkanDeviceMemory* memory = device_memories_.TryGet(handle)) {
+    vmaFreeMemory(allocator_, memory->vma_allocation);
+    device_memories_.Remove(handle);
+  }
+}
+
 /************************************************************************************************
  * BUFFER
  ************************************************************************************************/
@@ -1042,7 +1404,18 @@ BufferHandle VulkanRenderDevice::CreateBuffer(uint32_t size, BufferUsageFlags us
 	buffer_info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 	buffer_info.size        = size;
 	buffer_info.usage       = usage | (dynamic_memory ? 0 : VK_BUFFER_USAGE_TRANSFER_DST_BIT);
-  // buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;  // Owned by one queue - graphics_queue_
+
+  /* Buffers are shared between the graphics and compute queues without ownership transfers, as unlike textures they
+     don't lose anything (e.g. compression) being concurrently accessible */
+  uint32_t queue_families[] = {queue_family_indices_.graphics_family.value(),
+                               queue_family_indices_.compute_family.value_or(0)};
+  if (SupportsAsyncCompute()) {
+    buffer_info.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+    buffer_info.queueFamilyIndexCount = 2;
+    buffer_info.pQueueFamilyIndices   = queue_families;
+  } else {
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  }
 
   VmaAllocationCreateInfo vma_alloc_info = {};
   vma_alloc_info.usage = (dynamic_memory ? VMA_MEMORY_USAGE_AUTO : VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE);
@@ -1058,48 +1431,34 @@ BufferHandle VulkanRenderDevice::CreateBuffer(uint32_t size, BufferUsageFlags us
     }
   }
 
-  BufferHandle handle = GenNextHandle();
-  buffers_.emplace(handle, std::move(buffer));
+  BufferHandle handle = buffers_.Emplace(std::move(buffer));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteBuffer(BufferHandle handle) {
-  auto it = buffers_.find(handle);
-  if (it != buffers_.end()) {
-    if (it->second.dynamic_memory) {
-      vmaUnmapMemory(allocator_, it->second.vma_allocation);
+  if (VulkanBuffer* buffer = buffers_.TryGet(handle)) {
+    if (buffer->dynamic_memory) {
+      vmaUnmapMemory(allocator_, buffer->vma_allocation);
     }
 
-    vmaDestroyBuffer(allocator_, it->second.vk_buffer, it->second.vma_allocation);
-    buffers_.erase(it);
+    vmaDestroyBuffer(allocator_, buffer->vk_buffer, buffer->vma_allocation);
+    buffers_.Remove(handle);
   }
 }
 
-void VulkanRenderDevice::LoadBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) {
+UploadToken VulkanRenderDevice::LoadBufferData(BufferHandle handle, uint32_t offset, uint32_t size,
+                                               const void* data) {
   VulkanBuffer& buffer = GetVulkanBuffer(handle);
 
   if (buffer.dynamic_memory) {
     InvalidateBufferMemory(handle, offset, size);
     std::memcpy(reinterpret_cast<uint8_t*>(buffer.map_data) + offset, data, size);
     FlushBufferMemory(handle, offset, size);
-  } else {
-    /* Create staging buffer */
-    VulkanBuffer staging_buffer = CreateStagingBuffer(size);
-
-    /* Fill the staging buffer */
-    void* map_data = nullptr;
-    VULKAN_CALL(vmaMapMemory(allocator_, staging_buffer.vma_allocation, &map_data));
-    std::memcpy(map_data, data, size);
-    vmaUnmapMemory(allocator_, staging_buffer.vma_allocation);
 
-    /* Transfer data from the staging buffer to the buffer */
-    VkCommandBuffer command_buffer = BeginSingleTimeCommands();
-    CopyBuffer(command_buffer, staging_buffer.vk_buffer, buffer.vk_buffer, size, 0, offset);
-    EndSingleTimeCommands(command_buffer);
-
-    /* Free the staging buffer */
-    vmaDestroyBuffer(allocator_, staging_buffer.vk_buffer, staging_buffer.vma_allocation);
+    return kInvalidUploadToken;
   }
+
+  return upload_context_->UploadBuffer(buffer, offset, size, data);
 }
 
 void VulkanRenderDevice::InvalidateBufferMemory(BufferHandle handle, uint32_t offset, uint32_t size) {
@@ -1143,85 +1502,30 @@ DescriptorSetLayoutHandle VulkanRenderDevice::CreateDescriptorSetLayout(const De
 
   VULKAN_CALL(vkCreateDescriptorSetLayout(device_, &layout_create_info, /*allocator=*/nullptr, &vk_layout));
 
-  DescriptorSetLayoutHandle handle = GenNextHandle();
   VulkanDescriptorSetLayout layout{layout_info};
   layout.vk_layout = vk_layout;
-  descriptor_set_layouts_.emplace(handle, std::move(layout));
+  layout.hash      = CalculateLayoutInfoHash(layout_info);
 
-  return handle;
+  return descriptor_set_layouts_.Emplace(std::move(layout));
 }
 
 void VulkanRenderDevice::DeleteDescriptorSetLayout(DescriptorSetLayoutHandle layout_handle) {
-  auto it = descriptor_set_layouts_.find(layout_handle);
-  if (it != descriptor_set_layouts_.end()) {
-    vkDestroyDescriptorSetLayout(device_, it->second.vk_layout, /*allocator=*/nullptr);
-    descriptor_set_layouts_.erase(it);
+  if (VulkanDescriptorSetLayout* layout = descriptor_set_layouts_.TryGet(layout_handle)) {
+    vkDestroyDescriptorSetLayout(device_, layout->vk_layout, /*allocator=*/nullptr);
+    descriptor_set_layouts_.Remove(layout_handle);
+
+    descriptor_allocator_->ReleaseLayout(layout_handle);
   }
 }
 
 DescriptorSetHandle VulkanRenderDevice::CreateDescriptorSet(DescriptorSetLayoutHandle layout_handle) {
-  /* Get Descriptor Set Layout */
-  VulkanDescriptorSetLayout& layout = GetVulkanDescriptorSetLayout(layout_handle);
-
-  /* Descriptor Pool Sizes */
-  std::array<uint32_t, static_cast<size_t>(DescriptorType::kTotalTypes)> descriptor_counts;
-  std::memset(descriptor_counts.data(), 0, descriptor_counts.size() * sizeof(descriptor_counts[0]));
-
-  for (const auto& binding : layout.layout_info.bindings_layout_info) {
-    ++descriptor_counts[static_cast<size_t>(binding.descriptor_type)];
-  }
-
-  std::vector<VkDescriptorPoolSize> vk_pool_sizes{};
-  for (uint32_t i = 0; i < descriptor_counts.size(); ++i) {
-    DescriptorType type = static_cast<DescriptorType>(i);
-
-    if (type == DescriptorType::kInvalid || descriptor_counts[i] == 0) { continue; }
-
-    VkDescriptorPoolSize vk_pool_size{};
-    vk_pool_size.descriptorCount = descriptor_counts[i];
-    vk_pool_size.type            = GetVKDescriptorType(type);
-
-    vk_pool_sizes.emplace_back(vk_pool_size);
-  }
-
-  /* Create Descriptor Pool */
-  VkDescriptorPool vk_pool{VK_NULL_HANDLE};
-
-  VkDescriptorPoolCreateInfo pool_create_info{};
-  pool_create_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  pool_create_info.poolSizeCount = static_cast<uint32_t>(vk_pool_sizes.size());
-  pool_create_info.pPoolSizes    = vk_pool_sizes.data();
-  pool_create_info.maxSets       = 1;
-
-  VULKAN_CALL(vkCreateDescriptorPool(device_, &pool_create_info, /*allocator=*/nullptr, &vk_pool));
-
-  /* Allocate Descriptor Set */
-  VkDescriptorSet vk_set{VK_NULL_HANDLE};
-
-  VkDescriptorSetAllocateInfo alloc_info{};
-  alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-  alloc_info.descriptorPool     = vk_pool;
-  alloc_info.descriptorSetCount = 1;
-  alloc_info.pSetLayouts        = &layout.vk_layout;
-
-  VULKAN_CALL(vkAllocateDescriptorSets(device_, &alloc_info, &vk_set));
-
-  /* Create Descriptor Set */
-  VulkanDescriptorSet descriptor_set{};
-  descriptor_set.layout_handle = layout_handle;
-  descriptor_set.vk_pool       = vk_pool;
-  descriptor_set.vk_set        = vk_set;
-
-  DescriptorSetHandle handle = GenNextHandle();
-  descriptor_sets_.emplace(handle, std::move(descriptor_set));
-  return handle;
+  return descriptor_sets_.Emplace(descriptor_allocator_->Allocate(layout_handle));
 }
 
 void VulkanRenderDevice::DeleteDescriptorSet(DescriptorSetHandle handle) {
-  auto it = descriptor_sets_.find(handle);
-  if (it != descriptor_sets_.end()) {
-    vkDestroyDescriptorPool(device_, it->second.vk_pool, /*allocator=*/nullptr);
-    descriptor_sets_.erase(it);
+  if (VulkanDescriptorSet* descriptor_set = descriptor_sets_.TryGet(handle)) {
+    descriptor_allocator_->Free(*descriptor_set);
+    descriptor_sets_.Remove(handle);
   }
 }
 
@@ -1288,8 +1592,12 @@ void VulkanRenderDevice::WriteDescriptorInputAttachment(DescriptorSetHandle ds_h
   VulkanDescriptorSet& descriptor_set = GetVulkanDescriptorSet(ds_handle);
   VulkanTexture&       texture        = GetVulkanTexture(texture_handle);
 
+  VkImageLayout vk_image_layout = IsDepthContainingDataFormat(texture.specification.format)
+                                      ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                      : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
   VkDescriptorImageInfo image_info{};
-  image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  image_info.imageLayout = vk_image_layout;
   image_info.imageView   = texture.vk_image_view;
   image_info.sampler     = VK_NULL_HANDLE;
 
@@ -1431,6 +1739,8 @@ RenderPassHandle VulkanRenderDevice::CreateRenderPass(const RenderPassDescriptio
     vk_dependency.srcAccessMask = dependency.dependency_access_mask;
     // Bitmask of all memory access types used by dstSubpass
     vk_dependency.dstAccessMask = dependency.dependent_access_mask;
+    // Only the same framebuffer region is accessed, so that tile-based GPUs don't have to flush the tiles
+    vk_dependency.dependencyFlags = dependency.by_region ? VK_DEPENDENCY_BY_REGION_BIT : 0;
 
     vk_dependencies.emplace_back(std::move(vk_dependency));
   }
@@ -1450,21 +1760,24 @@ RenderPassHandle VulkanRenderDevice::CreateRenderPass(const RenderPassDescriptio
   VULKAN_CALL(vkCreateRenderPass(device_, &render_pass_create_info, /*allocator=*/nullptr, &vk_render_pass));
 
   VulkanRenderPass render_pass{render_pass_description};
-  render_pass.vk_render_pass = vk_render_pass;
+  render_pass.vk_render_pass     = vk_render_pass;
+  render_pass.compatibility_hash = CalculateCompatibilityHash(render_pass_description);
 
-  RenderPassHandle handle = GenNextHandle();
-  render_passes_.emplace(handle, std::move(render_pass));
+  RenderPassHandle handle = render_passes_.Emplace(std::move(render_pass));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteRenderPass(RenderPassHandle handle) {
-  auto it = render_passes_.find(handle);
-  if (it != render_passes_.end()) {
-    vkDestroyRenderPass(device_, it->second.vk_render_pass, /*allocator=*/nullptr);
-    render_passes_.erase(it);
+  if (VulkanRenderPass* render_pass = render_passes_.TryGet(handle)) {
+    vkDestroyRenderPass(device_, render_pass->vk_render_pass, /*allocator=*/nullptr);
+    render_passes_.Remove(handle);
   }
 }
 
+uint64_t VulkanRenderDevice::GetRenderPassCompatibilityHash(RenderPassHandle handle) {
+  return GetVulkanRenderPass(handle).compatibility_hash;
+}
+
 FramebufferHandle VulkanRenderDevice::CreateFramebuffer(const std::vector<FramebufferAttachment>& attachments,
                                                         RenderPassHandle compatible_render_pass_handle) {
   VulkanRenderPass& render_pass = GetVulkanRenderPass(compatible_render_pass_handle);
@@ -1502,16 +1815,14 @@ FramebufferHandle VulkanRenderDevice::CreateFramebuffer(const std::vector<Frameb
   VulkanFramebuffer framebuffer{};
   framebuffer.vk_framebuffer = vk_framebuffer;
 
-  FramebufferHandle handle = GenNextHandle();
-  framebuffers_.emplace(handle, std::move(framebuffer));
+  FramebufferHandle handle = framebuffers_.Emplace(std::move(framebuffer));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteFramebuffer(FramebufferHandle handle) {
-  auto it = framebuffers_.find(handle);
-  if (it != framebuffers_.end()) {
-    vkDestroyFramebuffer(device_, it->second.vk_framebuffer, /*allocator=*/nullptr);
-    framebuffers_.erase(it);
+  if (VulkanFramebuffer* framebuffer = framebuffers_.TryGet(handle)) {
+    vkDestroyFramebuffer(device_, framebuffer->vk_framebuffer, /*allocator=*/nullptr);
+    framebuffers_.Remove(handle);
   }
 }
 
@@ -1531,16 +1842,18 @@ ShaderModuleHandle VulkanRenderDevice::CreateShaderModule(ShaderModuleType type,
   VulkanShaderModule shader_module{type};
   shader_module.vk_module = vk_module;
 
-  ShaderModuleHandle handle = GenNextHandle();
-  shader_modules_.emplace(handle, std::move(shader_module));
+  for (uint32_t i = 0; i < binary_size / sizeof(uint32_t); ++i) {
+    HashCombine(shader_module.binary_hash, binary[i]);
+  }
+
+  ShaderModuleHandle handle = shader_modules_.Emplace(std::move(shader_module));
   return handle;
 }
 
 void VulkanRenderDevice::DeleteShaderModule(ShaderModuleHandle handle) {
-  auto it = shader_modules_.find(handle);
-  if (it != shader_modules_.end()) {
-    vkDestroyShaderModule(device_, it->second.vk_module, /*allocator=*/nullptr);
-    shader_modules_.erase(it);
+  if (VulkanShaderModule* shader_module = shader_modules_.TryGet(handle)) {
+    vkDestroyShaderModule(device_, shader_module->vk_module, /*allocator=*/nullptr);
+    shader_modules_.Remove(handle);
   }
 }
 
@@ -1550,6 +1863,19 @@ PipelineHandle VulkanRenderDevice::CreatePipeline(const PipelineDescription& des
   /* Get Render Pass */
   const VulkanRenderPass& render_pass = GetVulkanRenderPass(compatible_render_pass_handle);
 
+  /* Identical pipelines for compatible render passes are shared */
+  VulkanPipelineKey key{};
+  key.vk_bind_point                  = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  key.state_hash                     = CalculateStateHash(description);
+  key.render_pass_compatibility_hash = render_pass.compatibility_hash;
+  key.subpass_idx                    = subpass_idx;
+  FinishPipelineKey(key, description.shader_modules_count, description.shader_modules,
+                    description.descriptor_sets_count, description.descriptor_set_layouts);
+
+  if (PipelineHandle cached_pipeline = AcquireCachedPipeline(key); ValidRenderHandle(cached_pipeline)) {
+    return cached_pipeline;
+  }
+
   assert(subpass_idx < render_pass.description.subpasses.size());
   const SubpassDescription& subpass_description = render_pass.description.subpasses[subpass_idx];
 
@@ -1709,29 +2035,9 @@ PipelineHandle VulkanRenderDevice::CreatePipeline(const PipelineDescription& des
   vk_color_blend_info.blendConstants[3] = 0.0f;
 
   /* Pipeline layout */
-  VkPipelineLayout vk_pipeline_layout{VK_NULL_HANDLE};
-
-  std::vector<VkDescriptorSetLayout> vk_descriptor_set_layouts{description.descriptor_sets_count};
-  for (uint32_t i = 0; i < description.descriptor_sets_count; ++i) {
-    vk_descriptor_set_layouts[i] = GetVulkanDescriptorSetLayout(description.descriptor_set_layouts[i]).vk_layout;
-  }
-
-  std::vector<VkPushConstantRange> vk_push_constant_ranges{description.push_constant_ranges_count};
-  for (uint32_t i = 0; i < description.push_constant_ranges_count; ++i) {
-    vk_push_constant_ranges[i].offset     = description.push_constant_ranges[i].offset;
-    vk_push_constant_ranges[i].size       = description.push_constant_ranges[i].size;
-    vk_push_constant_ranges[i].stageFlags =
-        static_cast<VkShaderStageFlagBits>(description.push_constant_ranges[i].shader_stages);
-  }
-
-  VkPipelineLayoutCreateInfo vk_pipeline_layout_info{};
-  vk_pipeline_layout_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  vk_pipeline_layout_info.setLayoutCount         = static_cast<uint32_t>(vk_descriptor_set_layouts.size());
-  vk_pipeline_layout_info.pSetLayouts            = vk_descriptor_set_layouts.data();
-  vk_pipeline_layout_info.pushConstantRangeCount = static_cast<uint32_t>(vk_push_constant_ranges.size());
-  vk_pipeline_layout_info.pPushConstantRanges    = vk_push_constant_ranges.data();
-
-  VULKAN_CALL(vkCreatePipelineLayout(device_, &vk_pipeline_layout_info, /*allocator=*/nullptr, &vk_pipeline_layout));
+  VkPipelineLayout vk_pipeline_layout =
+      CreatePipelineLayout(description.descriptor_sets_count, description.descriptor_set_layouts,
+                           description.push_constant_ranges_count, description.push_constant_ranges);
 
   /* Graphics pipeline */
   VkPipeline vk_pipeline{VK_NULL_HANDLE};
@@ -1760,27 +2066,238 @@ PipelineHandle VulkanRenderDevice::CreatePipeline(const PipelineDescription& des
   vk_pipeline_info.basePipelineHandle  = VK_NULL_HANDLE;
   vk_pipeline_info.basePipelineIndex   = -1;
 
-  VULKAN_CALL(vkCreateGraphicsPipelines(device_, /*pipelineCache=*/VK_NULL_HANDLE, 1, &vk_pipeline_info,
+  VULKAN_CALL(vkCreateGraphicsPipelines(device_, pipeline_cache_, 1, &vk_pipeline_info,
                                         /*allocator=*/nullptr, &vk_pipeline));
 
-  PipelineHandle handle = GenNextHandle();
   VulkanPipeline pipeline{description};
   pipeline.vk_pipeline        = vk_pipeline;
   pipeline.vk_pipeline_layout = vk_pipeline_layout;
-  pipelines_.emplace(handle, std::move(pipeline));
+  pipeline.key                = key;
+
+  PipelineHandle handle = pipelines_.Emplace(std::move(pipeline));
+  pipelines_by_key_.emplace(std::move(key), handle);
+
+  return handle;
+}
+
+PipelineHandle VulkanRenderDevice::CreateComputePipeline(const ComputePipelineDescription& description) {
+  const VulkanShaderModule& shader_module = GetVulkanShaderModule(description.shader_module);
+  assert(shader_module.type == ShaderModuleType::kCompute);
+
+  VulkanPipelineKey key{};
+  key.vk_bind_point = VK_PIPELINE_BIND_POINT_COMPUTE;
+  HashCombine(key.state_hash, description.push_constant_ranges_count);
+  for (uint32_t i = 0; i < description.push_constant_ranges_count; ++i) {
+    HashCombine(key.state_hash, description.push_constant_ranges[i].offset);
+    HashCombine(key.state_hash, description.push_constant_ranges[i].size);
+    HashCombine(key.state_hash, description.push_constant_ranges[i].shader_stages);
+  }
+
+  FinishPipelineKey(key, 1, &description.shader_module, description.descriptor_sets_count,
+                    description.descriptor_set_layouts);
+
+  if (PipelineHandle cached_pipeline = AcquireCachedPipeline(key); ValidRenderHandle(cached_pipeline)) {
+    return cached_pipeline;
+  }
+
+  VkPipelineShaderStageCreateInfo vk_stage_create_info{};
+  vk_stage_create_info.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  vk_stage_create_info.stage               = VK_SHADER_STAGE_COMPUTE_BIT;
+  vk_stage_create_info.module              = shader_module.vk_module;
+  vk_stage_create_info.pName               = "main";
+  vk_stage_create_info.pSpecializationInfo = nullptr;
+
+  /* Pipeline layout */
+  VkPipelineLayout vk_pipeline_layout =
+      CreatePipelineLayout(description.descriptor_sets_count, description.descriptor_set_layouts,
+                           description.push_constant_ranges_count, description.push_constant_ranges);
+
+  /* Compute pipeline */
+  VkPipeline vk_pipeline{VK_NULL_HANDLE};
+
+  VkComputePipelineCreateInfo vk_pipeline_info{};
+  vk_pipeline_info.sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  vk_pipeline_info.stage              = vk_stage_create_info;
+  vk_pipeline_info.layout             = vk_pipeline_layout;
+  vk_pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
+  vk_pipeline_info.basePipelineIndex  = -1;
+
+  VULKAN_CALL(vkCreateComputePipelines(device_, pipeline_cache_, 1, &vk_pipeline_info,
+                                       /*allocator=*/nullptr, &vk_pipeline));
+
+  VulkanPipeline pipeline{};
+  pipeline.vk_pipeline        = vk_pipeline;
+  pipeline.vk_pipeline_layout = vk_pipeline_layout;
+  pipeline.vk_bind_point      = VK_PIPELINE_BIND_POINT_COMPUTE;
+  pipeline.key                = key;
+
+  PipelineHandle handle = pipelines_.Emplace(std::move(pipeline));
+  pipelines_by_key_.emplace(std::move(key), handle);
 
   return handle;
 }
 
 void VulkanRenderDevice::DeletePipeline(PipelineHandle handle) {
-  auto it = pipelines_.find(handle);
-  if (it != pipelines_.end()) {
-    vkDestroyPipeline(device_, it->second.vk_pipeline, /*allocator=*/nullptr);
-    vkDestroyPipelineLayout(device_, it->second.vk_pipeline_layout, /*allocator=*/nullptr);
-    pipelines_.erase(it);
+  if (VulkanPipeline* pipeline = pipelines_.TryGet(handle)) {
+    if (--pipeline->ref_count > 0) {
+      return;
+    }
+
+    pipelines_by_key_.erase(pipeline->key);
+
+    vkDestroyPipeline(device_, pipeline->vk_pipeline, /*allocator=*/nullptr);
+    vkDestroyPipelineLayout(device_, pipeline->vk_pipeline_layout, /*allocator=*/nullptr);
+    pipelines_.Remove(handle);
   }
 }
 
+bool VulkanRenderDevice::LoadPipelineCache(const std::string_view filename) {
+  std::ifstream file{std::string{filename}, std::ios::binary};
+  if (!file.is_open()) {
+    LOG_INFO("VULKAN: No pipeline cache found at {0}", filename);
+    return false;
+  }
+
+  PipelineCacheFileHeader expected_header = GetPipelineCacheFileHeader(physical_device_);
+  PipelineCacheFileHeader header{};
+
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    LOG_WARN("VULKAN: Pipeline cache {0} is corrupted", filename);
+    return false;
+  }
+
+  if (header.magic != expected_header.magic || header.vendor_id != expected_header.vendor_id ||
+      header.device_id != expected_header.device_id || header.driver_version != expected_header.driver_version ||
+      std::memcmp(header.pipeline_cache_uuid, expected_header.pipeline_cache_uuid, VK_UUID_SIZE) != 0) {
+    LOG_INFO("VULKAN: Discarding pipeline cache {0}, saved on a different device or driver version", filename);
+    return false;
+  }
+
+  /* Don't trust the size from the header before allocating for it */
+  std::streamoff data_offset = file.tellg();
+  file.seekg(0, std::ios::end);
+  std::streamoff file_size = file.tellg();
+  file.seekg(data_offset, std::ios::beg);
+
+  if (data_offset < 0 || file_size < data_offset ||
+      header.data_size > static_cast<uint64_t>(file_size - data_offset)) {
+    LOG_WARN("VULKAN: Pipeline cache {0} is corrupted", filename);
+    return false;
+  }
+
+  std::vector<char> data(header.data_size);
+  if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+    LOG_WARN("VULKAN: Pipeline cache {0} is corrupted", filename);
+    return false;
+  }
+
+  VkPipelineCacheCreateInfo pipeline_cache_info{};
+  pipeline_cache_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  pipeline_cache_info.initialDataSize = data.size();
+  pipeline_cache_info.pInitialData    = data.data();
+
+  VkPipelineCache vk_loaded_cache{VK_NULL_HANDLE};
+  VULKAN_CALL(vkCreatePipelineCache(device_, &pipeline_cache_info, /*allocator=*/nullptr, &vk_loaded_cache));
+
+  /* Keep the pipelines, which might have been created before loading */
+  VULKAN_CALL(vkMergePipelineCaches(device_, pipeline_cache_, 1, &vk_loaded_cache));
+  vkDestroyPipelineCache(device_, vk_loaded_cache, /*allocator=*/nullptr);
+
+  LOG_INFO("VULKAN: Loaded pipeline cache {0} ({1} bytes)", filename, data.size());
+  return true;
+}
+
+void VulkanRenderDevice::SavePipelineCache(const std::string_view filename) {
+  size_t data_size{0};
+  VULKAN_CALL(vkGetPipelineCacheData(device_, pipeline_cache_, &data_size, nullptr));
+
+  std::vector<char> data(data_size);
+  VULKAN_CALL(vkGetPipelineCacheData(device_, pipeline_cache_, &data_size, data.data()));
+
+  PipelineCacheFileHeader header = GetPipelineCacheFileHeader(physical_device_);
+  header.data_size = data_size;
+
+  std::ofstream file{std::string{filename}, std::ios::binary | std::ios::trunc};
+  if (!file.is_open()) {
+    LOG_ERROR("VULKAN: Unable to save the pipeline cache to {0}", filename);
+    return;
+  }
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(data.data(), static_cast<std::streamsize>(data_size));
+}
+
+/************************************************************************************************
+ * UPLOAD
+ ************************************************************************************************/
+UploadToken VulkanRenderDevice::LoadTextureData(TextureHandle handle, uint32_t size, const void* data,
+                                                bool generate_mipmaps, TextureLayout final_layout) {
+  return upload_context_->UploadTexture(GetVulkanTexture(handle), size, data, generate_mipmaps,
+                                        GetVKImageLayout(final_layout));
+}
+
+void VulkanRenderDevice::FlushUploads() {
+  upload_context_->Flush();
+}
+
+bool VulkanRenderDevice::IsUploadComplete(UploadToken token) {
+  return upload_context_->IsComplete(token);
+}
+
+void VulkanRenderDevice::WaitForUpload(UploadToken token) {
+  upload_context_->Wait(token);
+}
+
+/************************************************************************************************
+ * QUERY
+ ************************************************************************************************/
+QueryPoolHandle VulkanRenderDevice::CreateTimestampQueryPool(uint32_t queries_count) {
+  assert(queries_count > 0);
+
+  VkQueryPoolCreateInfo vk_create_info{};
+  vk_create_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  vk_create_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+  vk_create_info.queryCount = queries_count;
+
+  VkPhysicalDeviceProperties device_properties{};
+  vkGetPhysicalDeviceProperties(physical_device_, &device_properties);
+
+  VulkanQueryPool query_pool{};
+  query_pool.queries_count    = queries_count;
+  query_pool.timestamp_period = device_properties.limits.timestampPeriod;
+  VULKAN_CALL(vkCreateQueryPool(device_, &vk_create_info, /*allocator=*/nullptr, &query_pool.vk_query_pool));
+
+  QueryPoolHandle handle = query_pools_.Emplace(query_pool);
+  return handle;
+}
+
+void VulkanRenderDevice::DeleteQueryPool(QueryPoolHandle query_pool) {
+  if (VulkanQueryPool* vulkan_query_pool = query_pools_.TryGet(query_pool)) {
+    vkDestroyQueryPool(device_, vulkan_query_pool->vk_query_pool, /*allocator=*/nullptr);
+    query_pools_.Remove(query_pool);
+  }
+}
+
+bool VulkanRenderDevice::GetTimestamps(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count,
+                                       uint64_t* timestamps) {
+  VulkanQueryPool& vulkan_query_pool = GetVulkanQueryPool(query_pool);
+  assert(first_query + count <= vulkan_query_pool.queries_count);
+
+  /* Without VK_QUERY_RESULT_WAIT_BIT returns VK_NOT_READY if any of the queries is not available yet */
+  VkResult result = vkGetQueryPoolResults(device_, vulkan_query_pool.vk_query_pool, first_query, count,
+                                          count * sizeof(uint64_t), timestamps, sizeof(uint64_t),
+                                          VK_QUERY_RESULT_64_BIT);
+  if (result != VK_SUCCESS) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    timestamps[i] = static_cast<uint64_t>(static_cast<double>(timestamps[i]) * vulkan_query_pool.timestamp_period);
+  }
+
+  return true;
+}
+
 /************************************************************************************************
  * COMMAND BUFFER
  ************************************************************************************************/
@@ -1795,73 +2312,53 @@ void VulkanRenderDevice::DeleteCommandBuffer(CommandBuffer* command_buffer) {
 }
 
 VulkanFence& VulkanRenderDevice::GetVulkanFence(FenceHandle handle) {
-  auto it = fences_.find(handle);
-  assert(it != fences_.end());
-  return it->second;
+  return fences_.Get(handle);
 }
 
 VulkanSemaphore& VulkanRenderDevice::GetVulkanSemaphore(SemaphoreHandle handle) {
-  auto it = semaphores_.find(handle);
-  assert(it != semaphores_.end());
-  return it->second;
+  return semaphores_.Get(handle);
 }
 
 VulkanTexture& VulkanRenderDevice::GetVulkanTexture(TextureHandle handle) {
-  auto it = textures_.find(handle);
-  assert(it != textures_.end());
-  return it->second;
+  return textures_.Get(handle);
 }
 
 VulkanSampler& VulkanRenderDevice::GetVulkanSampler(SamplerHandle handle) {
-  auto it = samplers_.find(handle);
-  assert(it != samplers_.end());
-  return it->second;
+  return samplers_.Get(handle);
 }
 
 VulkanBuffer& VulkanRenderDevice::GetVulkanBuffer(BufferHandle handle) {
-  auto it = buffers_.find(handle);
-  assert(it != buffers_.end());
-  return it->second;
+  return buffers_.Get(handle);
 }
 
 VulkanDescriptorSetLayout& VulkanRenderDevice::GetVulkanDescriptorSetLayout(DescriptorSetLayoutHandle handle) {
-  auto it = descriptor_set_layouts_.find(handle);
-  assert(it != descriptor_set_layouts_.end());
-  return it->second;
+  return descriptor_set_layouts_.Get(handle);
 }
 
 VulkanDescriptorSet& VulkanRenderDevice::GetVulkanDescriptorSet(DescriptorSetHandle handle) {
-  auto it = descriptor_sets_.find(handle);
-  assert(it != descriptor_sets_.end());
-  return it->second;
+  return descriptor_sets_.Get(handle);
 }
 
 VulkanRenderPass& VulkanRenderDevice::GetVulkanRenderPass(RenderPassHandle handle) {
-  auto it = render_passes_.find(handle);
-  assert(it != render_passes_.end());
-  return it->second;
+  return render_passes_.Get(handle);
 }
 
 VulkanFramebuffer& VulkanRenderDevice::GetVulkanFramebuffer(FramebufferHandle handle) {
-  auto it = framebuffers_.find(handle);
-  assert(it != framebuffers_.end());
-  return it->second;
+  return framebuffers_.Get(handle);
 }
 
 VulkanShaderModule& VulkanRenderDevice::GetVulkanShaderModule(ShaderModuleHandle handle) {
-  auto it = shader_modules_.find(handle);
-  assert(it != shader_modules_.end());
-  return it->second;
+  return shader_modules_.Get(handle);
 }
 
 VulkanPipeline& VulkanRenderDevice::GetVulkanPipeline(PipelineHandle handle) {
-  auto it = pipelines_.find(handle);
-  assert(it != pipelines_.end());
-  return it->second;
+  return pipelines_.Get(handle);
 }
 
 VulkanSwapchain& VulkanRenderDevice::GetVulkanSwapchain(SwapchainHandle handle) {
-  auto it = swapchains_.find(handle);
-  assert(it != swapchains_.end());
-  return it->second;
+  return swapchains_.Get(handle);
+}
+
+VulkanQueryPool& VulkanRenderDevice::GetVulkanQueryPool(QueryPoolHandle handle) {
+  return query_pools_.Get(handle);
 }
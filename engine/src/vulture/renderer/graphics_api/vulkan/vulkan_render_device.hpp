@@ -42,13 +42,17 @@
 #include <vk_mem_alloc.h>
 #pragma GCC diagnostic pop
 
-#include <map>
+#include <unordered_map>
 
+#include <vulture/core/handle_pool.hpp>
 #include <vulture/platform/window.hpp>
 #include <vulture/renderer/graphics_api/render_device.hpp>
 
 namespace vulture {
 
+class VulkanUploadContext;
+class VulkanDescriptorAllocator;
+
 struct VulkanFence {
   VkFence vk_fence{VK_NULL_HANDLE};
 };
@@ -67,9 +71,19 @@ struct VulkanTexture {
 
   VkImageView         vk_image_view_per_layer[kTextureMaxLayers]{VK_NULL_HANDLE};
 
+  bool                placed{false};  ///< Placed in a VulkanDeviceMemory, which it doesn't own
+
   TextureSpecification specification{};
 };
 
+struct VulkanDeviceMemory {
+  VulkanDeviceMemory() = default;
+  VulkanDeviceMemory(const MemoryRequirements& requirements) : requirements(requirements) {}
+
+  VmaAllocation      vma_allocation{nullptr};
+  MemoryRequirements requirements{};
+};
+
 struct VulkanSampler {
   VulkanSampler() = default;
   VulkanSampler(const SamplerSpecification& specification) : specification(specification) {}
@@ -91,14 +105,15 @@ struct VulkanDescriptorSetLayout {
 
   DescriptorSetLayoutInfo layout_info{};
   VkDescriptorSetLayout   vk_layout{VK_NULL_HANDLE};
+  uint64_t                hash{0};  ///< Of the layout info, the same for identically defined layouts
 };
 
 struct VulkanDescriptorSet {
   VulkanDescriptorSet() = default;
 
   DescriptorSetLayoutHandle layout_handle{kInvalidRenderResourceHandle};  // Not owned by the set
-  VkDescriptorPool          vk_pool{VK_NULL_HANDLE};  // FIXME: make a pool of VkDescriptorPools to reuse
-  VkDescriptorSet           vk_set{VK_NULL_HANDLE};  // Automaticaly freed when destroying descriptor pool
+  VkDescriptorPool          vk_pool{VK_NULL_HANDLE};  // Shared with other sets, owned by the descriptor allocator
+  VkDescriptorSet           vk_set{VK_NULL_HANDLE};
 };
 
 struct VulkanRenderPass {
@@ -107,6 +122,7 @@ struct VulkanRenderPass {
 
   RenderPassDescription description{};
   VkRenderPass          vk_render_pass{VK_NULL_HANDLE};
+  uint64_t              compatibility_hash{0};
 };
 
 struct VulkanFramebuffer {
@@ -120,15 +136,48 @@ struct VulkanShaderModule {
 
   ShaderModuleType type{ShaderModuleType::kInvalid};
   VkShaderModule   vk_module{VK_NULL_HANDLE};
+  uint64_t         binary_hash{0};
+};
+
+/**
+ * @brief Inputs identifying a pipeline, identical pipelines for compatible render passes share the handle.
+ *
+ * The inputs are compared on lookup, so that pipelines whose combined hashes collide are never mixed up.
+ */
+struct VulkanPipelineKey {
+  VkPipelineBindPoint   vk_bind_point{VK_PIPELINE_BIND_POINT_GRAPHICS};
+  uint64_t              state_hash{0};                      ///< Fixed function state and push constants
+  uint64_t              render_pass_compatibility_hash{0};  ///< Graphics pipelines only
+  uint32_t              subpass_idx{0};                     ///< Graphics pipelines only
+  std::vector<uint64_t> shader_module_hashes;               ///< Stage and binary hash of each module
+  std::vector<uint64_t> descriptor_set_layout_hashes;
+
+  uint64_t              hash{0};  ///< Combined hash of all the inputs above
+
+  bool operator==(const VulkanPipelineKey& other) const;
+};
+
+struct VulkanPipelineKeyHasher {
+  size_t operator()(const VulkanPipelineKey& key) const { return static_cast<size_t>(key.hash); }
 };
 
 struct VulkanPipeline {
   VulkanPipeline() = default;
   VulkanPipeline(const PipelineDescription& description) : description(description) {}
 
-  PipelineDescription description{};
+  PipelineDescription description{};  ///< Of the first pipeline created with the key
   VkPipeline          vk_pipeline{VK_NULL_HANDLE};
   VkPipelineLayout    vk_pipeline_layout{VK_NULL_HANDLE};
+  VkPipelineBindPoint vk_bind_point{VK_PIPELINE_BIND_POINT_GRAPHICS};
+
+  VulkanPipelineKey   key{};         ///< Identical pipelines share the handle, see VulkanRenderDevice::CreatePipeline
+  uint32_t            ref_count{1};  ///< Number of times the handle has been returned and not deleted yet
+};
+
+struct VulkanQueryPool {
+  VkQueryPool vk_query_pool{VK_NULL_HANDLE};
+  uint32_t    queries_count{0};
+  float       timestamp_period{1.0f};  ///< Nanoseconds per timestamp tick
 };
 
 struct VulkanSwapChainSupportDetails {
@@ -152,6 +201,7 @@ class VulkanRenderDevice final : public RenderDevice {
   struct QueueFamilyIndices {
     std::optional<uint32_t> graphics_family;
     std::optional<uint32_t> present_family;
+    std::optional<uint32_t> compute_family;  ///< Dedicated, i.e. without graphics support
   };
 
  public:
@@ -165,6 +215,9 @@ class VulkanRenderDevice final : public RenderDevice {
   void FrameBegin() override;
   void FrameEnd() override;
 
+  bool SupportsAsyncCompute() const override;
+  bool SupportsLazilyAllocatedMemory() const override;
+
   /************************************************************************************************
    * INIT
    ************************************************************************************************/
@@ -214,13 +267,24 @@ class VulkanRenderDevice final : public RenderDevice {
 
   const SamplerSpecification& GetSamplerSpecification(SamplerHandle sampler) override;
 
+  /************************************************************************************************
+   * DEVICE MEMORY
+   ************************************************************************************************/
+  MemoryRequirements GetTextureMemoryRequirements(const TextureSpecification& specification) override;
+
+  DeviceMemoryHandle AllocateDeviceMemory(const MemoryRequirements& requirements) override;
+  void FreeDeviceMemory(DeviceMemoryHandle memory) override;
+
+  TextureHandle CreateTexture(const TextureSpecification& specification, DeviceMemoryHandle memory,
+                              uint64_t offset) override;
+
   /************************************************************************************************
    * BUFFER
    ************************************************************************************************/
   BufferHandle CreateBuffer(uint32_t size, BufferUsageFlags usage, bool dynamic_memory, void** map_data) override;
   void DeleteBuffer(BufferHandle buffer) override;
 
-  void LoadBufferData(BufferHandle buffer, uint32_t offset, uint32_t size, const void* data) override;
+  UploadToken LoadBufferData(BufferHandle buffer, uint32_t offset, uint32_t size, const void* data) override;
 
   void InvalidateBufferMemory(BufferHandle buffer, uint32_t offset, uint32_t size) override;
   void FlushBufferMemory(BufferHandle buffer, uint32_t offset, uint32_t size) override;
@@ -249,6 +313,7 @@ class VulkanRenderDevice final : public RenderDevice {
    ************************************************************************************************/
   RenderPassHandle CreateRenderPass(const RenderPassDescription& render_pass_description) override;
   void DeleteRenderPass(RenderPassHandle render_pass) override;
+  uint64_t GetRenderPassCompatibilityHash(RenderPassHandle render_pass) override;
 
   FramebufferHandle CreateFramebuffer(const std::vector<FramebufferAttachment>& attachments,
                                       RenderPassHandle compatible_render_pass) override;
@@ -262,8 +327,30 @@ class VulkanRenderDevice final : public RenderDevice {
 
   PipelineHandle CreatePipeline(const PipelineDescription& description, RenderPassHandle compatible_render_pass,
                                 uint32_t subpass_idx) override;
+  PipelineHandle CreateComputePipeline(const ComputePipelineDescription& description) override;
   void DeletePipeline(PipelineHandle pipeline) override;
 
+  bool LoadPipelineCache(const std::string_view filename) override;
+  void SavePipelineCache(const std::string_view filename) override;
+
+  /************************************************************************************************
+   * UPLOAD
+   ************************************************************************************************/
+  UploadToken LoadTextureData(TextureHandle texture, uint32_t size, const void* data, bool generate_mipmaps,
+                              TextureLayout final_layout) override;
+
+  void FlushUploads() override;
+  bool IsUploadComplete(UploadToken token) override;
+  void WaitForUpload(UploadToken token) override;
+
+  /************************************************************************************************
+   * QUERY
+   ************************************************************************************************/
+  QueryPoolHandle CreateTimestampQueryPool(uint32_t queries_count) override;
+  void DeleteQueryPool(QueryPoolHandle query_pool) override;
+
+  bool GetTimestamps(QueryPoolHandle query_pool, uint32_t first_query, uint32_t count, uint64_t* timestamps) override;
+
   /************************************************************************************************
    * COMMAND BUFFER
    ************************************************************************************************/
@@ -271,8 +358,6 @@ class VulkanRenderDevice final : public RenderDevice {
   void DeleteCommandBuffer(CommandBuffer* command_buffer) override;
 
  private:
-  uint32_t GenNextHandle();
-
   VulkanFence&               GetVulkanFence(FenceHandle);
   VulkanSemaphore&           GetVulkanSemaphore(SemaphoreHandle);
   VulkanTexture&             GetVulkanTexture(TextureHandle);
@@ -285,15 +370,41 @@ class VulkanRenderDevice final : public RenderDevice {
   VulkanShaderModule&        GetVulkanShaderModule(ShaderModuleHandle);
   VulkanPipeline&            GetVulkanPipeline(PipelineHandle);
   VulkanSwapchain&           GetVulkanSwapchain(SwapchainHandle);
+  VulkanQueryPool&           GetVulkanQueryPool(QueryPoolHandle);
+
+  VkImageCreateInfo GetImageCreateInfo(const TextureSpecification& specification);
+  TextureHandle AddTexture(VulkanTexture texture);
 
   VulkanBuffer CreateStagingBuffer(VkDeviceSize size);
 
+  /**
+   * @brief Add the hashes of the shader modules' binaries and of the descriptor set layouts' infos to the key and
+   *        combine all of its inputs into the key's hash, so that the pipelines created from identical shaders loaded
+   *        separately have the same key.
+   */
+  void FinishPipelineKey(VulkanPipelineKey& key, uint32_t shader_modules_count, const ShaderModuleHandle* shader_modules,
+                         uint32_t descriptor_sets_count, const DescriptorSetLayoutHandle* descriptor_set_layouts);
+
+  /**
+   * @brief Get the existing pipeline with the key, incrementing its reference count.
+   * @return kInvalidRenderResourceHandle if there is none.
+   */
+  PipelineHandle AcquireCachedPipeline(const VulkanPipelineKey& key);
+
+  VkPipelineLayout CreatePipelineLayout(uint32_t descriptor_sets_count,
+                                        const DescriptorSetLayoutHandle* descriptor_set_layouts,
+                                        uint32_t push_constant_ranges_count,
+                                        const PushConstantRange* push_constant_ranges);
+
   uint32_t FindMemoryType(uint32_t type_filter, VkMemoryPropertyFlags properties);
   void CopyBuffer(VkCommandBuffer command_buffer, VkBuffer src_buffer, VkBuffer dst_buffer, VkDeviceSize size,
                   VkDeviceSize src_offset = 0, VkDeviceSize dst_offset = 0);
+  void GenerateMipmaps(VkCommandBuffer command_buffer, VulkanTexture& texture, VkImageLayout vk_final_layout);
 
-  VkCommandPool CreateCommandPool(VkCommandPoolCreateFlags flags);
-  VkCommandBuffer CreateCommandBuffer(VkCommandPool command_pool);
+  VkCommandPool CreateCommandPool(VkCommandPoolCreateFlags flags, uint32_t queue_family);
+  uint32_t GetQueueFamily(CommandBufferType queue) const;
+  VkCommandBuffer CreateCommandBuffer(VkCommandPool command_pool,
+                                      VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
   VkCommandBuffer BeginSingleTimeCommands();
   void EndSingleTimeCommands(VkCommandBuffer command_buffer);
@@ -338,9 +449,17 @@ class VulkanRenderDevice final : public RenderDevice {
   VkQueue graphics_queue_{VK_NULL_HANDLE};
   /** @note Destroyed implicitly when the device is destroyed */
   VkQueue present_queue_{VK_NULL_HANDLE};
+  /** @note Destroyed implicitly when the device is destroyed, same as graphics_queue_ if there is no dedicated one */
+  VkQueue compute_queue_{VK_NULL_HANDLE};
 
   VkCommandPool transient_command_pool_{VK_NULL_HANDLE};
   VkCommandPool main_command_pool_{VK_NULL_HANDLE};
+  VkCommandPool compute_command_pool_{VK_NULL_HANDLE};  ///< Same as main_command_pool_ if no dedicated compute queue
+
+  UniquePtr<VulkanUploadContext>       upload_context_;
+  UniquePtr<VulkanDescriptorAllocator> descriptor_allocator_;
+
+  VkPipelineCache pipeline_cache_{VK_NULL_HANDLE};  ///< Used for creating all pipelines
 
   bool frame_began_{false};
   uint32_t current_frame_{0};
@@ -348,21 +467,26 @@ class VulkanRenderDevice final : public RenderDevice {
   uint32_t current_swapchain_texture_idx_{0};
   VkFence fence_swapchain_image_available_{VK_NULL_HANDLE};  // FIXME: Don't wait on image acquiring
 
-  uint32_t next_handle_{1};
-  std::map<FenceHandle, VulkanFence>                             fences_;
-  std::map<SemaphoreHandle, VulkanSemaphore>                     semaphores_;
-  std::map<SwapchainHandle, VulkanSwapchain>                     swapchains_;
-  std::map<TextureHandle, VulkanTexture>                         textures_;
-  std::map<SamplerHandle, VulkanSampler>                         samplers_;
-  std::map<BufferHandle, VulkanBuffer>                           buffers_;
-  std::map<DescriptorSetLayoutHandle, VulkanDescriptorSetLayout> descriptor_set_layouts_;
-  std::map<DescriptorSetHandle, VulkanDescriptorSet>             descriptor_sets_;
-  std::map<RenderPassHandle, VulkanRenderPass>                   render_passes_;
-  std::map<FramebufferHandle, VulkanFramebuffer>                 framebuffers_;
-  std::map<ShaderModuleHandle, VulkanShaderModule>               shader_modules_;
-  std::map<PipelineHandle, VulkanPipeline>                       pipelines_;
+  HandlePool<VulkanFence>               fences_;
+  HandlePool<VulkanSemaphore>           semaphores_;
+  HandlePool<VulkanSwapchain>           swapchains_;
+  HandlePool<VulkanTexture>             textures_;
+  HandlePool<VulkanDeviceMemory>        device_memories_;
+  HandlePool<VulkanSampler>             samplers_;
+  HandlePool<VulkanBuffer>              buffers_;
+  HandlePool<VulkanDescriptorSetLayout> descriptor_set_layouts_;
+  HandlePool<VulkanDescriptorSet>       descriptor_sets_;
+  HandlePool<VulkanRenderPass>          render_passes_;
+  HandlePool<VulkanFramebuffer>         framebuffers_;
+  HandlePool<VulkanShaderModule>        shader_modules_;
+  HandlePool<VulkanPipeline>            pipelines_;
+  HandlePool<VulkanQueryPool>           query_pools_;
+
+  std::unordered_map<VulkanPipelineKey, PipelineHandle, VulkanPipelineKeyHasher> pipelines_by_key_;
 
   friend class VulkanCommandBuffer;  // FIXME: (tralf-strues)
+  friend class VulkanUploadContext;
+  friend class VulkanDescriptorAllocator;
   friend class VulkanImGuiImplementation;  // FIXME: (tralf-strues)
 };
 
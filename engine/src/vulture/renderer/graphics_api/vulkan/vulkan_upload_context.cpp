@@ -0,0 +1,336 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file vulkan_upload_context.cpp
+ * @date 2023-06-27
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/renderer/graphics_api/vulkan/vulkan_upload_context.hpp>
+#include <vulture/renderer/graphics_api/vulkan/vulkan_utils.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vulture;
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+VulkanUploadContext::VulkanUploadContext(VulkanRenderDevice& device) : device_(device) {
+  vk_command_pool_ =
+      device_.CreateCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                device_.queue_family_indices_.graphics_family.value());
+
+  VkBufferCreateInfo buffer_info{};
+  buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  buffer_info.size  = kStagingRingSize;
+  buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+  VmaAllocationCreateInfo alloc_info{};
+  alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
+  alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VmaAllocationInfo allocation_info{};
+  VULKAN_CALL(vmaCreateBuffer(device_.allocator_, &buffer_info, &alloc_info, &staging_ring_.vk_buffer,
+                              &staging_ring_.vma_allocation, &allocation_info));
+
+  staging_ring_.dynamic_memory = true;
+  staging_ring_.map_data       = allocation_info.pMappedData;
+}
+
+VulkanUploadContext::~VulkanUploadContext() {
+  Flush();
+  while (!submitted_batches_.empty()) {
+    WaitForOldestBatch();
+  }
+
+  for (Batch& batch : free_batches_) {
+    vkDestroyFence(device_.device_, batch.vk_fence, /*allocator=*/nullptr);
+  }
+
+  /* Frees all the command buffers as well */
+  vkDestroyCommandPool(device_.device_, vk_command_pool_, /*allocator=*/nullptr);
+
+  vmaDestroyBuffer(device_.allocator_, staging_ring_.vk_buffer, staging_ring_.vma_allocation);
+}
+
+UploadToken VulkanUploadContext::UploadBuffer(VulkanBuffer& buffer, VkDeviceSize offset, VkDeviceSize size,
+                                              const void* data) {
+  StagingRegion region = StageData(size, data);
+
+  Batch& batch = GetRecordingBatch();
+  device_.CopyBuffer(batch.vk_command_buffer, region.vk_buffer, buffer.vk_buffer, size, region.offset, offset);
+
+  return batch.token;
+}
+
+UploadToken VulkanUploadContext::UploadTexture(VulkanTexture& texture, VkDeviceSize size, const void* data,
+                                               bool generate_mipmaps, VkImageLayout final_layout) {
+  StagingRegion region = StageData(size, data);
+
+  Batch& batch = GetRecordingBatch();
+
+  uint32_t layers_count = GetLayerCountFromTextureType(texture.specification);
+
+  VkImageMemoryBarrier barrier{};
+  barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+  barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image                           = texture.vk_image;
+  barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel   = 0;
+  barrier.subresourceRange.levelCount     = texture.specification.mip_levels;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount     = layers_count;
+  barrier.srcAccessMask                   = 0;
+  barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(batch.vk_command_buffer,
+                       /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       /*dstStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       /*dependencyFlags=*/0,
+                       /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                       /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                       /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
+
+  VkBufferImageCopy copy_region{};
+  copy_region.bufferOffset                    = region.offset;
+  copy_region.bufferRowLength                 = 0;  // Tightly packed
+  copy_region.bufferImageHeight               = 0;
+  copy_region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+  copy_region.imageSubresource.mipLevel       = 0;
+  copy_region.imageSubresource.baseArrayLayer = 0;
+  copy_region.imageSubresource.layerCount     = layers_count;
+  copy_region.imageOffset                     = {0, 0, 0};
+  copy_region.imageExtent                     = {texture.specification.width, texture.specification.height, 1};
+
+  vkCmdCopyBufferToImage(batch.vk_command_buffer, region.vk_buffer, texture.vk_image,
+                         /*dstImageLayout=*/VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, /*regionCount=*/1, &copy_region);
+
+  if (generate_mipmaps) {
+    device_.GenerateMipmaps(batch.vk_command_buffer, texture, final_layout);
+  } else {
+    barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout     = final_layout;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;  // Made visible by the barrier at the end of the batch
+
+    vkCmdPipelineBarrier(batch.vk_command_buffer,
+                         /*srcStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         /*dstStageMask=*/VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         /*dependencyFlags=*/0,
+                         /*memoryBarrierCount=*/0, /*pMemoryBarriers=*/nullptr,
+                         /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                         /*imageMemoryBarrierCount=*/1, /*pImageMemoryBarriers=*/&barrier);
+  }
+
+  return batch.token;
+}
+
+void VulkanUploadContext::Flush() {
+  if (!recording_) {
+    RetireCompletedBatches();
+    return;
+  }
+
+  /* Make the uploaded data visible to everything submitted after the batch */
+  VkMemoryBarrier memory_barrier{};
+  memory_barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  memory_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+  vkCmdPipelineBarrier(recording_batch_.vk_command_buffer,
+                       /*srcStageMask=*/VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       /*dstStageMask=*/VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       /*dependencyFlags=*/0,
+                       /*memoryBarrierCount=*/1, /*pMemoryBarriers=*/&memory_barrier,
+                       /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                       /*imageMemoryBarrierCount=*/0, /*pImageMemoryBarriers=*/nullptr);
+
+  VULKAN_CALL(vkEndCommandBuffer(recording_batch_.vk_command_buffer));
+
+  VkSubmitInfo submit_info{};
+  submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submit_info.commandBufferCount = 1;
+  submit_info.pCommandBuffers    = &recording_batch_.vk_command_buffer;
+
+  VULKAN_CALL(vkQueueSubmit(device_.graphics_queue_, /*submitCount=*/1, &submit_info, recording_batch_.vk_fence));
+
+  recording_batch_.staging_end = staging_head_;
+  submitted_batches_.push_back(std::move(recording_batch_));
+
+  recording_batch_ = Batch{};
+  recording_       = false;
+
+  RetireCompletedBatches();
+}
+
+bool VulkanUploadContext::IsComplete(UploadToken token) {
+  RetireCompletedBatches();
+  return token <= completed_token_;
+}
+
+void VulkanUploadContext::Wait(UploadToken token) {
+  if (recording_ && token >= recording_batch_.token) {
+    Flush();
+  }
+
+  while (token > completed_token_ && !submitted_batches_.empty()) {
+    WaitForOldestBatch();
+  }
+}
+
+UploadToken VulkanUploadContext::GetLastSubmittedToken() const {
+  return submitted_batches_.empty() ? completed_token_ : submitted_batches_.back().token;
+}
+
+VulkanUploadContext::StagingRegion VulkanUploadContext::StageData(VkDeviceSize size, const void* data) {
+  assert(size > 0);
+  assert(data != nullptr);
+
+  /* Too big for the ring, so use a dedicated staging buffer */
+  if (size > kStagingRingSize) {
+    VulkanBuffer staging_buffer = device_.CreateStagingBuffer(size);
+
+    void* map_data = nullptr;
+    VULKAN_CALL(vmaMapMemory(device_.allocator_, staging_buffer.vma_allocation, &map_data));
+    std::memcpy(map_data, data, size);
+    VULKAN_CALL(vmaFlushAllocation(device_.allocator_, staging_buffer.vma_allocation, 0, size));
+    vmaUnmapMemory(device_.allocator_, staging_buffer.vma_allocation);
+
+    GetRecordingBatch().dedicated_staging_buffers.push_back(staging_buffer);
+
+    return StagingRegion{staging_buffer.vk_buffer, 0};
+  }
+
+  uint64_t position = 0;
+  while (true) {
+    if (staging_head_ == staging_tail_) {
+      /* Nothing is in use, so start from the beginning of the ring */
+      staging_head_ = AlignUp(staging_head_, kStagingRingSize);
+      staging_tail_ = staging_head_;
+    }
+
+    /* Data must be contiguous, so skip the rest of the ring if it doesn't fit */
+    position = AlignUp(staging_head_, kStagingAlignment);
+    if ((position % kStagingRingSize) + size > kStagingRingSize) {
+      position = AlignUp(position, kStagingRingSize);
+    }
+
+    if (position + size - staging_tail_ <= kStagingRingSize) {
+      break;
+    }
+
+    /* Not enough free space, wait for the oldest batch to release its part of the ring */
+    if (submitted_batches_.empty()) {
+      Flush();
+    }
+
+    WaitForOldestBatch();
+  }
+
+  staging_head_ = position + size;
+
+  VkDeviceSize offset = position % kStagingRingSize;
+  std::memcpy(static_cast<uint8_t*>(staging_ring_.map_data) + offset, data, size);
+  VULKAN_CALL(vmaFlushAllocation(device_.allocator_, staging_ring_.vma_allocation, offset, size));
+
+  return StagingRegion{staging_ring_.vk_buffer, offset};
+}
+
+VulkanUploadContext::Batch& VulkanUploadContext::GetRecordingBatch() {
+  if (recording_) {
+    return recording_batch_;
+  }
+
+  if (!free_batches_.empty()) {
+    recording_batch_ = std::move(free_batches_.back());
+    free_batches_.pop_back();
+  } else {
+    recording_batch_.vk_command_buffer = device_.CreateCommandBuffer(vk_command_pool_);
+
+    VkFenceCreateInfo fence_info{};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VULKAN_CALL(vkCreateFence(device_.device_, &fence_info, /*allocator=*/nullptr, &recording_batch_.vk_fence));
+  }
+
+  recording_batch_.token = next_token_++;
+  recording_             = true;
+
+  VkCommandBufferBeginInfo begin_info{};
+  begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  VULKAN_CALL(vkBeginCommandBuffer(recording_batch_.vk_command_buffer, &begin_info));
+
+  /* Wait for the previously submitted work to finish accessing the resources about to be overwritten */
+  VkMemoryBarrier memory_barrier{};
+  memory_barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  memory_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(recording_batch_.vk_command_buffer,
+                       /*srcStageMask=*/VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       /*dstStageMask=*/VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       /*dependencyFlags=*/0,
+                       /*memoryBarrierCount=*/1, /*pMemoryBarriers=*/&memory_barrier,
+                       /*bufferMemoryBarrierCount=*/0, /*pBufferMemoryBarriers=*/nullptr,
+                       /*imageMemoryBarrierCount=*/0, /*pImageMemoryBarriers=*/nullptr);
+
+  return recording_batch_;
+}
+
+void VulkanUploadContext::RetireCompletedBatches() {
+  while (!submitted_batches_.empty() &&
+         vkGetFenceStatus(device_.device_, submitted_batches_.front().vk_fence) == VK_SUCCESS) {
+    RetireBatch(submitted_batches_.front());
+    submitted_batches_.pop_front();
+  }
+}
+
+void VulkanUploadContext::WaitForOldestBatch() {
+  assert(!submitted_batches_.empty());
+
+  VULKAN_CALL(vkWaitForFences(device_.device_, 1, &submitted_batches_.front().vk_fence, /*waitAll=*/VK_TRUE,
+                              /*timeout=*/UINT64_MAX));
+
+  RetireCompletedBatches();
+}
+
+void VulkanUploadContext::RetireBatch(Batch& batch) {
+  completed_token_ = batch.token;
+  staging_tail_    = std::max(staging_tail_, batch.staging_end);
+
+  for (VulkanBuffer& staging_buffer : batch.dedicated_staging_buffers) {
+    vmaDestroyBuffer(device_.allocator_, staging_buffer.vk_buffer, staging_buffer.vma_allocation);
+  }
+
+  batch.dedicated_staging_buffers.clear();
+
+  VULKAN_CALL(vkResetFences(device_.device_, 1, &batch.vk_fence));
+  VULKAN_CALL(vkResetCommandBuffer(batch.vk_command_buffer, /*flags=*/0));
+
+  free_batches_.push_back(std::move(batch));
+}
@@ -0,0 +1,121 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file vulkan_upload_context.hpp
+ * @date 2023-06-27
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <vulture/renderer/graphics_api/vulkan/vulkan_render_device.hpp>
+
+namespace vulture {
+
+/**
+ * @brief Batches uploads of static buffers and textures, so that they don't stall the CPU.
+ *
+ * Data is copied to a persistently mapped staging ring buffer and transfer commands are recorded into the current
+ * batch. Each submitted batch signals its own fence, which tells when the batch's staging memory can be reused.
+ * Data not fitting into the ring is staged in a dedicated buffer, freed along with the batch.
+ *
+ * Batches are submitted to the graphics queue, because generating mipmaps requires blitting, and every batch starts
+ * and ends with a full memory barrier. This way uploads are ordered with respect to the command buffers submitted
+ * before and after them without any additional synchronization.
+ */
+class VulkanUploadContext {
+ public:
+  static constexpr VkDeviceSize kStagingRingSize  = 32 * 1024 * 1024;
+  static constexpr VkDeviceSize kStagingAlignment = 256;  ///< Satisfies any optimalBufferCopyOffsetAlignment
+
+ public:
+  explicit VulkanUploadContext(VulkanRenderDevice& device);
+  ~VulkanUploadContext();
+
+  VulkanUploadContext(const VulkanUploadContext& other) = delete;
+  VulkanUploadContext& operator=(const VulkanUploadContext& other) = delete;
+
+  UploadToken UploadBuffer(VulkanBuffer& buffer, VkDeviceSize offset, VkDeviceSize size, const void* data);
+  UploadToken UploadTexture(VulkanTexture& texture, VkDeviceSize size, const void* data, bool generate_mipmaps,
+                            VkImageLayout final_layout);
+
+  /**
+   * @brief Submit the batch being recorded, if any.
+   */
+  void Flush();
+
+  bool IsComplete(UploadToken token);
+  void Wait(UploadToken token);
+
+  /**
+   * @brief Token of the most recently submitted batch, or kInvalidUploadToken if none.
+   */
+  UploadToken GetLastSubmittedToken() const;
+
+ private:
+  struct Batch {
+    UploadToken               token{kInvalidUploadToken};
+    VkCommandBuffer           vk_command_buffer{VK_NULL_HANDLE};
+    VkFence                   vk_fence{VK_NULL_HANDLE};
+    uint64_t                  staging_end{0};  ///< Staging ring position after the batch's data
+    std::vector<VulkanBuffer> dedicated_staging_buffers;
+  };
+
+  struct StagingRegion {
+    VkBuffer     vk_buffer{VK_NULL_HANDLE};
+    VkDeviceSize offset{0};
+  };
+
+  /**
+   * @brief Copy data to the staging memory, waiting for previous batches to free some of it if needed.
+   * @note May submit the batch being recorded, so must be called before recording commands that use the region.
+   */
+  StagingRegion StageData(VkDeviceSize size, const void* data);
+
+  Batch& GetRecordingBatch();
+
+  void RetireCompletedBatches();
+  void WaitForOldestBatch();
+  void RetireBatch(Batch& batch);
+
+ private:
+  VulkanRenderDevice& device_;
+
+  VkCommandPool       vk_command_pool_{VK_NULL_HANDLE};
+
+  VulkanBuffer        staging_ring_{};
+  uint64_t            staging_head_{0};  ///< Monotonic position, where the next data is staged
+  uint64_t            staging_tail_{0};  ///< Monotonic position, up to which staging memory is reclaimed
+
+  bool                recording_{false};
+  Batch               recording_batch_{};
+  std::deque<Batch>   submitted_batches_;
+  std::vector<Batch>  free_batches_;  ///< Retired batches, whose command buffers and fences are reused
+
+  UploadToken         next_token_{kInvalidUploadToken + 1};
+  UploadToken         completed_token_{kInvalidUploadToken};
+};
+
+}  // namespace vulture
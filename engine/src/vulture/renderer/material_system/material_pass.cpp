@@ -58,6 +58,16 @@ MaterialPass::MaterialPass(RenderDevice& device, SharedPtr<Shader> shader)
       texture_sampler.sampler = nullptr;
       texture_sampler.binding = sampler2d.binding;
     }
+
+    for (const auto& subpass_input : shader_->GetReflection().GetSubpassInputs()) {
+      if (subpass_input.set != descriptor_set_idx_) {
+        continue;
+      }
+
+      InputAttachment& input_attachment = input_attachments_[subpass_input.name];
+      input_attachment.texture = nullptr;
+      input_attachment.binding = subpass_input.binding;
+    }
   }
 }
 
@@ -84,6 +94,7 @@ MaterialPass::MaterialPass(MaterialPass&& other)
   shader_                 = std::move(other.shader_);
   descriptor_set_         = std::move(other.descriptor_set_);
   texture_samplers_       = std::move(other.texture_samplers_);
+  input_attachments_      = std::move(other.input_attachments_);
   property_buffers_count_ = std::move(other.property_buffers_count_);
 
   for (uint32_t i = 0; i < property_buffers_count_; ++i) {
@@ -117,6 +128,15 @@ void MaterialPass::SetTextureSampler(const StringView name, SharedPtr<Texture> t
   }
 }
 
+void MaterialPass::SetInputAttachment(const StringView name, SharedPtr<Texture> texture) {
+  assert(texture);
+
+  auto it = input_attachments_.find(name);
+  assert(it != input_attachments_.end());
+
+  it->second.texture = texture;
+}
+
 DescriptorSetHandle MaterialPass::WriteDescriptorSet() {
   if (!material_used_) {
     return kInvalidRenderResourceHandle;
@@ -146,6 +166,11 @@ DescriptorSetHandle MaterialPass::WriteDescriptorSet() {
                                    texture_sampler.sampler->GetHandle());
   }
 
+  for (const auto& [name, input_attachment] : input_attachments_) {
+    device_.WriteDescriptorInputAttachment(descriptor_set_, input_attachment.binding,
+                                           input_attachment.texture->GetHandle());
+  }
+
   return descriptor_set_;
 }
 
@@ -42,6 +42,11 @@ class MaterialPass {
     uint32_t           binding{0};
   };
 
+  struct InputAttachment {
+    SharedPtr<Texture> texture{nullptr};
+    uint32_t           binding{0};
+  };
+
   explicit MaterialPass(RenderDevice& device, SharedPtr<Shader> shader);
   ~MaterialPass();
 
@@ -63,6 +68,11 @@ class MaterialPass {
 
   void SetTextureSampler(const StringView name, SharedPtr<Texture> texture, SharedPtr<Sampler> sampler = nullptr);
 
+  /**
+   * @brief Set the texture read by a subpassInput, which must be the corresponding input attachment of the subpass.
+   */
+  void SetInputAttachment(const StringView name, SharedPtr<Texture> texture);
+
   // TODO: (tralf-strues) come up with some sort of caching system to only update if changed
   DescriptorSetHandle WriteDescriptorSet();
   DescriptorSetHandle GetDescriptorSet() const;
@@ -90,6 +100,9 @@ class MaterialPass {
   /* Texture samplers */
   HashMap<StringView, TextureSampler> texture_samplers_;
 
+  /* Input attachments */
+  HashMap<StringView, InputAttachment> input_attachments_;
+
   /* Uniform buffers for properties per shader stage */
   uint32_t property_buffers_count_{0};
   PropertyBuffer property_buffers_[kMaxPipelineShaderModules];
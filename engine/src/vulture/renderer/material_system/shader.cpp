@@ -63,8 +63,8 @@ Shader::~Shader() {
     device_.DeleteShaderModule(pipeline_description_.shader_modules[i]);
   }
 
-  if (IsBuilt()) {
-    device_.DeletePipeline(pipeline_);
+  for (const auto& built_pipeline : pipelines_) {
+    device_.DeletePipeline(built_pipeline.pipeline);
   }
 }
 
@@ -84,15 +84,17 @@ bool Shader::Load(const StringView filename) {
 
   name_ = name_node.as<std::string>();
 
+  compute_ = static_cast<bool>(root["comp_shader"]);
+
   /* Render Pass */
   YAML::Node render_pass_node = root["target_render_pass"];
-  if (!render_pass_node) {
+  if (render_pass_node) {
+    target_pass_id_ = GeneratePassIdFromString(render_pass_node.as<std::string>());
+  } else if (!compute_) {
     LOG_ERROR("No declaration of \"target_render_pass\" found!");
     return false;
   }
 
-  target_pass_id_ = GeneratePassIdFromString(render_pass_node.as<std::string>());
-
   if (!ParseDescriptorSetUsage(root)) {
     return false;
   }
@@ -117,6 +119,10 @@ bool Shader::Load(const StringView filename) {
   LOG_DEBUG("Shader reflection ({}):", filename);
   GetReflection().PrintData();  // FIXME: Debug only
 
+  if (compute_) {
+    BuildCompute();
+  }
+
   return true;
 }
 
@@ -243,6 +249,15 @@ bool Shader::ParseShaderModule(YAML::Node& root, const String& name, ShaderModul
 }
 
 bool Shader::ParseShaderSources(YAML::Node& root) {
+  if (compute_) {
+    if (root["vert_shader"] || root["frag_shader"]) {
+      LOG_ERROR("Compute shader can't contain graphics shader modules!");
+      return false;
+    }
+
+    return ParseShaderModule(root, "comp_shader", ShaderModuleType::kCompute);
+  }
+
   ParseShaderModule(root, "vert_shader", ShaderModuleType::kVertex);
   ParseShaderModule(root, "frag_shader", ShaderModuleType::kFragment);
 
@@ -292,6 +307,15 @@ bool Shader::CreateDescriptorSetLayouts() {
     layout_infos[sampler2d.set].bindings_layout_info.emplace_back(binding_info);
   }
 
+  for (const auto& subpass_input : reflection_.GetSubpassInputs()) {
+    DescriptorSetLayoutBindingInfo binding_info{};
+    binding_info.binding_idx     = subpass_input.binding;
+    binding_info.descriptor_type = DescriptorType::kInputAttachment;
+    binding_info.shader_stages   = subpass_input.shader_stages;
+
+    layout_infos[subpass_input.set].bindings_layout_info.emplace_back(binding_info);
+  }
+
   for (uint32_t i = 0; i < layout_infos.size(); ++i) {
     if (layout_infos[i].bindings_layout_info.size() > 0) {
       pipeline_description_.descriptor_set_layouts[i] = device_.CreateDescriptorSetLayout(layout_infos[i]);
@@ -303,23 +327,76 @@ bool Shader::CreateDescriptorSetLayouts() {
   return true;
 }
 
-PipelineHandle Shader::GetPipeline() const { return pipeline_; }
+PipelineHandle Shader::GetPipeline() const {
+  return pipelines_.empty() ? kInvalidRenderResourceHandle : pipelines_.front().pipeline;
+}
+
+PipelineHandle Shader::GetPipeline(RenderPassHandle render_pass, uint32_t subpass_idx) const {
+  return FindPipeline(device_.GetRenderPassCompatibilityHash(render_pass), subpass_idx);
+}
+
+PipelineHandle Shader::FindPipeline(uint64_t render_pass_compatibility_hash, uint32_t subpass_idx) const {
+  for (const auto& built_pipeline : pipelines_) {
+    if (built_pipeline.render_pass_compatibility_hash == render_pass_compatibility_hash &&
+        built_pipeline.subpass_idx == subpass_idx) {
+      return built_pipeline.pipeline;
+    }
+  }
+
+  return kInvalidRenderResourceHandle;
+}
+
+bool Shader::IsCompute() const { return compute_; }
 
 bool Shader::IsBuilt() const {
-  return ValidRenderHandle(pipeline_);
+  return !pipelines_.empty();
+}
+
+bool Shader::IsBuilt(RenderPassHandle render_pass, uint32_t subpass_idx) const {
+  return ValidRenderHandle(GetPipeline(render_pass, subpass_idx));
 }
 
 void Shader::Build(RenderPassHandle compatible_render_pass, uint32_t subpass_idx) {
-  if (ValidRenderHandle(pipeline_)) {
-    device_.DeletePipeline(pipeline_);
+  VULTURE_ASSERT(!compute_, "Compute shaders are built on load and don't target any render pass!");
+
+  uint64_t render_pass_compatibility_hash = device_.GetRenderPassCompatibilityHash(compatible_render_pass);
+  if (ValidRenderHandle(FindPipeline(render_pass_compatibility_hash, subpass_idx))) {
+    return;
   }
 
-  pipeline_ = device_.CreatePipeline(pipeline_description_, compatible_render_pass, subpass_idx);
+  BuiltPipeline built_pipeline{};
+  built_pipeline.render_pass_compatibility_hash = render_pass_compatibility_hash;
+  built_pipeline.subpass_idx                    = subpass_idx;
+  built_pipeline.pipeline = device_.CreatePipeline(pipeline_description_, compatible_render_pass, subpass_idx);
+
+  pipelines_.push_back(built_pipeline);
+}
+
+void Shader::BuildCompute() {
+  assert(pipeline_description_.shader_modules_count == 1);
+
+  ComputePipelineDescription description{};
+  description.descriptor_sets_count      = pipeline_description_.descriptor_sets_count;
+  description.push_constant_ranges_count = pipeline_description_.push_constant_ranges_count;
+  description.shader_module              = pipeline_description_.shader_modules[0];
+
+  for (uint32_t i = 0; i < description.descriptor_sets_count; ++i) {
+    description.descriptor_set_layouts[i] = pipeline_description_.descriptor_set_layouts[i];
+  }
+
+  for (uint32_t i = 0; i < description.push_constant_ranges_count; ++i) {
+    description.push_constant_ranges[i] = pipeline_description_.push_constant_ranges[i];
+  }
+
+  BuiltPipeline built_pipeline{};
+  built_pipeline.pipeline = device_.CreateComputePipeline(description);
+
+  pipelines_.push_back(built_pipeline);
 }
 
 void Shader::BindDescriptorSetIfUsed(CommandBuffer& commands, DescriptorSetBit set_bit, DescriptorSetHandle handle) {
   if (DescriptorSetUsed(set_bit)) {
-    commands.CmdBindDescriptorSet(pipeline_, GetDescriptorSetIdx(set_bit), handle);
+    commands.CmdBindDescriptorSet(GetPipeline(), GetDescriptorSetIdx(set_bit), handle);
   }
 }
 
@@ -40,6 +40,9 @@ namespace vulture {
 /**
  * @brief Graphics/compute pipeline abstraction targeting a specific render pass.
  *
+ * A graphics shader may be built for several render passes (e.g. the same pass in different render graphs), getting
+ * one pipeline per set of compatible render passes. The device also shares pipelines between identical shaders.
+ *
  * Example file for this can look like this (YAML format):
  *     name: ForwardPBR
  *     target_render_pass: ForwardPass
@@ -73,6 +76,13 @@ namespace vulture {
  *     blend_src_alpha_factor: SrcAlpha  # default: One
  *     blend_dst_alpha_factor: DstAlpha  # default: Zero
  *     blend_alpha_operation: Add        # default: Add
+ *
+ * Compute shaders declare a single "comp_shader" module instead of "vert_shader"/"frag_shader", all rasterization
+ * related fields are ignored for them and "target_render_pass" is optional. Compute pipelines don't depend on any
+ * render pass, so they are built right after loading:
+ *     name: LightCulling
+ *     descriptor_sets: [Frame, View, Custom]
+ *     comp_shader: ["light_culling.comp", "light_culling.comp.spv"]
  */
 class Shader : public IAsset {
  public:
@@ -92,8 +102,23 @@ class Shader : public IAsset {
 
   bool Load(const StringView filename);
 
+  /**
+   * @brief Get the pipeline built first, e.g. to bind descriptor sets, as all the pipelines have the same layout.
+   */
   PipelineHandle GetPipeline() const;
-  bool IsBuilt() const;
+
+  /**
+   * @return kInvalidRenderResourceHandle if the shader hasn't been built for the render pass or a compatible one.
+   */
+  PipelineHandle GetPipeline(RenderPassHandle render_pass, uint32_t subpass_idx = 0) const;
+
+  bool IsCompute() const;
+  bool IsBuilt() const;  ///< For any render pass
+  bool IsBuilt(RenderPassHandle render_pass, uint32_t subpass_idx = 0) const;
+
+  /**
+   * @brief Build the pipeline for the render pass, unless it has already been built for a compatible one.
+   */
   void Build(RenderPassHandle compatible_render_pass, uint32_t subpass_idx = 0);
 
   void BindDescriptorSetIfUsed(CommandBuffer& command_buffer, DescriptorSetBit set_bit, DescriptorSetHandle handle);
@@ -114,17 +139,32 @@ class Shader : public IAsset {
   bool ParseShaderModule(YAML::Node& root, const String& name, ShaderModuleType module_type);
   bool DeclarePushConstants();
   bool CreateDescriptorSetLayouts();
+  void BuildCompute();
+
+  PipelineHandle FindPipeline(uint64_t render_pass_compatibility_hash, uint32_t subpass_idx) const;
+
+ private:
+  /**
+   * Keyed by the render pass compatibility rather than by the handle, so that render passes recreated by the render
+   * graph (e.g. on resize) reuse the pipeline instead of building up entries for deleted handles.
+   */
+  struct BuiltPipeline {
+    uint64_t       render_pass_compatibility_hash {0};  ///< Zero for the compute pipeline
+    uint32_t       subpass_idx                    {0};
+    PipelineHandle pipeline                       {kInvalidRenderResourceHandle};
+  };
 
  private:
-  RenderDevice&       device_;
+  RenderDevice&         device_;
 
-  String              name_;
-  RenderPassId        target_pass_id_;
-  DescriptorSetUsage  set_usage_{0};
+  String                name_;
+  RenderPassId          target_pass_id_;
+  DescriptorSetUsage    set_usage_{0};
+  bool                  compute_{false};
 
-  ShaderReflection     reflection_;
-  PipelineDescription pipeline_description_;
-  PipelineHandle      pipeline_{kInvalidRenderResourceHandle};
+  ShaderReflection      reflection_;
+  PipelineDescription   pipeline_description_;
+  Vector<BuiltPipeline> pipelines_;  ///< The compute pipeline, or the graphics ones in the order of building
 };
 
 }  // namespace vulture
\ No newline at end of file
@@ -232,6 +232,21 @@ void vulture::ShaderReflection::AddShaderModule(ShaderModuleType shader_module,
            (first.set <= second.set && first.binding < second.binding);
   });
 
+  /* Subpass inputs (only in fragment shaders) */
+  for (const auto& resource : resources.subpass_inputs) {
+    SubpassInput& subpass_input = subpass_inputs_.emplace_back();
+    subpass_input.shader_stages        = stage_bit;
+    subpass_input.name                 = resource.name;
+    subpass_input.input_attachment_idx = compiler.get_decoration(resource.id, spv::DecorationInputAttachmentIndex);
+    subpass_input.set                  = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+    subpass_input.binding              = compiler.get_decoration(resource.id, spv::DecorationBinding);
+  }
+
+  std::sort(subpass_inputs_.begin(), subpass_inputs_.end(), [](const auto& first, const auto& second) {
+    return (first.set < second.set && first.binding <= second.binding) ||
+           (first.set <= second.set && first.binding < second.binding);
+  });
+
   VULTURE_ASSERT(resources.separate_images.empty(),   "Seperate images are not supported at the moment!");
   VULTURE_ASSERT(resources.separate_samplers.empty(), "Seperate samplers are not supported at the moment!");
   VULTURE_ASSERT(resources.storage_images.empty(),    "Storage images are not supported at the moment!");
@@ -257,6 +272,10 @@ const Vector<vulture::ShaderReflection::Sampler2D>& vulture::ShaderReflection::G
   return sampler2Ds_;
 }
 
+const Vector<vulture::ShaderReflection::SubpassInput>& vulture::ShaderReflection::GetSubpassInputs() const {
+  return subpass_inputs_;
+}
+
 void PrintMembers(const Vector<vulture::ShaderReflection::Member>& members) {
   for (const auto& member : members) {
     fmt::print("    - {0} {1}",
@@ -285,9 +304,12 @@ void vulture::ShaderReflection::PrintData() const {
 
   fmt::print(fmt::emphasis::bold | fg(fmt::color::golden_rod), "====Push constants====\n");
   for (const auto& push_constant : push_constants_) {
-    const char* stage_str = (push_constant.shader_module == ShaderModuleType::kVertex)
-                                ? "Vertex Shader\n-------------"
-                                : "Fragment Shader\n---------------";
+    const char* stage_str = nullptr;
+    switch (push_constant.shader_module) {
+      case ShaderModuleType::kVertex:  { stage_str = "Vertex Shader\n-------------"; break; }
+      case ShaderModuleType::kCompute: { stage_str = "Compute Shader\n--------------"; break; }
+      default:                         { stage_str = "Fragment Shader\n---------------"; break; }
+    }
     fmt::println("{0}", stage_str);
     fmt::println("* {0} (size = {1}, offset = {2})",
                  fmt::styled(push_constant.name, fmt::emphasis::underline | fmt::emphasis::bold),
@@ -332,4 +354,14 @@ void vulture::ShaderReflection::PrintData() const {
                  sampler.array_size);
   }
   fmt::print("\n");
+
+  fmt::print(fmt::emphasis::bold | fg(fmt::color::golden_rod), "====Subpass inputs====\n");
+  for (const auto& subpass_input : subpass_inputs_) {
+    fmt::println("* [set = {0}, binding = {1}] {2} (input attachment index = {3})",
+                 subpass_input.set,
+                 subpass_input.binding,
+                 fmt::styled(subpass_input.name, fmt::emphasis::underline | fmt::emphasis::bold),
+                 subpass_input.input_attachment_idx);
+  }
+  fmt::print("\n");
 }
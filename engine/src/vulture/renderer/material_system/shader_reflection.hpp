@@ -87,6 +87,17 @@ class ShaderReflection {
     uint32_t         binding{0};
   };
 
+  /**
+   * @brief Attachment of the current subpass read by the fragment shader at the same pixel (GLSL subpassInput).
+   */
+  struct SubpassInput {
+    ShaderStageFlags shader_stages{0};
+    String           name;
+    uint32_t         input_attachment_idx{0};  ///< Index in the subpass' input attachments
+    uint32_t         set{0};
+    uint32_t         binding{0};
+  };
+
  public:
   ShaderReflection() = default;
 
@@ -97,6 +108,7 @@ class ShaderReflection {
   const Vector<UniformBuffer>&   GetUniformBuffers() const;
   const Vector<StorageBuffer>&   GetStorageBuffers() const;
   const Vector<Sampler2D>&       GetSampler2Ds() const;
+  const Vector<SubpassInput>&    GetSubpassInputs() const;
 
   void PrintData() const;
 
@@ -106,6 +118,7 @@ class ShaderReflection {
   Vector<UniformBuffer>   uniform_buffers_;
   Vector<StorageBuffer>   storage_buffers_;
   Vector<Sampler2D>       sampler2Ds_;
+  Vector<SubpassInput>    subpass_inputs_;
 };
 
 }  // namespace vulture
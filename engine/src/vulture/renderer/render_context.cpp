@@ -30,15 +30,21 @@
 using namespace vulture;
 
 RenderContext::RenderContext(RenderDevice& device, CommandBuffer& command_buffer, uint32_t frame_idx,
-                             rg::RenderGraph& render_graph, const Camera& camera, const RenderQueue& render_queue,
+                             rg::RenderGraph& render_graph, uint32_t view_idx, const Camera* const* cameras,
+                             uint32_t views_count, const RenderQueue& render_queue, const RenderQueueView& view,
                              const LightEnvironment& lights)
     : device_(device),
       command_buffer_(command_buffer),
       frame_(frame_idx),
       render_graph_(render_graph),
-      camera_(camera),
+      view_idx_(view_idx),
+      cameras_(cameras),
+      views_count_(views_count),
       render_queue_(render_queue),
-      light_environment_(lights) {}
+      view_(view),
+      light_environment_(lights) {
+  assert(view_idx_ < views_count_);
+}
 
 RenderDevice&           RenderContext::GetRenderDevice()      { return device_; }
 CommandBuffer&          RenderContext::GetCommandBuffer()     { return command_buffer_; }
@@ -46,6 +52,14 @@ uint32_t                RenderContext::GetFrameIdx() const    { return frame_; }
 
 rg::RenderGraph&        RenderContext::GetRenderGraph()       { return render_graph_; }
 rg::Blackboard&         RenderContext::GetBlackboard()        { return render_graph_.GetBlackboard(); }
-const Camera&           RenderContext::GetCamera() const      { return camera_; }
+uint32_t                RenderContext::GetViewIdx() const     { return view_idx_; }
+const Camera&           RenderContext::GetCamera() const      { return *cameras_[view_idx_]; }
+uint32_t                RenderContext::GetViewsCount() const  { return views_count_; }
 const RenderQueue&      RenderContext::GetRenderQueue() const { return render_queue_; }
-const LightEnvironment& RenderContext::GetLights() const      { return light_environment_; }
\ No newline at end of file
+const RenderQueueView&  RenderContext::GetView() const        { return view_; }
+const LightEnvironment& RenderContext::GetLights() const      { return light_environment_; }
+
+const Camera& RenderContext::GetViewCamera(uint32_t view_idx) const {
+  assert(view_idx < views_count_);
+  return *cameras_[view_idx];
+}
\ No newline at end of file
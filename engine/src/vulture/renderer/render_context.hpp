@@ -34,10 +34,18 @@
 
 namespace vulture {
 
+/**
+ * @brief Arguments of the render features' Execute calls.
+ *
+ * Render features are executed once per frame with the shared render graph and then once per view with the view's
+ * render graph, camera and render queue culled by the camera's frustum. The cameras of all views are available to both,
+ * e.g. for fitting shared work to every view.
+ */
 class RenderContext {
  public:
   RenderContext(RenderDevice& device, CommandBuffer& command_buffer, uint32_t frame_idx, rg::RenderGraph& render_graph,
-                const Camera& camera, const RenderQueue& render_queue, const LightEnvironment& lights);
+                uint32_t view_idx, const Camera* const* cameras, uint32_t views_count, const RenderQueue& render_queue,
+                const RenderQueueView& view, const LightEnvironment& lights);
 
   RenderDevice&           GetRenderDevice();
   CommandBuffer&          GetCommandBuffer();
@@ -45,8 +53,12 @@ class RenderContext {
 
   rg::RenderGraph&        GetRenderGraph();
   rg::Blackboard&         GetBlackboard();
-  const Camera&           GetCamera() const;
+  uint32_t                GetViewIdx() const;
+  const Camera&           GetCamera() const;  ///< Of the current view
+  uint32_t                GetViewsCount() const;
+  const Camera&           GetViewCamera(uint32_t view_idx) const;
   const RenderQueue&      GetRenderQueue() const;
+  const RenderQueueView&  GetView() const;  ///< Render queue culled by the view camera's frustum
   const LightEnvironment& GetLights() const;
 
  private:
@@ -55,8 +67,11 @@ class RenderContext {
   uint32_t                frame_{0};
 
   rg::RenderGraph&        render_graph_;
-  const Camera&           camera_;
+  uint32_t                view_idx_{0};
+  const Camera* const*    cameras_{nullptr};
+  uint32_t                views_count_{0};
   const RenderQueue&      render_queue_;
+  const RenderQueueView&  view_;
   const LightEnvironment& light_environment_;
 };
 
@@ -39,6 +39,18 @@ class IRenderFeature {
 
   virtual StringView Name() const = 0;
 
+  /**
+   * @brief Add passes, which are executed once per frame regardless of the number of views (e.g. shadow maps).
+   */
+  virtual void SetupSharedRenderPasses(rg::RenderGraph& /*render_graph*/) {}
+  virtual void ExecuteShared(RenderContext& /*context*/) {}
+
+  /**
+   * @brief Add passes to a view's render graph, which is set up the same way for every view.
+   *
+   * The blackboard is shared by the shared and all view graphs, so pass data set up by a view graph is valid for any
+   * view graph, as they are identical.
+   */
   virtual void SetupRenderPasses(rg::RenderGraph& render_graph) = 0;
   virtual void Execute(RenderContext& context) = 0;
 };
@@ -27,13 +27,39 @@
 
 #pragma once
 
-#include <any>
-#include <typeindex>
-#include <unordered_map>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace vulture {
 namespace rg {
 
+using BlackboardSlotId = uint32_t;
+
+struct BlackboardSlotIdGenerator {
+  static BlackboardSlotId GetId() {
+    static std::atomic<BlackboardSlotId> id{0};
+    return id++;
+  }
+};
+
+template <typename T>
+struct BlackboardSlotIdHolder {
+  static BlackboardSlotId GetId() {
+    const static BlackboardSlotId id = BlackboardSlotIdGenerator::GetId();
+    return id;
+  }
+};
+
+/**
+ * @brief Per-frame data shared by the render passes and the render features.
+ *
+ * Each type gets a process-wide slot id on the first use, so lookups are array loads instead of hashing. Slots are
+ * allocated separately, so references stay valid until the value is replaced by another Add.
+ */
 class Blackboard {
  public:
   Blackboard() = default;
@@ -51,7 +77,20 @@ class Blackboard {
   bool Has() const;
 
  private:
-  std::unordered_map<std::type_index, std::any> storage_;  // FIXME: (tralf-strues) Come up with another way to store
+  struct SlotBase {
+    virtual ~SlotBase() = default;
+  };
+
+  template <typename T>
+  struct Slot final : SlotBase {
+    template <typename... Args>
+    explicit Slot(Args&&... args) : value{std::forward<Args>(args)...} {}
+
+    T value;
+  };
+
+ private:
+  std::vector<std::unique_ptr<SlotBase>> slots_;  ///< Indexed by BlackboardSlotId, nullptr if not added
 };
 
 #include <vulture/renderer/render_graph/blackboard.ipp>
@@ -27,22 +27,32 @@
 
 template <typename T, typename... Args>
 T& Blackboard::Add(Args&&... args) {
-  return storage_[typeid(T)].emplace<T>(T{std::forward<Args>(args)...});
+  BlackboardSlotId slot_id = BlackboardSlotIdHolder<T>::GetId();
+  if (slot_id >= slots_.size()) {
+    slots_.resize(slot_id + 1);
+  }
+
+  auto slot = std::make_unique<Slot<T>>(std::forward<Args>(args)...);
+  T&   value = slot->value;
+
+  slots_[slot_id] = std::move(slot);
+  return value;
 }
 
 template <typename T>
 T& Blackboard::Get() {
   assert(Has<T>());
-  return std::any_cast<T&>(storage_.at(typeid(T)));
+  return static_cast<Slot<T>&>(*slots_[BlackboardSlotIdHolder<T>::GetId()]).value;
 }
 
 template <typename T>
 const T& Blackboard::Get() const {
   assert(Has<T>());
-  return std::any_cast<const T&>(storage_.at(typeid(T)));
+  return static_cast<const Slot<T>&>(*slots_[BlackboardSlotIdHolder<T>::GetId()]).value;
 }
 
 template <typename T>
 bool Blackboard::Has() const {
-  return storage_.find(typeid(T)) != storage_.cend();
+  BlackboardSlotId slot_id = BlackboardSlotIdHolder<T>::GetId();
+  return slot_id < slots_.size() && slots_[slot_id] != nullptr;
 }
@@ -27,9 +27,140 @@
 
 #include <vulture/renderer/render_graph/render_graph.hpp>
 
+#include <algorithm>
+
 using namespace vulture;
 using namespace vulture::rg;
 
+namespace {
+
+TextureSpecification GetTextureSpecification(const DynamicTextureSpecification& dynamic_specification) {
+  TextureSpecification specification{};
+  specification.format       = dynamic_specification.format.Get();
+  specification.type         = dynamic_specification.type;
+  specification.usage        = dynamic_specification.usage;
+  specification.cpu_readable = dynamic_specification.cpu_readable;
+  specification.width        = dynamic_specification.width.Get();
+  specification.height       = dynamic_specification.height.Get();
+  specification.samples      = dynamic_specification.samples.Get();
+  specification.mip_levels   = dynamic_specification.mip_levels;
+
+  return specification;
+}
+
+TextureSpecification GetTextureSpecification(const rg::detail::TextureEntry& entry) {
+  TextureSpecification specification = GetTextureSpecification(entry.specification);
+  if (entry.transient_attachment) {
+    specification.usage |= kTextureUsageBitTransientAttachment;
+  }
+
+  return specification;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+double BytesToMiB(uint64_t size) { return static_cast<double>(size) / (1024.0 * 1024.0); }
+
+/**
+ * @brief How a pass accesses a texture.
+ */
+struct TextureAccess {
+  TextureLayout               layout  {TextureLayout::kUndefined};
+  PipelineStageFlags          stages  {kPipelineStageBitNone};
+  MemoryAccessDependencyFlags access  {kMemoryAccessBitNone};
+  bool                        write   {false};
+  bool                        discard {false};  ///< Previous contents are not needed
+};
+
+/**
+ * @brief Synchronization state of a texture between passes.
+ */
+struct TextureState {
+  TextureLayout               layout       {TextureLayout::kUndefined};
+  PipelineStageFlags          write_stages {kPipelineStageBitNone};  ///< Stages of the last write
+  MemoryAccessDependencyFlags write_access {kMemoryAccessBitNone};
+  PipelineStageFlags          read_stages  {kPipelineStageBitNone};  ///< Stages of the reads after the last write
+
+  CommandBufferType           queue          {CommandBufferType::kGraphics};  ///< Owning queue
+  int32_t                     submission_idx {0};  ///< Submission of the last access, if using async compute
+};
+
+/**
+ * @brief Synchronization state of a buffer between passes.
+ */
+struct BufferState {
+  PipelineStageFlags          write_stages {kPipelineStageBitNone};  ///< Stages of the last write
+  MemoryAccessDependencyFlags write_access {kMemoryAccessBitNone};
+  PipelineStageFlags          read_stages  {kPipelineStageBitNone};  ///< Stages of the reads after the last write
+
+  CommandBufferType           queue        {CommandBufferType::kInvalid};  ///< Queue of the last access
+};
+
+/**
+ * @brief The largest minUniformBufferOffsetAlignment and minStorageBufferOffsetAlignment allowed by Vulkan, so that
+ *        buffer slices can be bound on any device.
+ */
+constexpr uint32_t kBufferSliceAlignment = 256;
+
+constexpr MemoryAccessDependencyFlags kWriteAccessMask =
+    kMemoryAccessBitShaderWrite | kMemoryAccessBitColorAttachmentWrite | kMemoryAccessBitDepthStencilAttachmentWrite |
+    kMemoryAccessBitTransferWrite | kMemoryAccessBitHostWrite | kMemoryAccessBitMemoryWrite;
+
+TextureAccess GetAttachmentAccess(const PassNode::TextureUsage& usage, const DynamicTextureSpecification& specification,
+                                  bool depth_stencil) {
+  TextureAccess access{};
+  access.write = true;
+
+  /* Only a single layer is written, so the contents of the others must be preserved */
+  access.discard = usage.load != AttachmentLoad::kLoad && specification.type == TextureType::kTexture2D;
+
+  if (depth_stencil) {
+    access.layout = TextureLayout::kDepthStencilAttachment;
+    access.stages = kPipelineStageBitEarlyFragmentTests | kPipelineStageBitLateFragmentTests;
+    access.access = kMemoryAccessBitDepthStencilAttachmentRead | kMemoryAccessBitDepthStencilAttachmentWrite;
+  } else {
+    access.layout = TextureLayout::kColorAttachment;
+    access.stages = kPipelineStageBitColorAttachmentOutput;
+    access.access = kMemoryAccessBitColorAttachmentWrite |
+                    (usage.load == AttachmentLoad::kLoad ? kMemoryAccessBitColorAttachmentRead : kMemoryAccessBitNone);
+  }
+
+  return access;
+}
+
+TextureAccess GetInputAttachmentAccess(const DynamicTextureSpecification& specification) {
+  TextureAccess access{};
+  access.layout = IsDepthContainingDataFormat(specification.format.Get()) ? TextureLayout::kDepthStencilReadOnly
+                                                                          : TextureLayout::kShaderReadOnly;
+  access.stages = kPipelineStageBitFragmentShader;
+  access.access = kMemoryAccessBitInputAttachmentRead;
+
+  return access;
+}
+
+TextureAccess GetSampledAccess(bool compute) {
+  TextureAccess access{};
+  access.layout = TextureLayout::kShaderReadOnly;
+  access.stages = compute ? kPipelineStageBitComputeShader : kPipelineStageBitFragmentShader;
+  access.access = kMemoryAccessBitShaderRead;
+
+  return access;
+}
+
+/**
+ * @brief Access of the textures with a final layout after the graph, i.e. by the code outside of it.
+ */
+TextureAccess GetExternalAccess(TextureLayout final_layout) {
+  TextureAccess access{};
+  access.layout = final_layout;
+  access.stages = kPipelineStageBitFragmentShader | kPipelineStageBitTransfer;
+  access.access = kMemoryAccessBitShaderRead | kMemoryAccessBitTransferRead;
+
+  return access;
+}
+
+}  // namespace
+
 /************************************************************************************************
  * Dynamic Texture Specification
  ************************************************************************************************/
@@ -43,381 +174,1700 @@ DynamicTextureSpecification::DynamicTextureSpecification(const TextureSpecificat
       samples(specification.samples),
       mip_levels(specification.mip_levels) {}
 
-/************************************************************************************************
- * Render Graph
- ************************************************************************************************/
-RenderGraph::RenderGraph(Blackboard& blackboard) : blackboard_(blackboard) {}
+/************************************************************************************************
+ * Render Graph
+ ************************************************************************************************/
+RenderGraph::RenderGraph(Blackboard& blackboard) : blackboard_(blackboard) {}
+
+Blackboard& RenderGraph::GetBlackboard() { return blackboard_; }
+
+BufferVersionId RenderGraph::CreateBuffer(const std::string_view name, const BufferSpecification& specification) {
+  return NewBufferEntry(name, specification, /*host_written=*/true);
+}
+
+BufferVersionId RenderGraph::LastBufferVersion(const std::string_view name) {
+  BufferVersionId last_version = kInvalidBufferVersionId;
+  for (const auto& node : buffer_nodes_) {
+    if (buffer_entries_[node.actual_buffer_idx].name == name) {
+      last_version = node.version_id;
+    }
+  }
+
+  return last_version;
+}
+
+TextureVersionId RenderGraph::FirstVersion(const std::string_view name) {
+  for (const auto& node : texture_nodes_) {
+    if (texture_entries_[node.actual_texture_idx].name == name) {
+      return node.version_id;
+    }
+  }
+
+  return kInvalidTextureVersionId;
+}
+
+TextureVersionId RenderGraph::LastVersion(const std::string_view name) {
+  TextureVersionId last_version = kInvalidTextureVersionId;
+  for (const auto& node : texture_nodes_) {
+    if (texture_entries_[node.actual_texture_idx].name == name) {
+      last_version = node.version_id;
+    }
+  }
+
+  return last_version;
+}
+
+TextureVersionId RenderGraph::ImportTexture(const std::string_view name, SharedPtr<Texture> texture,
+                                            TextureLayout final_layout) {
+  assert(texture);
+  return NewEntry(name, texture, DynamicTextureSpecification(texture->GetSpecification()), true, final_layout);
+}
+
+TextureVersionId RenderGraph::DeclareTexture(const std::string_view name, TextureLayout final_layout) {
+  texture_entries_.emplace_back(name, nullptr, rg::DynamicTextureSpecification{}, true, final_layout, 0, true);
+
+  TextureNode& texture_node = AddTextureNode(texture_entries_.size() - 1, 0);
+  texture_node.subgraph_idx = cur_subgraph_idx_;
+
+  return texture_node.version_id;
+}
+
+void RenderGraph::Setup(RenderDevice& device) {
+  for (auto& pass_node : pass_nodes_) {
+    RenderGraphBuilder builder{*this, pass_node};
+
+    cur_subgraph_idx_ = pass_node.subgraph_idx;
+    if (pass_node.IsCompute()) {
+      pass_node.compute_pass->Setup(builder, blackboard_, pass_node.render_pass_id);
+    } else {
+      pass_node.render_pass->Setup(builder, blackboard_, pass_node.render_pass_id);
+    }
+    cur_subgraph_idx_ = -1;
+  }
+
+  AllocateTransientBuffers(device);
+}
+
+void RenderGraph::Compile(RenderDevice& device) {
+  CullPasses();
+  UpdateDependentTextureValues();
+  MergePasses();
+  ScheduleQueues(device);
+  RecreateTransientTextures(device);
+  RecreateRenderPasses(device);
+  RecreateFramebuffers(device);
+  CalculateBarriers();
+
+  queues_dirty_ = false;
+}
+
+void RenderGraph::Update(RenderDevice& device) {
+  if (textures_dirty_) {
+    UpdateDependentTextureValues();
+    queues_dirty_ |= MergePasses();  // E.g. the extents of the merged passes' attachments might no longer match
+    RecreateTransientTextures(device);
+    RecreateRenderPasses(device);
+    RecreateFramebuffers(device);
+  }
+}
+
+void RenderGraph::Execute(RenderDevice& device, CommandBuffer& command_buffer, uint32_t frame_in_flight) {
+  Update(device);
+
+  if (queues_dirty_) {
+    ScheduleQueues(device);
+    CalculateBarriers();
+    queues_dirty_ = false;
+  }
+
+  if (submissions_.empty()) {
+    for (uint32_t pass_idx = 0; pass_idx < built_passes_.size(); ++pass_idx) {
+      if (!pass_nodes_[pass_idx].culled) {
+        ExecutePass(command_buffer, pass_idx, frame_in_flight);
+      }
+    }
+
+    RecordBarriers(command_buffer, final_barriers_, frame_in_flight);
+  } else {
+    ExecuteSubmissions(device, frame_in_flight);
+  }
+
+  for (auto& entry : texture_entries_) {
+    entry.contents_undefined = false;
+  }
+}
+
+SharedPtr<Texture> RenderGraph::GetTexture(TextureVersionId version_id) {
+  return GetTextureEntry(version_id).texture;
+}
+
+BufferSlice RenderGraph::GetBuffer(BufferVersionId version_id, uint32_t frame_in_flight) const {
+  assert(frame_in_flight < kFramesInFlight);
+  assert(ValidRenderHandle(buffer_ring_));
+
+  const detail::BufferEntry& entry = GetBufferEntry(version_id);
+
+  BufferSlice slice{};
+  slice.buffer = buffer_ring_;
+  slice.offset = frame_in_flight * buffer_ring_frame_size_ + entry.offset;
+  slice.size   = entry.specification.size;
+
+  return slice;
+}
+
+void RenderGraph::ReimportTexture(TextureVersionId version, SharedPtr<Texture> texture) {
+  assert(version != kInvalidTextureVersionId);
+  assert(texture);
+
+  detail::TextureEntry& entry = GetTextureEntry(version);
+  if (entry.texture == nullptr || entry.texture->GetHandle() != texture->GetHandle() ||
+      entry.prev_texture_handle != texture->GetHandle()) {
+    const TextureSpecification& specification = texture->GetSpecification();
+    entry.dirty |= entry.specification.format.Get()  != specification.format ||
+                   entry.specification.type          != specification.type ||
+                   entry.specification.usage         != specification.usage ||
+                   entry.specification.cpu_readable  != specification.cpu_readable ||
+                   entry.specification.width.Get()   != specification.width ||
+                   entry.specification.height.Get()  != specification.height ||
+                   entry.specification.samples.Get() != specification.samples ||
+                   entry.specification.mip_levels    != specification.mip_levels;
+
+    if (entry.dirty || entry.texture == nullptr) {
+      entry.dirty     = true;
+      textures_dirty_ = true;
+    }
+
+    entry.specification        = DynamicTextureSpecification{texture->GetSpecification()};
+    entry.texture             = texture;
+    entry.prev_texture_handle = texture->GetHandle();
+    entry.contents_undefined  = true;
+  }
+}
+
+const TransientMemoryStatistics& RenderGraph::GetTransientMemoryStatistics() const {
+  return transient_memory_statistics_;
+}
+
+bool RenderGraph::FindRenderPass(RenderPassId render_pass_id, RenderPassHandle* render_pass,
+                                 uint32_t* subpass_idx) const {
+  assert(render_pass != nullptr);
+  assert(subpass_idx != nullptr);
+
+  for (uint32_t pass_idx = 0; pass_idx < pass_nodes_.size(); ++pass_idx) {
+    const auto& pass_node = pass_nodes_[pass_idx];
+    if (pass_node.IsCompute() || pass_node.culled || pass_node.render_pass_id != render_pass_id) {
+      continue;
+    }
+
+    if (pass_idx >= built_passes_.size() || !ValidRenderHandle(built_passes_[pass_idx].pass_handle)) {
+      continue;
+    }
+
+    *render_pass = built_passes_[pass_idx].pass_handle;
+    *subpass_idx = pass_node.subpass_idx;
+    return true;
+  }
+
+  return false;
+}
+
+void RenderGraph::SetSubpassMerging(bool enable) {
+  textures_dirty_  |= (subpass_merging_ != enable);
+  subpass_merging_  = enable;
+}
+
+bool RenderGraph::IsSubpassMergingEnabled() const { return subpass_merging_; }
+
+void RenderGraph::SetAsyncCompute(bool enable) {
+  queues_dirty_ |= (async_compute_ != enable);
+  async_compute_ = enable;
+}
+
+bool RenderGraph::IsAsyncComputeEnabled() const { return async_compute_; }
+
+void RenderGraph::Destroy(RenderDevice& device) {
+  for (auto& built_pass : built_passes_) {
+    if (ValidRenderHandle(built_pass.framebuffer_handle)) {
+      device.DeleteFramebuffer(built_pass.framebuffer_handle);
+    }
+  }
+
+  for (auto& [hash, render_pass] : render_pass_cache_) {
+    device.DeleteRenderPass(render_pass.handle);
+  }
+
+  render_pass_cache_.clear();
+
+  for (auto& pass_node : pass_nodes_) {
+    delete pass_node.render_pass;
+    delete pass_node.compute_pass;
+    pass_node.render_pass  = nullptr;
+    pass_node.compute_pass = nullptr;
+  }
+
+  built_passes_.clear();
+  pass_nodes_.clear();
+  texture_nodes_.clear();
+  texture_entries_.clear();  // Transient textures are released with the last reference to them
+  subgraph_names_.clear();
+
+  for (auto& heap : memory_heaps_) {
+    device.FreeDeviceMemory(heap.memory);
+  }
+
+  memory_heaps_.clear();
+  transient_memory_statistics_ = TransientMemoryStatistics{};
+
+  if (ValidRenderHandle(buffer_ring_)) {
+    device.DeleteBuffer(buffer_ring_);
+  }
+
+  buffer_nodes_.clear();
+  buffer_entries_.clear();
+  buffer_ring_            = kInvalidRenderResourceHandle;
+  buffer_ring_frame_size_ = 0;
+
+  texture_barriers_.clear();
+  buffer_barriers_.clear();
+  final_barriers_ = detail::BarrierBatch{};
+
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    for (auto* command_buffer : graphics_command_buffers_[frame]) {
+      device.DeleteCommandBuffer(command_buffer);
+    }
+
+    for (auto* command_buffer : compute_command_buffers_[frame]) {
+      device.DeleteCommandBuffer(command_buffer);
+    }
+
+    for (auto semaphore : semaphores_[frame]) {
+      device.DeleteSemaphore(semaphore);
+    }
+
+    graphics_command_buffers_[frame].clear();
+    compute_command_buffers_[frame].clear();
+    semaphores_[frame].clear();
+  }
+
+  submissions_.clear();
+  return_barriers_ = detail::BarrierBatch{};
+  queues_dirty_    = false;
+
+  textures_dirty_   = true;
+  cur_subgraph_idx_ = -1;
+}
+
+void RenderGraph::CullPasses() {
+  /* Versions of imported textures and textures with a final layout are used outside of the graph */
+  std::vector<bool> used_versions(texture_nodes_.size(), false);
+  for (const auto& texture_node : texture_nodes_) {
+    const detail::TextureEntry& entry = texture_entries_[texture_node.actual_texture_idx];
+    used_versions[texture_node.version_id] = entry.imported || entry.final_layout != TextureLayout::kUndefined;
+  }
+
+  /* Buffers are transient, so their versions are only used by the passes reading them */
+  std::vector<bool> used_buffer_versions(buffer_nodes_.size(), false);
+
+  /* Passes only read versions written by the previous passes, so a single backward sweep is enough */
+  for (int32_t pass_idx = static_cast<int32_t>(pass_nodes_.size()) - 1; pass_idx >= 0; --pass_idx) {
+    PassNode& pass_node = pass_nodes_[pass_idx];
+
+    bool used = pass_node.depth_stencil_usage.has_value() && used_versions[pass_node.depth_stencil_usage->out];
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      used |= used_versions[color_attachment_usage.out];
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      used |= used_versions[resolve_attachment_usage.out];
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      used |= (buffer_usage.out != kInvalidBufferVersionId && used_buffer_versions[buffer_usage.out]);
+    }
+
+    pass_node.culled = !used;
+    if (pass_node.culled) {
+      continue;
+    }
+
+    if (pass_node.depth_stencil_usage.has_value()) {
+      used_versions[pass_node.depth_stencil_usage->in] = true;
+    }
+
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      used_versions[color_attachment_usage.in] = true;
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      used_versions[resolve_attachment_usage.in] = true;
+    }
+
+    for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+      used_versions[sampled_texture_id] = true;
+    }
+
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      used_versions[input_attachment_id] = true;
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      used_buffer_versions[buffer_usage.in] = true;
+    }
+  }
+}
+
+bool RenderGraph::MergePasses() {
+  bool changed = false;
+
+  /* Passes accessing the resources of async compute passes might wait for them in a separate submission, so they are
+     never merged. Doesn't depend on the async compute toggle, so that toggling doesn't recreate render passes. */
+  std::vector<bool> async_textures(texture_entries_.size(), false);
+  std::vector<bool> async_buffers(buffer_entries_.size(), false);
+
+  int32_t first_pass_idx = -1;  // Pass beginning the render pass, into which the next pass can be merged
+  for (uint32_t pass_idx = 0; pass_idx < pass_nodes_.size(); ++pass_idx) {
+    PassNode& pass_node = pass_nodes_[pass_idx];
+
+    uint32_t prev_first_subpass_pass_idx = pass_node.first_subpass_pass_idx;
+    pass_node.first_subpass_pass_idx = pass_idx;
+    pass_node.subpass_idx            = 0;
+    pass_node.subpass_pass_indices.clear();
+
+    if (pass_node.culled) {
+      continue;
+    }
+
+    if (pass_node.IsCompute()) {
+      if (pass_node.compute_pass->UsesAsyncCompute()) {
+        for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+          async_textures[texture_nodes_[sampled_texture_id].actual_texture_idx] = true;
+        }
+
+        for (const auto& buffer_usage : pass_node.buffer_usages) {
+          async_buffers[buffer_nodes_[buffer_usage.in].actual_buffer_idx] = true;
+        }
+      }
+
+      first_pass_idx = -1;
+      continue;
+    }
+
+    bool async_dependency = false;
+    auto check_texture = [this, &async_textures, &async_dependency](TextureVersionId id) {
+      async_dependency |= async_textures[texture_nodes_[id].actual_texture_idx];
+    };
+
+    if (pass_node.depth_stencil_usage.has_value()) {
+      check_texture(pass_node.depth_stencil_usage->in);
+    }
+
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      check_texture(color_attachment_usage.in);
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      check_texture(resolve_attachment_usage.in);
+    }
+
+    for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+      check_texture(sampled_texture_id);
+    }
+
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      check_texture(input_attachment_id);
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      async_dependency |= async_buffers[buffer_nodes_[buffer_usage.in].actual_buffer_idx];
+    }
+
+    if (subpass_merging_ && first_pass_idx != -1 && !async_dependency && CanMergePass(pass_idx, first_pass_idx)) {
+      PassNode& first_pass_node = pass_nodes_[first_pass_idx];
+
+      pass_node.first_subpass_pass_idx = first_pass_idx;
+      pass_node.subpass_idx            = static_cast<uint32_t>(first_pass_node.subpass_pass_indices.size());
+      first_pass_node.subpass_pass_indices.push_back(pass_idx);
+    } else {
+      first_pass_idx = static_cast<int32_t>(pass_idx);
+      pass_node.subpass_pass_indices.push_back(pass_idx);
+    }
+
+    changed |= (pass_node.first_subpass_pass_idx != prev_first_subpass_pass_idx);
+  }
+
+  /* Transient attachments depend on the render passes, so the textures have to be placed and created again */
+  if (changed) {
+    for (auto& entry : texture_entries_) {
+      entry.dirty |= !entry.imported;
+    }
+  }
+
+  return changed;
+}
+
+bool RenderGraph::CanMergePass(uint32_t pass_idx, uint32_t first_pass_idx) const {
+  struct Attachment {
+    uint32_t entry_idx {0};
+    uint32_t layer     {0};
+  };
+
+  auto get_attachments = [this](const PassNode& pass_node, std::vector<Attachment>& attachments) {
+    auto add = [this, &attachments](TextureVersionId id, uint32_t layer) {
+      attachments.push_back(Attachment{texture_nodes_[id].actual_texture_idx, layer});
+    };
+
+    if (pass_node.depth_stencil_usage.has_value()) {
+      add(pass_node.depth_stencil_usage->in, pass_node.depth_stencil_usage->layer);
+    }
+
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      add(color_attachment_usage.in, color_attachment_usage.layer);
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      add(resolve_attachment_usage.in, resolve_attachment_usage.layer);
+    }
+
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      add(input_attachment_id, 0);
+    }
+  };
+
+  auto samples_any = [this](const PassNode& pass_node, const std::vector<Attachment>& attachments) {
+    for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+      for (const auto& attachment : attachments) {
+        if (texture_nodes_[sampled_texture_id].actual_texture_idx == attachment.entry_idx) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  };
+
+  const PassNode& pass_node       = pass_nodes_[pass_idx];
+  const PassNode& first_pass_node = pass_nodes_[first_pass_idx];
+
+  std::vector<Attachment> attachments;
+  std::vector<Attachment> render_pass_attachments;
+
+  get_attachments(pass_node, attachments);
+  for (uint32_t subpass_pass_idx : first_pass_node.subpass_pass_indices) {
+    get_attachments(pass_nodes_[subpass_pass_idx], render_pass_attachments);
+  }
+
+  /* Subpasses share the framebuffer */
+  RenderArea render_area = GetRenderArea(first_pass_idx);
+  for (const auto& attachment : attachments) {
+    const DynamicTextureSpecification& specification = texture_entries_[attachment.entry_idx].specification;
+    if (specification.width.Get() != render_area.width || specification.height.Get() != render_area.height) {
+      return false;
+    }
+  }
+
+  /* Merging only pays off if the attachments stay in the tile memory between the subpasses. Different layers of the
+     same texture aren't merged, as their barriers are calculated for the whole texture. */
+  bool shares_attachment = false;
+  for (const auto& attachment : attachments) {
+    for (const auto& render_pass_attachment : render_pass_attachments) {
+      if (attachment.entry_idx == render_pass_attachment.entry_idx) {
+        if (attachment.layer != render_pass_attachment.layer) {
+          return false;
+        }
+
+        shares_attachment = true;
+      }
+    }
+  }
+
+  /* Attachments can only be read at the same pixel, and only by the subpasses following the ones writing them */
+  if (samples_any(pass_node, render_pass_attachments)) {
+    return false;
+  }
+
+  for (uint32_t subpass_pass_idx : first_pass_node.subpass_pass_indices) {
+    const PassNode& subpass_pass_node = pass_nodes_[subpass_pass_idx];
+
+    if (samples_any(subpass_pass_node, attachments)) {
+      return false;
+    }
+
+    /* Buffer barriers can't be recorded inside of a render pass */
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      for (const auto& subpass_buffer_usage : subpass_pass_node.buffer_usages) {
+        bool same_buffer = buffer_nodes_[buffer_usage.in].actual_buffer_idx ==
+                           buffer_nodes_[subpass_buffer_usage.in].actual_buffer_idx;
+        bool write       = buffer_usage.out != kInvalidBufferVersionId ||
+                           subpass_buffer_usage.out != kInvalidBufferVersionId;
+
+        if (same_buffer && write) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return shares_attachment;
+}
+
+void RenderGraph::ScheduleQueues(RenderDevice& device) {
+  submissions_.clear();
+
+  bool async_compute = false;
+  for (auto& pass_node : pass_nodes_) {
+    pass_node.submission_idx = -1;
+    async_compute |= !pass_node.culled && pass_node.IsCompute() && pass_node.compute_pass->UsesAsyncCompute();
+  }
+
+  if (!async_compute_ || !async_compute || !device.SupportsAsyncCompute()) {
+    return;
+  }
+
+  /* The first submission is on the graphics queue and also stands for the previous frame, which ends with all textures
+     owned by the graphics queue. Buffers are only written by the host before the frame. */
+  submissions_.emplace_back();
+
+  std::vector<int32_t> texture_submissions(texture_entries_.size(), 0);  // Submissions of the last accesses
+  std::vector<int32_t> buffer_submissions(buffer_entries_.size(), -1);
+
+  /* Indexed by the queue: graphics and compute */
+  int32_t last_submissions[2]   = {0, -1};
+  int32_t waited_submissions[2] = {-1, -1};  // The last submission of the other queue waited for by the queue
+
+  std::vector<uint32_t> texture_entry_indices;
+  for (uint32_t pass_idx = 0; pass_idx < pass_nodes_.size(); ++pass_idx) {
+    PassNode& pass_node = pass_nodes_[pass_idx];
+    if (pass_node.culled) {
+      continue;
+    }
+
+    texture_entry_indices.clear();
+    if (pass_node.depth_stencil_usage.has_value()) {
+      texture_entry_indices.push_back(texture_nodes_[pass_node.depth_stencil_usage->in].actual_texture_idx);
+    }
+
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      texture_entry_indices.push_back(texture_nodes_[color_attachment_usage.in].actual_texture_idx);
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      texture_entry_indices.push_back(texture_nodes_[resolve_attachment_usage.in].actual_texture_idx);
+    }
+
+    for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+      texture_entry_indices.push_back(texture_nodes_[sampled_texture_id].actual_texture_idx);
+    }
+
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      texture_entry_indices.push_back(texture_nodes_[input_attachment_id].actual_texture_idx);
+    }
+
+    bool              compute   = pass_node.IsCompute() && pass_node.compute_pass->UsesAsyncCompute();
+    CommandBufferType queue     = compute ? CommandBufferType::kCompute : CommandBufferType::kGraphics;
+    uint32_t          queue_idx = compute ? 1 : 0;
+
+    /* Any access after an access from the other queue, even a read after a read, has to wait for the other queue's
+       submission, as textures also have to be transferred between the queues */
+    int32_t dependency = -1;
+    auto depend = [this, queue, &dependency](int32_t submission_idx) {
+      if (submission_idx != -1 && submissions_[submission_idx].queue != queue) {
+        dependency = std::max(dependency, submission_idx);
+      }
+    };
+
+    for (uint32_t entry_idx : texture_entry_indices) {
+      depend(texture_submissions[entry_idx]);
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      depend(buffer_submissions[buffer_nodes_[buffer_usage.in].actual_buffer_idx]);
+    }
+
+    /* Submissions waited for by the other queue are closed, so that the semaphore is signaled as early as possible */
+    int32_t& submission_idx = last_submissions[queue_idx];
+    if (submission_idx == -1 || submissions_[submission_idx].signal || dependency > waited_submissions[queue_idx]) {
+      detail::QueueSubmission submission{};
+      submission.queue = queue;
+
+      if (dependency > waited_submissions[queue_idx]) {
+        submission.wait_submission_idx  = dependency;
+        submissions_[dependency].signal = true;
+        waited_submissions[queue_idx]   = dependency;
+      }
+
+      submissions_.push_back(std::move(submission));
+      submission_idx = static_cast<int32_t>(submissions_.size()) - 1;
+    }
+
+    submissions_[submission_idx].pass_indices.push_back(pass_idx);
+    pass_node.submission_idx = submission_idx;
+
+    /* Guaranteed by not merging passes depending on async compute */
+    assert(pass_node.subpass_idx == 0 ||
+           pass_nodes_[pass_node.first_subpass_pass_idx].submission_idx == submission_idx);
+
+    for (uint32_t entry_idx : texture_entry_indices) {
+      texture_submissions[entry_idx] = submission_idx;
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      buffer_submissions[buffer_nodes_[buffer_usage.in].actual_buffer_idx] = submission_idx;
+    }
+  }
+
+  /* The frame ends on the graphics queue, which must wait for all of the compute work */
+  int32_t last_compute_submission_idx = last_submissions[1];
+  if (last_compute_submission_idx > waited_submissions[0]) {
+    submissions_[last_compute_submission_idx].signal = true;
+
+    detail::QueueSubmission submission{};
+    submission.queue               = CommandBufferType::kGraphics;
+    submission.wait_submission_idx = last_compute_submission_idx;
+    submissions_.push_back(std::move(submission));
+  }
+}
+
+void RenderGraph::UpdateDependentTextureValues() {
+  for (auto& entry : texture_entries_) {
+    DynamicTextureSpecification& specification = entry.specification;
+
+    if (specification.format.IsDependent()) {
+      auto dependency_format = GetTextureEntry(specification.format.GetDependency()).specification.format;
+
+      if (specification.format.Get() != dependency_format.Get()) {
+        specification.format.UpdateDependentValue(dependency_format.Get());
+        entry.dirty = true;
+      }
+    }
+
+    if (specification.width.IsDependent()) {
+      auto dependency_width = GetTextureEntry(specification.width.GetDependency()).specification.width;
+
+      if (specification.width.Get() != dependency_width.Get()) {
+        specification.width.UpdateDependentValue(dependency_width.Get());
+        entry.dirty = true;
+      }
+    }
+
+    if (specification.height.IsDependent()) {
+      auto dependency_height = GetTextureEntry(specification.height.GetDependency()).specification.height;
+
+      if (specification.height.Get() != dependency_height.Get()) {
+        specification.height.UpdateDependentValue(dependency_height.Get());
+        entry.dirty = true;
+      }
+    }
+
+    if (specification.samples.IsDependent()) {
+      auto dependency_samples = GetTextureEntry(specification.samples.GetDependency()).specification.samples;
+
+      if (specification.samples.Get() != dependency_samples.Get()) {
+        specification.samples.UpdateDependentValue(dependency_samples.Get());
+        entry.dirty = true;
+      }
+    }
+
+    if (entry.dirty) {
+      textures_dirty_ = true;
+    }
+  }
+}
+
+void RenderGraph::CalculateTextureLifetimes(const RenderDevice& device) {
+  for (auto& entry : texture_entries_) {
+    entry.first_pass_idx = -1;
+    entry.last_pass_idx  = -1;
+    entry.frame_local    = false;
+    entry.aliasable      = false;
+  }
+
+  std::vector<bool> attachment_only(texture_entries_.size(), true);  // Never sampled
+
+  for (int32_t pass_idx = 0; pass_idx < static_cast<int32_t>(pass_nodes_.size()); ++pass_idx) {
+    const PassNode& pass_node = pass_nodes_[pass_idx];
+    if (pass_node.culled) {
+      continue;
+    }
+
+    auto use_texture = [this, pass_idx](TextureVersionId id, bool reads_contents) {
+      detail::TextureEntry& entry = GetTextureEntry(id);
+
+      /* Aliased memory has undefined contents at the beginning of the lifetime and is reused after its end, so only
+         textures, which are both produced and consumed by the graph, can be aliased */
+      if (entry.first_pass_idx == -1) {
+        entry.first_pass_idx = pass_idx;
+        entry.frame_local    = !entry.imported && !entry.specification.cpu_readable &&
+                               entry.final_layout == TextureLayout::kUndefined;
+        entry.aliasable      = entry.frame_local;
+      }
+
+      if (entry.first_pass_idx == pass_idx && reads_contents) {
+        entry.frame_local = false;
+        entry.aliasable   = false;
+      }
+
+      entry.last_pass_idx = pass_idx;
+    };
+
+    if (pass_node.depth_stencil_usage.has_value()) {
+      use_texture(pass_node.depth_stencil_usage->in, pass_node.depth_stencil_usage->load == AttachmentLoad::kLoad);
+    }
+
+    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+      use_texture(color_attachment_usage.in, color_attachment_usage.load == AttachmentLoad::kLoad);
+    }
+
+    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+      use_texture(resolve_attachment_usage.in, resolve_attachment_usage.load == AttachmentLoad::kLoad);
+    }
+
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      use_texture(input_attachment_id, true);
+    }
+
+    for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+      use_texture(sampled_texture_id, true);
+      attachment_only[texture_nodes_[sampled_texture_id].actual_texture_idx] = false;
+
+      /* Might be used by the compute queue concurrently with the graphics passes, which are the only ones the aliasing
+         is calculated for. Doesn't depend on the async compute toggle, so that toggling doesn't recreate textures. */
+      if (pass_node.IsCompute() && pass_node.compute_pass->UsesAsyncCompute()) {
+        GetTextureEntry(sampled_texture_id).aliasable = false;
+      }
+    }
+  }
+
+  /* Textures living within a single render pass never leave the tile memory of tile-based GPUs, so they don't need any
+     actual memory. Such memory can't be aliased, though. */
+  constexpr TextureUsageFlags kAttachmentUsages = kTextureUsageBitColorAttachment | kTextureUsageBitDepthAttachment |
+                                                  kTextureUsageBitInputAttachment;
+
+  for (uint32_t entry_idx = 0; entry_idx < texture_entries_.size(); ++entry_idx) {
+    detail::TextureEntry& entry = texture_entries_[entry_idx];
+
+    bool transient_attachment =
+        device.SupportsLazilyAllocatedMemory() && entry.frame_local && attachment_only[entry_idx] &&
+        (entry.specification.usage & ~kAttachmentUsages) == 0 &&
+        pass_nodes_[entry.first_pass_idx].first_subpass_pass_idx ==
+            pass_nodes_[entry.last_pass_idx].first_subpass_pass_idx;
+
+    entry.dirty                |= (entry.transient_attachment != transient_attachment);
+    entry.transient_attachment  = transient_attachment;
+    entry.aliasable            &= !transient_attachment;
+  }
+}
+
+void RenderGraph::PlaceAliasedTextures(RenderDevice& device) {
+  assert(memory_heaps_.empty());
+
+  transient_memory_statistics_ = TransientMemoryStatistics{};
+
+  std::vector<uint32_t> aliased_entries;
+  for (uint32_t entry_idx = 0; entry_idx < texture_entries_.size(); ++entry_idx) {
+    detail::TextureEntry& entry = texture_entries_[entry_idx];
+    if (entry.imported) {
+      continue;
+    }
+
+    entry.memory_requirements = device.GetTextureMemoryRequirements(GetTextureSpecification(entry));
+    transient_memory_statistics_.textures_size += entry.memory_requirements.size;
+
+    if (entry.aliasable) {
+      aliased_entries.push_back(entry_idx);
+    } else {
+      transient_memory_statistics_.allocated_size += entry.memory_requirements.size;
+
+      /* The previous heap is going to be freed */
+      entry.dirty    |= (entry.heap_idx != -1);
+      entry.heap_idx  = -1;
+    }
+  }
+
+  /* First-fit placement, the largest textures go first so that the smaller ones fill the gaps between them */
+  std::stable_sort(aliased_entries.begin(), aliased_entries.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return texture_entries_[lhs].memory_requirements.size > texture_entries_[rhs].memory_requirements.size;
+  });
+
+  struct MemoryRange {
+    uint64_t begin{0};
+    uint64_t end{0};
+  };
+
+  std::vector<MemoryRange> occupied_ranges;
+  for (uint32_t i = 0; i < aliased_entries.size(); ++i) {
+    detail::TextureEntry&     entry        = texture_entries_[aliased_entries[i]];
+    const MemoryRequirements& requirements = entry.memory_requirements;
+
+    int32_t heap_idx = -1;
+    for (int32_t cur_heap_idx = 0; cur_heap_idx < static_cast<int32_t>(memory_heaps_.size()); ++cur_heap_idx) {
+      if (memory_heaps_[cur_heap_idx].requirements.memory_type_bits == requirements.memory_type_bits) {
+        heap_idx = cur_heap_idx;
+        break;
+      }
+    }
+
+    if (heap_idx == -1) {
+      heap_idx = static_cast<int32_t>(memory_heaps_.size());
+      memory_heaps_.emplace_back().requirements.memory_type_bits = requirements.memory_type_bits;
+    }
+
+    /* Memory ranges of the already placed textures, which are alive at the same time */
+    occupied_ranges.clear();
+    for (uint32_t j = 0; j < i; ++j) {
+      const detail::TextureEntry& other = texture_entries_[aliased_entries[j]];
+
+      if (other.heap_idx == heap_idx && other.first_pass_idx <= entry.last_pass_idx &&
+          entry.first_pass_idx <= other.last_pass_idx) {
+        occupied_ranges.push_back(MemoryRange{other.heap_offset, other.heap_offset + other.memory_requirements.size});
+      }
+    }
+
+    std::sort(occupied_ranges.begin(), occupied_ranges.end(),
+              [](const MemoryRange& lhs, const MemoryRange& rhs) { return lhs.begin < rhs.begin; });
+
+    uint64_t offset = 0;
+    for (const auto& range : occupied_ranges) {
+      if (offset + requirements.size <= range.begin) {
+        break;
+      }
+
+      offset = std::max(offset, AlignUp(range.end, requirements.alignment));
+    }
+
+    entry.heap_idx    = heap_idx;
+    entry.heap_offset = offset;
+    entry.dirty       = true;
+
+    MemoryRequirements& heap_requirements = memory_heaps_[heap_idx].requirements;
+    heap_requirements.size      = std::max(heap_requirements.size, offset + requirements.size);
+    heap_requirements.alignment = std::max(heap_requirements.alignment, requirements.alignment);
+  }
+
+  for (auto& heap : memory_heaps_) {
+    heap.memory = device.AllocateDeviceMemory(heap.requirements);
+    transient_memory_statistics_.allocated_size += heap.requirements.size;
+  }
+
+  transient_memory_statistics_.aliased_textures_count = static_cast<uint32_t>(aliased_entries.size());
+  transient_memory_statistics_.heaps_count            = static_cast<uint32_t>(memory_heaps_.size());
+}
+
+void RenderGraph::RecreateTransientTextures(RenderDevice& device) {
+  bool transient_textures_dirty = false;
+  for (const auto& entry : texture_entries_) {
+    transient_textures_dirty |= (entry.dirty && !entry.imported);
+  }
+
+  /* Placement depends on all aliased textures, so it is recalculated from scratch on any change. The barriers depend
+     on which textures share memory, so they have to be recalculated as well. */
+  std::vector<detail::TransientMemoryHeap> prev_memory_heaps;
+  if (transient_textures_dirty) {
+    prev_memory_heaps.swap(memory_heaps_);
+
+    CalculateTextureLifetimes(device);
+    PlaceAliasedTextures(device);
+
+    queues_dirty_ = true;
+  }
+
+  for (auto& entry : texture_entries_) {
+    if (entry.dirty && !entry.imported) {
+      TextureSpecification specification = GetTextureSpecification(entry);
+
+      if (entry.heap_idx != -1) {
+        DeviceMemoryHandle memory = memory_heaps_[entry.heap_idx].memory;
+
+        if (entry.texture) {
+          entry.texture->Recreate(specification, memory, entry.heap_offset);
+        } else {
+          entry.texture = CreateShared<Texture>(device, specification, memory, entry.heap_offset);
+        }
+      } else {
+        if (entry.texture) {
+          entry.texture->Recreate(specification);
+        } else {
+          entry.texture = CreateShared<Texture>(device, specification);
+        }
+      }
+
+      entry.dirty              = false;
+      entry.contents_undefined = true;
+    }
+  }
+
+  for (auto& heap : prev_memory_heaps) {
+    device.FreeDeviceMemory(heap.memory);
+  }
+
+  textures_dirty_ = false;
+}
+
+void RenderGraph::CalculateBarriers() {
+  texture_barriers_.clear();
+  buffer_barriers_.clear();
+
+  std::vector<TextureState> states(texture_entries_.size());
+  std::vector<bool>         used(texture_entries_.size());
+
+  /* Releases are recorded at the end of the submissions, so they are gathered separately to keep batches contiguous */
+  std::vector<std::vector<detail::PassTextureBarrier>> releases(submissions_.size());
+  std::vector<PipelineStageFlags>                      release_stage_masks(submissions_.size(), kPipelineStageBitNone);
+
+  auto release = [&states, &releases, &release_stage_masks](const detail::PassTextureBarrier& acquire) {
+    const TextureState& state = states[acquire.entry_idx];
+
+    detail::PassTextureBarrier barrier = acquire;
+    barrier.src_access_mask = state.write_access;
+    barrier.dst_access_mask = kMemoryAccessBitNone;
+    barrier.release         = true;
+
+    releases[state.submission_idx].push_back(barrier);
+    release_stage_masks[state.submission_idx] |= state.write_stages | state.read_stages;
+  };
+
+  /* Aliased textures, whose memory overlaps with each texture's one. Their states are either of the earlier passes or
+     of the end of the previous frame, so a texture's first use has to wait for the accesses through all of them. */
+  std::vector<std::vector<uint32_t>> overlapping_entries(texture_entries_.size());
+  for (uint32_t entry_idx = 0; entry_idx < texture_entries_.size(); ++entry_idx) {
+    const detail::TextureEntry& entry = texture_entries_[entry_idx];
+    if (entry.heap_idx == -1) {
+      continue;
+    }
+
+    for (uint32_t other_idx = entry_idx + 1; other_idx < texture_entries_.size(); ++other_idx) {
+      const detail::TextureEntry& other = texture_entries_[other_idx];
+
+      if (other.heap_idx == entry.heap_idx &&
+          other.heap_offset < entry.heap_offset + entry.memory_requirements.size &&
+          entry.heap_offset < other.heap_offset + other.memory_requirements.size) {
+        overlapping_entries[entry_idx].push_back(other_idx);
+        overlapping_entries[other_idx].push_back(entry_idx);
+      }
+    }
+  }
+
+  auto transition = [this, &states, &used, &release, &overlapping_entries](
+                        detail::BarrierBatch* batch, uint32_t entry_idx, const TextureAccess& access,
+                        CommandBufferType queue, int32_t submission_idx) {
+    TextureState& state     = states[entry_idx];
+    bool          first_use = !used[entry_idx];
+
+    /* Aliased memory has been written through the other textures since the texture's last use, so its contents (of
+       all the layers, not only the rendered to one) and its layout are undefined at the beginning of the lifetime */
+    bool discard = access.discard || (first_use && texture_entries_[entry_idx].heap_idx != -1);
+
+    /* Accesses from the other queue are ordered by a semaphore, which is a full memory dependency, so only the
+       ownership has to be transferred, unless the contents are discarded anyway */
+    bool queue_transfer = (state.queue != queue) && !discard;
+    if (state.queue != queue) {
+      if (batch != nullptr && queue_transfer) {
+        detail::PassTextureBarrier barrier{};
+        barrier.entry_idx  = entry_idx;
+        barrier.old_layout = state.layout;
+        barrier.new_layout = access.layout;
+        barrier.first_use  = first_use;
+        barrier.src_queue  = state.queue;
+        barrier.dst_queue  = queue;
+        release(barrier);
+      }
+
+      state.write_stages = kPipelineStageBitNone;
+      state.write_access = kMemoryAccessBitNone;
+      state.read_stages  = kPipelineStageBitNone;
+    }
+
+    bool               layout_change  = state.layout != access.layout;
+    PipelineStageFlags src_stage_mask = state.write_stages | state.read_stages;
+
+    /* Write after write/read or read after write, which hasn't been synchronized with the reading stages yet */
+    bool hazard = access.write ? (src_stage_mask != kPipelineStageBitNone)
+                               : (state.write_stages != kPipelineStageBitNone && (access.stages & ~state.read_stages));
+
+    /* The first use always has a barrier, as the texture might have been just (re)created */
+    if (batch != nullptr && (first_use || layout_change || hazard || queue_transfer)) {
+      MemoryAccessDependencyFlags src_access_mask = state.write_access;
+
+      /* Aliased memory might still be accessed through the other textures (on the other queue they are ordered by the
+         semaphore), including reads by synchronous compute passes */
+      if (first_use) {
+        for (uint32_t other_idx : overlapping_entries[entry_idx]) {
+          const TextureState& other_state = states[other_idx];
+          if (other_state.queue == queue) {
+            src_stage_mask  |= other_state.write_stages | other_state.read_stages;
+            src_access_mask |= other_state.write_access;
+          }
+        }
+      }
+
+      detail::PassTextureBarrier barrier{};
+      barrier.entry_idx       = entry_idx;
+      barrier.old_layout      = discard ? TextureLayout::kUndefined : state.layout;
+      barrier.new_layout      = access.layout;
+      barrier.src_access_mask = src_access_mask;
+      barrier.dst_access_mask = access.access;
+      barrier.first_use       = first_use;
+
+      if (queue_transfer) {
+        barrier.src_queue = state.queue;
+        barrier.dst_queue = queue;
+      }
+
+      texture_barriers_.push_back(barrier);
+
+      batch->src_stage_mask |= src_stage_mask;
+      batch->dst_stage_mask |= access.stages;
+      ++batch->texture_barriers_count;
+    }
+
+    state.layout         = access.layout;
+    state.queue          = queue;
+    state.submission_idx = submission_idx;
+    used[entry_idx]      = true;
+
+    if (access.write) {
+      state.write_stages = access.stages;
+      state.write_access = access.access & kWriteAccessMask;
+      state.read_stages  = kPipelineStageBitNone;
+    } else {
+      state.read_stages |= access.stages;
+    }
+  };
+
+  /* Host writes are made visible by the queue submission, so only the accesses by the passes need barriers */
+  std::vector<BufferState> buffer_states(buffer_entries_.size());
 
-Blackboard& RenderGraph::GetBlackboard() { return blackboard_; }
+  auto buffer_access = [this, &buffer_states](detail::BarrierBatch& batch, const PassNode::BufferUsage& usage,
+                                              CommandBufferType queue) {
+    uint32_t     entry_idx = buffer_nodes_[usage.in].actual_buffer_idx;
+    BufferState& state     = buffer_states[entry_idx];
+    bool         write     = (usage.out != kInvalidBufferVersionId);
 
-TextureVersionId RenderGraph::FirstVersion(const std::string_view name) {
-  for (const auto& node : texture_nodes_) {
-    if (texture_entries_[node.actual_texture_idx].name == name) {
-      return node.version_id;
+    /* Buffers are shared by the queues, so the accesses from the other queue are only ordered by the semaphore */
+    if (state.queue != queue) {
+      state       = BufferState{};
+      state.queue = queue;
     }
-  }
 
-  return kInvalidTextureVersionId;
-}
+    PipelineStageFlags src_stage_mask = state.write_stages | state.read_stages;
 
-TextureVersionId RenderGraph::LastVersion(const std::string_view name) {
-  TextureVersionId last_version = kInvalidTextureVersionId;
-  for (const auto& node : texture_nodes_) {
-    if (texture_entries_[node.actual_texture_idx].name == name) {
-      last_version = node.version_id;
+    bool hazard = write ? (src_stage_mask != kPipelineStageBitNone)
+                        : (state.write_stages != kPipelineStageBitNone && (usage.stages & ~state.read_stages));
+
+    if (hazard) {
+      detail::PassBufferBarrier barrier{};
+      barrier.entry_idx       = entry_idx;
+      barrier.src_access_mask = state.write_access;
+      barrier.dst_access_mask = usage.access;
+      buffer_barriers_.push_back(barrier);
+
+      batch.src_stage_mask |= src_stage_mask;
+      batch.dst_stage_mask |= usage.stages;
+      ++batch.buffer_barriers_count;
+    }
+
+    if (write) {
+      state.write_stages = usage.stages;
+      state.write_access = usage.access & kWriteAccessMask;
+      state.read_stages  = kPipelineStageBitNone;
+    } else {
+      state.read_stages |= usage.stages;
+    }
+  };
+
+  /* The graph is executed every frame, so the textures' states at the beginning of a frame are the ones at the end of
+     the previous frame. The first sweep only calculates them, the second one creates the barriers. Buffers don't carry
+     any state between frames, as a frame's ring region is only reused after the frame has finished on the GPU. */
+  int32_t last_graphics_submission_idx = -1;
+  for (uint32_t submission_idx = 0; submission_idx < submissions_.size(); ++submission_idx) {
+    if (submissions_[submission_idx].queue == CommandBufferType::kGraphics) {
+      last_graphics_submission_idx = static_cast<int32_t>(submission_idx);
     }
   }
 
-  return last_version;
-}
+  /* Render pass (its first pass), in which a texture has been last used as an attachment, -1 if none. Transitions
+     between the subpasses are done by the render pass itself. */
+  std::vector<int32_t> attachment_render_passes(texture_entries_.size());
 
-TextureVersionId RenderGraph::ImportTexture(const std::string_view name, SharedPtr<Texture> texture,
-                                            TextureLayout final_layout) {
-  assert(texture);
-  return NewEntry(name, texture, DynamicTextureSpecification(texture->GetSpecification()), true, final_layout);
-}
+  for (uint32_t sweep = 0; sweep < 2; ++sweep) {
+    bool create_barriers = (sweep == 1);
+    std::fill(used.begin(), used.end(), false);
+    std::fill(attachment_render_passes.begin(), attachment_render_passes.end(), -1);
 
-TextureVersionId RenderGraph::DeclareTexture(const std::string_view name, TextureLayout final_layout) {
-  texture_entries_.emplace_back(name, nullptr, rg::DynamicTextureSpecification{}, true, final_layout, 0, true);
+    for (auto& state : states) {
+      state.submission_idx = 0;
+    }
 
-  TextureNode& texture_node = AddTextureNode(texture_entries_.size() - 1, 0);
-  texture_node.subgraph_idx = cur_subgraph_idx_;
+    for (uint32_t pass_idx = 0; pass_idx < pass_nodes_.size(); ++pass_idx) {
+      const PassNode&       pass_node = pass_nodes_[pass_idx];
+      detail::BarrierBatch& batch     = built_passes_[pass_idx].barriers;
 
-  return texture_node.version_id;
-}
+      batch = detail::BarrierBatch{};
+      batch.first_texture_barrier = static_cast<uint32_t>(texture_barriers_.size());
+      batch.first_buffer_barrier  = static_cast<uint32_t>(buffer_barriers_.size());
 
-void RenderGraph::Setup() {
-  for (auto& pass_node : pass_nodes_) {
-    RenderGraphBuilder builder{*this, pass_node};
+      if (pass_node.culled) {
+        continue;
+      }
 
-    cur_subgraph_idx_ = pass_node.subgraph_idx;
-    pass_node.render_pass->Setup(builder, blackboard_, pass_node.render_pass_id);
-    cur_subgraph_idx_ = -1;
+      detail::BarrierBatch* batch_ptr      = create_barriers ? &batch : nullptr;
+      CommandBufferType     queue          = GetPassQueue(pass_idx);
+      int32_t               submission_idx = pass_node.submission_idx;
+      int32_t               render_pass    = static_cast<int32_t>(pass_node.first_subpass_pass_idx);
+
+      /* Barriers of all subpasses are recorded before the render pass begins, so only the attachments not used by the
+         previous subpasses can have them */
+      auto attachment_transition = [&](uint32_t entry_idx, const TextureAccess& access) {
+        bool subpass_dependency = (attachment_render_passes[entry_idx] == render_pass && pass_node.subpass_idx > 0);
+
+        transition(subpass_dependency ? nullptr : batch_ptr, entry_idx, access, queue, submission_idx);
+        attachment_render_passes[entry_idx] = render_pass;
+      };
+
+      if (pass_node.depth_stencil_usage.has_value()) {
+        uint32_t entry_idx = texture_nodes_[pass_node.depth_stencil_usage->in].actual_texture_idx;
+        attachment_transition(entry_idx,
+                              GetAttachmentAccess(*pass_node.depth_stencil_usage,
+                                                  texture_entries_[entry_idx].specification, /*depth_stencil=*/true));
+      }
+
+      for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
+        uint32_t entry_idx = texture_nodes_[color_attachment_usage.in].actual_texture_idx;
+        attachment_transition(entry_idx,
+                              GetAttachmentAccess(color_attachment_usage, texture_entries_[entry_idx].specification,
+                                                  /*depth_stencil=*/false));
+      }
+
+      for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
+        uint32_t entry_idx = texture_nodes_[resolve_attachment_usage.in].actual_texture_idx;
+        attachment_transition(entry_idx,
+                              GetAttachmentAccess(resolve_attachment_usage, texture_entries_[entry_idx].specification,
+                                                  /*depth_stencil=*/false));
+      }
+
+      for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+        uint32_t entry_idx = texture_nodes_[input_attachment_id].actual_texture_idx;
+        attachment_transition(entry_idx, GetInputAttachmentAccess(texture_entries_[entry_idx].specification));
+      }
+
+      for (const auto& sampled_texture_id : pass_node.sampled_texture_ids) {
+        transition(batch_ptr, texture_nodes_[sampled_texture_id].actual_texture_idx,
+                   GetSampledAccess(pass_node.IsCompute()), queue, submission_idx);
+      }
+
+      if (create_barriers) {
+        for (const auto& buffer_usage : pass_node.buffer_usages) {
+          buffer_access(batch, buffer_usage, queue);
+        }
+      }
+    }
+
+    /* Textures last used by the compute queue are returned to the graphics queue, which the frame ends with. Their next
+       accesses are synchronized with the acquire, as it waits for all commands. */
+    return_barriers_ = detail::BarrierBatch{};
+    return_barriers_.first_texture_barrier = static_cast<uint32_t>(texture_barriers_.size());
+    return_barriers_.first_buffer_barrier  = static_cast<uint32_t>(buffer_barriers_.size());
+
+    for (uint32_t entry_idx = 0; entry_idx < texture_entries_.size(); ++entry_idx) {
+      TextureState& state = states[entry_idx];
+      if (!used[entry_idx] || state.queue == CommandBufferType::kGraphics) {
+        continue;
+      }
+
+      if (create_barriers) {
+        detail::PassTextureBarrier barrier{};
+        barrier.entry_idx       = entry_idx;
+        barrier.old_layout      = state.layout;
+        barrier.new_layout      = state.layout;
+        barrier.dst_access_mask = kMemoryAccessBitMemoryRead | kMemoryAccessBitMemoryWrite;
+        barrier.src_queue       = state.queue;
+        barrier.dst_queue       = CommandBufferType::kGraphics;
+        release(barrier);
+        texture_barriers_.push_back(barrier);
+
+        return_barriers_.dst_stage_mask |= kPipelineStageBitAllCommands;
+        ++return_barriers_.texture_barriers_count;
+      }
+
+      state.write_stages   = kPipelineStageBitAllCommands;
+      state.write_access   = kMemoryAccessBitNone;
+      state.read_stages    = kPipelineStageBitNone;
+      state.queue          = CommandBufferType::kGraphics;
+      state.submission_idx = last_graphics_submission_idx;
+    }
+
+    final_barriers_ = detail::BarrierBatch{};
+    final_barriers_.first_texture_barrier = static_cast<uint32_t>(texture_barriers_.size());
+    final_barriers_.first_buffer_barrier  = static_cast<uint32_t>(buffer_barriers_.size());
+
+    for (uint32_t entry_idx = 0; entry_idx < texture_entries_.size(); ++entry_idx) {
+      const detail::TextureEntry& entry = texture_entries_[entry_idx];
+
+      if (used[entry_idx] && entry.final_layout != TextureLayout::kUndefined) {
+        transition(create_barriers ? &final_barriers_ : nullptr, entry_idx, GetExternalAccess(entry.final_layout),
+                   CommandBufferType::kGraphics, last_graphics_submission_idx);
+      }
+    }
   }
-}
 
-void RenderGraph::Compile(RenderDevice& device) {
-  UpdateDependentTextureValues();
-  RecreateTransientTextures(device);
-  RecreateRenderPasses(device);
-  RecreateFramebuffers(device);
+  for (uint32_t submission_idx = 0; submission_idx < submissions_.size(); ++submission_idx) {
+    detail::BarrierBatch& batch = submissions_[submission_idx].release_barriers;
+
+    batch = detail::BarrierBatch{};
+    batch.src_stage_mask         = release_stage_masks[submission_idx];
+    batch.first_texture_barrier  = static_cast<uint32_t>(texture_barriers_.size());
+    batch.texture_barriers_count = static_cast<uint32_t>(releases[submission_idx].size());
+    batch.first_buffer_barrier   = static_cast<uint32_t>(buffer_barriers_.size());
+
+    texture_barriers_.insert(texture_barriers_.end(), releases[submission_idx].begin(), releases[submission_idx].end());
+  }
 }
 
-void RenderGraph::Execute(RenderDevice& device, CommandBuffer& command_buffer) {
-  if (textures_dirty_) {
-    UpdateDependentTextureValues();
-    RecreateTransientTextures(device);
-    RecreateRenderPasses(device);
-    RecreateFramebuffers(device);
+void RenderGraph::RecordBarriers(CommandBuffer& command_buffer, const detail::BarrierBatch& batch,
+                                 uint32_t frame_in_flight) {
+  if (batch.texture_barriers_count == 0 && batch.buffer_barriers_count == 0) {
+    return;
   }
 
-  for (uint32_t i = 0; i < built_passes_.size(); ++i) {
-    const auto& pass_node  = pass_nodes_[i];
-    const auto& built_pass = built_passes_[i];
-
-    uint32_t width  = 0;
-    uint32_t height = 0;
-    if (!pass_node.color_attachment_usages.empty()) {
-      const detail::TextureEntry& texture = GetTextureEntry(pass_node.color_attachment_usages[0].out);
-      width  = texture.specification.width.Get();
-      height = texture.specification.height.Get();
-    } else if (pass_node.depth_stencil_usage.has_value()) {
-      const detail::TextureEntry& texture = GetTextureEntry(pass_node.depth_stencil_usage->out);
-      width  = texture.specification.width.Get();
-      height = texture.specification.height.Get();
-    } else {
-      assert(!"No color or depth stencil attachments found!");
+  recorded_barriers_.clear();
+  for (uint32_t i = 0; i < batch.texture_barriers_count; ++i) {
+    const detail::PassTextureBarrier& pass_barrier = texture_barriers_[batch.first_texture_barrier + i];
+    const detail::TextureEntry&       entry        = texture_entries_[pass_barrier.entry_idx];
+    assert(entry.texture);
+
+    /* Undefined contents aren't transferred, the acquiring queue simply discards them */
+    bool discard = pass_barrier.first_use && entry.contents_undefined;
+    if (discard && pass_barrier.release) {
+      continue;
     }
 
-    CommandBuffer::RenderPassBeginInfo render_pass_begin_info{};
-    render_pass_begin_info.render_pass        = built_pass.pass_handle;
-    render_pass_begin_info.framebuffer        = built_pass.framebuffer_handle;
-    render_pass_begin_info.render_area        = RenderArea{0, 0, width, height};
-    render_pass_begin_info.clear_values_count = built_pass.clear_values.size();
-    render_pass_begin_info.clear_values       = built_pass.clear_values.data();
+    TextureBarrier barrier{};
+    barrier.texture         = entry.texture->GetHandle();
+    barrier.old_layout      = discard ? TextureLayout::kUndefined : pass_barrier.old_layout;
+    barrier.new_layout      = pass_barrier.new_layout;
+    barrier.src_access_mask = pass_barrier.src_access_mask;
+    barrier.dst_access_mask = pass_barrier.dst_access_mask;
 
-    command_buffer.RenderPassBegin(render_pass_begin_info);
+    if (!discard) {
+      barrier.src_queue = pass_barrier.src_queue;
+      barrier.dst_queue = pass_barrier.dst_queue;
+    }
 
-    Viewport viewport{};
-    viewport.x         = 0;
-    viewport.y         = static_cast<float>(height);
-    viewport.width     = static_cast<float>(width);
-    viewport.height    = -static_cast<float>(height);
-    viewport.min_depth = 0.0f;
-    viewport.max_depth = 1.0f;
-    // Viewport viewport{};
-    // viewport.x         = 0;
-    // viewport.y         = 0;
-    // viewport.width     = static_cast<float>(width);
-    // viewport.height    = static_cast<float>(height);
-    // viewport.min_depth = 0.0f;
-    // viewport.max_depth = 1.0f;
-    command_buffer.CmdSetViewports(1, &viewport);
+    recorded_barriers_.push_back(barrier);
+  }
 
-    pass_node.render_pass->Execute(command_buffer, blackboard_, pass_node.render_pass_id, built_pass.pass_handle);
+  recorded_buffer_barriers_.resize(batch.buffer_barriers_count);
+  for (uint32_t i = 0; i < batch.buffer_barriers_count; ++i) {
+    const detail::PassBufferBarrier& pass_barrier = buffer_barriers_[batch.first_buffer_barrier + i];
+    const detail::BufferEntry&       entry        = buffer_entries_[pass_barrier.entry_idx];
+
+    BufferBarrier& barrier  = recorded_buffer_barriers_[i];
+    barrier.buffer          = buffer_ring_;
+    barrier.offset          = frame_in_flight * buffer_ring_frame_size_ + entry.offset;
+    barrier.size            = entry.specification.size;
+    barrier.src_access_mask = pass_barrier.src_access_mask;
+    barrier.dst_access_mask = pass_barrier.dst_access_mask;
+  }
 
-    command_buffer.RenderPassEnd();
+  if (recorded_barriers_.empty() && batch.buffer_barriers_count == 0) {
+    return;
   }
+
+  command_buffer.CmdPipelineBarrier(batch.src_stage_mask, batch.dst_stage_mask,
+                                    static_cast<uint32_t>(recorded_barriers_.size()), recorded_barriers_.data(),
+                                    batch.buffer_barriers_count, recorded_buffer_barriers_.data());
 }
 
-SharedPtr<Texture> RenderGraph::GetTexture(TextureVersionId version_id) {
-  return GetTextureEntry(version_id).texture;
+RenderArea RenderGraph::GetRenderArea(uint32_t pass_idx) const {
+  const PassNode& pass_node = pass_nodes_[pass_idx];
+
+  const detail::TextureEntry* texture = nullptr;
+  if (!pass_node.color_attachment_usages.empty()) {
+    texture = &GetTextureEntry(pass_node.color_attachment_usages[0].out);
+  } else if (pass_node.depth_stencil_usage.has_value()) {
+    texture = &GetTextureEntry(pass_node.depth_stencil_usage->out);
+  } else {
+    assert(!"No color or depth stencil attachments found!");
+    return RenderArea{};
+  }
+
+  return RenderArea{0, 0, texture->specification.width.Get(), texture->specification.height.Get()};
 }
 
-void RenderGraph::ReimportTexture(TextureVersionId version, SharedPtr<Texture> texture) {
-  assert(version != kInvalidTextureVersionId);
-  assert(texture);
+void RenderGraph::ExecutePass(CommandBuffer& command_buffer, uint32_t pass_idx, uint32_t frame_in_flight) {
+  const auto& pass_node  = pass_nodes_[pass_idx];
+  const auto& built_pass = built_passes_[pass_idx];
 
-  detail::TextureEntry& entry = GetTextureEntry(version);
-  if (entry.texture == nullptr || entry.texture->GetHandle() != texture->GetHandle() ||
-      entry.prev_texture_handle != texture->GetHandle()) {
-    const TextureSpecification& specification = texture->GetSpecification();
-    entry.dirty |= entry.specification.format.Get()  != specification.format ||
-                   entry.specification.type          != specification.type ||
-                   entry.specification.usage         != specification.usage ||
-                   entry.specification.cpu_readable  != specification.cpu_readable ||
-                   entry.specification.width.Get()   != specification.width ||
-                   entry.specification.height.Get()  != specification.height ||
-                   entry.specification.samples.Get() != specification.samples ||
-                   entry.specification.mip_levels    != specification.mip_levels;
+  if (pass_node.IsCompute()) {
+    RecordBarriers(command_buffer, built_pass.barriers, frame_in_flight);
 
-    if (entry.dirty || entry.texture == nullptr) {
-      entry.dirty     = true;
-      textures_dirty_ = true;
+    if (pass_node.compute_pass->IsEnabled(blackboard_, pass_node.render_pass_id)) {
+      pass_node.compute_pass->Execute(command_buffer, blackboard_, pass_node.render_pass_id);
     }
 
-    entry.specification        = DynamicTextureSpecification{texture->GetSpecification()};
-    entry.texture             = texture;
-    entry.prev_texture_handle = texture->GetHandle();
+    return;
+  }
+
+  /* Merged passes are executed as the subpasses of the render pass begun by the first one */
+  if (pass_node.subpass_idx > 0) {
+    return;
+  }
+
+  for (uint32_t subpass_pass_idx : pass_node.subpass_pass_indices) {
+    RecordBarriers(command_buffer, built_passes_[subpass_pass_idx].barriers, frame_in_flight);
+  }
+
+  RenderArea render_area = GetRenderArea(pass_idx);
+
+  CommandBuffer::RenderPassBeginInfo render_pass_begin_info{};
+  render_pass_begin_info.render_pass        = built_pass.pass_handle;
+  render_pass_begin_info.framebuffer        = built_pass.framebuffer_handle;
+  render_pass_begin_info.render_area        = render_area;
+  render_pass_begin_info.clear_values_count = built_pass.clear_values.size();
+  render_pass_begin_info.clear_values       = built_pass.clear_values.data();
+
+  Viewport viewport{};
+  viewport.x         = 0;
+  viewport.y         = static_cast<float>(render_area.height);
+  viewport.width     = static_cast<float>(render_area.width);
+  viewport.height    = -static_cast<float>(render_area.height);
+  viewport.min_depth = 0.0f;
+  viewport.max_depth = 1.0f;
+  // Viewport viewport{};
+  // viewport.x         = 0;
+  // viewport.y         = 0;
+  // viewport.width     = static_cast<float>(width);
+  // viewport.height    = static_cast<float>(height);
+  // viewport.min_depth = 0.0f;
+  // viewport.max_depth = 1.0f;
+
+  for (uint32_t subpass_idx = 0; subpass_idx < pass_node.subpass_pass_indices.size(); ++subpass_idx) {
+    const auto& subpass_node = pass_nodes_[pass_node.subpass_pass_indices[subpass_idx]];
+
+    /* Disabled passes still load and store their attachments, so that the dependent passes see defined contents */
+    bool enabled                   = subpass_node.render_pass->IsEnabled(blackboard_, subpass_node.render_pass_id);
+    bool secondary_command_buffers = enabled && subpass_node.render_pass->UsesSecondaryCommandBuffers();
+
+    if (subpass_idx == 0) {
+      render_pass_begin_info.secondary_command_buffers = secondary_command_buffers;
+      command_buffer.RenderPassBegin(render_pass_begin_info);
+    } else {
+      command_buffer.CmdNextSubpass(secondary_command_buffers);
+    }
+
+    if (!enabled) {
+      continue;
+    }
+
+    if (secondary_command_buffers) {
+      CommandBuffer::InheritanceInfo inheritance_info{};
+      inheritance_info.render_pass = built_pass.pass_handle;
+      inheritance_info.subpass     = subpass_idx;
+      inheritance_info.framebuffer = built_pass.framebuffer_handle;
+      inheritance_info.render_area = render_area;
+      inheritance_info.viewport    = viewport;
+
+      subpass_node.render_pass->ExecuteSecondary(command_buffer, inheritance_info, blackboard_,
+                                                 subpass_node.render_pass_id);
+    } else {
+      command_buffer.CmdSetViewports(1, &viewport);
+      subpass_node.render_pass->Execute(command_buffer, blackboard_, subpass_node.render_pass_id,
+                                        built_pass.pass_handle, subpass_idx);
+    }
   }
+
+  command_buffer.RenderPassEnd();
 }
 
-void RenderGraph::UpdateDependentTextureValues() {
-  for (auto& entry : texture_entries_) {
-    DynamicTextureSpecification& specification = entry.specification;
+void RenderGraph::ExecuteSubmissions(RenderDevice& device, uint32_t frame_in_flight) {
+  std::vector<CommandBuffer*>&  graphics_command_buffers = graphics_command_buffers_[frame_in_flight];
+  std::vector<CommandBuffer*>&  compute_command_buffers  = compute_command_buffers_[frame_in_flight];
+  std::vector<SemaphoreHandle>& semaphores               = semaphores_[frame_in_flight];
 
-    if (specification.format.IsDependent()) {
-      auto dependency_format = GetTextureEntry(specification.format.GetDependency()).specification.format;
+  while (semaphores.size() < submissions_.size()) {
+    semaphores.push_back(device.CreateSemaphore());
+  }
 
-      if (specification.format.Get() != dependency_format.Get()) {
-        specification.format.UpdateDependentValue(dependency_format.Get());
-        entry.dirty = true;
-      }
+  uint32_t last_graphics_submission_idx = 0;
+  for (uint32_t submission_idx = 0; submission_idx < submissions_.size(); ++submission_idx) {
+    if (submissions_[submission_idx].queue == CommandBufferType::kGraphics) {
+      last_graphics_submission_idx = submission_idx;
     }
+  }
 
-    if (specification.width.IsDependent()) {
-      auto dependency_width = GetTextureEntry(specification.width.GetDependency()).specification.width;
+  /* Command buffers are reused in the order of the submissions, the previous use of the frame has already finished */
+  uint32_t graphics_command_buffers_used = 0;
+  uint32_t compute_command_buffers_used  = 0;
 
-      if (specification.width.Get() != dependency_width.Get()) {
-        specification.width.UpdateDependentValue(dependency_width.Get());
-        entry.dirty = true;
-      }
+  for (uint32_t submission_idx = 0; submission_idx < submissions_.size(); ++submission_idx) {
+    const detail::QueueSubmission& submission = submissions_[submission_idx];
+
+    bool compute = (submission.queue == CommandBufferType::kCompute);
+    auto& command_buffers      = compute ? compute_command_buffers : graphics_command_buffers;
+    auto& command_buffers_used = compute ? compute_command_buffers_used : graphics_command_buffers_used;
+
+    if (command_buffers_used == command_buffers.size()) {
+      command_buffers.push_back(device.CreateCommandBuffer(submission.queue));
     }
 
-    if (specification.height.IsDependent()) {
-      auto dependency_height = GetTextureEntry(specification.height.GetDependency()).specification.height;
+    CommandBuffer& command_buffer = *command_buffers[command_buffers_used++];
+    command_buffer.Reset();
+    command_buffer.Begin();
 
-      if (specification.height.Get() != dependency_height.Get()) {
-        specification.height.UpdateDependentValue(dependency_height.Get());
-        entry.dirty = true;
-      }
+    for (uint32_t pass_idx : submission.pass_indices) {
+      ExecutePass(command_buffer, pass_idx, frame_in_flight);
     }
 
-    if (specification.samples.IsDependent()) {
-      auto dependency_samples = GetTextureEntry(specification.samples.GetDependency()).specification.samples;
+    RecordBarriers(command_buffer, submission.release_barriers, frame_in_flight);
 
-      if (specification.samples.Get() != dependency_samples.Get()) {
-        specification.samples.UpdateDependentValue(dependency_samples.Get());
-        entry.dirty = true;
-      }
+    if (submission_idx == last_graphics_submission_idx) {
+      RecordBarriers(command_buffer, return_barriers_, frame_in_flight);
+      RecordBarriers(command_buffer, final_barriers_, frame_in_flight);
     }
 
-    if (entry.dirty) {
-      textures_dirty_ = true;
+    command_buffer.End();
+
+    SemaphoreHandle signal_semaphore = kInvalidRenderResourceHandle;
+    if (submission.signal) {
+      signal_semaphore = semaphores[submission_idx];
+    }
+
+    SemaphoreHandle wait_semaphore = kInvalidRenderResourceHandle;
+    if (submission.wait_submission_idx != -1) {
+      wait_semaphore = semaphores[submission.wait_submission_idx];
     }
+
+    command_buffer.Submit(kInvalidRenderResourceHandle, signal_semaphore, wait_semaphore, kPipelineStageBitAllCommands);
   }
 }
 
-void RenderGraph::RecreateTransientTextures(RenderDevice& device) {
-  for (auto& entry : texture_entries_) {
-    if (entry.dirty && !entry.imported) {
-      TextureSpecification specification{};
-      specification.format       = entry.specification.format.Get();
-      specification.type         = entry.specification.type;
-      specification.usage        = entry.specification.usage;
-      specification.cpu_readable = entry.specification.cpu_readable;
-      specification.width        = entry.specification.width.Get();
-      specification.height       = entry.specification.height.Get();
-      specification.samples      = entry.specification.samples.Get();
-      specification.mip_levels   = entry.specification.mip_levels;
-
-      if (entry.texture) {
-        entry.texture->Recreate(specification);
-      } else {
-        entry.texture = CreateShared<Texture>(device, specification);
-      }
+CommandBufferType RenderGraph::GetPassQueue(uint32_t pass_idx) const {
+  int32_t submission_idx = pass_nodes_[pass_idx].submission_idx;
+  return (submission_idx == -1) ? CommandBufferType::kGraphics : submissions_[submission_idx].queue;
+}
 
-      entry.dirty = false;
-    }
+void RenderGraph::AllocateTransientBuffers(RenderDevice& device) {
+  assert(!ValidRenderHandle(buffer_ring_));
+
+  /* Offsets are the same in every frame region, so that the frame's slices are simply shifted by the region's size */
+  uint32_t         frame_size = 0;
+  BufferUsageFlags usage      = kBufferUsageBitNone;
+  for (auto& entry : buffer_entries_) {
+    entry.offset = static_cast<uint32_t>(AlignUp(frame_size, kBufferSliceAlignment));
+    frame_size   = entry.offset + entry.specification.size;
+    usage       |= entry.specification.usage;
   }
 
-  textures_dirty_ = false;
+  buffer_ring_frame_size_ = static_cast<uint32_t>(AlignUp(frame_size, kBufferSliceAlignment));
+  if (buffer_ring_frame_size_ == 0) {
+    return;
+  }
+
+  buffer_ring_ = device.CreateBuffer(buffer_ring_frame_size_ * kFramesInFlight, usage, /*dynamic_memory=*/true);
 }
 
 void RenderGraph::RecreateRenderPasses(RenderDevice& device) {
   built_passes_.resize(pass_nodes_.size());
-  
+
+  std::vector<uint32_t> attachment_entries;    // Texture entry of each attachment of the render pass
+  std::vector<int32_t>  attachment_subpasses;  // Last subpass using each attachment
+
   for (uint32_t i = 0; i < pass_nodes_.size(); ++i) {
     const auto& pass_node  = pass_nodes_[i];
     auto&       built_pass = built_passes_[i];
 
-    built_pass.description.subpasses.resize(1);
+    built_pass.description.attachments.clear();
+    built_pass.description.subpasses.clear();
+    built_pass.description.subpass_dependencies.clear();
+    built_pass.framebuffer_attachments.clear();
+    built_pass.clear_values.clear();
 
-    SubpassDescription& subpass = built_pass.description.subpasses[0];
-    subpass.bind_point = SubpassPipelineBindPoint::kGraphics;
-    subpass.color_attachments.resize(pass_node.color_attachment_usages.size());
-    subpass.resolve_attachments.resize(pass_node.resolve_attachment_usages.size());
+    /* Compute passes are executed outside of render passes */
+    if (pass_node.culled || pass_node.IsCompute()) {
+      built_pass.pass_handle = kInvalidRenderResourceHandle;
+      continue;
+    }
 
-    /* Attachments */
-    uint32_t attachments_count = (pass_node.depth_stencil_usage.has_value() ? 1 : 0) +
-                                  pass_node.color_attachment_usages.size() + pass_node.resolve_attachment_usages.size();
+    /* Merged passes are subpasses of the render pass begun by the first one, which also owns the framebuffer */
+    if (pass_node.subpass_idx > 0) {
+      built_pass.pass_handle = built_passes_[pass_node.first_subpass_pass_idx].pass_handle;
+      continue;
+    }
 
-    built_pass.description.attachments.resize(attachments_count);
-    built_pass.framebuffer_attachments.resize(attachments_count);
-    built_pass.clear_values.resize(attachments_count);
+    attachment_entries.clear();
+    attachment_subpasses.clear();
+
+    RenderPassDescription& description = built_pass.description;
+    description.subpasses.resize(pass_node.subpass_pass_indices.size());
+
+    /* Subpasses share the attachments, the load op is taken from the first use and the store op from the last write.
+       Layout transitions before the render pass are done by the barriers, and between the subpasses by the render
+       pass itself. */
+    auto add_attachment = [&](uint32_t subpass_idx, TextureVersionId id, uint32_t layer, TextureLayout layout,
+                              const PassNode::TextureUsage* usage) {
+      uint32_t                    entry_idx = texture_nodes_[id].actual_texture_idx;
+      const detail::TextureEntry& entry     = texture_entries_[entry_idx];
+
+      uint32_t attachment = 0;
+      while (attachment < attachment_entries.size() &&
+             (attachment_entries[attachment] != entry_idx ||
+              built_pass.framebuffer_attachments[attachment].layer != layer)) {
+        ++attachment;
+      }
 
-    uint32_t attachment = 0;
-    if (pass_node.depth_stencil_usage.has_value()) {
-      const detail::TextureEntry& entry = GetTextureEntry(pass_node.depth_stencil_usage->in);
+      if (attachment == attachment_entries.size()) {
+        AttachmentDescription attachment_description{};
+        attachment_description.format         = entry.specification.format.Get();   // FIXME: dynamic
+        attachment_description.samples        = entry.specification.samples.Get();  // FIXME: dynamic
+        attachment_description.load_op        = (usage != nullptr) ? usage->load : AttachmentLoad::kLoad;
+        attachment_description.store_op       = AttachmentStore::kStore;
+        attachment_description.initial_layout = layout;
+        description.attachments.push_back(attachment_description);
 
-      built_pass.framebuffer_attachments[attachment] = {entry.texture->GetHandle(),
-                                                        pass_node.depth_stencil_usage->layer};
-      built_pass.clear_values[attachment] = pass_node.depth_stencil_usage->clear_value;
+        built_pass.framebuffer_attachments.emplace_back(entry.texture->GetHandle(), layer);
+        built_pass.clear_values.push_back((usage != nullptr) ? usage->clear_value : ClearValue{});
 
-      TextureLayout initial_layout = TextureLayout::kUndefined;
-      if (pass_node.depth_stencil_usage->load == AttachmentLoad::kLoad) {
-        initial_layout = TextureLayout::kDepthStencilAttachment;
+        attachment_entries.push_back(entry_idx);
+        attachment_subpasses.push_back(-1);
       }
 
-      TextureLayout final_layout = TextureLayout::kUndefined;
-
-      NextPassUsage next_pass_usage = GetNextPassUsage(i, pass_node.depth_stencil_usage->out);
-      if (next_pass_usage.pass_idx != -1) {
-        final_layout = next_pass_usage.layout;
-      } else if (entry.final_layout != TextureLayout::kUndefined) {
-        final_layout = entry.final_layout;
-      } else {
-        final_layout = TextureLayout::kGeneral;
+      AttachmentDescription& attachment_description = description.attachments[attachment];
+      attachment_description.final_layout = layout;
+      if (usage != nullptr) {
+        attachment_description.store_op = usage->store;
       }
 
-      AttachmentDescription attachment_description{};
-      attachment_description.format         = entry.specification.format.Get();   // FIXME: dynamic
-      attachment_description.samples        = entry.specification.samples.Get();  // FIXME: dynamic
-      attachment_description.load_op        = pass_node.depth_stencil_usage->load;
-      attachment_description.store_op       = pass_node.depth_stencil_usage->store;
-      attachment_description.initial_layout = initial_layout;
-      attachment_description.final_layout   = final_layout;
-      built_pass.description.attachments[attachment] = attachment_description;
+      /* Attachments written by a subpass are read (or written) by the following ones at the same pixel */
+      int32_t prev_subpass_idx = attachment_subpasses[attachment];
+      if (prev_subpass_idx != -1 && prev_subpass_idx != static_cast<int32_t>(subpass_idx)) {
+        SubpassDependency dependency{};
+        dependency.dependency_subpass_idx = static_cast<uint32_t>(prev_subpass_idx);
+        dependency.dependent_subpass_idx  = subpass_idx;
+        dependency.dependency_stage_mask  = kPipelineStageBitEarlyFragmentTests | kPipelineStageBitLateFragmentTests |
+                                            kPipelineStageBitColorAttachmentOutput;
+        dependency.dependent_stage_mask   = kPipelineStageBitEarlyFragmentTests | kPipelineStageBitLateFragmentTests |
+                                            kPipelineStageBitColorAttachmentOutput | kPipelineStageBitFragmentShader;
+        dependency.dependency_access_mask = kMemoryAccessBitColorAttachmentWrite |
+                                            kMemoryAccessBitDepthStencilAttachmentWrite;
+        dependency.dependent_access_mask  = kMemoryAccessBitInputAttachmentRead |
+                                            kMemoryAccessBitColorAttachmentRead |
+                                            kMemoryAccessBitColorAttachmentWrite |
+                                            kMemoryAccessBitDepthStencilAttachmentRead |
+                                            kMemoryAccessBitDepthStencilAttachmentWrite;
+        dependency.by_region              = true;
+
+        if (std::find(description.subpass_dependencies.begin(), description.subpass_dependencies.end(), dependency) ==
+            description.subpass_dependencies.end()) {
+          description.subpass_dependencies.push_back(dependency);
+        }
+      }
 
-      subpass.depth_stencil_attachment = AttachmentReference{attachment, TextureLayout::kDepthStencilAttachment};
+      attachment_subpasses[attachment] = static_cast<int32_t>(subpass_idx);
 
-      ++attachment;
-    }
+      return attachment;
+    };
 
-    uint32_t color_attachment_idx = 0;
-    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
-      const detail::TextureEntry& entry = GetTextureEntry(color_attachment_usage.in);
+    for (uint32_t subpass_idx = 0; subpass_idx < pass_node.subpass_pass_indices.size(); ++subpass_idx) {
+      uint32_t        subpass_pass_idx  = pass_node.subpass_pass_indices[subpass_idx];
+      const PassNode& subpass_pass_node = pass_nodes_[subpass_pass_idx];
 
-      built_pass.framebuffer_attachments[attachment] = {entry.texture->GetHandle(), color_attachment_usage.layer};
-      built_pass.clear_values[attachment]            = color_attachment_usage.clear_value;
+      SubpassDescription& subpass = description.subpasses[subpass_idx];
+      subpass            = SubpassDescription{};
+      subpass.bind_point = SubpassPipelineBindPoint::kGraphics;
 
-      TextureLayout initial_layout = TextureLayout::kUndefined;
-      if (color_attachment_usage.load == AttachmentLoad::kLoad) {
-        initial_layout = TextureLayout::kColorAttachment;
+      for (const auto& input_attachment_id : subpass_pass_node.input_attachment_ids) {
+        TextureLayout layout = GetInputAttachmentAccess(GetTextureEntry(input_attachment_id).specification).layout;
+        subpass.input_attachments.push_back(
+            AttachmentReference{add_attachment(subpass_idx, input_attachment_id, 0, layout, nullptr), layout});
       }
 
-      TextureLayout final_layout = TextureLayout::kUndefined;
-
-      NextPassUsage next_pass_usage = GetNextPassUsage(i, color_attachment_usage.out);
-      if (next_pass_usage.pass_idx != -1) {
-        final_layout = next_pass_usage.layout;
-      } else if (entry.final_layout != TextureLayout::kUndefined) {
-        final_layout = entry.final_layout;
-      } else {
-        final_layout = TextureLayout::kGeneral;
+      if (subpass_pass_node.depth_stencil_usage.has_value()) {
+        const auto& usage = *subpass_pass_node.depth_stencil_usage;
+        subpass.depth_stencil_attachment = AttachmentReference{
+            add_attachment(subpass_idx, usage.in, usage.layer, TextureLayout::kDepthStencilAttachment, &usage),
+            TextureLayout::kDepthStencilAttachment};
       }
 
-      AttachmentDescription attachment_description{};
-      attachment_description.format         = entry.specification.format.Get();   // FIXME: dynamic
-      attachment_description.samples        = entry.specification.samples.Get();  // FIXME: dynamic
-      attachment_description.load_op        = color_attachment_usage.load;
-      attachment_description.store_op       = color_attachment_usage.store;
-      attachment_description.initial_layout = initial_layout;
-      attachment_description.final_layout    = final_layout;
-      built_pass.description.attachments[attachment] = attachment_description;
-
-      subpass.color_attachments[color_attachment_idx] =
-          AttachmentReference{attachment, TextureLayout::kColorAttachment};
-
-      ++color_attachment_idx;
-      ++attachment;
-    }
+      for (const auto& usage : subpass_pass_node.color_attachment_usages) {
+        subpass.color_attachments.push_back(AttachmentReference{
+            add_attachment(subpass_idx, usage.in, usage.layer, TextureLayout::kColorAttachment, &usage),
+            TextureLayout::kColorAttachment});
+      }
 
-    uint32_t resolve_attachment_idx = 0;
-    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
-      const detail::TextureEntry& entry = GetTextureEntry(resolve_attachment_usage.in);
+      for (const auto& usage : subpass_pass_node.resolve_attachment_usages) {
+        subpass.resolve_attachments.push_back(AttachmentReference{
+            add_attachment(subpass_idx, usage.in, usage.layer, TextureLayout::kColorAttachment, &usage),
+            TextureLayout::kColorAttachment});
+      }
 
-      built_pass.framebuffer_attachments[attachment] = {entry.texture->GetHandle(), resolve_attachment_usage.layer};
-      built_pass.clear_values[attachment]            = resolve_attachment_usage.clear_value;
+      /* Aliased memory might still be accessed by the previous passes, when a texture's lifetime begins */
+      bool begins_aliased_lifetime = false;
+      for (const auto& entry : texture_entries_) {
+        begins_aliased_lifetime |=
+            (entry.heap_idx != -1 && entry.first_pass_idx == static_cast<int32_t>(subpass_pass_idx));
+      }
 
-      TextureLayout initial_layout = TextureLayout::kUndefined;
-      if (resolve_attachment_usage.load == AttachmentLoad::kLoad) {
-        initial_layout = TextureLayout::kColorAttachment;
+      if (begins_aliased_lifetime) {
+        SubpassDependency dependency{};
+        dependency.dependency_subpass_idx = kSubpassExternal;
+        dependency.dependent_subpass_idx  = subpass_idx;
+        dependency.dependency_stage_mask  = kPipelineStageBitFragmentShader | kPipelineStageBitComputeShader |
+                                            kPipelineStageBitEarlyFragmentTests | kPipelineStageBitLateFragmentTests |
+                                            kPipelineStageBitColorAttachmentOutput;
+        dependency.dependent_stage_mask   = kPipelineStageBitEarlyFragmentTests | kPipelineStageBitLateFragmentTests |
+                                            kPipelineStageBitColorAttachmentOutput;
+        dependency.dependency_access_mask = kMemoryAccessBitColorAttachmentWrite |
+                                            kMemoryAccessBitDepthStencilAttachmentWrite;
+        dependency.dependent_access_mask  = kMemoryAccessBitColorAttachmentWrite |
+                                            kMemoryAccessBitDepthStencilAttachmentWrite;
+
+        description.subpass_dependencies.push_back(dependency);
       }
+    }
 
-      TextureLayout final_layout = TextureLayout::kUndefined;
+    /* Contents of frame-local textures, which aren't used after the render pass, never have to leave the tile memory */
+    for (uint32_t attachment = 0; attachment < attachment_entries.size(); ++attachment) {
+      const detail::TextureEntry& entry = texture_entries_[attachment_entries[attachment]];
 
-      NextPassUsage next_pass_usage = GetNextPassUsage(i, resolve_attachment_usage.out);
-      if (next_pass_usage.pass_idx != -1) {
-        final_layout = next_pass_usage.layout;
-      } else if (entry.final_layout != TextureLayout::kUndefined) {
-        final_layout = entry.final_layout;
-      } else {
-        final_layout = TextureLayout::kGeneral;
+      if (entry.frame_local && pass_nodes_[entry.last_pass_idx].first_subpass_pass_idx == i) {
+        description.attachments[attachment].store_op = AttachmentStore::kDontCare;
       }
+    }
 
-      AttachmentDescription attachment_description{};
-      attachment_description.format         = entry.specification.format.Get();   // FIXME: dynamic
-      attachment_description.samples        = entry.specification.samples.Get();  // FIXME: dynamic
-      attachment_description.load_op        = resolve_attachment_usage.load;
-      attachment_description.store_op       = resolve_attachment_usage.store;
-      attachment_description.initial_layout = initial_layout;
-      attachment_description.final_layout    = final_layout;
-      built_pass.description.attachments[attachment] = attachment_description;
-
-      subpass.resolve_attachments[resolve_attachment_idx] =
-          AttachmentReference{attachment, TextureLayout::kColorAttachment};
+    /* Descriptions don't depend on the extents, so e.g. resizing only recreates the framebuffers */
+    uint64_t hash       = CalculateHash(description);
+    auto     candidates = render_pass_cache_.equal_range(hash);
 
-      ++resolve_attachment_idx;
-      ++attachment;
+    auto cached = candidates.first;
+    while (cached != candidates.second && !(cached->second.description == description)) {
+      ++cached;
     }
 
-    if (ValidRenderHandle(built_pass.pass_handle)) {
-      device.DeleteRenderPass(built_pass.pass_handle);
+    if (cached == candidates.second) {
+      detail::CachedRenderPass render_pass{};
+      render_pass.description = description;
+      render_pass.handle      = device.CreateRenderPass(description);
+
+      cached = render_pass_cache_.emplace(hash, std::move(render_pass));
     }
 
-    built_pass.pass_handle = device.CreateRenderPass(built_pass.description);
+    built_pass.pass_handle = cached->second.handle;
   }
 }
 
 void RenderGraph::RecreateFramebuffers(RenderDevice& device) {
-  for (auto& built_pass : built_passes_) {
+  for (uint32_t i = 0; i < built_passes_.size(); ++i) {
+    auto& built_pass = built_passes_[i];
+
     if (ValidRenderHandle(built_pass.framebuffer_handle)) {
       device.DeleteFramebuffer(built_pass.framebuffer_handle);
+      built_pass.framebuffer_handle = kInvalidRenderResourceHandle;
     }
 
-    built_pass.framebuffer_handle =
-        device.CreateFramebuffer(built_pass.framebuffer_attachments, built_pass.pass_handle);
+    /* Merged passes use the framebuffer of the first one */
+    if (ValidRenderHandle(built_pass.pass_handle) && pass_nodes_[i].subpass_idx == 0) {
+      built_pass.framebuffer_handle =
+          device.CreateFramebuffer(built_pass.framebuffer_attachments, built_pass.pass_handle);
+    }
   }
 }
 
@@ -454,34 +1904,38 @@ const rg::detail::TextureEntry& RenderGraph::GetTextureEntry(TextureVersionId id
   return texture_entries_[texture_nodes_[id].actual_texture_idx];
 }
 
-RenderGraph::NextPassUsage RenderGraph::GetNextPassUsage(uint32_t pass_idx, TextureVersionId id) {
-  for (uint32_t cur_pass_idx = pass_idx + 1; cur_pass_idx < pass_nodes_.size(); ++cur_pass_idx) {
-    const auto& pass_node = pass_nodes_[cur_pass_idx];
+BufferVersionId RenderGraph::NewBufferEntry(const std::string_view name, const BufferSpecification& specification,
+                                            bool host_written) {
+  assert(specification.size > 0);
+  assert(!ValidRenderHandle(buffer_ring_) && "Buffers can only be created before the ring is allocated");
 
-    if (pass_node.depth_stencil_usage.has_value() && pass_node.depth_stencil_usage->in == id) {
-      return NextPassUsage{static_cast<int32_t>(cur_pass_idx), TextureLayout::kDepthStencilAttachment};
-    }
+  buffer_entries_.emplace_back(name, specification, host_written);
 
-    for (const auto& color_attachment_usage : pass_node.color_attachment_usages) {
-      if (color_attachment_usage.in == id) {
-        return NextPassUsage{static_cast<int32_t>(cur_pass_idx), TextureLayout::kColorAttachment};
-      }
-    }
+  BufferNode& buffer_node  = AddBufferNode(buffer_entries_.size() - 1, 0);
+  buffer_node.subgraph_idx = cur_subgraph_idx_;
 
-    for (const auto& resolve_attachment_usage : pass_node.resolve_attachment_usages) {
-      if (resolve_attachment_usage.in == id) {
-        return NextPassUsage{static_cast<int32_t>(cur_pass_idx), TextureLayout::kColorAttachment};
-      }
-    }
+  return buffer_node.version_id;
+}
 
-    for (const auto& sampler_id : pass_node.sampled_texture_ids) {
-      if (sampler_id == id) {
-        return NextPassUsage{static_cast<int32_t>(cur_pass_idx), TextureLayout::kShaderReadOnly};
-      }
-    }
-  }
+BufferNode& RenderGraph::AddBufferNode(uint32_t actual_buffer_idx, uint32_t buffer_version) {
+  BufferNode& buffer_node       = buffer_nodes_.emplace_back();
+  buffer_node.version_id        = buffer_nodes_.size() - 1;
+  buffer_node.actual_buffer_idx = actual_buffer_idx;
+  buffer_node.version_num       = buffer_version;
+
+  ++buffer_entries_[actual_buffer_idx].ref_count;
+
+  return buffer_node;
+}
+
+rg::detail::BufferEntry& RenderGraph::GetBufferEntry(BufferVersionId id) {
+  assert(id != kInvalidBufferVersionId);
+  return buffer_entries_[buffer_nodes_[id].actual_buffer_idx];
+}
 
-  return NextPassUsage{-1, TextureLayout::kUndefined};
+const rg::detail::BufferEntry& RenderGraph::GetBufferEntry(BufferVersionId id) const {
+  assert(id != kInvalidBufferVersionId);
+  return buffer_entries_[buffer_nodes_[id].actual_buffer_idx];
 }
 
 void RenderGraph::BeginSubgraph(const std::string_view name) {
@@ -519,6 +1973,21 @@ void RenderGraph::ExportGraphviz(std::ostream& os) const {
 
   ExportGraphvizSubgraph(os, -1);
 
+  /* Transient memory */
+  const TransientMemoryStatistics& statistics = transient_memory_statistics_;
+  fmt::print(os,
+             "M [label=<{{<B>Transient Memory</B>|"
+             "Allocated: {0:.2f} MiB<BR/>"
+             "Without aliasing: {1:.2f} MiB<BR/>"
+             "Saved: {2:.2f} MiB<BR/><BR/>"
+             "Aliased textures: {3}<BR/>"
+             "Heaps: {4}}}> style=\"filled\", fillcolor=lightgray, fontsize=20]\n\n",
+             BytesToMiB(statistics.allocated_size),
+             BytesToMiB(statistics.textures_size),
+             BytesToMiB(statistics.textures_size - statistics.allocated_size),
+             statistics.aliased_textures_count,
+             statistics.heaps_count);
+
   /* Connections */
   for (uint32_t pass_idx = 0; pass_idx < pass_nodes_.size(); ++pass_idx) {
     const PassNode& pass_node = pass_nodes_[pass_idx];
@@ -635,6 +2104,23 @@ void RenderGraph::ExportGraphviz(std::ostream& os) const {
          << "olivedrab3"
          << "]" << std::endl;
     }
+
+    uint32_t input_attachment_idx = 0;
+    for (const auto& input_attachment_id : pass_node.input_attachment_ids) {
+      fmt::print(os, "T{0} -> P{1} [label=\"Input Attachment [{2}]\" fontcolor=darkorchid color=darkorchid]\n",
+                 input_attachment_id, pass_idx, input_attachment_idx++);
+    }
+
+    for (const auto& buffer_usage : pass_node.buffer_usages) {
+      if (buffer_usage.out != kInvalidBufferVersionId) {
+        fmt::print(os, "P{0} -> B{1} [label=\"Write\" fontcolor=orangered color=orangered]\n", pass_idx,
+                   buffer_usage.out);
+        fmt::print(os, "B{0} -> P{1} [fontcolor=gray color=gray style=dashed]\n", buffer_usage.in, pass_idx);
+      } else {
+        fmt::print(os, "B{0} -> P{1} [label=\"Read\" fontcolor=olivedrab3 color=olivedrab3]\n", buffer_usage.in,
+                   pass_idx);
+      }
+    }
   }
   os << std::endl;
 
@@ -676,8 +2162,22 @@ void RenderGraph::ExportGraphvizSubgraph(std::ostream& os, int32_t subgraph_idx)
         // << std::hex
         // << pass_node.render_pass_id
         // << std::dec
+        << (pass_node.culled ? "<BR/><B>[Culled]</B>" : "")
+        << (!pass_node.culled && pass_idx < built_passes_.size()
+                ? fmt::format("<BR/>Barriers: {0}", built_passes_[pass_idx].barriers.texture_barriers_count +
+                                                        built_passes_[pass_idx].barriers.buffer_barriers_count)
+                : "")
+        << (pass_node.IsCompute() ? (GetPassQueue(pass_idx) == CommandBufferType::kCompute
+                                         ? fmt::format("<BR/>[Async Compute] Submission: {0}", pass_node.submission_idx)
+                                         : std::string("<BR/>[Compute]"))
+                                  : std::string(""))
+        << (!pass_node.culled && !pass_node.IsCompute() &&
+                    pass_nodes_[pass_node.first_subpass_pass_idx].subpass_pass_indices.size() > 1
+                ? fmt::format("<BR/>Render pass: P{0}, subpass: {1}", pass_node.first_subpass_pass_idx,
+                              pass_node.subpass_idx)
+                : "")
         << "}> style=\"filled\", fillcolor="
-        << "goldenrod1"
+        << (pass_node.culled ? "gray" : (pass_node.IsCompute() ? "lightskyblue" : "goldenrod1"))
         << ", fontsize=" << 28 << "]" << std::endl;
     }
   }
@@ -712,13 +2212,38 @@ void RenderGraph::ExportGraphvizSubgraph(std::ostream& os, int32_t subgraph_idx)
       os << "} | {"
          << "Handle: " << entry.texture->GetHandle() << "<BR/><BR/>"
          << "Id: " << texture_node.actual_texture_idx << "<BR/>"
-         << "Refs : " << entry.ref_count
-         << (entry.imported ? "<BR/><BR/><B>[Imported]</B>" : "")
+         << "Refs : " << entry.ref_count;
+
+      if (entry.heap_idx != -1) {
+        fmt::print(os, "<BR/><BR/>Heap {0}, offset {1:.2f} MiB<BR/>Passes: [{2}, {3}]", entry.heap_idx,
+                   BytesToMiB(entry.heap_offset), entry.first_pass_idx, entry.last_pass_idx);
+      }
+
+      os << (entry.imported ? "<BR/><BR/><B>[Imported]</B>" : "")
          << "} }> style=\"rounded,filled\", fillcolor="
          << (entry.imported ? "indianred1" : "lightsteelblue") << "]" << std::endl;
     }
   }
 
+  /* Buffer Nodes */
+  for (const auto& buffer_node : buffer_nodes_) {
+    const detail::BufferEntry& entry = GetBufferEntry(buffer_node.version_id);
+
+    if (buffer_node.subgraph_idx == subgraph_idx) {
+      fmt::print(os,
+                 "B{0} [label=<{{ {{<B>{1}</B> <FONT>(v.{2})</FONT><BR/><BR/>Size: {3} B}} | "
+                 "{{Offset: {4} B<BR/>Refs : {5}{6}}} }}> style=\"rounded,filled\", fillcolor={7}]\n",
+                 buffer_node.version_id,
+                 entry.name,
+                 buffer_node.version_num,
+                 entry.specification.size,
+                 entry.offset,
+                 entry.ref_count,
+                 entry.host_written ? "<BR/><BR/><B>[Host Written]</B>" : "",
+                 entry.host_written ? "lightpink" : "darkseagreen1");
+    }
+  }
+
   if (subgraph_idx != -1) {
     os << "}" << std::endl;
   }
@@ -747,6 +2272,7 @@ TextureVersionId RenderGraphBuilder::SetDepthStencil(TextureVersionId texture_ve
                                                      AttachmentStore store,
                                                      ClearValue clear_value,
                                                      uint32_t layer) {
+  assert(!pass_node_.IsCompute() && "Compute passes can't have attachments!");
   assert(texture_version_id != kInvalidTextureVersionId);
 
   TextureNode& in_texture_node = graph_.texture_nodes_[texture_version_id];
@@ -764,6 +2290,7 @@ TextureVersionId RenderGraphBuilder::AddColorAttachment(TextureVersionId texture
                                                         AttachmentStore store,
                                                         ClearValue clear_value,
                                                         uint32_t layer) {
+  assert(!pass_node_.IsCompute() && "Compute passes can't have attachments!");
   assert(texture_version_id != kInvalidTextureVersionId);
 
   TextureNode& in_texture_node = graph_.texture_nodes_[texture_version_id];
@@ -781,6 +2308,7 @@ TextureVersionId RenderGraphBuilder::AddResolveAttachment(TextureVersionId textu
                                                           AttachmentLoad load,
                                                           AttachmentStore store,
                                                           ClearValue clear_value) {
+  assert(!pass_node_.IsCompute() && "Compute passes can't have attachments!");
   assert(texture_version_id != kInvalidTextureVersionId);
 
   TextureNode& in_texture_node = graph_.texture_nodes_[texture_version_id];
@@ -798,4 +2326,39 @@ void RenderGraphBuilder::AddSampledTexture(TextureVersionId texture_version_id)
   assert(texture_version_id != kInvalidTextureVersionId);
 
   pass_node_.sampled_texture_ids.push_back(texture_version_id);
-}
\ No newline at end of file
+}
+
+void RenderGraphBuilder::AddInputAttachment(TextureVersionId texture_version_id) {
+  assert(texture_version_id != kInvalidTextureVersionId);
+
+  pass_node_.input_attachment_ids.push_back(texture_version_id);
+}
+
+BufferVersionId RenderGraphBuilder::LastBufferVersion(const std::string_view name) {
+  return graph_.LastBufferVersion(name);
+}
+
+BufferVersionId RenderGraphBuilder::CreateBuffer(const std::string_view name,
+                                                 const BufferSpecification& specification) {
+  return graph_.NewBufferEntry(name, specification, /*host_written=*/false);
+}
+
+void RenderGraphBuilder::ReadBuffer(BufferVersionId buffer_version_id, PipelineStageFlags stages,
+                                    MemoryAccessDependencyFlags access) {
+  assert(buffer_version_id != kInvalidBufferVersionId);
+
+  pass_node_.buffer_usages.push_back({buffer_version_id, kInvalidBufferVersionId, stages, access});
+}
+
+BufferVersionId RenderGraphBuilder::WriteBuffer(BufferVersionId buffer_version_id, PipelineStageFlags stages,
+                                                MemoryAccessDependencyFlags access) {
+  assert(buffer_version_id != kInvalidBufferVersionId);
+
+  BufferNode& in_buffer_node  = graph_.buffer_nodes_[buffer_version_id];
+  BufferNode& out_buffer_node = graph_.AddBufferNode(in_buffer_node.actual_buffer_idx, in_buffer_node.version_num + 1);
+  out_buffer_node.subgraph_idx = graph_.cur_subgraph_idx_;
+
+  pass_node_.buffer_usages.push_back({buffer_version_id, out_buffer_node.version_id, stages, access});
+
+  return out_buffer_node.version_id;
+}
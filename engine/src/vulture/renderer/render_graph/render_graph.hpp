@@ -29,6 +29,7 @@
 
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <vulture/renderer/graphics_api/render_device.hpp>
 #include <vulture/renderer/render_graph/blackboard.hpp>
@@ -84,6 +85,23 @@ struct DynamicTextureSpecification {
   explicit DynamicTextureSpecification(const TextureSpecification& specification);
 };
 
+/************************************************************************************************
+ * Buffers
+ ************************************************************************************************/
+struct BufferSpecification {
+  uint32_t         size  {0};  ///< In bytes
+  BufferUsageFlags usage {kBufferUsageBitNone};
+};
+
+/**
+ * @brief Range of the transient buffer ring used by a buffer during a frame in flight.
+ */
+struct BufferSlice {
+  BufferHandle buffer {kInvalidRenderResourceHandle};
+  uint32_t     offset {0};
+  uint32_t     size   {0};
+};
+
 /************************************************************************************************
  * Render Graph
  ************************************************************************************************/
@@ -99,6 +117,18 @@ struct TextureEntry {
   uint32_t                    ref_count{0};
   bool                        dirty{true};
 
+  /* Transient memory aliasing */
+  int32_t                     first_pass_idx{-1};   ///< Index of the first pass using the texture
+  int32_t                     last_pass_idx{-1};    ///< Index of the last pass using the texture
+  bool                        frame_local{false};   ///< Contents are produced and consumed within a single frame
+  bool                        aliasable{false};     ///< Whether the texture can share memory with other textures
+  bool                        transient_attachment{false};  ///< Only lives within a render pass, lazily allocated
+  MemoryRequirements          memory_requirements{};
+  int32_t                     heap_idx{-1};         ///< Index of the memory heap, -1 if not aliased
+  uint64_t                    heap_offset{0};
+
+  bool                        contents_undefined{true};  ///< (Re)created or reimported since the last execution
+
   TextureEntry(const std::string_view name, SharedPtr<Texture> texture,
                const DynamicTextureSpecification& specification, bool imported, TextureLayout final_layout,
                uint32_t ref_count = 0, bool dirty = true,
@@ -113,18 +143,104 @@ struct TextureEntry {
         dirty(dirty) {}
 };
 
+struct BufferEntry {
+  std::string         name{"unnamed"};
+  BufferSpecification specification{};
+  bool                host_written{false};  ///< Created by RenderGraph::CreateBuffer, written by the host every frame
+  uint32_t            offset{0};            ///< Offset in the ring's frame region
+  uint32_t            ref_count{0};
+
+  BufferEntry(const std::string_view name, const BufferSpecification& specification, bool host_written)
+      : name(name), specification(specification), host_written(host_written) {}
+};
+
+/**
+ * @brief Device memory shared by transient textures with non-overlapping lifetimes.
+ */
+struct TransientMemoryHeap {
+  DeviceMemoryHandle memory{kInvalidRenderResourceHandle};
+  MemoryRequirements requirements{};
+};
+
+/**
+ * @brief Texture barrier, whose texture handle is only resolved on execution.
+ */
+struct PassTextureBarrier {
+  uint32_t                    entry_idx       {0};
+  TextureLayout               old_layout      {TextureLayout::kUndefined};
+  TextureLayout               new_layout      {TextureLayout::kUndefined};
+  MemoryAccessDependencyFlags src_access_mask {kMemoryAccessBitNone};
+  MemoryAccessDependencyFlags dst_access_mask {kMemoryAccessBitNone};
+  bool                        first_use       {false};  ///< Contents are discarded if they are undefined
+
+  /* Queue ownership transfer, only between the submissions of an async compute schedule */
+  CommandBufferType           src_queue       {CommandBufferType::kInvalid};
+  CommandBufferType           dst_queue       {CommandBufferType::kInvalid};
+  bool                        release         {false};  ///< Recorded by src_queue, otherwise by dst_queue
+};
+
+/**
+ * @brief Buffer barrier, whose buffer slice is only resolved on execution.
+ */
+struct PassBufferBarrier {
+  uint32_t                    entry_idx       {0};
+  MemoryAccessDependencyFlags src_access_mask {kMemoryAccessBitNone};
+  MemoryAccessDependencyFlags dst_access_mask {kMemoryAccessBitNone};
+};
+
+/**
+ * @brief Barriers recorded as a single pipeline barrier, ranges in RenderGraph's texture and buffer barriers.
+ */
+struct BarrierBatch {
+  PipelineStageFlags src_stage_mask         {kPipelineStageBitNone};
+  PipelineStageFlags dst_stage_mask         {kPipelineStageBitNone};
+  uint32_t           first_texture_barrier  {0};
+  uint32_t           texture_barriers_count {0};
+  uint32_t           first_buffer_barrier   {0};
+  uint32_t           buffer_barriers_count  {0};
+};
+
+/**
+ * @brief Passes executed on the same queue one after another, in a single command buffer.
+ */
+struct QueueSubmission {
+  CommandBufferType     queue               {CommandBufferType::kGraphics};
+  std::vector<uint32_t> pass_indices;
+  int32_t               wait_submission_idx {-1};     ///< Submission of the other queue to wait for, -1 if none
+  bool                  signal              {false};  ///< Whether a submission of the other queue waits for this one
+  BarrierBatch          release_barriers    {};       ///< Queue ownership releases, recorded after the passes
+};
+
+/**
+ * @brief Render pass shared by all passes with the same description, which is compared on lookup, so that descriptions
+ *        with colliding hashes get separate render passes.
+ */
+struct CachedRenderPass {
+  RenderPassDescription description{};
+  RenderPassHandle      handle{kInvalidRenderResourceHandle};
+};
+
 struct BuiltPass {
-  RenderPassHandle                   pass_handle{kInvalidRenderResourceHandle};
+  RenderPassHandle                   pass_handle{kInvalidRenderResourceHandle};  ///< Owned by the render pass cache
   RenderPassDescription              description{};
 
   FramebufferHandle                  framebuffer_handle{kInvalidRenderResourceHandle};
   std::vector<FramebufferAttachment> framebuffer_attachments;
 
   std::vector<ClearValue>            clear_values{};
+
+  BarrierBatch                       barriers{};  ///< Recorded before the render pass begins
 };
 
 }  // namespace detail
 
+struct TransientMemoryStatistics {
+  uint64_t textures_size          {0};  ///< Memory of transient textures if each had its own allocation
+  uint64_t allocated_size         {0};  ///< Memory actually allocated for transient textures
+  uint32_t aliased_textures_count {0};
+  uint32_t heaps_count            {0};
+};
+
 class RenderGraph {
  public:
   RenderGraph(Blackboard& blackboard);
@@ -139,6 +255,9 @@ class RenderGraph {
   template <typename OutputDataT, typename RenderPassT, typename... RenderPassArgs>
   OutputDataT& AddPass(const std::string_view name, RenderPassArgs... args);
 
+  /**
+   * @brief Add a pass, RenderPassT must implement either IRenderPass or IComputePass.
+   */
   template <typename RenderPassT, typename... RenderPassArgs>
   void AddPass(const std::string_view name, RenderPassArgs... args);
 
@@ -147,30 +266,104 @@ class RenderGraph {
   TextureVersionId ImportTexture(const std::string_view name, SharedPtr<Texture> texture, TextureLayout final_layout);
   TextureVersionId DeclareTexture(const std::string_view name, TextureLayout final_layout);
 
+  /**
+   * @brief Create a buffer, which is written by the host every frame and only read by the passes.
+   */
+  BufferVersionId CreateBuffer(const std::string_view name, const BufferSpecification& specification);
+  BufferVersionId LastBufferVersion(const std::string_view name);
+
   Blackboard& GetBlackboard();
 
-  void Setup();
+  /**
+   * @brief Setup the passes and allocate the transient buffer ring.
+   *
+   * Unlike textures, buffers don't have dependent values, so they are allocated right away, which allows writing to
+   * them before the first compilation.
+   */
+  void Setup(RenderDevice& device);
 
   /* Compile phase */
   void Compile(RenderDevice& device);
 
   /* Execute phase */
-  void Execute(RenderDevice& device, CommandBuffer& command_buffer);
+  /**
+   * @brief Record the passes into the command buffer.
+   *
+   * If any pass is scheduled on the async compute queue, the graph instead records and submits its own graphics and
+   * compute command buffers, synchronized with semaphores. These are submitted before the command buffer, so commands
+   * recorded into it (even before the call) run after the graph, and imported textures must be ready for use already.
+   */
+  void Execute(RenderDevice& device, CommandBuffer& command_buffer, uint32_t frame_in_flight);
 
   SharedPtr<Texture> GetTexture(TextureVersionId version_id);
 
+  /**
+   * @brief Get the buffer's slice for the frame in flight, valid after the setup until the graph is destroyed.
+   *
+   * Each frame in flight has its own region of the ring, so the host can write the slice of the current frame while
+   * the GPU still reads the previous one's.
+   */
+  BufferSlice GetBuffer(BufferVersionId version_id, uint32_t frame_in_flight) const;
+
+  template <typename T>
+  void LoadBufferData(RenderDevice& device, BufferVersionId version_id, uint32_t frame_in_flight, uint32_t count,
+                      const T* data) const;
+
   /* Update phase */
   void ReimportTexture(TextureVersionId version_id, SharedPtr<Texture> texture);
 
+  /**
+   * @brief Recreate the textures affected by the reimports since the last update, so that the new transient textures
+   *        can be accessed before the execution. Called by Execute as well.
+   */
+  void Update(RenderDevice& device);
+
   /* Other */
+  const TransientMemoryStatistics& GetTransientMemoryStatistics() const;
+
+  /**
+   * @brief Find the render pass and the subpass, which the pass with the id is executed in, e.g. to build the pipelines
+   *        of the shaders targeting the pass ahead of time. Valid after the compilation.
+   *
+   * @return false If there is no such render (not compute) pass or it has been culled.
+   */
+  bool FindRenderPass(RenderPassId render_pass_id, RenderPassHandle* render_pass, uint32_t* subpass_idx) const;
+
+  /**
+   * @brief Merge adjacent render passes working on the same attachments into subpasses of a single render pass.
+   *
+   * A pass is merged into the previous one's render pass if it has the same extent, uses (as an attachment or an input
+   * attachment) at least one of its attachments, and only reads them at the same pixel, i.e. doesn't sample them. Then
+   * the attachments stay in the tile memory of tile-based GPUs between the passes, and the ones not used after the
+   * render pass are neither stored nor, if the device supports it, even allocated. Enabled by default.
+   */
+  void SetSubpassMerging(bool enable);
+  bool IsSubpassMergingEnabled() const;
+
+  /**
+   * @brief Execute the compute passes, which opt in with @ref{IComputePass::UsesAsyncCompute}, on the async compute
+   *        queue, if the device supports it.
+   *
+   * The queues are rescheduled on the next execution, so it can be toggled at any time, e.g. to compare frame times.
+   */
+  void SetAsyncCompute(bool enable);
+  bool IsAsyncComputeEnabled() const;
+
   void Destroy(RenderDevice& device);
   void ExportGraphviz(std::ostream& os) const;
 
  private:
+  void CullPasses();
   void UpdateDependentTextureValues();
+  bool MergePasses();  ///< Returns whether the merged passes have changed
+  bool CanMergePass(uint32_t pass_idx, uint32_t first_pass_idx) const;
+  void CalculateTextureLifetimes(const RenderDevice& device);
+  void PlaceAliasedTextures(RenderDevice& device);
   void RecreateTransientTextures(RenderDevice& device);
   void RecreateRenderPasses(RenderDevice& device);
   void RecreateFramebuffers(RenderDevice& device);
+  void AllocateTransientBuffers(RenderDevice& device);
+  void ScheduleQueues(RenderDevice& device);
 
   TextureVersionId NewEntry(const std::string_view name, SharedPtr<Texture> texture,
                             const DynamicTextureSpecification& specification, bool imported,
@@ -181,12 +374,21 @@ class RenderGraph {
   detail::TextureEntry& GetTextureEntry(TextureVersionId id);
   const detail::TextureEntry& GetTextureEntry(TextureVersionId id) const;
 
-  struct NextPassUsage {
-    int32_t       pass_idx{-1};
-    TextureLayout layout{TextureLayout::kUndefined};
-  };
+  BufferVersionId NewBufferEntry(const std::string_view name, const BufferSpecification& specification,
+                                 bool host_written);
+
+  BufferNode& AddBufferNode(uint32_t actual_buffer_idx, uint32_t buffer_version);
 
-  NextPassUsage GetNextPassUsage(uint32_t pass_idx, TextureVersionId id);
+  detail::BufferEntry& GetBufferEntry(BufferVersionId id);
+  const detail::BufferEntry& GetBufferEntry(BufferVersionId id) const;
+
+  void CalculateBarriers();
+  void RecordBarriers(CommandBuffer& command_buffer, const detail::BarrierBatch& batch, uint32_t frame_in_flight);
+
+  RenderArea GetRenderArea(uint32_t pass_idx) const;
+  void ExecutePass(CommandBuffer& command_buffer, uint32_t pass_idx, uint32_t frame_in_flight);
+  void ExecuteSubmissions(RenderDevice& device, uint32_t frame_in_flight);
+  CommandBufferType GetPassQueue(uint32_t pass_idx) const;
 
   void ExportGraphvizSubgraph(std::ostream& os, int32_t subgraph_idx) const;
 
@@ -195,10 +397,38 @@ class RenderGraph {
   std::vector<PassNode>             pass_nodes_;
   std::vector<detail::BuiltPass>    built_passes_;
 
+  /* Render passes by description hash, persist until the graph is destroyed */
+  std::unordered_multimap<uint64_t, detail::CachedRenderPass> render_pass_cache_;
+
   std::vector<TextureNode>          texture_nodes_;    ///< Texture versions, indexed by TextureVersionId
   std::vector<detail::TextureEntry> texture_entries_;  ///< Actual Texture resources
   bool                              textures_dirty_{true};
 
+  std::vector<BufferNode>           buffer_nodes_;    ///< Buffer versions, indexed by BufferVersionId
+  std::vector<detail::BufferEntry>  buffer_entries_;
+
+  BufferHandle                      buffer_ring_{kInvalidRenderResourceHandle};  ///< A region per frame in flight
+  uint32_t                          buffer_ring_frame_size_{0};
+
+  std::vector<detail::PassTextureBarrier> texture_barriers_;   ///< Cached until the graph is recompiled
+  std::vector<detail::PassBufferBarrier>  buffer_barriers_;    ///< Cached until the graph is recompiled
+  detail::BarrierBatch                    final_barriers_;     ///< Transitions to the final layouts
+  std::vector<TextureBarrier>             recorded_barriers_;  ///< Reused on every execution
+  std::vector<BufferBarrier>              recorded_buffer_barriers_;
+
+  bool                                       subpass_merging_{true};
+
+  bool                                       async_compute_{false};
+  bool                                       queues_dirty_{false};  ///< Async compute, merged passes or aliasing changed
+  std::vector<detail::QueueSubmission>       submissions_;      ///< Empty if everything runs on the graphics queue
+  detail::BarrierBatch                       return_barriers_;  ///< Acquires of textures last used by async compute
+  PerFrameData<std::vector<CommandBuffer*>>  graphics_command_buffers_;
+  PerFrameData<std::vector<CommandBuffer*>>  compute_command_buffers_;
+  PerFrameData<std::vector<SemaphoreHandle>> semaphores_;       ///< Signaled by the submissions with the same index
+
+  std::vector<detail::TransientMemoryHeap> memory_heaps_;
+  TransientMemoryStatistics                transient_memory_statistics_;
+
   std::vector<std::string>          subgraph_names_;
   int32_t                           cur_subgraph_idx_{-1};
 
@@ -236,6 +466,33 @@ class RenderGraphBuilder {
 
   void AddSampledTexture(TextureVersionId texture);
 
+  /**
+   * @brief Read the texture at the same pixel (subpassInput in shaders), which allows merging the pass with the one
+   *        writing the texture, see @ref{RenderGraph::SetSubpassMerging}.
+   *
+   * The input_attachment_index in shaders is the order of the calls.
+   */
+  void AddInputAttachment(TextureVersionId texture);
+
+  BufferVersionId LastBufferVersion(const std::string_view name);
+
+  /**
+   * @brief Create a transient buffer, whose contents are produced by the passes.
+   */
+  BufferVersionId CreateBuffer(const std::string_view name, const BufferSpecification& specification);
+
+  /**
+   * @note Default stages here and in WriteBuffer are the graphics ones, so compute passes must specify
+   *       kPipelineStageBitComputeShader explicitly.
+   */
+  void ReadBuffer(BufferVersionId buffer,
+                  PipelineStageFlags stages = kPipelineStageBitVertexShade | kPipelineStageBitFragmentShader,
+                  MemoryAccessDependencyFlags access = kMemoryAccessBitUniformRead | kMemoryAccessBitShaderRead);
+
+  BufferVersionId WriteBuffer(BufferVersionId buffer,
+                              PipelineStageFlags stages = kPipelineStageBitFragmentShader,
+                              MemoryAccessDependencyFlags access = kMemoryAccessBitShaderWrite);
+
  private:
   RenderGraph& graph_;
   PassNode&    pass_node_;
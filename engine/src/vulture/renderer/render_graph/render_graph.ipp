@@ -82,3 +82,12 @@ void RenderGraph::AddPass(const std::string_view name, RenderPassArgs... args) {
   pass_node.subgraph_idx = cur_subgraph_idx_;
   pass_node.render_pass_id = GeneratePassIdFromString(pass_node.name);
 }
+
+template <typename T>
+void RenderGraph::LoadBufferData(RenderDevice& device, BufferVersionId version_id, uint32_t frame_in_flight,
+                                 uint32_t count, const T* data) const {
+  BufferSlice slice = GetBuffer(version_id, frame_in_flight);
+  assert(count * sizeof(T) <= slice.size);
+
+  device.LoadBufferData(slice.buffer, slice.offset, count * sizeof(T), reinterpret_cast<const void*>(data));
+}
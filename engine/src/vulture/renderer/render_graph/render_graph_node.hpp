@@ -48,20 +48,45 @@ struct PassNode {
     uint32_t         layer       {0};
   };
 
+  struct BufferUsage {
+    BufferVersionId             in     {kInvalidBufferVersionId};
+    BufferVersionId             out    {kInvalidBufferVersionId};  ///< Invalid if the buffer is only read
+
+    PipelineStageFlags          stages {kPipelineStageBitNone};
+    MemoryAccessDependencyFlags access {kMemoryAccessBitNone};
+  };
+
   PassNode(const std::string_view name, IRenderPass* render_pass) : name(name), render_pass(render_pass) {
     assert(render_pass != nullptr);
   }
 
+  PassNode(const std::string_view name, IComputePass* compute_pass) : name(name), compute_pass(compute_pass) {
+    assert(compute_pass != nullptr);
+  }
+
+  bool IsCompute() const { return compute_pass != nullptr; }
+
   std::string                   name;
-  IRenderPass*                  render_pass{nullptr};  ///< Owned by the RenderGraph
+  IRenderPass*                  render_pass{nullptr};   ///< Owned by the RenderGraph
+  IComputePass*                 compute_pass{nullptr};  ///< Owned by the RenderGraph, set instead of render_pass
   int32_t                       subgraph_idx{-1};
 
   RenderPassId                  render_pass_id{0};
-  
+  bool                          culled{false};  ///< None of the outputs are used, set by RenderGraph::Compile
+  int32_t                       submission_idx{-1};  ///< Set by RenderGraph::Compile, -1 if not using async compute
+
+  /* Subpass merging, set by RenderGraph::Compile */
+  uint32_t                      first_subpass_pass_idx{0};  ///< Pass beginning the render pass the pass is a subpass of
+  uint32_t                      subpass_idx{0};
+  std::vector<uint32_t>         subpass_pass_indices;       ///< Subpasses of the render pass, if the pass begins it
+
   std::optional<TextureUsage>   depth_stencil_usage{std::nullopt};
   std::vector<TextureUsage>     color_attachment_usages;
   std::vector<TextureUsage>     resolve_attachment_usages;
   std::vector<TextureVersionId> sampled_texture_ids;
+  std::vector<TextureVersionId> input_attachment_ids;  ///< In the order of input_attachment_index in the shaders
+
+  std::vector<BufferUsage>      buffer_usages;
 };
 
 struct TextureNode {
@@ -71,5 +96,12 @@ struct TextureNode {
   int32_t          subgraph_idx{-1};
 };
 
+struct BufferNode {
+  BufferVersionId version_id{kInvalidBufferVersionId};
+  uint32_t        actual_buffer_idx{0};
+  uint32_t        version_num{0};
+  int32_t         subgraph_idx{-1};
+};
+
 }  // namespace rg
 }  // namespace vulture
@@ -35,5 +35,8 @@ namespace rg {
 using TextureVersionId = int32_t;
 constexpr TextureVersionId kInvalidTextureVersionId = -1;
 
+using BufferVersionId = int32_t;
+constexpr BufferVersionId kInvalidBufferVersionId = -1;
+
 }  // namespace rg
 }  // namespace vulture
@@ -27,9 +27,11 @@
 
 #pragma once
 
+#include <cassert>
+#include <vulture/renderer/graphics_api/command_buffer.hpp>
+
 namespace vulture {
 
-class CommandBuffer;
 using RenderPassId = uint64_t;
 
 namespace rg {
@@ -42,8 +44,71 @@ class IRenderPass {
   virtual ~IRenderPass() = default;
 
   virtual void Setup(RenderGraphBuilder& builder, Blackboard& blackboard, RenderPassId pass_id) = 0;
+
+  /**
+   * @param handle      Render pass the pipelines must be compatible with.
+   * @param subpass_idx Subpass the pipelines must be created for, non-zero if the pass has been merged with the
+   *                    previous ones, see @ref{RenderGraph::SetSubpassMerging}.
+   */
   virtual void Execute(CommandBuffer& command_buffer, Blackboard& blackboard, RenderPassId pass_id,
-                       RenderPassHandle handle) = 0;
+                       RenderPassHandle handle, uint32_t subpass_idx) = 0;
+
+  /**
+   * @brief Whether the pass should be executed this frame.
+   *
+   * Checked before each execution, so can change from frame to frame without recompiling the graph. The render pass of
+   * a disabled pass is still begun and ended, so its attachments are loaded (or cleared) and stored as declared and the
+   * dependent passes see well-defined contents, but nothing is recorded inside it.
+   */
+  virtual bool IsEnabled(const Blackboard& blackboard, RenderPassId pass_id) const { return true; }
+
+  /**
+   * @brief Whether the pass should be executed with @ref{ExecuteSecondary} instead of @ref{Execute}.
+   *
+   * Checked before each execution, so can change from frame to frame.
+   */
+  virtual bool UsesSecondaryCommandBuffers() const { return false; }
+
+  /**
+   * @brief Record the pass into secondary command buffers (possibly from multiple threads) and execute them with the
+   *        primary command buffer.
+   *
+   * The render pass is begun with secondary command buffers contents, so the only command allowed to be recorded into
+   * the primary command buffer is CmdExecuteCommands. Secondary command buffers must be begun with the inheritance
+   * info, which also contains the viewport and render area.
+   */
+  virtual void ExecuteSecondary(CommandBuffer& primary_command_buffer,
+                                const CommandBuffer::InheritanceInfo& inheritance_info, Blackboard& blackboard,
+                                RenderPassId pass_id) {
+    assert(!"Pass doesn't support secondary command buffers!");
+  }
+};
+
+/**
+ * @brief Pass, which is executed outside of any render pass, e.g. for dispatching compute work.
+ *
+ * Can't have any attachments, only sampled textures and buffers. Its reads and writes are synchronized with the other
+ * passes by the barriers the same way as the ones of the render passes, but no viewport is set.
+ */
+class IComputePass {
+ public:
+  virtual ~IComputePass() = default;
+
+  virtual void Setup(RenderGraphBuilder& builder, Blackboard& blackboard, RenderPassId pass_id) = 0;
+  virtual void Execute(CommandBuffer& command_buffer, Blackboard& blackboard, RenderPassId pass_id) = 0;
+
+  /**
+   * @brief Whether the pass should be executed this frame, checked before each execution.
+   */
+  virtual bool IsEnabled(const Blackboard& blackboard, RenderPassId pass_id) const { return true; }
+
+  /**
+   * @brief Whether the pass can be executed on the async compute queue, see @ref{RenderGraph::SetAsyncCompute}.
+   *
+   * Checked on scheduling. The pass overlaps with the graphics passes only until the first pass depending on it, so it
+   * pays off for passes, whose results are consumed much later in the frame.
+   */
+  virtual bool UsesAsyncCompute() const { return false; }
 };
 
 }  // namespace rg
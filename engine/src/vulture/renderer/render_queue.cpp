@@ -0,0 +1,127 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file render_queue.cpp
+ * @date 2023-06-17
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/jobs/job_system.hpp>
+#include <vulture/renderer/render_queue.hpp>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kBoundingBoxesBatchSize = 256;
+
+float CalculateDepth(const Frustum& frustum, const AABB& bounding_box) {
+  const glm::vec4& near_plane = frustum.planes[Frustum::kNear];
+  return glm::dot(glm::vec3(near_plane), bounding_box.Center()) + near_plane.w;
+}
+
+}  // namespace
+
+/************************************************************************************************
+ * Render Queue
+ ************************************************************************************************/
+RenderQueue::RenderQueue(LinearAllocator& frame_allocator)
+    : renderables(LinearStlAllocator<Renderable>(frame_allocator)),
+      submesh_bounding_boxes(LinearStlAllocator<AABB>(frame_allocator)) {}
+
+void RenderQueue::CalculateBoundingBoxes() {
+  uint32_t submesh_bounding_boxes_count = 0;
+  for (auto& renderable : renderables) {
+    renderable.first_submesh_bounding_box  = submesh_bounding_boxes_count;
+    submesh_bounding_boxes_count          += renderable.mesh->GetSubmeshes().size();
+  }
+
+  submesh_bounding_boxes.resize(submesh_bounding_boxes_count);
+
+  uint32_t renderables_count = static_cast<uint32_t>(renderables.size());
+
+  auto transform_batch = [&](uint32_t first_renderable, uint32_t last_renderable) {
+    for (uint32_t renderable_idx = first_renderable; renderable_idx < last_renderable; ++renderable_idx) {
+      Renderable& renderable = renderables[renderable_idx];
+
+      renderable.bounding_box = renderable.mesh->GetBoundingBox().Transformed(renderable.model_matrix);
+
+      uint32_t bounding_box_idx = renderable.first_submesh_bounding_box;
+      for (const auto& submesh : renderable.mesh->GetSubmeshes()) {
+        submesh_bounding_boxes[bounding_box_idx++] =
+            submesh.GetGeometry().GetBoundingBox().Transformed(renderable.model_matrix);
+      }
+    }
+  };
+
+  jobs::JobSystem::Instance().ParallelFor(renderables_count, kBoundingBoxesBatchSize, transform_batch);
+}
+
+/************************************************************************************************
+ * Render Queue View
+ ************************************************************************************************/
+void RenderQueueView::Reset(const RenderQueue& render_queue) {
+  queue = &render_queue;
+  items.clear();
+
+  for (uint32_t renderable_idx = 0; renderable_idx < render_queue.renderables.size(); ++renderable_idx) {
+    uint32_t submeshes_count = render_queue.renderables[renderable_idx].mesh->GetSubmeshes().size();
+    for (uint32_t submesh_idx = 0; submesh_idx < submeshes_count; ++submesh_idx) {
+      items.push_back(Item{renderable_idx, submesh_idx});
+    }
+  }
+}
+
+void RenderQueueView::Cull(const RenderQueue& render_queue, const Frustum& frustum) {
+  queue = &render_queue;
+  items.clear();
+
+  for (uint32_t renderable_idx = 0; renderable_idx < render_queue.renderables.size(); ++renderable_idx) {
+    const RenderQueue::Renderable& renderable = render_queue.renderables[renderable_idx];
+
+    uint32_t submeshes_count = renderable.mesh->GetSubmeshes().size();
+    if (renderable.mesh->IsNeverCulled()) {
+      for (uint32_t submesh_idx = 0; submesh_idx < submeshes_count; ++submesh_idx) {
+        items.push_back(Item{renderable_idx, submesh_idx});
+      }
+
+      continue;
+    }
+
+    if (!frustum.Intersects(renderable.bounding_box)) {
+      continue;
+    }
+
+    if (submeshes_count == 1) {
+      items.push_back(Item{renderable_idx, 0, CalculateDepth(frustum, renderable.bounding_box)});
+      continue;
+    }
+
+    for (uint32_t submesh_idx = 0; submesh_idx < submeshes_count; ++submesh_idx) {
+      uint32_t    bounding_box_idx = renderable.first_submesh_bounding_box + submesh_idx;
+      const AABB& bounding_box     = render_queue.submesh_bounding_boxes[bounding_box_idx];
+      if (frustum.Intersects(bounding_box)) {
+        items.push_back(Item{renderable_idx, submesh_idx, CalculateDepth(frustum, bounding_box)});
+      }
+    }
+  }
+}
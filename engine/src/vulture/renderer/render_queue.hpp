@@ -27,17 +27,27 @@
 
 #pragma once
 
+#include <vulture/core/linear_allocator.hpp>
+#include <vulture/renderer/frustum.hpp>
 #include <vulture/renderer/geometry/mesh.hpp>
 
 namespace vulture {
 
+/**
+ * @brief Renderables of a single frame, allocated from the frame's allocator.
+ *
+ * Renderables don't own their meshes, which must stay alive until the frame is rendered.
+ */
 struct RenderQueue {
   struct Renderable {
-    SharedPtr<Mesh> mesh;
-    glm::mat4       model_matrix;
+    Mesh*     mesh{nullptr};
+    glm::mat4 model_matrix;
+
+    AABB      bounding_box{};                 ///< World space, set by CalculateBoundingBoxes
+    uint32_t  first_submesh_bounding_box{0};  ///< Index into submesh_bounding_boxes
   };
 
-  RenderQueue() = default;
+  explicit RenderQueue(LinearAllocator& frame_allocator);
 
   RenderQueue(const RenderQueue& other) = delete;
   RenderQueue& operator=(const RenderQueue& other) = delete;
@@ -45,7 +55,42 @@ struct RenderQueue {
   RenderQueue(RenderQueue&& other) = default;
   RenderQueue& operator=(RenderQueue&& other) = default;
 
-  Vector<Renderable> renderables;
+  /**
+   * @brief Transform renderables' and their submeshes' bounding boxes to world space.
+   *
+   * Needs to be called once after all renderables have been added and before culling. Renderables are processed in
+   * parallel on @ref{jobs::JobSystem::Instance}.
+   */
+  void CalculateBoundingBoxes();
+
+  LinearVector<Renderable> renderables;
+  LinearVector<AABB>       submesh_bounding_boxes;  ///< World space, of all renderables' submeshes one after another
+};
+
+/**
+ * @brief Submeshes of a RenderQueue visible from a single view.
+ */
+struct RenderQueueView {
+  struct Item {
+    uint32_t renderable_idx{0};
+    uint32_t submesh_idx{0};
+    float    depth{0.0f};  ///< Distance from the view's near plane to the bounding box center, 0 if not culled
+  };
+
+  const RenderQueue* queue{nullptr};
+  Vector<Item>       items;
+
+  /**
+   * @brief Make every submesh of the queue visible (i.e. no culling).
+   */
+  void Reset(const RenderQueue& render_queue);
+
+  /**
+   * @brief Leave only submeshes, whose bounding boxes intersect the frustum.
+   *
+   * Renderables are tested first, so that submeshes of completely invisible ones are not tested at all.
+   */
+  void Cull(const RenderQueue& render_queue, const Frustum& frustum);
 };
 
-}  // namespace vulture
\ No newline at end of file
+}  // namespace vulture
@@ -25,75 +25,336 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <vulture/core/time.hpp>
 #include <vulture/renderer/renderer.hpp>
 
 using namespace vulture;
 
-struct UBFrameData {
-  float time{0};
-};
-
 Renderer::Renderer(RenderDevice& device, Vector<UniquePtr<IRenderFeature>> features)
-    : device_(device), render_graph_(blackboard_), features_(std::move(features)) {
+    : device_(device), shared_render_graph_(blackboard_), features_(std::move(features)) {
   CreateDescriptorSets();
   CreateBuffers();
-  WriteDescriptors();
 
   blackboard_.Add<RendererBlackboardData>();
 
-  render_graph_.DeclareTexture("backbuffer", TextureLayout::kShaderReadOnly);
-
   for (auto& feature : features_) {
-    render_graph_.BeginSubgraph(feature->Name());
-    feature->SetupRenderPasses(render_graph_);
-    render_graph_.EndSubgraph();
+    shared_render_graph_.BeginSubgraph(feature->Name());
+    feature->SetupSharedRenderPasses(shared_render_graph_);
+    shared_render_graph_.EndSubgraph();
   }
 
-  render_graph_.Setup();
+  shared_render_graph_.Setup(device_);
+
+  /* Render graph buffers are only allocated during the setup */
+  WriteDescriptors();
+
+  GetOrCreateView(0);
+
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    timestamp_pools_[frame] = device_.CreateTimestampQueryPool(kTimestampQueriesCount);
+  }
+}
+
+Renderer::~Renderer() {
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    device_.DeleteQueryPool(timestamp_pools_[frame]);
+
+    DeleteFrameSet(frame_sets_[frame]);
+    for (auto& frame_set : retired_frame_sets_[frame]) {
+      DeleteFrameSet(frame_set);
+    }
+  }
+
+  for (auto& view : views_) {
+    for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+      device_.DeleteBuffer(view->ub_view[frame]);
+    }
+
+    view->render_graph.Destroy(device_);
+  }
+
+  shared_render_graph_.Destroy(device_);
+}
+
+void Renderer::PrebuildShaders(const Camera& camera, const Vector<SharedPtr<Shader>>& shaders) {
+  Timer timer;
+
+  if (!shared_render_graph_compiled_) {
+    shared_render_graph_.Compile(device_);
+    shared_render_graph_compiled_ = true;
+  }
+
+  rg::RenderGraph& render_graph = views_[0]->render_graph;
+  if (!views_[0]->compiled) {
+    render_graph.ReimportTexture(render_graph.FirstVersion("backbuffer"), camera.render_texture);
+    CompileViewRenderGraph(0);
+  }
+
+  uint32_t built_count = 0;
+  for (const auto& shader : shaders) {
+    if (shader->IsCompute()) {
+      continue;
+    }
+
+    RenderPassHandle render_pass{kInvalidRenderResourceHandle};
+    uint32_t         subpass_idx{0};
+
+    if (!render_graph.FindRenderPass(shader->GetTargetPassId(), &render_pass, &subpass_idx) &&
+        !shared_render_graph_.FindRenderPass(shader->GetTargetPassId(), &render_pass, &subpass_idx)) {
+      continue;
+    }
+
+    if (!shader->IsBuilt(render_pass, subpass_idx)) {
+      shader->Build(render_pass, subpass_idx);
+      ++built_count;
+    }
+  }
+
+  LOG_INFO("Prebuilt {0} shaders in {1}ms", built_count, timer.ElapsedMs());
 }
 
 LightEnvironment& Renderer::GetLightEnvironment() { return light_environment_; }
+FrameAllocator& Renderer::GetFrameAllocator() { return frame_allocator_; }
+
+const DrawStatistics& Renderer::GetDrawStatistics() {
+  return blackboard_.Get<RendererBlackboardData>().draw_statistics;
+}
+
+const ViewStatistics& Renderer::GetSharedStatistics() const { return shared_statistics_; }
+
+const ViewStatistics& Renderer::GetViewStatistics(uint32_t view_idx) const {
+  assert(view_idx < views_.size());
+  return views_[view_idx]->statistics;
+}
+
+uint32_t Renderer::GetViewsCount() const { return static_cast<uint32_t>(views_.size()); }
+
+rg::RenderGraph& Renderer::GetSharedRenderGraph() { return shared_render_graph_; }
+
+rg::RenderGraph& Renderer::GetRenderGraph(uint32_t view_idx) {
+  assert(view_idx < views_.size());
+  return views_[view_idx]->render_graph;
+}
 
-rg::RenderGraph& Renderer::GetRenderGraph() { return render_graph_; }
 Vector<UniquePtr<IRenderFeature>>& Renderer::GetFeatures() { return features_; }
 
-void Renderer::Render(CommandBuffer& command_buffer, const Camera& camera, RenderQueue render_queue, float time,
+LinearAllocator& Renderer::BeginFrame(uint32_t frame_in_flight) {
+  return frame_allocator_.BeginFrame(frame_in_flight);
+}
+
+void Renderer::Render(CommandBuffer& command_buffer, const Camera& camera, RenderQueue& render_queue, float time,
                       uint32_t frame_in_flight) {
-  UpdateBuffers(frame_in_flight, camera, time);
-  UpdateBlackboard(frame_in_flight, camera, time);
+  const Camera* cameras[] = {&camera};
+  Render(command_buffer, cameras, 1, render_queue, time, frame_in_flight);
+}
+
+void Renderer::Render(CommandBuffer& command_buffer, const Camera* const* cameras, uint32_t cameras_count,
+                      RenderQueue& render_queue, float time, uint32_t frame_in_flight) {
+  assert(frame_allocator_.GetFrameInFlight() == frame_in_flight);
+  assert(cameras != nullptr && cameras_count > 0 && cameras_count <= kMaxViews);
+
+  uint32_t views_count = cameras_count;
+  for (uint32_t view_idx = 0; view_idx < views_count; ++view_idx) {
+    GetOrCreateView(view_idx);
+  }
+
+  /* Results of the frame, which previously used the pool, are ready, as its fence has been waited for */
+  ReadTimestamps(frame_in_flight);
+
+  QueryPoolHandle timestamp_pool = timestamp_pools_[frame_in_flight];
+  command_buffer.CmdResetQueryPool(timestamp_pool, 0, kTimestampQueriesCount);
+  timestamp_views_count_[frame_in_flight] = views_count;
+
+  RendererBlackboardData& blackboard_data = blackboard_.Get<RendererBlackboardData>();
+
+  /* Shared work */
+  Timer timer;
+  command_buffer.CmdWriteTimestamp(timestamp_pool, 0, kPipelineStageBitAllCommands);
+
+  UpdateBuffers(frame_in_flight, time);
+  UpdateBlackboard(frame_in_flight, time);
+
+  render_queue.CalculateBoundingBoxes();
+
+  View& first_view = *views_[0];
+  first_view.render_queue_view.Cull(render_queue, cameras[0]->CalculateFrustum());
+
+  blackboard_data.view_idx = 0;
+  blackboard_data.camera   = cameras[0];
+
+  RenderContext shared_context{device_,      command_buffer,               frame_in_flight,   shared_render_graph_,
+                               0,            cameras,                      views_count,
+                               render_queue, first_view.render_queue_view, light_environment_};
+  for (auto& feature : features_) {
+    feature->ExecuteShared(shared_context);
+  }
+
+  if (!shared_render_graph_compiled_) {
+    shared_render_graph_.Compile(device_);
+    shared_render_graph_compiled_ = true;
+  }
+
+  shared_render_graph_.Execute(device_, command_buffer, frame_in_flight);
+
+  command_buffer.CmdWriteTimestamp(timestamp_pool, 1, kPipelineStageBitAllCommands);
+
+  shared_statistics_.cpu_time_ms     = timer.ElapsedMs();
+  shared_statistics_.draw_statistics = blackboard_data.draw_statistics;
+
+  /* Views */
+  for (uint32_t view_idx = 0; view_idx < views_count; ++view_idx) {
+    View&         view   = *views_[view_idx];
+    const Camera& camera = *cameras[view_idx];
+
+    timer.Reset();
+    command_buffer.CmdWriteTimestamp(timestamp_pool, 2 * (view_idx + 1), kPipelineStageBitAllCommands);
+
+    /* The first view has been culled before the shared work */
+    if (view_idx > 0) {
+      view.render_queue_view.Cull(render_queue, camera.CalculateFrustum());
+    }
+
+    UpdateViewBuffer(view, frame_in_flight, camera);
+
+    blackboard_data.view_idx            = view_idx;
+    blackboard_data.camera              = &camera;
+    blackboard_data.descriptor_set_view = view.view_set[frame_in_flight].GetHandle();
+
+    rg::RenderGraph& render_graph = view.render_graph;
+    VULTURE_ASSERT(!render_graph.IsAsyncComputeEnabled(),
+                   "View render graphs can't use async compute, as they would run before the shared graph!");
+
+    /* Transient textures depend on the render texture, so they have to be recreated before the features access them */
+    render_graph.ReimportTexture(render_graph.FirstVersion("backbuffer"), camera.render_texture);
+
+    if (!view.compiled) {
+      CompileViewRenderGraph(view_idx);
+    } else {
+      render_graph.Update(device_);
+    }
+
+    RenderContext context{device_,      command_buffer,         frame_in_flight,   render_graph, view_idx, cameras,
+                          views_count,  render_queue,           view.render_queue_view, light_environment_};
+    for (auto& feature : features_) {
+      feature->Execute(context);
+    }
+
+    DrawStatistics frame_statistics = blackboard_data.draw_statistics;
+    blackboard_data.draw_statistics = DrawStatistics{};
+
+    render_graph.Execute(device_, command_buffer, frame_in_flight);
+
+    command_buffer.CmdWriteTimestamp(timestamp_pool, 2 * (view_idx + 1) + 1, kPipelineStageBitAllCommands);
+
+    view.statistics.cpu_time_ms     = timer.ElapsedMs();
+    view.statistics.draw_statistics = blackboard_data.draw_statistics;
+
+    blackboard_data.draw_statistics = frame_statistics += view.statistics.draw_statistics;
+  }
+
+  const Vector<glm::mat4>& instances = blackboard_data.instances;
+  if (!instances.empty()) {
+    FrameSet& frame_set = frame_sets_[frame_in_flight];
+    assert(instances.size() <= frame_set.instances_capacity);
+    device_.LoadBufferData<glm::mat4>(frame_set.sb_instances, 0, instances.size(), instances.data());
+
+    /* Draws recorded before the buffer was grown only use the instances, which fitted into the previous buffers */
+    for (const auto& retired_frame_set : retired_frame_sets_[frame_in_flight]) {
+      uint32_t instances_count = std::min<uint32_t>(instances.size(), retired_frame_set.instances_capacity);
+      device_.LoadBufferData<glm::mat4>(retired_frame_set.sb_instances, 0, instances_count, instances.data());
+    }
+  }
+}
+
+void Renderer::ReserveInstances(uint32_t instances_count) {
+  RendererBlackboardData& blackboard_data = blackboard_.Get<RendererBlackboardData>();
+  uint32_t                frame           = blackboard_data.frame_in_flight;
+
+  FrameSet& frame_set = frame_sets_[frame];
+  if (instances_count <= frame_set.instances_capacity) {
+    return;
+  }
+
+  uint32_t instances_capacity = std::max(instances_count, 2 * frame_set.instances_capacity);
+  LOG_INFO("Growing instance buffer of frame {0} to {1} instances", frame, instances_capacity);
+
+  retired_frame_sets_[frame].push_back(std::move(frame_set));
+  frame_set = CreateFrameSet(frame, instances_capacity);
+
+  blackboard_data.descriptor_set_frame = frame_set.set->GetHandle();
+}
+
+Renderer::View& Renderer::GetOrCreateView(uint32_t view_idx) {
+  assert(view_idx <= views_.size());
+  if (view_idx < views_.size()) {
+    return *views_[view_idx];
+  }
+
+  View& view = *views_.emplace_back(CreateUnique<View>(blackboard_));
+
+  const ShaderStageFlags stage_flags = kShaderStageBitVertex | kShaderStageBitFragment;
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    view.ub_view[frame] = device_.CreateDynamicUniformBuffer<UBViewData>(1);
+
+    view.view_set[frame].AddBinding(DescriptorType::kUniformBuffer, stage_flags).Build(device_);
+    device_.WriteDescriptorUniformBuffer(view.view_set[frame].GetHandle(), 0, view.ub_view[frame], 0,
+                                         sizeof(UBViewData));
+  }
+
+  /* Every view graph is set up the same way, so the pass data in the shared blackboard is valid for all of them */
+  view.render_graph.DeclareTexture("backbuffer", TextureLayout::kShaderReadOnly);
 
-  RenderContext context{device_, command_buffer, frame_in_flight,   render_graph_,
-                        camera,  render_queue,   light_environment_};
   for (auto& feature : features_) {
-    feature->Execute(context);
+    view.render_graph.BeginSubgraph(feature->Name());
+    feature->SetupRenderPasses(view.render_graph);
+    view.render_graph.EndSubgraph();
   }
 
-  static bool first_frame = true;
-  if (first_frame) {
-    render_graph_.Compile(device_);
-    first_frame = false;
+  view.render_graph.Setup(device_);
+
+  return view;
+}
+
+void Renderer::CompileViewRenderGraph(uint32_t view_idx) {
+  View& view = *views_[view_idx];
+  view.render_graph.Compile(device_);
+  view.compiled = true;
 
+  if (view_idx == 0) {
     // FIXME: (tralf-strues) get rid of
     std::ofstream output_file("log/render_graph.dot", std::ios::trunc);
     assert(output_file.is_open());
-    render_graph_.ExportGraphviz(output_file);
+    view.render_graph.ExportGraphviz(output_file);
     system("dot -Tpng log/render_graph.dot > log/render_graph.png");
     output_file.close();
   }
+}
+
+void Renderer::ReadTimestamps(uint32_t frame) {
+  uint32_t views_count = timestamp_views_count_[frame];
+  if (views_count == 0) {
+    return;
+  }
+
+  uint64_t timestamps[kTimestampQueriesCount]{};
+  if (!device_.GetTimestamps(timestamp_pools_[frame], 0, 2 * (views_count + 1), timestamps)) {
+    return;
+  }
 
-  render_graph_.Execute(device_, command_buffer);
+  auto duration_ms = [&timestamps](uint32_t first_query) {
+    return static_cast<float>(timestamps[first_query + 1] - timestamps[first_query]) * 1e-6f;
+  };
+
+  shared_statistics_.gpu_time_ms = duration_ms(0);
+  for (uint32_t view_idx = 0; view_idx < views_count; ++view_idx) {
+    views_[view_idx]->statistics.gpu_time_ms = duration_ms(2 * (view_idx + 1));
+  }
 }
 
 void Renderer::CreateDescriptorSets() {
   const ShaderStageFlags stage_flags = kShaderStageBitVertex | kShaderStageBitFragment;
 
   for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
-    /* Frame Set */
-    frame_set_[frame].AddBinding(DescriptorType::kUniformBuffer, stage_flags).Build(device_);
-
-    /* View Set */
-    main_view_set_[frame].AddBinding(DescriptorType::kUniformBuffer, stage_flags).Build(device_);
-
     /* Scene Set */
     scene_set_[frame].AddBinding(DescriptorType::kUniformBuffer, stage_flags)
                      .AddBinding(DescriptorType::kStorageBuffer, stage_flags)
@@ -106,88 +367,125 @@ void Renderer::CreateDescriptorSets() {
 void Renderer::CreateBuffers() {
   for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
     /* Frame */
-    ub_frame_[frame] = device_.CreateDynamicUniformBuffer<UBFrameData>(1);
+    ub_frame_[frame]   = device_.CreateDynamicUniformBuffer<UBFrameData>(1);
+    frame_sets_[frame] = CreateFrameSet(frame, kInitialInstancesCapacity);
+  }
+
+  /* Scene */
+  ub_light_ = shared_render_graph_.CreateBuffer("light_data", {sizeof(UBLightData), kBufferUsageBitUniformBuffer});
+
+  sb_directional_lights_ = shared_render_graph_.CreateBuffer(
+      "directional_lights", {kMaxDirectionalLights * sizeof(DirectionalLight), kBufferUsageBitStorageBuffer});
+  sb_point_lights_ = shared_render_graph_.CreateBuffer(
+      "point_lights", {kMaxPointLights * sizeof(PointLight), kBufferUsageBitStorageBuffer});
+  sb_spot_lights_ = shared_render_graph_.CreateBuffer(
+      "spot_lights", {kMaxSpotLights * sizeof(SpotLight), kBufferUsageBitStorageBuffer});
+}
+
+void Renderer::WriteDescriptors() {
+  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
+    /* Scene set */
+    rg::BufferSlice light_data = shared_render_graph_.GetBuffer(ub_light_, frame);
+    device_.WriteDescriptorUniformBuffer(scene_set_[frame].GetHandle(), 0, light_data.buffer, light_data.offset,
+                                         light_data.size);
 
-    /* View */
-    ub_main_view_[frame] = device_.CreateDynamicUniformBuffer<UBViewData>(1);
+    rg::BufferSlice directional_lights = shared_render_graph_.GetBuffer(sb_directional_lights_, frame);
+    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 1, directional_lights.buffer,
+                                         directional_lights.offset, directional_lights.size);
 
-    /* Scene */
-    ub_light_[frame] = device_.CreateDynamicUniformBuffer<UBLightData>(1);
+    rg::BufferSlice point_lights = shared_render_graph_.GetBuffer(sb_point_lights_, frame);
+    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 2, point_lights.buffer, point_lights.offset,
+                                         point_lights.size);
 
-    sb_directional_lights_[frame] = device_.CreateDynamicStorageBuffer<DirectionalLight>(kMaxDirectionalLights);
-    sb_point_lights_[frame] = device_.CreateDynamicStorageBuffer<PointLight>(kMaxPointLights);
-    sb_spot_lights_[frame] = device_.CreateDynamicStorageBuffer<SpotLight>(kMaxSpotLights);
+    rg::BufferSlice spot_lights = shared_render_graph_.GetBuffer(sb_spot_lights_, frame);
+    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 3, spot_lights.buffer, spot_lights.offset,
+                                         spot_lights.size);
   }
 }
 
-void Renderer::WriteDescriptors() {
-  for (uint32_t frame = 0; frame < kFramesInFlight; ++frame) {
-    /* Frame set */
-    device_.WriteDescriptorUniformBuffer(frame_set_[frame].GetHandle(), 0, ub_frame_[frame], 0, sizeof(UBFrameData));
+Renderer::FrameSet Renderer::CreateFrameSet(uint32_t frame, uint32_t instances_capacity) {
+  const ShaderStageFlags stage_flags = kShaderStageBitVertex | kShaderStageBitFragment;
 
-    /* View set */
-    device_.WriteDescriptorUniformBuffer(main_view_set_[frame].GetHandle(), 0, ub_main_view_[frame], 0,
-                                         sizeof(UBViewData));
+  FrameSet frame_set;
+  frame_set.set = CreateUnique<DescriptorSet>();
+  frame_set.set->AddBinding(DescriptorType::kUniformBuffer, stage_flags)
+                .AddBinding(DescriptorType::kStorageBuffer, stage_flags)
+                .Build(device_);
 
-    /* Scene set */
-    device_.WriteDescriptorUniformBuffer(scene_set_[frame].GetHandle(), 0, ub_light_[frame], 0, sizeof(UBLightData));
+  frame_set.sb_instances       = device_.CreateDynamicStorageBuffer<glm::mat4>(instances_capacity);
+  frame_set.instances_capacity = instances_capacity;
 
-    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 1, sb_directional_lights_[frame], 0,
-                                         kMaxDirectionalLights * sizeof(DirectionalLight));
+  device_.WriteDescriptorUniformBuffer(frame_set.set->GetHandle(), 0, ub_frame_[frame], 0, sizeof(UBFrameData));
+  device_.WriteDescriptorStorageBuffer(frame_set.set->GetHandle(), 1, frame_set.sb_instances, 0,
+                                       instances_capacity * sizeof(glm::mat4));
 
-    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 2, sb_point_lights_[frame], 0,
-                                         kMaxPointLights * sizeof(PointLight));
+  return frame_set;
+}
 
-    device_.WriteDescriptorStorageBuffer(scene_set_[frame].GetHandle(), 3, sb_spot_lights_[frame], 0,
-                                         kMaxSpotLights * sizeof(SpotLight));
+void Renderer::DeleteFrameSet(FrameSet& frame_set) {
+  if (ValidRenderHandle(frame_set.sb_instances)) {
+    device_.DeleteBuffer(frame_set.sb_instances);
   }
+
+  frame_set = FrameSet{};
 }
 
-void Renderer::UpdateBuffers(uint32_t frame, const Camera& camera, float time) {
+void Renderer::UpdateBuffers(uint32_t frame, float time) {
   /* Frame */
   UBFrameData frame_data{};
   frame_data.time = time;
 
   device_.LoadBufferData<UBFrameData>(ub_frame_[frame], 0, 1, &frame_data);
 
-  /* Main view */
-  UBViewData main_view_data{};
-  main_view_data.view       = camera.ViewMatrix();
-  main_view_data.proj       = camera.ProjMatrix();
-  main_view_data.position   = camera.Position();
-  main_view_data.near_plane = camera.NearPlane();
-  main_view_data.far_plane  = camera.FarPlane();
-  main_view_data.exposure   = camera.exposure;
-
-  device_.LoadBufferData<UBViewData>(ub_main_view_[frame], 0, 1, &main_view_data);
-
   /* Scene */
   UBLightData light_data{};
   light_data.directional_lights_count = light_environment_.directional_lights.size();
   light_data.point_lights_count       = light_environment_.point_lights.size();
   light_data.spot_lights_count        = light_environment_.spot_lights.size();
-  device_.LoadBufferData<UBLightData>(ub_light_[frame], 0, 1, &light_data);
+  shared_render_graph_.LoadBufferData<UBLightData>(device_, ub_light_, frame, 1, &light_data);
+
+  shared_render_graph_.LoadBufferData<DirectionalLight>(device_, sb_directional_lights_, frame,
+                                                        light_environment_.directional_lights.size(),
+                                                        light_environment_.directional_lights.data());
 
-  device_.LoadBufferData<DirectionalLight>(sb_directional_lights_[frame], 0,
-                                           light_environment_.directional_lights.size(),
-                                           light_environment_.directional_lights.data());
+  shared_render_graph_.LoadBufferData<PointLight>(device_, sb_point_lights_, frame,
+                                                  light_environment_.point_lights.size(),
+                                                  light_environment_.point_lights.data());
+
+  shared_render_graph_.LoadBufferData<SpotLight>(device_, sb_spot_lights_, frame,
+                                                 light_environment_.spot_lights.size(),
+                                                 light_environment_.spot_lights.data());
+}
 
-  device_.LoadBufferData<PointLight>(sb_point_lights_[frame], 0, light_environment_.point_lights.size(),
-                                     light_environment_.point_lights.data());
+void Renderer::UpdateViewBuffer(View& view, uint32_t frame, const Camera& camera) {
+  UBViewData view_data{};
+  view_data.view       = camera.ViewMatrix();
+  view_data.proj       = camera.ProjMatrix();
+  view_data.position   = camera.Position();
+  view_data.near_plane = camera.NearPlane();
+  view_data.far_plane  = camera.FarPlane();
+  view_data.exposure   = camera.exposure;
 
-  device_.LoadBufferData<SpotLight>(sb_spot_lights_[frame], 0, light_environment_.spot_lights.size(),
-                                    light_environment_.spot_lights.data());
+  device_.LoadBufferData<UBViewData>(view.ub_view[frame], 0, 1, &view_data);
 }
 
-void Renderer::UpdateBlackboard(uint32_t frame, const Camera& camera, float time) {
-  RendererBlackboardData& blackboard_data  = blackboard_.Get<RendererBlackboardData>();
-  blackboard_data.time                     = time;
-  blackboard_data.frame_in_flight           = frame;
-  blackboard_data.descriptor_set_frame     = frame_set_[frame].GetHandle();
-  
-  blackboard_data.light_environment        = &light_environment_;
-  blackboard_data.descriptor_set_scene     = scene_set_[frame].GetHandle();
+void Renderer::UpdateBlackboard(uint32_t frame, float time) {
+  /* Draws of the frame, which previously used the frame in flight, have finished */
+  for (auto& frame_set : retired_frame_sets_[frame]) {
+    DeleteFrameSet(frame_set);
+  }
+  retired_frame_sets_[frame].clear();
+
+  RendererBlackboardData& blackboard_data = blackboard_.Get<RendererBlackboardData>();
+  blackboard_data.renderer                = this;
+  blackboard_data.time                    = time;
+  blackboard_data.frame_in_flight         = frame;
+  blackboard_data.descriptor_set_frame    = frame_sets_[frame].set->GetHandle();
+  blackboard_data.frame_allocator         = &frame_allocator_.Get();
 
-  blackboard_data.main_camera              = &camera;
-  blackboard_data.descriptor_set_main_view = main_view_set_[frame].GetHandle();
-}
\ No newline at end of file
+  blackboard_data.light_environment       = &light_environment_;
+  blackboard_data.descriptor_set_scene    = scene_set_[frame].GetHandle();
+
+  blackboard_data.draw_statistics         = DrawStatistics{};
+  blackboard_data.instances.clear();
+}
@@ -28,21 +28,52 @@
 #pragma once
 
 #include <vulture/renderer/descriptor_set.hpp>
+#include <vulture/renderer/draw_list.hpp>
+#include <vulture/renderer/frame_allocator.hpp>
 #include <vulture/renderer/light.hpp>
+#include <vulture/renderer/material_system/shader.hpp>
 #include <vulture/renderer/render_feature.hpp>
 
 namespace vulture {
 
+constexpr uint32_t kInitialInstancesCapacity = 65536;
+constexpr uint32_t kMaxViews                 = 8;
+
+class Renderer;
+
 struct RendererBlackboardData {
+  Renderer*               renderer                 {nullptr};
   float                   time                     {0.0f};
   uint32_t                frame_in_flight          {0};
   DescriptorSetHandle     descriptor_set_frame     {kInvalidRenderResourceHandle};
+  LinearAllocator*        frame_allocator          {nullptr};  ///< Reset at the beginning of the frame
 
   const LightEnvironment* light_environment        {nullptr};
   DescriptorSetHandle     descriptor_set_scene     {kInvalidRenderResourceHandle};
 
-  const Camera*           main_camera              {nullptr};
-  DescriptorSetHandle     descriptor_set_main_view {kInvalidRenderResourceHandle};
+  /* Set before executing each view's render graph */
+  uint32_t                view_idx                 {0};
+  const Camera*           camera                   {nullptr};
+  DescriptorSetHandle     descriptor_set_view      {kInvalidRenderResourceHandle};
+
+  DrawStatistics          draw_statistics          {};  ///< Accumulated by render queue passes during the graph execution
+
+  /**
+   * Model matrices of all instances drawn during the frame (by all views), appended by render queue passes while
+   * recording and uploaded by the Renderer to the frame set's instance buffer after the render graphs are executed.
+   *
+   * Passes must call @ref{Renderer::ReserveInstances} before recording draws, which use the appended instances.
+   */
+  Vector<glm::mat4>       instances;
+};
+
+/**
+ * @brief Timings and draw counts of a view (or of the shared work) during the frame.
+ */
+struct ViewStatistics {
+  float          cpu_time_ms     {0.0f};  ///< Culling, executing the render features and recording the render graph
+  float          gpu_time_ms     {0.0f};  ///< Of the frame kFramesInFlight frames ago, which has already finished
+  DrawStatistics draw_statistics {};
 };
 
 struct UBFrameData {
@@ -64,48 +95,146 @@ struct UBLightData {
   alignas(4) uint32_t spot_lights_count{0};
 };
 
+/**
+ * @brief Renders the render queue from one or several views (split-screen, picture-in-picture, editor viewports).
+ *
+ * Work, which doesn't depend on the view, is done once per frame: uploading the frame and light data, computing the
+ * bounding boxes, and executing the shared render graph with the passes added by
+ * @ref{IRenderFeature::SetupSharedRenderPasses} (e.g. shadow maps). Then each view culls the render queue by its
+ * camera's frustum and executes its own render graph, which renders into the camera's render texture.
+ */
 class Renderer {
  public:
   Renderer(RenderDevice& device, Vector<UniquePtr<IRenderFeature>> features);
+  ~Renderer();
+
+  /**
+   * @brief Begin the frame, which resets the frame's allocator, render queue must be allocated after that.
+   */
+  LinearAllocator& BeginFrame(uint32_t frame_in_flight);
 
-  void Render(CommandBuffer& command_buffer, const Camera& camera, RenderQueue render_queue, float time,
+  void Render(CommandBuffer& command_buffer, const Camera& camera, RenderQueue& render_queue, float time,
               uint32_t frame_in_flight);
 
-  LightEnvironment& GetLightEnvironment();
+  /**
+   * @brief Render the queue from each of cameras_count cameras into its render texture.
+   *
+   * View-dependent shared work (e.g. fitting shadow cascades) uses the first camera. View graphs are created on the
+   * first use of the view index.
+   */
+  void Render(CommandBuffer& command_buffer, const Camera* const* cameras, uint32_t cameras_count,
+              RenderQueue& render_queue, float time, uint32_t frame_in_flight);
+
+  /**
+   * @brief Build the pipelines of the shaders for the render passes they target, so that they aren't built lazily
+   *        during the first frames. Shaders targeting passes, which are in none of the render graphs, are skipped.
+   *
+   * @note Compiles the render graphs, the first view's one for the camera's render texture.
+   */
+  void PrebuildShaders(const Camera& camera, const Vector<SharedPtr<Shader>>& shaders);
+
+  /**
+   * @brief Make the current frame's instance buffer fit instances_count instances, growing it if needed.
+   *
+   * The grown buffer gets a new frame set, which replaces @ref{RendererBlackboardData::descriptor_set_frame}. The
+   * previous buffer and set are kept until the frame in flight is reused, as already recorded draws refer to them.
+   */
+  void ReserveInstances(uint32_t instances_count);
 
-  rg::RenderGraph& GetRenderGraph();
+  LightEnvironment& GetLightEnvironment();
+  FrameAllocator& GetFrameAllocator();
+
+  /**
+   * @brief Draw and bind counts of all render queue passes, recorded during the last Render call.
+   */
+  const DrawStatistics& GetDrawStatistics();
+
+  /**
+   * @note GPU times are measured by timestamps in the command buffer passed to Render, so they don't include render
+   *       graph passes submitted to the async compute queue.
+   */
+  const ViewStatistics& GetSharedStatistics() const;
+  const ViewStatistics& GetViewStatistics(uint32_t view_idx) const;
+  uint32_t GetViewsCount() const;
+
+  rg::RenderGraph& GetSharedRenderGraph();
+
+  /**
+   * @note View graphs must not enable async compute. A graph using it submits its own command buffers ahead of the one
+   *       passed to Render, which holds the shared graph's passes (e.g. the shadow maps the views sample).
+   */
+  rg::RenderGraph& GetRenderGraph(uint32_t view_idx = 0);
   Vector<UniquePtr<IRenderFeature>>& GetFeatures();
 
  private:
+  static constexpr uint32_t kTimestampQueriesCount = 2 * (kMaxViews + 1);  ///< Begin and end of shared work and views
+
+  struct View {
+    View(rg::Blackboard& blackboard) : render_graph(blackboard) {}
+
+    rg::RenderGraph             render_graph;
+    bool                        compiled{false};
+
+    RenderQueueView             render_queue_view;
+
+    PerFrameData<DescriptorSet> view_set;
+    PerFrameData<BufferHandle>  ub_view{kInvalidRenderResourceHandle};
+
+    ViewStatistics              statistics;
+  };
+
+  struct FrameSet {
+    UniquePtr<DescriptorSet>    set;
+    BufferHandle                sb_instances{kInvalidRenderResourceHandle};
+    uint32_t                    instances_capacity{0};
+  };
+
   void CreateDescriptorSets();
   void CreateBuffers();
   void WriteDescriptors();
 
-  void UpdateBuffers(uint32_t frame, const Camera& camera, float time);
-  void UpdateBlackboard(uint32_t frame, const Camera& camera, float time);
+  FrameSet CreateFrameSet(uint32_t frame, uint32_t instances_capacity);
+  void DeleteFrameSet(FrameSet& frame_set);
+
+  View& GetOrCreateView(uint32_t view_idx);
+  void CompileViewRenderGraph(uint32_t view_idx);
+
+  void UpdateBuffers(uint32_t frame, float time);
+  void UpdateViewBuffer(View& view, uint32_t frame, const Camera& camera);
+  void UpdateBlackboard(uint32_t frame, float time);
+
+  void ReadTimestamps(uint32_t frame);
 
  private:
   RenderDevice&                     device_;
 
+  FrameAllocator                    frame_allocator_;
   LightEnvironment                  light_environment_;
 
-  rg::Blackboard                    blackboard_;
-  rg::RenderGraph                   render_graph_;
+  rg::Blackboard                    blackboard_;  ///< Shared by all render graphs, which are set up the same way
+  rg::RenderGraph                   shared_render_graph_;
+  bool                              shared_render_graph_compiled_{false};
+  Vector<UniquePtr<View>>           views_;
   Vector<UniquePtr<IRenderFeature>> features_;
 
+  ViewStatistics                    shared_statistics_;
+
+  /* Timestamps, read back when the frame in flight is reused */
+  PerFrameData<QueryPoolHandle>     timestamp_pools_{kInvalidRenderResourceHandle};
+  PerFrameData<uint32_t>            timestamp_views_count_{0};  ///< Number of views, which wrote timestamps
+
   /* Descriptor sets */
-  PerFrameData<DescriptorSet>       frame_set_;
+  PerFrameData<FrameSet>            frame_sets_;
+  PerFrameData<Vector<FrameSet>>    retired_frame_sets_;  ///< Replaced by growing the instance buffer during the frame
   PerFrameData<BufferHandle>        ub_frame_{kInvalidRenderResourceHandle};
 
-  PerFrameData<DescriptorSet>       main_view_set_;
-  PerFrameData<BufferHandle>        ub_main_view_{kInvalidRenderResourceHandle};
-
   PerFrameData<DescriptorSet>       scene_set_;
-  
-  PerFrameData<BufferHandle>        ub_light_{kInvalidRenderResourceHandle};
-  PerFrameData<BufferHandle>        sb_directional_lights_{kInvalidRenderResourceHandle};
-  PerFrameData<BufferHandle>        sb_point_lights_{kInvalidRenderResourceHandle};
-  PerFrameData<BufferHandle>        sb_spot_lights_{kInvalidRenderResourceHandle};
+
+  /* Render graph buffers, which have a slice per frame in flight */
+  rg::BufferVersionId               ub_light_{rg::kInvalidBufferVersionId};
+  rg::BufferVersionId               sb_directional_lights_{rg::kInvalidBufferVersionId};
+  rg::BufferVersionId               sb_point_lights_{rg::kInvalidBufferVersionId};
+  rg::BufferVersionId               sb_spot_lights_{rg::kInvalidBufferVersionId};
 };
 
 }  // namespace vulture
\ No newline at end of file
@@ -37,6 +37,12 @@ Texture::Texture(RenderDevice& device, const TextureSpecification& specification
   handle_ = device_.CreateTexture(specification);
 }
 
+Texture::Texture(RenderDevice& device, const TextureSpecification& specification, DeviceMemoryHandle memory,
+                 uint64_t offset)
+    : device_(device), specification_(specification) {
+  handle_ = device_.CreateTexture(specification, memory, offset);
+}
+
 Texture::~Texture() {
   if (ValidRenderHandle(handle_)) {
     device_.DeleteTexture(handle_);
@@ -58,4 +64,13 @@ void Texture::Recreate(const TextureSpecification& specification) {
 
   specification_ = specification;
   handle_ = device_.CreateTexture(specification_);
+}
+
+void Texture::Recreate(const TextureSpecification& specification, DeviceMemoryHandle memory, uint64_t offset) {
+  if (ValidRenderHandle(handle_)) {
+    device_.DeleteTexture(handle_);
+  }
+
+  specification_ = specification;
+  handle_ = device_.CreateTexture(specification_, memory, offset);
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ class Texture : public IAsset {
  public:
   Texture(RenderDevice& device, TextureHandle handle);
   Texture(RenderDevice& device, const TextureSpecification& specification);
+  Texture(RenderDevice& device, const TextureSpecification& specification, DeviceMemoryHandle memory, uint64_t offset);
   ~Texture() override;
 
   Texture(const Texture& other) = delete;
@@ -48,6 +49,7 @@ class Texture : public IAsset {
   const TextureSpecification& GetSpecification() const;
 
   void Recreate(const TextureSpecification& specification);
+  void Recreate(const TextureSpecification& specification, DeviceMemoryHandle memory, uint64_t offset);
 
  private:
   RenderDevice&        device_;
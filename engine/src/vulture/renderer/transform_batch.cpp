@@ -0,0 +1,213 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file transform_batch.cpp
+ * @date 2023-06-16
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vulture/renderer/transform_batch.hpp>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define VULTURE_TRANSFORM_BATCH_SSE
+#endif
+
+using namespace vulture;
+
+namespace {
+
+/**
+ * Rotation part of glm::mat4_cast, each column scaled by the corresponding scale component.
+ */
+inline void ComposeMatrix(float px, float py, float pz, float qx, float qy, float qz, float qw, float sx, float sy,
+                          float sz, glm::mat4& matrix) {
+  float xx = qx * qx;
+  float yy = qy * qy;
+  float zz = qz * qz;
+  float xy = qx * qy;
+  float xz = qx * qz;
+  float yz = qy * qz;
+  float wx = qw * qx;
+  float wy = qw * qy;
+  float wz = qw * qz;
+
+  matrix[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f);
+  matrix[1] = glm::vec4(2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f);
+  matrix[2] = glm::vec4(2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f);
+  matrix[3] = glm::vec4(px, py, pz, 1.0f);
+}
+
+#ifdef VULTURE_TRANSFORM_BATCH_SSE
+/**
+ * Same as ComposeMatrix, but for 4 transforms at once. Results are transposed from SoA lanes into 4 column-major
+ * matrices.
+ */
+inline void ComposeMatrices4(const TransformBatch& batch, uint32_t first, glm::mat4* matrices) {
+  __m128 px = _mm_loadu_ps(batch.position_x.data() + first);
+  __m128 py = _mm_loadu_ps(batch.position_y.data() + first);
+  __m128 pz = _mm_loadu_ps(batch.position_z.data() + first);
+
+  __m128 qx = _mm_loadu_ps(batch.rotation_x.data() + first);
+  __m128 qy = _mm_loadu_ps(batch.rotation_y.data() + first);
+  __m128 qz = _mm_loadu_ps(batch.rotation_z.data() + first);
+  __m128 qw = _mm_loadu_ps(batch.rotation_w.data() + first);
+
+  __m128 sx = _mm_loadu_ps(batch.scale_x.data() + first);
+  __m128 sy = _mm_loadu_ps(batch.scale_y.data() + first);
+  __m128 sz = _mm_loadu_ps(batch.scale_z.data() + first);
+
+  const __m128 one  = _mm_set1_ps(1.0f);
+  const __m128 two  = _mm_set1_ps(2.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  __m128 xx = _mm_mul_ps(qx, qx);
+  __m128 yy = _mm_mul_ps(qy, qy);
+  __m128 zz = _mm_mul_ps(qz, qz);
+  __m128 xy = _mm_mul_ps(qx, qy);
+  __m128 xz = _mm_mul_ps(qx, qz);
+  __m128 yz = _mm_mul_ps(qy, qz);
+  __m128 wx = _mm_mul_ps(qw, qx);
+  __m128 wy = _mm_mul_ps(qw, qy);
+  __m128 wz = _mm_mul_ps(qw, qz);
+
+  /* cXrY - row Y of column X */
+  __m128 c0r0 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+  __m128 c0r1 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+  __m128 c0r2 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+  __m128 c0r3 = zero;
+
+  __m128 c1r0 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+  __m128 c1r1 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+  __m128 c1r2 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+  __m128 c1r3 = zero;
+
+  __m128 c2r0 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+  __m128 c2r1 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+  __m128 c2r2 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+  __m128 c2r3 = zero;
+
+  __m128 c3r3 = one;
+
+  _MM_TRANSPOSE4_PS(c0r0, c0r1, c0r2, c0r3);
+  _MM_TRANSPOSE4_PS(c1r0, c1r1, c1r2, c1r3);
+  _MM_TRANSPOSE4_PS(c2r0, c2r1, c2r2, c2r3);
+  _MM_TRANSPOSE4_PS(px, py, pz, c3r3);
+
+  /* After transposing, the i-th register of each column holds that column of the i-th matrix */
+  const __m128 columns[4][4] = {{c0r0, c1r0, c2r0, px},
+                                {c0r1, c1r1, c2r1, py},
+                                {c0r2, c1r2, c2r2, pz},
+                                {c0r3, c1r3, c2r3, c3r3}};
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    float* matrix = &matrices[i][0][0];
+    _mm_storeu_ps(matrix + 0,  columns[i][0]);
+    _mm_storeu_ps(matrix + 4,  columns[i][1]);
+    _mm_storeu_ps(matrix + 8,  columns[i][2]);
+    _mm_storeu_ps(matrix + 12, columns[i][3]);
+  }
+}
+#endif
+
+}  // namespace
+
+/************************************************************************************************
+ * Transform Batch
+ ************************************************************************************************/
+uint32_t TransformBatch::Size() const {
+  return static_cast<uint32_t>(position_x.size());
+}
+
+void TransformBatch::Clear() {
+  position_x.clear();
+  position_y.clear();
+  position_z.clear();
+
+  rotation_x.clear();
+  rotation_y.clear();
+  rotation_z.clear();
+  rotation_w.clear();
+
+  scale_x.clear();
+  scale_y.clear();
+  scale_z.clear();
+}
+
+void TransformBatch::Reserve(uint32_t capacity) {
+  position_x.reserve(capacity);
+  position_y.reserve(capacity);
+  position_z.reserve(capacity);
+
+  rotation_x.reserve(capacity);
+  rotation_y.reserve(capacity);
+  rotation_z.reserve(capacity);
+  rotation_w.reserve(capacity);
+
+  scale_x.reserve(capacity);
+  scale_y.reserve(capacity);
+  scale_z.reserve(capacity);
+}
+
+void TransformBatch::Add(const Transform& transform) {
+  position_x.push_back(transform.position.x);
+  position_y.push_back(transform.position.y);
+  position_z.push_back(transform.position.z);
+
+  rotation_x.push_back(transform.rotation.x);
+  rotation_y.push_back(transform.rotation.y);
+  rotation_z.push_back(transform.rotation.z);
+  rotation_w.push_back(transform.rotation.w);
+
+  scale_x.push_back(transform.scale.x);
+  scale_y.push_back(transform.scale.y);
+  scale_z.push_back(transform.scale.z);
+}
+
+/************************************************************************************************
+ * Batched matrix computation
+ ************************************************************************************************/
+void vulture::ComputeMatrices(const TransformBatch& batch, glm::mat4* matrices) {
+  uint32_t count = batch.Size();
+  uint32_t i     = 0;
+
+#ifdef VULTURE_TRANSFORM_BATCH_SSE
+  for (; i + 4 <= count; i += 4) {
+    ComposeMatrices4(batch, i, matrices + i);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    ComposeMatrix(batch.position_x[i], batch.position_y[i], batch.position_z[i], batch.rotation_x[i],
+                  batch.rotation_y[i], batch.rotation_z[i], batch.rotation_w[i], batch.scale_x[i], batch.scale_y[i],
+                  batch.scale_z[i], matrices[i]);
+  }
+}
+
+void vulture::ComputeMatrices(const Transform* transforms, uint32_t count, glm::mat4* matrices) {
+  for (uint32_t i = 0; i < count; ++i) {
+    const Transform& transform = transforms[i];
+    ComposeMatrix(transform.position.x, transform.position.y, transform.position.z, transform.rotation.x,
+                  transform.rotation.y, transform.rotation.z, transform.rotation.w, transform.scale.x,
+                  transform.scale.y, transform.scale.z, matrices[i]);
+  }
+}
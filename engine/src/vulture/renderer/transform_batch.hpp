@@ -0,0 +1,79 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file transform_batch.hpp
+ * @date 2023-06-16
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulture/core/types.hpp>
+#include <vulture/renderer/transform.hpp>
+
+namespace vulture {
+
+/**
+ * @brief Structure-of-arrays storage of transforms for batched matrix computation.
+ */
+struct TransformBatch {
+  Vector<float> position_x;
+  Vector<float> position_y;
+  Vector<float> position_z;
+
+  Vector<float> rotation_x;
+  Vector<float> rotation_y;
+  Vector<float> rotation_z;
+  Vector<float> rotation_w;
+
+  Vector<float> scale_x;
+  Vector<float> scale_y;
+  Vector<float> scale_z;
+
+  uint32_t Size() const;
+
+  void Clear();
+  void Reserve(uint32_t capacity);
+  void Add(const Transform& transform);
+};
+
+/**
+ * @brief Compute model matrices (T * R * S) of all transforms in the batch.
+ *
+ * Composes the matrices directly from the quaternion, without building and multiplying separate translation, rotation
+ * and scale matrices. Uses SSE when available, processing 4 transforms at a time.
+ *
+ * @param batch
+ * @param matrices Output array of at least batch.Size() matrices.
+ */
+void ComputeMatrices(const TransformBatch& batch, glm::mat4* matrices);
+
+/**
+ * @brief Same as above, but for an array of transforms.
+ *
+ * @param transforms
+ * @param count
+ * @param matrices Output array of at least count matrices.
+ */
+void ComputeMatrices(const Transform* transforms, uint32_t count, glm::mat4* matrices);
+
+}  // namespace vulture
@@ -62,6 +62,24 @@ struct TransformComponent {
   glm::mat4 CalculateMatrix() const { return transform.CalculateMatrix(); }
 };
 
+/**
+ * @brief Cached world-space transform, updated once per frame by @ref{Scene::UpdateWorldTransforms}.
+ *
+ * Attached to every entity created by the Scene, must not be modified manually. Entities without a
+ * TransformComponent have identity world transform.
+ */
+struct WorldTransformComponent {
+  Transform transform;     ///< World-space transform
+  glm::mat4 matrix{1.0f};  ///< World-space matrix, i.e. transform.CalculateMatrix()
+
+  Transform local_transform;  ///< Local transform the cached values were computed from
+  bool      has_local_transform{false};
+  bool      valid{false};
+
+  bool      changed{false};  ///< Whether the cached values were recomputed during the last update
+  uint32_t  update_idx{0};   ///< Index of the last update, in which the entity was visited
+};
+
 struct CameraComponent {
   Camera camera;
   bool is_main{false};
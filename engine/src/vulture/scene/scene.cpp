@@ -30,6 +30,22 @@
 
 using namespace vulture;
 
+namespace {
+
+bool EqualTransforms(const Transform& lhs, const Transform& rhs) {
+  return lhs.position == rhs.position && lhs.rotation == rhs.rotation && lhs.scale == rhs.scale;
+}
+
+Transform CombineTransforms(const Transform& parent_transform, const Transform& local_transform) {
+  glm::vec4 local_position = glm::vec4(parent_transform.scale * local_transform.position, 1.0f);
+
+  return Transform(parent_transform.position + glm::vec3(parent_transform.CalculateRotationMatrix() * local_position),
+                   parent_transform.rotation * local_transform.rotation,
+                   parent_transform.scale * local_transform.scale);
+}
+
+}  // namespace
+
 fennecs::EntityWorld& Scene::GetEntityWorld() { return world_; }
 
 void Scene::OnStart(Dispatcher& dispatcher) {
@@ -70,11 +86,13 @@ fennecs::EntityHandle Scene::GetMainCamera() {
 }
 
 void Scene::OnUpdate(float timestep) {
+  UpdateWorldTransforms();
+
   fennecs::EntityStream camera_stream = world_.Query<CameraComponent>();
   for (fennecs::EntityHandle entity = camera_stream.Next(); !entity.IsNull(); entity = camera_stream.Next()) {
     CameraComponent& camera_component = entity.Get<CameraComponent>();
     camera_component.camera.OnUpdateProjection();
-    camera_component.camera.OnUpdateTransform(ComputeWorldSpaceTransform(entity));
+    camera_component.camera.OnUpdateTransform(entity.Get<WorldTransformComponent>().transform);
   }
 
   fennecs::EntityStream stream = world_.Query<ScriptComponent>();  
@@ -89,7 +107,23 @@ void Scene::Render(Renderer& renderer, CommandBuffer& command_buffer,
   fennecs::EntityHandle main_camera_handle = GetMainCamera();
   assert(!main_camera_handle.IsNull());
 
-  const Camera& main_camera = main_camera_handle.Get<CameraComponent>().camera;
+  /* The main camera is the first view, so that view-dependent shared work (e.g. shadow cascades) is fitted to it */
+  Array<const Camera*, kMaxViews> cameras{&main_camera_handle.Get<CameraComponent>().camera};
+  uint32_t                        cameras_count = 1;
+
+  fennecs::EntityStream camera_stream = world_.Query<CameraComponent>();
+  for (auto entity = camera_stream.Next(); !entity.IsNull() && cameras_count < kMaxViews;
+       entity = camera_stream.Next()) {
+    const CameraComponent& camera_component = entity.Get<CameraComponent>();
+    if (!camera_component.is_main && camera_component.camera.render_texture != nullptr) {
+      cameras[cameras_count++] = &camera_component.camera;
+    }
+  }
+
+  /* Scripts could have changed transforms after OnUpdate */
+  UpdateWorldTransforms();
+
+  LinearAllocator& frame_allocator = renderer.BeginFrame(current_frame);
 
   /* Lights */
   LightEnvironment& lights = renderer.GetLightEnvironment();
@@ -122,24 +156,26 @@ void Scene::Render(Renderer& renderer, CommandBuffer& command_buffer,
   }
 
   /* Render Queue */
-  RenderQueue render_queue{};
+  RenderQueue render_queue{frame_allocator};
 
   fennecs::EntityStream mesh_stream = world_.Query<MeshComponent, TransformComponent>();
   for (auto entity = mesh_stream.Next(); !entity.IsNull(); entity = mesh_stream.Next()) {
-    MeshComponent& mesh_component = entity.Get<MeshComponent>();
-    Transform&     transform      = entity.Get<TransformComponent>().transform;
+    assert(entity.Has<WorldTransformComponent>());
 
-    render_queue.renderables.emplace_back(
-        RenderQueue::Renderable{mesh_component.mesh, ComputeWorldSpaceMatrix(entity)});
+    MeshComponent&                 mesh_component  = entity.Get<MeshComponent>();
+    const WorldTransformComponent& world_transform = entity.Get<WorldTransformComponent>();
+
+    render_queue.renderables.emplace_back(RenderQueue::Renderable{mesh_component.mesh.get(), world_transform.matrix});
   }
 
-  renderer.Render(command_buffer, main_camera, std::move(render_queue), time, current_frame);
+  renderer.Render(command_buffer, cameras.data(), cameras_count, render_queue, time, current_frame);
 }
 
 fennecs::EntityHandle Scene::CreateEntity(const std::string& name) {
   fennecs::EntityHandle entity = world_.AddEntity();
   entity = world_.Attach<HierarchyComponent>(entity);
   entity = world_.Attach<NameComponent>(entity, name);
+  entity = world_.Attach<WorldTransformComponent>(entity);
   return entity;
 }
 
@@ -147,6 +183,7 @@ fennecs::EntityHandle Scene::CreateChildEntity(fennecs::EntityHandle& parent, co
   fennecs::EntityHandle entity = world_.AddEntity();
   entity = world_.Attach<HierarchyComponent>(entity, parent);
   entity = world_.Attach<NameComponent>(entity, name);
+  entity = world_.Attach<WorldTransformComponent>(entity);
 
   if (!parent.Has<HierarchyComponent>()) {
     parent = world_.Attach<HierarchyComponent>(fennecs::EntityHandle{parent});
@@ -170,13 +207,81 @@ Transform Scene::ComputeWorldSpaceTransform(fennecs::EntityHandle entity) {
 
   auto parent = entity.Get<HierarchyComponent>().parent;
   if (parent.has_value()) {
-    const Transform& parent_transform = ComputeWorldSpaceTransform(parent.value());
-    glm::vec4 local_position = glm::vec4(parent_transform.scale * local_transform.position, 1.0f);
-
-    return Transform(
-        parent_transform.position + glm::vec3(parent_transform.CalculateRotationMatrix() * local_position),
-        parent_transform.rotation * local_transform.rotation, parent_transform.scale * local_transform.scale);
+    return CombineTransforms(ComputeWorldSpaceTransform(parent.value()), local_transform);
   }
 
   return local_transform;
 }
+
+void Scene::UpdateWorldTransforms() {
+  ++world_transforms_update_idx_;
+
+  dirty_world_transforms_.clear();
+  dirty_world_transforms_batch_.Clear();
+
+  fennecs::EntityStream stream = world_.Query<WorldTransformComponent>();
+  for (auto entity = stream.Next(); !entity.IsNull(); entity = stream.Next()) {
+    UpdateWorldTransform(entity);
+  }
+
+  /* Matrices of all recomputed transforms are calculated in one batch */
+  uint32_t dirty_count = dirty_world_transforms_batch_.Size();
+  dirty_world_matrices_.resize(dirty_count);
+  ComputeMatrices(dirty_world_transforms_batch_, dirty_world_matrices_.data());
+
+  for (uint32_t i = 0; i < dirty_count; ++i) {
+    dirty_world_transforms_[i]->matrix = dirty_world_matrices_[i];
+  }
+}
+
+WorldTransformComponent& Scene::UpdateWorldTransform(fennecs::EntityHandle entity) {
+  WorldTransformComponent& world_transform = entity.Get<WorldTransformComponent>();
+  if (world_transform.update_idx == world_transforms_update_idx_) {
+    return world_transform;
+  }
+
+  world_transform.update_idx = world_transforms_update_idx_;
+
+  /* Parent is updated first, so that the hierarchy is traversed in topological order */
+  const WorldTransformComponent* parent_world_transform = nullptr;
+
+  auto parent = entity.Get<HierarchyComponent>().parent;
+  if (parent.has_value() && parent->Has<WorldTransformComponent>()) {
+    parent_world_transform = &UpdateWorldTransform(parent.value());
+  }
+
+  bool has_local_transform = entity.Has<TransformComponent>();
+  bool dirty               = !world_transform.valid || world_transform.has_local_transform != has_local_transform;
+
+  if (has_local_transform) {
+    const Transform& local_transform = entity.Get<TransformComponent>().transform;
+
+    dirty |= !EqualTransforms(world_transform.local_transform, local_transform);
+    dirty |= parent_world_transform != nullptr && parent_world_transform->changed;
+
+    if (dirty) {
+      world_transform.local_transform = local_transform;
+      world_transform.transform       = local_transform;
+
+      // Parents without a TransformComponent have identity world transform, so there is nothing to combine with
+      if (parent_world_transform != nullptr && parent_world_transform->has_local_transform) {
+        world_transform.transform = CombineTransforms(parent_world_transform->transform, local_transform);
+      }
+    }
+  } else if (dirty) {
+    world_transform.local_transform = Transform{};
+    world_transform.transform       = Transform{};
+  }
+
+  if (dirty) {
+    dirty_world_transforms_.push_back(&world_transform);
+    dirty_world_transforms_batch_.Add(world_transform.transform);
+
+    world_transform.has_local_transform = has_local_transform;
+    world_transform.valid               = true;
+  }
+
+  world_transform.changed = dirty;
+
+  return world_transform;
+}
@@ -30,6 +30,7 @@
 #include <fennecs/entity/world.hpp>
 #include <vulture/event_system/event_system.hpp>
 #include <vulture/renderer/renderer.hpp>
+#include <vulture/renderer/transform_batch.hpp>
 #include <vulture/scene/components.hpp>
 
 namespace vulture {
@@ -51,6 +52,9 @@ class Scene {
    */
   void OnUpdate(float timestep);
 
+  /**
+   * @brief Render the scene from the main camera and every other camera, which has a render texture.
+   */
   void Render(Renderer& renderer, CommandBuffer& command_buffer, uint32_t current_frame, float time);
 
   /**
@@ -70,11 +74,35 @@ class Scene {
    */
   fennecs::EntityHandle CreateChildEntity(fennecs::EntityHandle& parent, const std::string& name = "Untitled entity");
 
+  /**
+   * @brief Update cached world transforms of all entities.
+   *
+   * Parents are always updated before their children and each entity is visited exactly once. Only entities, whose
+   * local transform or any of whose ancestors' transforms have changed since the last update, are recomputed.
+   *
+   * @note Called by @ref{OnUpdate} and @ref{Render}, so should only be called manually when world transforms are
+   *       needed between the two.
+   */
+  void UpdateWorldTransforms();
+
+  /**
+   * @brief Compute world-space matrix/transform by walking up the hierarchy.
+   *
+   * @warning Not cached, prefer WorldTransformComponent when the up-to-date value is not required.
+   */
   glm::mat4 ComputeWorldSpaceMatrix(fennecs::EntityHandle entity);
   Transform ComputeWorldSpaceTransform(fennecs::EntityHandle entity);
 
+ private:
+  WorldTransformComponent& UpdateWorldTransform(fennecs::EntityHandle entity);
+
  private:
   fennecs::EntityWorld world_;
+  uint32_t             world_transforms_update_idx_{0};
+
+  Vector<WorldTransformComponent*> dirty_world_transforms_;  ///< Recomputed during the current update
+  TransformBatch                   dirty_world_transforms_batch_;
+  Vector<glm::mat4>                dirty_world_matrices_;
   // Scene3D scene_;
 };
 
@@ -0,0 +1,238 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file frame_allocations_test.cpp
+ * @date 2023-07-01
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <vulture/renderer/features/forward_rendering/forward_rendering.hpp>
+#include <vulture/renderer/features/shadows/cascaded_shadow_mapping.hpp>
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
+#include <vulture/renderer/renderer.hpp>
+#include <vulture/scene/scene.hpp>
+
+using namespace vulture;
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations_count{0};
+
+/* First frames build pipelines, compile the render graphs and grow the allocators and containers */
+constexpr uint32_t kWarmUpFrames   = 4 * kFramesInFlight;
+constexpr uint32_t kMeasuredFrames = 16 * kFramesInFlight;
+
+constexpr uint32_t kGridSize = 16;
+
+SharedPtr<Texture> CreateRenderTexture(RenderDevice& device, uint32_t width, uint32_t height) {
+  TextureSpecification specification{};
+  specification.format = DataFormat::kR8G8B8A8_UNORM;
+  specification.usage  = kTextureUsageBitColorAttachment | kTextureUsageBitSampled;
+  specification.width  = width;
+  specification.height = height;
+
+  return CreateShared<Texture>(device, specification);
+}
+
+SharedPtr<Shader> LoadShader(RenderDevice& device, const StringView path) {
+  SharedPtr<Shader> shader = CreateShared<Shader>(device);
+  if (!shader->Load(path)) {
+    return nullptr;
+  }
+
+  return shader;
+}
+
+}  // namespace
+
+/************************************************************************************************
+ * Allocation counting
+ ************************************************************************************************/
+void* operator new(std::size_t size) {
+  g_heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+/************************************************************************************************
+ * Tests
+ ************************************************************************************************/
+/**
+ * @brief Renders a scene with shadows and two views on the null render device.
+ *
+ * Shaders are loaded from the compiled SPIR-V binaries, so compile_shaders.sh has to be run before, and the test has
+ * to be run from the repository root.
+ */
+class FrameAllocationsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!std::filesystem::exists("assets/.vulture/shaders/BuiltIn.PBR.vert.spv")) {
+      GTEST_SKIP() << "Shaders are not compiled, run compile_shaders.sh from the repository root";
+    }
+
+    device_.Init(nullptr, nullptr, nullptr, false);
+
+    /* Not loaded through the AssetRegistry, which would keep the shaders of the previous test's device */
+    SharedPtr<Shader> pbr_shader    = LoadShader(device_, "assets/.vulture/shaders/BuiltIn.PBR.shader");
+    SharedPtr<Shader> shadow_shader = LoadShader(device_, "assets/.vulture/shaders/BuiltIn.DirShadow.shader");
+    ASSERT_NE(pbr_shader, nullptr);
+    ASSERT_NE(shadow_shader, nullptr);
+
+    SharedPtr<Material> material = CreateShared<Material>(device_);
+    material->AddShader(pbr_shader);
+    material->AddShader(shadow_shader);
+    material->WriteMaterialPassDescriptors();
+
+    mesh_ = CreateShared<Mesh>(device_, Geometry::CreateCube(), material);
+
+    /* Renderer */
+    Vector<UniquePtr<IRenderFeature>> features;
+    features.emplace_back(CreateUnique<CascadedShadowMapRenderFeature>(device_));
+    features.emplace_back(CreateUnique<ForwardRenderFeature>());
+    renderer_ = CreateUnique<Renderer>(device_, std::move(features));
+
+    command_buffer_ = device_.CreateCommandBuffer(CommandBufferType::kGraphics);
+  }
+
+  void TearDown() override {
+    if (command_buffer_ != nullptr) {
+      device_.DeleteCommandBuffer(command_buffer_);
+    }
+  }
+
+  /**
+   * @return Number of heap allocations during the measured frames.
+   */
+  template <typename RenderFunc>
+  uint64_t CountSteadyStateAllocations(RenderFunc&& render_func) {
+    uint64_t heap_allocations = 0;
+    for (uint32_t frame = 0; frame < kWarmUpFrames + kMeasuredFrames; ++frame) {
+      uint64_t allocations_before = g_heap_allocations_count.load(std::memory_order_relaxed);
+
+      uint32_t frame_in_flight = frame % kFramesInFlight;
+      command_buffer_->Reset();
+      command_buffer_->Begin();
+      render_func(frame_in_flight, static_cast<float>(frame));
+      command_buffer_->End();
+
+      if (frame >= kWarmUpFrames) {
+        heap_allocations += g_heap_allocations_count.load(std::memory_order_relaxed) - allocations_before;
+      }
+    }
+
+    return heap_allocations;
+  }
+
+ protected:
+  NullRenderDevice    device_;
+  SharedPtr<Mesh>     mesh_;
+  UniquePtr<Renderer> renderer_;
+  CommandBuffer*      command_buffer_{nullptr};
+};
+
+TEST_F(FrameAllocationsTest, RendererRender) {
+  Camera main_camera{PerspectiveCameraSpecification{16.0f / 9.0f}, CreateRenderTexture(device_, 1600, 900)};
+  Camera second_camera{PerspectiveCameraSpecification{1.0f}, CreateRenderTexture(device_, 512, 512)};
+
+  for (Camera* camera : {&main_camera, &second_camera}) {
+    camera->OnUpdateProjection();
+  }
+
+  main_camera.OnUpdateTransform(Transform{glm::vec3{0.0f, 5.0f, 20.0f}});
+  second_camera.OnUpdateTransform(Transform{glm::vec3{20.0f, 5.0f, 0.0f}});
+
+  const Camera* cameras[] = {&main_camera, &second_camera};
+
+  LightEnvironment& lights = renderer_->GetLightEnvironment();
+  lights.directional_lights.emplace_back(DirectionalLightSpecification{glm::vec3{1.0f}, 1.0f},
+                                         glm::normalize(glm::vec3{-1.0f, -1.0f, -1.0f}));
+
+  uint64_t heap_allocations = CountSteadyStateAllocations([&](uint32_t frame_in_flight, float time) {
+    RenderQueue render_queue{renderer_->BeginFrame(frame_in_flight)};
+    for (uint32_t x = 0; x < kGridSize; ++x) {
+      for (uint32_t z = 0; z < kGridSize; ++z) {
+        glm::vec3 position{2.0f * x - kGridSize, 0.0f, 2.0f * z - kGridSize};
+        render_queue.renderables.push_back(
+            RenderQueue::Renderable{mesh_.get(), glm::translate(glm::mat4{1.0f}, position)});
+      }
+    }
+
+    renderer_->Render(*command_buffer_, cameras, 2, render_queue, time, frame_in_flight);
+  });
+
+  EXPECT_GT(renderer_->GetDrawStatistics().draws, 0U);
+  EXPECT_EQ(heap_allocations, 0U) << "over " << kMeasuredFrames << " frames";
+}
+
+TEST_F(FrameAllocationsTest, SceneRender) {
+  Scene scene;
+  fennecs::EntityWorld& world = scene.GetEntityWorld();
+
+  fennecs::EntityHandle main_camera = scene.CreateEntity("Main camera");
+  main_camera = world.Attach<CameraComponent>(main_camera, PerspectiveCameraSpecification{16.0f / 9.0f}, true);
+  main_camera = world.Attach<TransformComponent>(main_camera, glm::vec3{0.0f, 5.0f, 20.0f});
+  main_camera.Get<CameraComponent>().camera.render_texture = CreateRenderTexture(device_, 1600, 900);
+
+  fennecs::EntityHandle second_camera = scene.CreateEntity("Second camera");
+  second_camera = world.Attach<CameraComponent>(second_camera, PerspectiveCameraSpecification{1.0f});
+  second_camera = world.Attach<TransformComponent>(second_camera, glm::vec3{20.0f, 5.0f, 0.0f});
+  second_camera.Get<CameraComponent>().camera.render_texture = CreateRenderTexture(device_, 512, 512);
+
+  fennecs::EntityHandle light = scene.CreateEntity("Light");
+  light = world.Attach<DirectionalLightSpecification>(light, glm::vec3{1.0f}, 1.0f);
+  light = world.Attach<TransformComponent>(
+      light, Transform{glm::vec3{0.0f}, glm::quat{glm::radians(glm::vec3{-45.0f, 60.0f, 35.0f})}});
+
+  fennecs::EntityHandle point_light = scene.CreateEntity("Point light");
+  point_light = world.Attach<PointLightSpecification>(point_light, glm::vec3{1.0f, 0.5f, 0.1f}, 2.5f, 3.0f);
+  point_light = world.Attach<TransformComponent>(point_light, glm::vec3{0.0f, 4.0f, 0.0f});
+
+  for (uint32_t x = 0; x < kGridSize; ++x) {
+    for (uint32_t z = 0; z < kGridSize; ++z) {
+      fennecs::EntityHandle cube = scene.CreateEntity("Cube");
+      cube = world.Attach<MeshComponent>(cube, mesh_);
+      cube = world.Attach<TransformComponent>(cube, glm::vec3{2.0f * x - kGridSize, 0.0f, 2.0f * z - kGridSize});
+    }
+  }
+
+  uint64_t heap_allocations = CountSteadyStateAllocations([&](uint32_t frame_in_flight, float time) {
+    scene.OnUpdate(1.0f / 60.0f);
+    scene.Render(*renderer_, *command_buffer_, frame_in_flight, time);
+  });
+
+  EXPECT_GT(renderer_->GetDrawStatistics().draws, 0U);
+  EXPECT_EQ(heap_allocations, 0U) << "over " << kMeasuredFrames << " frames";
+}
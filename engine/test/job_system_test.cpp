@@ -0,0 +1,196 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file job_system_test.cpp
+ * @date 2023-07-01
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vulture/jobs/job_system.hpp>
+
+using namespace vulture;
+using namespace vulture::jobs;
+
+namespace {
+
+constexpr uint32_t kMaxThreadsCount = 8;
+
+/**
+ * @brief Sum of leaves of a binary tree of jobs, each of which schedules its children and waits for them.
+ */
+uint32_t SpawnTree(JobSystem& job_system, uint32_t depth) {
+  if (depth == 0) {
+    return 1;
+  }
+
+  uint32_t left  = 0;
+  uint32_t right = 0;
+
+  Counter counter;
+  job_system.Schedule([&] { left = SpawnTree(job_system, depth - 1); }, counter);
+  job_system.Schedule([&] { right = SpawnTree(job_system, depth - 1); }, counter);
+  job_system.Wait(counter);
+
+  return left + right;
+}
+
+}  // namespace
+
+/**
+ * @brief Parametrized by the number of threads, from 1 to kMaxThreadsCount.
+ *
+ * Jobs write shared data non-atomically, which is only read after waiting for them, so that running with
+ * BUILD_WITH_TSAN checks that Wait synchronizes with the jobs' execution.
+ */
+class JobSystemTest : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(JobSystemTest, ParallelForCoversRangeOnce) {
+  JobSystem job_system(GetParam());
+
+  constexpr uint32_t kCount = 10000;
+
+  Vector<uint32_t> visits(kCount, 0);
+  job_system.ParallelFor(kCount, 16, [&](uint32_t begin, uint32_t end) {
+    for (uint32_t idx = begin; idx < end; ++idx) {
+      ++visits[idx];
+    }
+  });
+
+  for (uint32_t idx = 0; idx < kCount; ++idx) {
+    ASSERT_EQ(visits[idx], 1U) << "index " << idx;
+  }
+}
+
+TEST_P(JobSystemTest, NestedParallelFor) {
+  JobSystem job_system(GetParam());
+
+  constexpr uint32_t kOuterCount = 64;
+  constexpr uint32_t kInnerCount = 1024;
+
+  Vector<uint32_t> visits(kOuterCount * kInnerCount, 0);
+  job_system.ParallelFor(kOuterCount, 1, [&](uint32_t outer_begin, uint32_t outer_end) {
+    for (uint32_t outer = outer_begin; outer < outer_end; ++outer) {
+      job_system.ParallelFor(kInnerCount, 32, [&](uint32_t inner_begin, uint32_t inner_end) {
+        for (uint32_t inner = inner_begin; inner < inner_end; ++inner) {
+          ++visits[outer * kInnerCount + inner];
+        }
+      });
+    }
+  });
+
+  for (uint32_t idx = 0; idx < visits.size(); ++idx) {
+    ASSERT_EQ(visits[idx], 1U) << "index " << idx;
+  }
+}
+
+TEST_P(JobSystemTest, JobsSpawnJobs) {
+  JobSystem job_system(GetParam());
+
+  constexpr uint32_t kDepth = 10;
+
+  uint32_t leaves = 0;
+
+  Counter counter;
+  job_system.Schedule([&] { leaves = SpawnTree(job_system, kDepth); }, counter);
+  job_system.Wait(counter);
+
+  EXPECT_EQ(leaves, 1U << kDepth);
+}
+
+TEST_P(JobSystemTest, CounterWait) {
+  JobSystem job_system(GetParam());
+
+  constexpr uint32_t kJobsCount = 1000;
+  constexpr uint32_t kRounds    = 16;
+
+  Vector<uint32_t> results(kJobsCount, 0);
+  for (uint32_t round = 1; round <= kRounds; ++round) {
+    Counter counter;
+    EXPECT_TRUE(counter.IsDone());
+
+    for (uint32_t job_idx = 0; job_idx < kJobsCount; ++job_idx) {
+      job_system.Schedule([&results, job_idx, round] { results[job_idx] = job_idx * round; }, counter);
+    }
+
+    job_system.Wait(counter);
+    EXPECT_TRUE(counter.IsDone());
+
+    for (uint32_t job_idx = 0; job_idx < kJobsCount; ++job_idx) {
+      ASSERT_EQ(results[job_idx], job_idx * round) << "job " << job_idx << ", round " << round;
+    }
+  }
+}
+
+TEST_P(JobSystemTest, RawJobsWithRanges) {
+  JobSystem job_system(GetParam());
+
+  constexpr uint32_t kJobsCount      = 256;
+  constexpr uint32_t kElementsPerJob = 64;
+
+  Vector<uint32_t> values(kJobsCount * kElementsPerJob, 0);
+
+  Counter counter;
+  for (uint32_t job_idx = 0; job_idx < kJobsCount; ++job_idx) {
+    Job job;
+    job.function = [](void* data, uint32_t begin, uint32_t end) {
+      uint32_t* values = static_cast<uint32_t*>(data);
+      for (uint32_t idx = begin; idx < end; ++idx) {
+        values[idx] = idx;
+      }
+    };
+    job.data  = values.data();
+    job.begin = job_idx * kElementsPerJob;
+    job.end   = job.begin + kElementsPerJob;
+
+    job_system.Schedule(job, counter);
+  }
+
+  job_system.Wait(counter);
+
+  for (uint32_t idx = 0; idx < values.size(); ++idx) {
+    ASSERT_EQ(values[idx], idx);
+  }
+}
+
+TEST_P(JobSystemTest, CurrentThreadIdx) {
+  JobSystem job_system(GetParam());
+
+  EXPECT_EQ(job_system.GetThreadsCount(), GetParam());
+  EXPECT_EQ(job_system.GetCurrentThreadIdx(), 0U);
+
+  constexpr uint32_t kCount = 4096;
+
+  Vector<uint32_t> thread_indices(kCount, 0);
+  job_system.ParallelFor(kCount, 1, [&](uint32_t begin, uint32_t end) {
+    for (uint32_t idx = begin; idx < end; ++idx) {
+      thread_indices[idx] = job_system.GetCurrentThreadIdx();
+    }
+  });
+
+  for (uint32_t thread_idx : thread_indices) {
+    ASSERT_LT(thread_idx, GetParam());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, JobSystemTest, ::testing::Range(1U, kMaxThreadsCount + 1));
@@ -0,0 +1,584 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file render_graph_test.cpp
+ * @date 2023-07-02
+ * 
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <functional>
+#include <vulture/renderer/graphics_api/null/null_command_buffer.hpp>
+#include <vulture/renderer/graphics_api/null/null_render_device.hpp>
+#include <vulture/renderer/render_graph/render_graph.hpp>
+
+using namespace vulture;
+
+namespace {
+
+constexpr uint32_t kBackbufferWidth  = 1920;
+constexpr uint32_t kBackbufferHeight = 1080;
+
+using SetupFunc = std::function<void(rg::RenderGraphBuilder& builder)>;
+
+/**
+ * @brief Pass declaring its resources with a callback, which logs its executions.
+ */
+class TestPass final : public rg::IRenderPass {
+ public:
+  TestPass(String name, SetupFunc setup, Vector<String>* executed)
+      : name_(std::move(name)), setup_(std::move(setup)), executed_(executed) {}
+
+  void Setup(rg::RenderGraphBuilder& builder, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/) override {
+    setup_(builder);
+  }
+
+  void Execute(CommandBuffer& /*command_buffer*/, rg::Blackboard& /*blackboard*/, RenderPassId /*pass_id*/,
+               RenderPassHandle /*handle*/, uint32_t /*subpass_idx*/) override {
+    executed_->push_back(name_);
+  }
+
+ private:
+  String          name_;
+  SetupFunc       setup_;
+  Vector<String>* executed_{nullptr};
+};
+
+/**
+ * @brief Render pass and the barriers recorded between the end of the previous one and its beginning.
+ */
+struct RecordedRenderPass {
+  RenderPassHandle       render_pass{kInvalidRenderResourceHandle};
+  uint32_t               subpasses_count{1};
+  Vector<TextureBarrier> barriers;
+};
+
+struct RecordedFrame {
+  Vector<RecordedRenderPass> render_passes;
+  Vector<TextureBarrier>     final_barriers;  ///< Recorded after the last render pass
+};
+
+rg::DynamicTextureSpecification ColorSpecification(uint32_t width, uint32_t height) {
+  rg::DynamicTextureSpecification specification{};
+  specification.format = DataFormat::kR8G8B8A8_UNORM;
+  specification.usage  = kTextureUsageBitColorAttachment | kTextureUsageBitSampled | kTextureUsageBitInputAttachment;
+  specification.width  = width;
+  specification.height = height;
+
+  return specification;
+}
+
+const TextureBarrier* FindBarrier(const Vector<TextureBarrier>& barriers, const Texture& texture) {
+  for (const auto& barrier : barriers) {
+    if (barrier.texture == texture.GetHandle()) {
+      return &barrier;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+/**
+ * @brief Builds graphs of passes rendering to an imported backbuffer on the null render device and inspects the
+ *        recorded commands.
+ */
+class RenderGraphTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    device_.Init(nullptr, nullptr, nullptr, false);
+
+    backbuffer_     = CreateBackbuffer(kBackbufferWidth, kBackbufferHeight);
+    render_graph_   = CreateUnique<rg::RenderGraph>(blackboard_);
+    command_buffer_ = static_cast<NullCommandBuffer*>(device_.CreateCommandBuffer(CommandBufferType::kGraphics, false));
+
+    render_graph_->ImportTexture("backbuffer", backbuffer_, TextureLayout::kShaderReadOnly);
+  }
+
+  void TearDown() override {
+    render_graph_->Destroy(device_);
+    device_.DeleteCommandBuffer(command_buffer_);
+  }
+
+  SharedPtr<Texture> CreateBackbuffer(uint32_t width, uint32_t height) {
+    TextureSpecification specification{};
+    specification.format = DataFormat::kR8G8B8A8_UNORM;
+    specification.usage  = kTextureUsageBitColorAttachment | kTextureUsageBitSampled;
+    specification.width  = width;
+    specification.height = height;
+
+    return CreateShared<Texture>(device_, specification);
+  }
+
+  void AddPass(const std::string_view name, SetupFunc setup) {
+    render_graph_->AddPass<TestPass>(name, String{name}, std::move(setup), &executed_);
+  }
+
+  void Compile() {
+    render_graph_->Setup(device_);
+    render_graph_->Compile(device_);
+  }
+
+  void ResizeBackbuffer(uint32_t width, uint32_t height) {
+    backbuffer_ = CreateBackbuffer(width, height);
+    render_graph_->ReimportTexture(render_graph_->FirstVersion("backbuffer"), backbuffer_);
+  }
+
+  RecordedFrame Execute() {
+    executed_.clear();
+
+    command_buffer_->Reset();
+    command_buffer_->Begin();
+    render_graph_->Execute(device_, *command_buffer_, frame_++ % kFramesInFlight);
+    command_buffer_->End();
+
+    RecordedFrame          frame;
+    Vector<TextureBarrier> barriers;
+
+    command_buffer_->ForEachCommand([&frame, &barriers](const NullCommandHeader& header, const void* payload) {
+      switch (header.type) {
+        case NullCommandType::kPipelineBarrier: {
+          NullCmdPipelineBarrier command{};
+          std::memcpy(&command, payload, sizeof(command));
+
+          const uint8_t* data = static_cast<const uint8_t*>(payload) + sizeof(command);
+          for (uint32_t i = 0; i < command.texture_barriers_count; ++i) {
+            TextureBarrier barrier{};
+            std::memcpy(&barrier, data + i * sizeof(TextureBarrier), sizeof(TextureBarrier));
+            barriers.push_back(barrier);
+          }
+          break;
+        }
+
+        case NullCommandType::kRenderPassBegin: {
+          NullCmdRenderPassBegin command{};
+          std::memcpy(&command, payload, sizeof(command));
+
+          RecordedRenderPass& render_pass = frame.render_passes.emplace_back();
+          render_pass.render_pass = command.render_pass;
+          render_pass.barriers    = std::move(barriers);
+          barriers.clear();
+          break;
+        }
+
+        case NullCommandType::kNextSubpass: {
+          ++frame.render_passes.back().subpasses_count;
+          break;
+        }
+
+        default: {
+          break;
+        }
+      }
+    });
+
+    frame.final_barriers = std::move(barriers);
+    return frame;
+  }
+
+  SharedPtr<Texture> GetTexture(const std::string_view name) {
+    return render_graph_->GetTexture(render_graph_->LastVersion(name));
+  }
+
+  bool IsPassCulled(const std::string_view name) const {
+    RenderPassHandle render_pass{kInvalidRenderResourceHandle};
+    uint32_t         subpass_idx{0};
+    return !render_graph_->FindRenderPass(GeneratePassIdFromString(String{name}), &render_pass, &subpass_idx);
+  }
+
+  RenderPassHandle GetRenderPass(const std::string_view name, uint32_t* subpass_idx) const {
+    RenderPassHandle render_pass{kInvalidRenderResourceHandle};
+    EXPECT_TRUE(render_graph_->FindRenderPass(GeneratePassIdFromString(String{name}), &render_pass, subpass_idx));
+    return render_pass;
+  }
+
+  /**
+   * @brief Memory range of a transient texture placed in a shared heap.
+   */
+  struct Placement {
+    DeviceMemoryHandle memory{kInvalidRenderResourceHandle};
+    uint64_t           begin{0};
+    uint64_t           end{0};
+  };
+
+  bool GetPlacement(const Texture& texture, Placement* placement) {
+    if (!device_.GetTexturePlacement(texture.GetHandle(), &placement->memory, &placement->begin)) {
+      return false;
+    }
+
+    placement->end = placement->begin + device_.GetTextureMemoryRequirements(texture.GetSpecification()).size;
+    return true;
+  }
+
+  bool MemoryOverlaps(const Texture& lhs, const Texture& rhs) {
+    Placement lhs_placement{};
+    Placement rhs_placement{};
+    if (!GetPlacement(lhs, &lhs_placement) || !GetPlacement(rhs, &rhs_placement)) {
+      return false;
+    }
+
+    return lhs_placement.memory == rhs_placement.memory && lhs_placement.begin < rhs_placement.end &&
+           rhs_placement.begin < lhs_placement.end;
+  }
+
+ protected:
+  NullRenderDevice           device_;
+  rg::Blackboard             blackboard_;
+  UniquePtr<rg::RenderGraph> render_graph_;
+  NullCommandBuffer*         command_buffer_{nullptr};
+  SharedPtr<Texture>         backbuffer_;
+
+  Vector<String>             executed_;
+  uint32_t                   frame_{0};
+};
+
+/************************************************************************************************
+ * Culling
+ ************************************************************************************************/
+TEST_F(RenderGraphTest, CullsPassesNotContributingToOutputs) {
+  AddPass("Unused", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.CreateTexture("unused", ColorSpecification(256, 256)), AttachmentLoad::kClear);
+  });
+
+  /* Both passes of a chain ending in an unused texture are culled */
+  AddPass("DeadProducer", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.CreateTexture("dead", ColorSpecification(256, 256)), AttachmentLoad::kClear);
+  });
+
+  AddPass("DeadConsumer", [](rg::RenderGraphBuilder& builder) {
+    builder.AddSampledTexture(builder.LastVersion("dead"));
+    builder.AddColorAttachment(builder.CreateTexture("dead_out", ColorSpecification(256, 256)),
+                               AttachmentLoad::kClear);
+  });
+
+  /* Textures with a final layout are used outside of the graph */
+  AddPass("Exported", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(
+        builder.CreateTexture("exported", ColorSpecification(256, 256), TextureLayout::kShaderReadOnly),
+        AttachmentLoad::kClear);
+  });
+
+  AddPass("Producer", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.CreateTexture("color", ColorSpecification(256, 256)), AttachmentLoad::kClear);
+  });
+
+  AddPass("Composite", [](rg::RenderGraphBuilder& builder) {
+    builder.AddSampledTexture(builder.LastVersion("color"));
+    builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kClear);
+  });
+
+  Compile();
+
+  EXPECT_TRUE(IsPassCulled("Unused"));
+  EXPECT_TRUE(IsPassCulled("DeadProducer"));
+  EXPECT_TRUE(IsPassCulled("DeadConsumer"));
+  EXPECT_FALSE(IsPassCulled("Exported"));
+  EXPECT_FALSE(IsPassCulled("Producer"));
+  EXPECT_FALSE(IsPassCulled("Composite"));
+
+  RecordedFrame frame = Execute();
+  EXPECT_EQ(executed_, (Vector<String>{"Exported", "Producer", "Composite"}));
+  EXPECT_EQ(frame.render_passes.size(), 3);
+}
+
+/************************************************************************************************
+ * Barriers
+ ************************************************************************************************/
+TEST_F(RenderGraphTest, BarriersBetweenProducerAndConsumer) {
+  AddPass("Producer", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.CreateTexture("color", ColorSpecification(256, 256)), AttachmentLoad::kClear);
+  });
+
+  AddPass("Composite", [](rg::RenderGraphBuilder& builder) {
+    builder.AddSampledTexture(builder.LastVersion("color"));
+    builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kClear);
+  });
+
+  Compile();
+
+  SharedPtr<Texture> color = GetTexture("color");
+
+  for (uint32_t frame_idx = 0; frame_idx < 2 * kFramesInFlight; ++frame_idx) {
+    RecordedFrame frame = Execute();
+    ASSERT_EQ(frame.render_passes.size(), 2);
+
+    /* The producer's contents are discarded by the clear */
+    const Vector<TextureBarrier>& producer_barriers = frame.render_passes[0].barriers;
+    ASSERT_EQ(producer_barriers.size(), 1);
+    EXPECT_EQ(producer_barriers[0].texture, color->GetHandle());
+    EXPECT_EQ(producer_barriers[0].old_layout, TextureLayout::kUndefined);
+    EXPECT_EQ(producer_barriers[0].new_layout, TextureLayout::kColorAttachment);
+
+    /* The consumer samples the written texture and renders to the backbuffer */
+    const Vector<TextureBarrier>& composite_barriers = frame.render_passes[1].barriers;
+    ASSERT_EQ(composite_barriers.size(), 2);
+
+    const TextureBarrier* color_barrier = FindBarrier(composite_barriers, *color);
+    ASSERT_NE(color_barrier, nullptr);
+    EXPECT_EQ(color_barrier->old_layout, TextureLayout::kColorAttachment);
+    EXPECT_EQ(color_barrier->new_layout, TextureLayout::kShaderReadOnly);
+    EXPECT_TRUE(color_barrier->src_access_mask & kMemoryAccessBitColorAttachmentWrite);
+    EXPECT_TRUE(color_barrier->dst_access_mask & kMemoryAccessBitShaderRead);
+
+    const TextureBarrier* backbuffer_barrier = FindBarrier(composite_barriers, *backbuffer_);
+    ASSERT_NE(backbuffer_barrier, nullptr);
+    EXPECT_EQ(backbuffer_barrier->old_layout, TextureLayout::kUndefined);
+    EXPECT_EQ(backbuffer_barrier->new_layout, TextureLayout::kColorAttachment);
+
+    /* Only the imported texture is transitioned to its final layout */
+    ASSERT_EQ(frame.final_barriers.size(), 1);
+    EXPECT_EQ(frame.final_barriers[0].texture, backbuffer_->GetHandle());
+    EXPECT_EQ(frame.final_barriers[0].old_layout, TextureLayout::kColorAttachment);
+    EXPECT_EQ(frame.final_barriers[0].new_layout, TextureLayout::kShaderReadOnly);
+  }
+}
+
+TEST_F(RenderGraphTest, BarriersPreserveLoadedContents) {
+  AddPass("Clear", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kClear);
+  });
+
+  AddPass("Overlay", [](rg::RenderGraphBuilder& builder) {
+    builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kLoad);
+  });
+
+  Compile();
+
+  /* Merged passes don't need any barrier between them */
+  render_graph_->SetSubpassMerging(false);
+
+  Execute();
+  RecordedFrame frame = Execute();
+  ASSERT_EQ(frame.render_passes.size(), 2);
+
+  /* Write after write in the same layout */
+  const TextureBarrier* overlay_barrier = FindBarrier(frame.render_passes[1].barriers, *backbuffer_);
+  ASSERT_NE(overlay_barrier, nullptr);
+  EXPECT_EQ(overlay_barrier->old_layout, TextureLayout::kColorAttachment);
+  EXPECT_EQ(overlay_barrier->new_layout, TextureLayout::kColorAttachment);
+  EXPECT_TRUE(overlay_barrier->src_access_mask & kMemoryAccessBitColorAttachmentWrite);
+  EXPECT_TRUE(overlay_barrier->dst_access_mask & kMemoryAccessBitColorAttachmentRead);
+}
+
+/************************************************************************************************
+ * Aliasing
+ ************************************************************************************************/
+/**
+ * @brief Chain of passes, each sampling the previous pass' texture, so that only the textures of adjacent passes are
+ *        alive at the same time.
+ */
+class RenderGraphAliasingTest : public RenderGraphTest {
+ protected:
+  static constexpr uint32_t kChainLength = 4;
+
+  static String ChainTextureName(uint32_t idx) { return fmt::format("chain_{0}", idx); }
+
+  void AddChain(TextureType first_texture_type = TextureType::kTexture2D) {
+    for (uint32_t idx = 0; idx < kChainLength; ++idx) {
+      AddPass(ChainTextureName(idx), [idx, first_texture_type](rg::RenderGraphBuilder& builder) {
+        if (idx > 0) {
+          builder.AddSampledTexture(builder.LastVersion(ChainTextureName(idx - 1)));
+        }
+
+        rg::TextureVersionId backbuffer = builder.LastVersion("backbuffer");
+
+        rg::DynamicTextureSpecification specification = ColorSpecification(0, 0);
+        specification.width.SetDependency(backbuffer);
+        specification.height.SetDependency(backbuffer);
+
+        if (idx == 0 && first_texture_type != TextureType::kTexture2D) {
+          specification.type = first_texture_type;
+        }
+
+        builder.AddColorAttachment(builder.CreateTexture(ChainTextureName(idx), specification),
+                                   AttachmentLoad::kClear);
+      });
+    }
+
+    AddPass("Composite", [](rg::RenderGraphBuilder& builder) {
+      builder.AddSampledTexture(builder.LastVersion(ChainTextureName(kChainLength - 1)));
+      builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kClear);
+    });
+  }
+
+  void ExpectNoOverlapWithinLifetimes() {
+    for (uint32_t idx = 0; idx < kChainLength; ++idx) {
+      SharedPtr<Texture> texture = GetTexture(ChainTextureName(idx));
+
+      Placement placement{};
+      EXPECT_TRUE(GetPlacement(*texture, &placement)) << ChainTextureName(idx) << " is not aliased";
+
+      if (idx + 1 < kChainLength) {
+        EXPECT_FALSE(MemoryOverlaps(*texture, *GetTexture(ChainTextureName(idx + 1))))
+            << ChainTextureName(idx) << " overlaps with the next texture, which is alive at the same time";
+      }
+    }
+
+    /* Lifetimes are disjoint, so the memory is reused */
+    EXPECT_TRUE(MemoryOverlaps(*GetTexture(ChainTextureName(0)), *GetTexture(ChainTextureName(2))));
+
+    const rg::TransientMemoryStatistics& statistics = render_graph_->GetTransientMemoryStatistics();
+    EXPECT_EQ(statistics.aliased_textures_count, kChainLength);
+    EXPECT_LT(statistics.allocated_size, statistics.textures_size);
+  }
+};
+
+TEST_F(RenderGraphAliasingTest, TexturesAliveTogetherDontOverlap) {
+  AddChain();
+  Compile();
+  Execute();
+
+  ExpectNoOverlapWithinLifetimes();
+}
+
+TEST_F(RenderGraphAliasingTest, PlacementFollowsResize) {
+  AddChain();
+  Compile();
+  Execute();
+
+  ResizeBackbuffer(kBackbufferWidth / 2, kBackbufferHeight / 2);
+  RecordedFrame frame = Execute();
+
+  EXPECT_EQ(GetTexture(ChainTextureName(0))->GetSpecification().width, kBackbufferWidth / 2);
+  ExpectNoOverlapWithinLifetimes();
+
+  /* The first use of memory aliased with an earlier texture waits for the accesses through it */
+  const TextureBarrier* barrier = FindBarrier(frame.render_passes[2].barriers, *GetTexture(ChainTextureName(2)));
+  ASSERT_NE(barrier, nullptr);
+  EXPECT_EQ(barrier->old_layout, TextureLayout::kUndefined);
+}
+
+TEST_F(RenderGraphAliasingTest, FirstUseOfAliasedArrayDiscardsContents) {
+  AddChain(TextureType::kTexture2DArray);
+  Compile();
+
+  for (uint32_t frame_idx = 0; frame_idx < 2 * kFramesInFlight; ++frame_idx) {
+    RecordedFrame frame = Execute();
+
+    /* Other layers would be preserved if the texture wasn't aliased, but its memory has been written by the others */
+    const TextureBarrier* barrier = FindBarrier(frame.render_passes[0].barriers, *GetTexture(ChainTextureName(0)));
+    ASSERT_NE(barrier, nullptr);
+    EXPECT_EQ(barrier->old_layout, TextureLayout::kUndefined);
+  }
+}
+
+/************************************************************************************************
+ * Subpass merging
+ ************************************************************************************************/
+/**
+ * @brief A pass rendering to a fixed size texture followed by a pass reading it as an input attachment and rendering
+ *        to the backbuffer, which are merged while the backbuffer has the same size.
+ */
+class RenderGraphMergingTest : public RenderGraphTest {
+ protected:
+  void AddPasses(bool sample_instead_of_input = false) {
+    AddPass("GBuffer", [](rg::RenderGraphBuilder& builder) {
+      builder.AddColorAttachment(builder.CreateTexture("gbuffer", ColorSpecification(kBackbufferWidth,
+                                                                                     kBackbufferHeight)),
+                                 AttachmentLoad::kClear);
+    });
+
+    AddPass("Lighting", [sample_instead_of_input](rg::RenderGraphBuilder& builder) {
+      if (sample_instead_of_input) {
+        builder.AddSampledTexture(builder.LastVersion("gbuffer"));
+      } else {
+        builder.AddInputAttachment(builder.LastVersion("gbuffer"));
+      }
+
+      builder.AddColorAttachment(builder.LastVersion("backbuffer"), AttachmentLoad::kClear);
+    });
+  }
+
+  bool PassesMerged() {
+    uint32_t gbuffer_subpass_idx  = 0;
+    uint32_t lighting_subpass_idx = 0;
+
+    RenderPassHandle gbuffer_pass  = GetRenderPass("GBuffer", &gbuffer_subpass_idx);
+    RenderPassHandle lighting_pass = GetRenderPass("Lighting", &lighting_subpass_idx);
+    EXPECT_EQ(gbuffer_subpass_idx, 0);
+
+    if (gbuffer_pass != lighting_pass) {
+      EXPECT_EQ(lighting_subpass_idx, 0);
+      return false;
+    }
+
+    EXPECT_EQ(lighting_subpass_idx, 1);
+    return true;
+  }
+};
+
+TEST_F(RenderGraphMergingTest, MergesInputAttachmentReads) {
+  AddPasses();
+  Compile();
+
+  EXPECT_TRUE(PassesMerged());
+
+  RecordedFrame frame = Execute();
+  ASSERT_EQ(frame.render_passes.size(), 1);
+  EXPECT_EQ(frame.render_passes[0].subpasses_count, 2);
+  EXPECT_EQ(executed_, (Vector<String>{"GBuffer", "Lighting"}));
+}
+
+TEST_F(RenderGraphMergingTest, DoesntMergeSampledReads) {
+  AddPasses(/*sample_instead_of_input=*/true);
+  Compile();
+
+  EXPECT_FALSE(PassesMerged());
+  EXPECT_EQ(Execute().render_passes.size(), 2);
+}
+
+TEST_F(RenderGraphMergingTest, DoesntMergeWhenDisabled) {
+  AddPasses();
+  render_graph_->SetSubpassMerging(false);
+  Compile();
+
+  EXPECT_FALSE(PassesMerged());
+  EXPECT_EQ(Execute().render_passes.size(), 2);
+}
+
+TEST_F(RenderGraphMergingTest, MergingFollowsResize) {
+  AddPasses();
+  Compile();
+  Execute();
+
+  /* Attachments of a render pass must have the same extent */
+  ResizeBackbuffer(kBackbufferWidth / 2, kBackbufferHeight / 2);
+  RecordedFrame frame = Execute();
+
+  EXPECT_FALSE(PassesMerged());
+  ASSERT_EQ(frame.render_passes.size(), 2);
+
+  /* The input attachment is read in a separate render pass now */
+  const TextureBarrier* barrier = FindBarrier(frame.render_passes[1].barriers, *GetTexture("gbuffer"));
+  ASSERT_NE(barrier, nullptr);
+  EXPECT_EQ(barrier->old_layout, TextureLayout::kColorAttachment);
+  EXPECT_EQ(barrier->new_layout, TextureLayout::kShaderReadOnly);
+
+  ResizeBackbuffer(kBackbufferWidth, kBackbufferHeight);
+  frame = Execute();
+
+  EXPECT_TRUE(PassesMerged());
+  EXPECT_EQ(frame.render_passes.size(), 1);
+}